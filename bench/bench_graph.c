@@ -0,0 +1,538 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "core/graph_build.h"
+#include "core/graph_batch.h"
+#include "core/graph_operations.h"
+#include "io/edge_list.h"
+#include "io/graph_export.h"
+#include "utils/general_utils.h"
+#include "utils/graph_build_utils.h"
+
+// Benchmark harness for core graph operations.
+// Every (graph type, distribution, size) configuration runs in a forked child so
+// peak RSS is reported per configuration. Output is one JSON object per line.
+
+#ifndef BENCH_VERSION
+#define BENCH_VERSION "unknown"
+#endif
+
+#define MAX_SIZES 16
+#define FAST_BATCH 64  // ops timed together for sub-microsecond operations
+
+typedef enum {
+    DIST_UNIFORM,
+    DIST_POWERLAW
+} Distribution;
+
+static const char* dist_names[] = {"uniform", "powerlaw"};
+
+typedef struct {
+    size_t sizes[MAX_SIZES];
+    size_t size_count;
+    size_t avg_degree;
+    size_t repeats;
+    uint64_t seed;
+    FILE* out;
+} BenchConfig;
+
+typedef struct {
+    int from;
+    int to;
+} BenchEdge;
+
+// Per-benchmark sample collection (ns per op for each timed batch)
+typedef struct {
+    double* samples;
+    size_t count;
+    size_t capacity;
+    size_t ops;
+    size_t failures;
+    uint64_t total_ns;
+} Samples;
+
+// Helper: xorshift64* generator, good enough for workload generation
+static uint64_t rng_next(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static double rng_uniform(uint64_t* state) {
+    return (rng_next(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static size_t pick_node(uint64_t* state, size_t n, Distribution dist) {
+    double u = rng_uniform(state);
+    // Power-law: skew picks towards low IDs, producing hub nodes
+    if (dist == DIST_POWERLAW) u = pow(u, 2.5);
+    size_t idx = (size_t)(u * n);
+    return idx < n ? idx : n - 1;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return usage.ru_maxrss;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_edge(const void* a, const void* b) {
+    const BenchEdge* x = a;
+    const BenchEdge* y = b;
+    if (x->from != y->from) return (x->from > y->from) - (x->from < y->from);
+    return (x->to > y->to) - (x->to < y->to);
+}
+
+static void samples_init(Samples* s, size_t capacity) {
+    s->samples = malloc((capacity ? capacity : 1) * sizeof(double));
+    s->count = 0;
+    s->capacity = capacity ? capacity : 1;
+    s->ops = 0;
+    s->failures = 0;
+    s->total_ns = 0;
+}
+
+static void samples_add(Samples* s, uint64_t elapsed_ns, size_t ops) {
+    if (!s->samples || ops == 0) return;
+    if (s->count == s->capacity) {
+        double* grown = realloc(s->samples, s->capacity * 2 * sizeof(double));
+        if (!grown) return;
+        s->samples = grown;
+        s->capacity *= 2;
+    }
+    s->samples[s->count++] = (double)elapsed_ns / (double)ops;
+    s->ops += ops;
+    s->total_ns += elapsed_ns;
+}
+
+static double percentile(const double* sorted, size_t count, double p) {
+    if (count == 0) return 0.0;
+    size_t idx = (size_t)(p * (double)(count - 1) + 0.5);
+    return sorted[idx];
+}
+
+static void report(const BenchConfig* config, const char* name, GraphType type,
+                   Distribution dist, size_t nodes, size_t edges, Samples* s) {
+    if (s->count > 0) qsort(s->samples, s->count, sizeof(double), compare_double);
+
+    double mean = s->ops ? (double)s->total_ns / (double)s->ops : 0.0;
+    double ops_per_sec = s->total_ns ? (double)s->ops * 1e9 / (double)s->total_ns : 0.0;
+
+    fprintf(config->out,
+        "{\"bench\":\"%s\",\"version\":\"%s\",\"graph_type\":\"%s\",\"distribution\":\"%s\","
+        "\"nodes\":%zu,\"edges\":%zu,\"ops\":%zu,\"failures\":%zu,\"ops_per_sec\":%.1f,"
+        "\"ns_per_op\":{\"mean\":%.1f,\"p50\":%.1f,\"p90\":%.1f,\"p99\":%.1f,\"max\":%.1f},"
+        "\"peak_rss_kb\":%ld}\n",
+        name, BENCH_VERSION, type == GRAPH_DIRECTED ? "directed" : "undirected", dist_names[dist],
+        nodes, edges, s->ops, s->failures, ops_per_sec, mean,
+        percentile(s->samples, s->count, 0.50),
+        percentile(s->samples, s->count, 0.90),
+        percentile(s->samples, s->count, 0.99),
+        s->count ? s->samples[s->count - 1] : 0.0,
+        peak_rss_kb());
+    fflush(config->out);
+
+    free(s->samples);
+    s->samples = NULL;
+}
+
+// Helper: random, duplicate free, self-loop free edge workload
+static BenchEdge* generate_edges(size_t n, size_t avg_degree, GraphType type,
+                                 Distribution dist, uint64_t seed, size_t* edge_count) {
+    size_t target = type == GRAPH_UNDIRECTED ? n * avg_degree / 2 : n * avg_degree;
+    BenchEdge* edges = malloc((target ? target : 1) * sizeof(BenchEdge));
+    if (!edges) return NULL;
+
+    uint64_t state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    size_t count = 0;
+    for (size_t i = 0; i < target; i++) {
+        int from = (int)pick_node(&state, n, DIST_UNIFORM);
+        int to = (int)pick_node(&state, n, dist);
+        if (from == to) continue;
+        // Undirected edges are canonicalized so duplicates can be removed
+        if (type == GRAPH_UNDIRECTED && from > to) {
+            int tmp = from; from = to; to = tmp;
+        }
+        edges[count].from = from;
+        edges[count].to = to;
+        count++;
+    }
+
+    qsort(edges, count, sizeof(BenchEdge), compare_edge);
+    size_t unique = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (unique == 0 || compare_edge(&edges[unique - 1], &edges[i]) != 0) edges[unique++] = edges[i];
+    }
+
+    // Shuffle so inserts do not arrive sorted by source
+    for (size_t i = unique; i > 1; i--) {
+        size_t j = (size_t)(rng_next(&state) % i);
+        BenchEdge tmp = edges[i - 1];
+        edges[i - 1] = edges[j];
+        edges[j] = tmp;
+    }
+
+    *edge_count = unique;
+    return edges;
+}
+
+static Graph* build_graph(GraphType type, size_t n, const BenchEdge* edges, size_t edge_count) {
+    Graph* graph = graph_create(type, 0);
+    if (!graph) return NULL;
+    for (size_t i = 0; i < n; i++) graph_insert_node(graph, (int)i, 0);
+    for (size_t i = 0; i < edge_count; i++) graph_insert_edge(graph, edges[i].from, edges[i].to, 1.0);
+    return graph;
+}
+
+static void bench_insert_node(const BenchConfig* config, GraphType type, Distribution dist, size_t n) {
+    Samples s;
+    samples_init(&s, n / FAST_BATCH + 1);
+
+    Graph* graph = graph_create(type, 0);
+    if (!graph) return;
+
+    for (size_t i = 0; i < n; i += FAST_BATCH) {
+        size_t end = i + FAST_BATCH < n ? i + FAST_BATCH : n;
+        uint64_t start = now_ns();
+        for (size_t j = i; j < end; j++) {
+            if (graph_insert_node(graph, (int)j, 0) != STATUS_SUCCESS) s.failures++;
+        }
+        samples_add(&s, now_ns() - start, end - i);
+    }
+
+    report(config, "graph_insert_node", type, dist, n, 0, &s);
+    graph_destroy(graph);
+}
+
+static Graph* bench_insert_edge(const BenchConfig* config, GraphType type, Distribution dist, size_t n,
+                                const BenchEdge* edges, size_t edge_count) {
+    Samples s;
+    samples_init(&s, edge_count / FAST_BATCH + 1);
+
+    Graph* graph = graph_create(type, 0);
+    if (!graph) return NULL;
+    for (size_t i = 0; i < n; i++) graph_insert_node(graph, (int)i, 0);
+
+    for (size_t i = 0; i < edge_count; i += FAST_BATCH) {
+        size_t end = i + FAST_BATCH < edge_count ? i + FAST_BATCH : edge_count;
+        uint64_t start = now_ns();
+        for (size_t j = i; j < end; j++) {
+            if (graph_insert_edge(graph, edges[j].from, edges[j].to, 1.0) != STATUS_SUCCESS) s.failures++;
+        }
+        samples_add(&s, now_ns() - start, end - i);
+    }
+
+    report(config, "graph_insert_edge", type, dist, n, edge_count, &s);
+    return graph;
+}
+
+static void bench_batch_commit(const BenchConfig* config, GraphType type, Distribution dist, size_t n,
+                               const BenchEdge* edges, size_t edge_count) {
+    Samples s;
+    samples_init(&s, 1);
+
+    Graph* graph = graph_create(type, 0);
+    GraphBatch* batch = graph ? graph_batch_begin(graph) : NULL;
+    if (!batch) {
+        graph_destroy(graph);
+        return;
+    }
+
+    // Edges are sampled uniquely, so the whole workload commits as one batch
+    uint64_t start = now_ns();
+    for (size_t i = 0; i < n; i++) graph_batch_insert_node(batch, (int)i, 0);
+    for (size_t i = 0; i < edge_count; i++) graph_batch_insert_edge(batch, edges[i].from, edges[i].to, 1.0);
+    if (graph_batch_commit(batch, NULL) != STATUS_SUCCESS) s.failures++;
+    samples_add(&s, now_ns() - start, n + edge_count);
+
+    report(config, "graph_batch_commit", type, dist, n, edge_count, &s);
+    graph_destroy(graph);
+}
+
+static void bench_find_node(const BenchConfig* config, GraphType type, Distribution dist,
+                            Graph* graph, size_t n, size_t edge_count) {
+    size_t lookups = n * 4;
+    Samples s;
+    samples_init(&s, lookups / FAST_BATCH + 1);
+
+    uint64_t state = config->seed ^ 0xF17D;
+    volatile size_t found = 0;
+    for (size_t i = 0; i < lookups; i += FAST_BATCH) {
+        int ids[FAST_BATCH];
+        size_t end = i + FAST_BATCH < lookups ? i + FAST_BATCH : lookups;
+        // One in four lookups misses, exercising full chain walks
+        for (size_t j = i; j < end; j++) {
+            size_t idx = pick_node(&state, n, dist);
+            ids[j - i] = (j & 3) == 3 ? (int)(idx + n) : (int)idx;
+        }
+
+        uint64_t start = now_ns();
+        for (size_t j = i; j < end; j++) {
+            if (find_node(graph, ids[j - i])) found++;
+        }
+        samples_add(&s, now_ns() - start, end - i);
+    }
+
+    report(config, "find_node", type, dist, n, edge_count, &s);
+}
+
+static void bench_edge_count(const BenchConfig* config, GraphType type, Distribution dist,
+                             Graph* graph, size_t n, size_t edge_count) {
+    size_t repeats = config->repeats * 4;
+    Samples s;
+    samples_init(&s, repeats);
+
+    for (size_t i = 0; i < repeats; i++) {
+        uint64_t start = now_ns();
+        size_t counted = graph_edge_count(graph);
+        samples_add(&s, now_ns() - start, 1);
+        if (counted != edge_count) s.failures++;
+    }
+
+    report(config, "graph_edge_count", type, dist, n, edge_count, &s);
+}
+
+static void bench_resize(const BenchConfig* config, GraphType type, Distribution dist, size_t n,
+                         const BenchEdge* edges, size_t edge_count) {
+    Samples s;
+    samples_init(&s, config->repeats);
+
+    for (size_t i = 0; i < config->repeats; i++) {
+        Graph* graph = build_graph(type, n, edges, edge_count);
+        if (!graph) break;
+
+        uint64_t start = now_ns();
+        if (graph_resize(graph) != STATUS_SUCCESS) s.failures++;
+        samples_add(&s, now_ns() - start, 1);
+
+        graph_destroy(graph);
+    }
+
+    report(config, "graph_resize", type, dist, n, edge_count, &s);
+}
+
+static void bench_remove_node(const BenchConfig* config, GraphType type, Distribution dist,
+                              Graph* graph, size_t n, size_t edge_count) {
+    // Directed removal scans every node, so keep the op count bounded
+    size_t limit = type == GRAPH_DIRECTED ? 100 : 1000;
+    size_t removals = n / 10 < limit ? n / 10 : limit;
+    if (removals == 0) removals = 1;
+
+    // Partial Fisher-Yates shuffle, so every removal hits a node that still exists
+    int* ids = malloc(n * sizeof(int));
+    if (!ids) return;
+    for (size_t i = 0; i < n; i++) ids[i] = (int)i;
+    uint64_t state = config->seed ^ 0xDE1E7E;
+    for (size_t i = 0; i < removals; i++) {
+        size_t j = i + (size_t)(rng_next(&state) % (n - i));
+        int swap = ids[i];
+        ids[i] = ids[j];
+        ids[j] = swap;
+    }
+
+    Samples s;
+    samples_init(&s, removals);
+
+    for (size_t i = 0; i < removals; i++) {
+        uint64_t start = now_ns();
+        if (graph_remove_node(graph, ids[i]) != STATUS_SUCCESS) s.failures++;
+        samples_add(&s, now_ns() - start, 1);
+    }
+
+    report(config, "graph_remove_node", type, dist, n, edge_count, &s);
+    free(ids);
+}
+
+static void bench_load_graph(const BenchConfig* config, GraphType type, Distribution dist, size_t n,
+                             const BenchEdge* edges, size_t edge_count) {
+    char path[] = "/tmp/bench_graph_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return;
+
+    FILE* file = fdopen(fd, "w");
+    if (!file) {
+        close(fd);
+        unlink(path);
+        return;
+    }
+    for (size_t i = 0; i < edge_count; i++) fprintf(file, "%d %d 1.0\n", edges[i].from, edges[i].to);
+    fclose(file);
+
+    Samples s;
+    samples_init(&s, config->repeats);
+
+    for (size_t i = 0; i < config->repeats; i++) {
+        Graph* graph = graph_create(type, 0);
+        if (!graph) break;
+
+        uint64_t start = now_ns();
+        if (load_graph(path, graph) != 0) s.failures++;
+        samples_add(&s, now_ns() - start, edge_count ? edge_count : 1);
+
+        graph_destroy(graph);
+    }
+
+    unlink(path);
+    report(config, "load_graph", type, dist, n, edge_count, &s);
+}
+
+static void bench_save_edge_list(const BenchConfig* config, GraphType type, Distribution dist,
+                                 const Graph* graph, size_t n, size_t edge_count) {
+    char path[] = "/tmp/bench_graph_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return;
+    close(fd);
+
+    Samples s;
+    samples_init(&s, config->repeats);
+
+    for (size_t i = 0; i < config->repeats; i++) {
+        size_t written = 0;
+        uint64_t start = now_ns();
+        if (graph_save_edge_list(graph, path, NULL, &written) != STATUS_SUCCESS || written != edge_count) s.failures++;
+        samples_add(&s, now_ns() - start, edge_count ? edge_count : 1);
+    }
+
+    unlink(path);
+    report(config, "graph_save_edge_list", type, dist, n, edge_count, &s);
+}
+
+static int run_configuration(const BenchConfig* config, GraphType type, Distribution dist, size_t n) {
+    size_t edge_count = 0;
+    BenchEdge* edges = generate_edges(n, config->avg_degree, type, dist, config->seed + n, &edge_count);
+    if (!edges) {
+        fprintf(stderr, "Error: Failed to generate benchmark workload for %zu nodes\n", n);
+        return 1;
+    }
+
+    bench_insert_node(config, type, dist, n);
+
+    Graph* graph = bench_insert_edge(config, type, dist, n, edges, edge_count);
+    if (graph) {
+        bench_find_node(config, type, dist, graph, n, edge_count);
+        bench_edge_count(config, type, dist, graph, n, edge_count);
+        bench_save_edge_list(config, type, dist, graph, n, edge_count);
+        bench_remove_node(config, type, dist, graph, n, edge_count);
+        graph_destroy(graph);
+    }
+
+    bench_batch_commit(config, type, dist, n, edges, edge_count);
+    bench_resize(config, type, dist, n, edges, edge_count);
+    bench_load_graph(config, type, dist, n, edges, edge_count);
+
+    free(edges);
+    return 0;
+}
+
+static int parse_sizes(const char* arg, BenchConfig* config) {
+    config->size_count = 0;
+    const char* cursor = arg;
+    while (*cursor && config->size_count < MAX_SIZES) {
+        char* end;
+        unsigned long long value = strtoull(cursor, &end, 10);
+        if (end == cursor || value == 0) return 1;
+        config->sizes[config->size_count++] = (size_t)value;
+        cursor = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') return 1;
+    }
+    return config->size_count == 0;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [-o output] [-s sizes] [-d avg_degree] [-r repeats] [-S seed]\n"
+        "  -o  write JSON lines to file instead of stdout\n"
+        "  -s  comma separated node counts (default 1000,10000,100000)\n"
+        "  -d  average degree of generated graphs (default 8)\n"
+        "  -r  repeats for whole-graph benchmarks (default 5)\n"
+        "  -S  workload seed (default 42)\n", program);
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config = {
+        .sizes = {1000, 10000, 100000},
+        .size_count = 3,
+        .avg_degree = 8,
+        .repeats = 5,
+        .seed = 42,
+        .out = stdout
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:s:d:r:S:h")) != -1) {
+        switch (opt) {
+            case 'o':
+                config.out = fopen(optarg, "w");
+                if (!config.out) {
+                    fprintf(stderr, "Error: Failed to open output file %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 's':
+                if (parse_sizes(optarg, &config)) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'd':
+                config.avg_degree = (size_t)strtoull(optarg, NULL, 10);
+                break;
+            case 'r':
+                config.repeats = (size_t)strtoull(optarg, NULL, 10);
+                if (config.repeats == 0) config.repeats = 1;
+                break;
+            case 'S':
+                config.seed = strtoull(optarg, NULL, 10);
+                break;
+            default:
+                usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    Distribution dists[] = {DIST_UNIFORM, DIST_POWERLAW};
+    int failed = 0;
+
+    for (size_t t = 0; t < 2; t++) {
+        for (size_t d = 0; d < 2; d++) {
+            for (size_t i = 0; i < config.size_count; i++) {
+                // Isolate each configuration so peak RSS is not inherited
+                fflush(config.out);
+                pid_t pid = fork();
+                if (pid < 0) {
+                    failed |= run_configuration(&config, types[t], dists[d], config.sizes[i]);
+                } else if (pid == 0) {
+                    _exit(run_configuration(&config, types[t], dists[d], config.sizes[i]));
+                } else {
+                    int status = 0;
+                    waitpid(pid, &status, 0);
+                    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = 1;
+                }
+            }
+        }
+    }
+
+    if (config.out != stdout) fclose(config.out);
+    return failed;
+}
@@ -0,0 +1,39 @@
+#ifndef GRAPH_BATCH_H
+#define GRAPH_BATCH_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Atomic batched mutations.
+// * Operations are buffered by the graph_batch_* calls and only touch the graph on
+// * commit. Commit reserves hash table and neighbor capacity once, applies the
+// * operations in order while recording a single undo log, and rolls everything
+// * back if any operation fails. Node/edge order and weights are restored exactly;
+// * only reserved capacity is kept.
+
+typedef struct GraphBatch GraphBatch;
+
+GraphBatch* graph_batch_begin(Graph* graph);
+
+// Buffer operations. On commit each one is checked like its graph_* counterpart,
+// but where that would only warn (missing node, existing edge, ...) the whole
+// batch fails with STATUS_WARNING and is rolled back.
+Status graph_batch_insert_node(GraphBatch* batch, int node_id, size_t initial_capacity);
+Status graph_batch_remove_node(GraphBatch* batch, int node_id);
+Status graph_batch_insert_edge(GraphBatch* batch, int from, int to, double weight);
+Status graph_batch_update_edge(GraphBatch* batch, int from, int to, double weight);
+Status graph_batch_remove_edge(GraphBatch* batch, int from, int to);
+
+size_t graph_batch_size(const GraphBatch* batch);
+
+// Apply all buffered operations or none. The batch is released either way.
+// failed_op (optional) receives the index of the operation that failed, or
+// graph_batch_size() when reserving capacity failed before any operation ran.
+Status graph_batch_commit(GraphBatch* batch, size_t* failed_op);
+
+// Discard buffered operations, the graph is left untouched. Releases the batch.
+void graph_batch_abort(GraphBatch* batch);
+
+#endif
@@ -33,7 +33,7 @@ typedef struct Node {
 typedef struct {
     GraphType type;
     Node** nodes; // * Hash table for nodes
-    Node** node_ids;
+    int* node_ids; // * Node IDs in insertion order
     size_t node_count;
     size_t node_capacity;
 } Graph;
@@ -42,7 +42,7 @@ typedef struct {
 
 // Graph initialization/deletion tools
 Graph* graph_create(GraphType type, size_t initial_capacity);
-void graph_destroy(Graph* graph);
+Status graph_destroy(Graph* graph);
 
 // Edit graph tools
 Status graph_insert_node(Graph* graph, int node_id, size_t initial_capacity);
@@ -0,0 +1,46 @@
+#ifndef GRAPH_CSR_H
+#define GRAPH_CSR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Compressed sparse row snapshot of a Graph for read-only analytics.
+// * Nodes get dense indices in insertion order (index i is graph->node_ids[i]),
+// * neighbor lists are sorted by index. The snapshot does not follow later
+// * changes to the graph.
+
+#define CSR_NO_INDEX UINT32_MAX
+
+typedef struct {
+    int id;
+    uint32_t index;
+} CsrSlot;
+
+typedef struct {
+    GraphType type;
+    size_t node_count;
+    size_t arc_count;       // stored adjacency entries, undirected edges count twice
+    int* ids;               // index -> node ID
+    size_t* offsets;        // node_count + 1 entries, neighbors of i are [offsets[i], offsets[i + 1])
+    uint32_t* targets;      // neighbor indices
+    double* weights;        // parallel to targets, NULL unless requested
+
+    // ID -> index lookup, open addressing
+    CsrSlot* slots;
+    size_t slot_capacity;   // power of two
+} GraphCsr;
+
+Status graph_csr_build(const Graph* graph, GraphCsr* csr, bool with_weights, int num_threads);
+void graph_csr_free(GraphCsr* csr);
+
+// Dense index of a node ID, CSR_NO_INDEX if absent
+uint32_t graph_csr_index(const GraphCsr* csr, int node_id);
+
+static inline size_t graph_csr_degree(const GraphCsr* csr, uint32_t index) {
+    return csr->offsets[index + 1] - csr->offsets[index];
+}
+
+#endif
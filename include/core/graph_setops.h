@@ -0,0 +1,40 @@
+#ifndef GRAPH_SETOPS_H
+#define GRAPH_SETOPS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Set operations on the edge sets of two graphs of the same type.
+// * Every output node merges the ID-sorted neighbor lists it has in a and b.
+// * Nodes are processed in parallel, each neighbor array is allocated at its
+// * exact final size and the node table is reserved once, so no output array
+// * ever grows. Neighbor lists of the result come out sorted by ID.
+// *
+// * union:        nodes of a, then nodes only in b; edges of either graph
+// * intersection: nodes of both, in the order of a; edges of both graphs
+// * difference:   nodes of a; edges of a that b does not have, with a's weight
+
+typedef enum {
+    WEIGHT_FIRST,               // weight in a
+    WEIGHT_SECOND,              // weight in b
+    WEIGHT_SUM,
+    WEIGHT_MIN,
+    WEIGHT_MAX,
+    WEIGHT_MEAN
+} WeightRule;
+
+typedef struct {
+    WeightRule weights;         // for edges present in both graphs
+    int num_threads;            // 0 = one per CPU
+} SetOpConfig;
+
+SetOpConfig setop_config_default(void);
+
+// New graphs, NULL on failure or when the types differ; config may be NULL for defaults
+Graph* graph_union(const Graph* a, const Graph* b, const SetOpConfig* config);
+Graph* graph_intersection(const Graph* a, const Graph* b, const SetOpConfig* config);
+Graph* graph_difference(const Graph* a, const Graph* b, const SetOpConfig* config);
+
+#endif
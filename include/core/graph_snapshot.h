@@ -0,0 +1,60 @@
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Multi-version graph: consistent read-only snapshots of a graph that keeps
+// * being modified.
+// * graph_snapshot is O(1): it copies the graph header and bumps the version.
+// * Afterwards the writer copies on write whatever a live snapshot can still
+// * see: a node header (with the chain of headers before it in its bucket),
+// * a neighbor array, or the bucket and ID tables (pointers only, once per
+// * version). Superseded blocks are retired with the version that replaced them
+// * and freed once every snapshot older than that version has been released.
+// *
+// * A snapshot is a plain const Graph, so every metric runs on it unchanged, from
+// * any thread. Mutations must come from one thread at a time, which is also the
+// * only thread allowed to read versioned_graph_current; snapshots may be taken
+// * and released from anywhere.
+
+typedef struct VersionedGraph VersionedGraph;
+typedef struct GraphSnapshot GraphSnapshot;
+
+typedef struct {
+    uint64_t version;           // version the next snapshot will get
+    size_t live_snapshots;
+    size_t retired_blocks;      // superseded blocks waiting for old snapshots
+    uint64_t headers_copied;
+    uint64_t neighbor_arrays_copied;
+    uint64_t tables_copied;
+} VersionedGraphStats;
+
+// Take ownership of graph, NULL on failure (graph is then left untouched)
+VersionedGraph* versioned_graph_create(Graph* graph);
+
+// Release the graph; memory still seen by open snapshots goes with the last of them
+void versioned_graph_destroy(VersionedGraph* versioned);
+
+// The latest version, for the writer thread only
+const Graph* versioned_graph_current(const VersionedGraph* versioned);
+
+// Same semantics as the graph_* counterparts
+Status versioned_graph_insert_node(VersionedGraph* versioned, int node_id, size_t initial_capacity);
+Status versioned_graph_remove_node(VersionedGraph* versioned, int node_id);
+Status versioned_graph_insert_edge(VersionedGraph* versioned, int from, int to, double weight);
+Status versioned_graph_update_edge(VersionedGraph* versioned, int from, int to, double weight);
+Status versioned_graph_remove_edge(VersionedGraph* versioned, int from, int to);
+
+void versioned_graph_stats(VersionedGraph* versioned, VersionedGraphStats* stats);
+
+// Freeze the current version, NULL on OOM
+GraphSnapshot* graph_snapshot(VersionedGraph* versioned);
+const Graph* graph_snapshot_graph(const GraphSnapshot* snapshot);
+uint64_t graph_snapshot_version(const GraphSnapshot* snapshot);
+void graph_snapshot_release(GraphSnapshot* snapshot);
+
+#endif
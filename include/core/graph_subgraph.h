@@ -0,0 +1,49 @@
+#ifndef GRAPH_SUBGRAPH_H
+#define GRAPH_SUBGRAPH_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Subgraph extraction.
+// * A GraphView selects nodes (membership set over the given IDs, a bitmap when
+// * the ID range is compact) and/or edges (predicate) of a graph without copying
+// * it. Views are read-only and valid until the underlying graph is modified.
+// * graph_view_materialize copies a view into a new Graph with the hash table and
+// * every neighbor array sized exactly, skipping lookups and duplicate scans.
+
+// Undirected edges are tested once as (min ID, max ID) so both directions agree
+typedef bool (*EdgePredicate)(int from, int to, double weight, void* ctx);
+
+typedef struct GraphView GraphView;
+
+typedef struct {
+    const GraphView* view;
+    const Node* node;
+    size_t position;
+} GraphViewIter;
+
+// Induced view over ids (duplicates and missing IDs are skipped, order is kept)
+GraphView* graph_view_induced(const Graph* graph, const int* ids, size_t n);
+// Every node, only edges accepted by predicate
+GraphView* graph_view_filtered(const Graph* graph, EdgePredicate predicate, void* ctx);
+void graph_view_destroy(GraphView* view);
+
+size_t graph_view_node_count(const GraphView* view);
+int graph_view_node_id(const GraphView* view, size_t index);
+bool graph_view_has_node(const GraphView* view, int node_id);
+
+// Neighbor iteration: start with graph_view_neighbors, then call graph_view_next
+// until it returns NULL
+bool graph_view_neighbors(const GraphView* view, int node_id, GraphViewIter* iter);
+const EdgeNode* graph_view_next(GraphViewIter* iter);
+size_t graph_view_degree(const GraphView* view, int node_id);
+
+// Copy a view into a new graph of the same type, NULL on failure
+Graph* graph_view_materialize(const GraphView* view);
+
+Graph* graph_induced_subgraph(const Graph* graph, const int* ids, size_t n);
+Graph* graph_filter_edges(const Graph* graph, EdgePredicate predicate, void* ctx);
+
+#endif
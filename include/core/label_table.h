@@ -0,0 +1,38 @@
+#ifndef LABEL_TABLE_H
+#define LABEL_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+
+// * Interned string labels for node IDs (gene or protein symbols).
+// * Every distinct label is copied once into an arena of large blocks and gets
+// * the next free ID, 0, 1, 2, ... so IDs stay dense. Lookup by name is one
+// * hash and an open addressing probe, lookup by ID is an array index.
+// * Interning is single threaded; lookups may run concurrently once it stops.
+// *
+// * Label file: one label per line, line i holding the label of ID i.
+
+typedef struct LabelTable LabelTable;
+
+// expected_labels sizes the tables up front, 0 is fine
+LabelTable* label_table_create(size_t expected_labels);
+void label_table_destroy(LabelTable* table);
+
+// ID of the label (length bytes, no terminator needed), a new label gets the next ID
+Status label_table_intern(LabelTable* table, const char* label, size_t length, int* id);
+
+// ID of the label, -1 when it was never interned
+int label_table_find(const LabelTable* table, const char* label, size_t length);
+
+// Terminated label of an ID, NULL when the ID has none; length is optional
+const char* label_table_name(const LabelTable* table, int id, size_t* length);
+
+size_t label_table_count(const LabelTable* table);
+size_t label_table_max_length(const LabelTable* table);
+
+Status label_table_save(const LabelTable* table, const char* path);
+LabelTable* label_table_load(const char* path);
+
+#endif
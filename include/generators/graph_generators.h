@@ -0,0 +1,71 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Seeded synthetic graph generators.
+// * Edges are produced in fixed size chunks, each with its own RNG stream derived
+// * from (seed, chunk), so the output is identical for any number of threads.
+// * Node IDs are 0 .. node_count - 1. Duplicate edges may be produced by R-MAT and
+// * Barabasi-Albert; graph_insert_edge and load_graph reject them as usual.
+
+typedef enum {
+    GEN_RMAT,               // Recursive matrix (Kronecker) graph
+    GEN_BARABASI_ALBERT,    // Preferential attachment
+    GEN_ERDOS_RENYI,        // G(n, p)
+    GEN_SBM                 // Stochastic block model
+} GeneratorModel;
+
+typedef struct {
+    int scale;              // 2^scale nodes (max 30)
+    size_t edge_factor;     // edge_factor * 2^scale sampled edges
+    double a, b, c;         // quadrant probabilities, d = 1 - a - b - c
+    bool scramble_ids;      // permute IDs so degree is not correlated with ID
+} RmatParams;
+
+typedef struct {
+    size_t node_count;
+    size_t edges_per_node;  // edges attached by every new node
+} BarabasiAlbertParams;
+
+typedef struct {
+    size_t node_count;
+    double p;               // edge probability
+} ErdosRenyiParams;
+
+typedef struct {
+    size_t block_count;
+    const size_t* block_sizes;      // block_count entries, blocks are contiguous ID ranges
+    const double* probabilities;    // block_count x block_count, row-major
+} SbmParams;
+
+typedef struct {
+    GeneratorModel model;
+    union {
+        RmatParams rmat;
+        BarabasiAlbertParams ba;
+        ErdosRenyiParams er;
+        SbmParams sbm;
+    } params;
+    uint64_t seed;
+    int num_threads;            // 0 = one per CPU
+    bool allow_self_loops;
+    GraphType type;             // only used by generate_edge_list, graphs keep their own type
+} GeneratorConfig;
+
+// Config with sensible defaults for the given model (Graph500 R-MAT parameters)
+GeneratorConfig generator_config_default(GeneratorModel model);
+
+// Generate into an existing graph: nodes 0 .. n - 1 are inserted, then edges in chunk order.
+// edge_count (optional) receives the number of edges actually inserted.
+Status generate_graph(Graph* graph, const GeneratorConfig* config, size_t* edge_count);
+
+// Generate into an edge list file readable by load_graph.
+// edge_count (optional) receives the number of edge lines written.
+Status generate_edge_list(const char* filename, const GeneratorConfig* config, size_t* edge_count);
+
+#endif
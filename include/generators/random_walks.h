@@ -0,0 +1,61 @@
+#ifndef RANDOM_WALKS_H
+#define RANDOM_WALKS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Random walk corpus generation (DeepWalk, node2vec).
+// * Walks run on a CSR snapshot. Weighted steps draw from per-node alias tables
+// * (O(1) per step); node2vec draws a first-order candidate the same way and
+// * accepts it with probability alpha / max alpha, where alpha is 1/p for the
+// * previous node, 1 for its neighbors (binary search in its sorted list) and
+// * 1/q otherwise. No step scans a neighbor list.
+// *
+// * Walk w (round w / starts, start w % starts) is generated in a fixed chunk
+// * with its own RNG stream derived from (seed, chunk), and chunks are emitted
+// * in order, so the output is identical for any number of threads. A walk
+// * stops early at a node without out-edges.
+
+typedef enum {
+    WALK_UNIFORM,           // every out-edge equally likely
+    WALK_WEIGHTED,          // proportional to EdgeNode.weight
+    WALK_NODE2VEC           // second order, biased by p and q on top of the weights
+} WalkMode;
+
+typedef struct {
+    WalkMode mode;
+    size_t walk_length;         // nodes per walk, including the start
+    size_t walks_per_node;      // rounds over the start nodes
+    double p;                   // node2vec return parameter
+    double q;                   // node2vec in-out parameter
+    uint64_t seed;
+    int num_threads;            // 0 = one per CPU
+    const int* start_nodes;     // node IDs, NULL = every node in insertion order
+    size_t start_count;
+} WalkConfig;
+
+// A run of consecutive walks, valid only during the sink call
+typedef struct {
+    size_t first_walk;          // index of the first walk in the whole corpus
+    size_t count;
+    size_t stride;              // walk_length
+    const int* nodes;           // count x stride node IDs, walk i has lengths[i] of them
+    const uint32_t* lengths;
+} WalkBlock;
+
+// Called serially with blocks in walk order; any status other than STATUS_SUCCESS stops the run
+typedef Status (*WalkSink)(void* ctx, const WalkBlock* block);
+
+WalkConfig walk_config_default(void);
+
+// Weighted and node2vec walks need finite positive weights.
+// walk_count (optional) receives the number of walks emitted.
+Status graph_random_walks(const Graph* graph, const WalkConfig* config, WalkSink sink, void* ctx, size_t* walk_count);
+
+// Write walks to a text file, one walk per line as space separated node IDs
+Status graph_random_walks_to_file(const Graph* graph, const WalkConfig* config, const char* filename, size_t* walk_count);
+
+#endif
@@ -4,6 +4,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "utils/general_utils.h"
+#include "core/graph_build.h"
+#include "core/label_table.h"
+
+// Edge list loading tools
+void get_file_name(int argc, char *argv[], char* buffer, size_t size);
+int load_graph(const char* filename, Graph* graph);
+
+// Same format with string node labels ("TP53 MDM2 0.9"), interned into labels.
+// Node IDs are the label IDs, so one table can serve several graphs.
+int load_labeled_graph(const char* filename, Graph* graph, LabelTable* labels);
+
+// Split "from to [weight]" on whitespace and intern both labels.
+// STATUS_INVALID for lines with fewer than two fields or a malformed weight.
+Status parse_labeled_edge(const char* line, LabelTable* labels, int* source, int* target, double* weight);
 
 
 
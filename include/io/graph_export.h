@@ -0,0 +1,36 @@
+#ifndef GRAPH_EXPORT_H
+#define GRAPH_EXPORT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+#include "core/label_table.h"
+
+// * Graph writers.
+// * The graph is walked once in node insertion order. Nodes are formatted in
+// * fixed size shards into reusable buffers, then each round of shards is
+// * written with a single writev, so output order never depends on threads.
+// *
+// * Edge list:      "from to weight" per line, readable by load_graph. Undirected
+// *                 edges are written once, as from <= to. Isolated nodes are lost.
+// * Adjacency list: "id neighbor:weight neighbor:weight ..." per node, every node
+// *                 including isolated ones, undirected edges listed at both ends.
+// * With a label table nodes are written by label (IDs without one stay numeric),
+// * and load_labeled_graph reads an edge list back.
+
+typedef struct {
+    bool write_weights;     // without weights load_graph defaults them to 1.0
+    bool write_header;      // leading "# ..." comment line
+    int num_threads;        // 1 = sequential, 0 = one per CPU
+    const LabelTable* labels;   // write node labels instead of IDs, NULL = IDs
+} ExportOptions;
+
+ExportOptions export_options_default(void);
+
+// options may be NULL for defaults; edge_count (optional) receives the number of edges written,
+// for adjacency lists the number of neighbor entries
+Status graph_save_edge_list(const Graph* graph, const char* filename, const ExportOptions* options, size_t* edge_count);
+Status graph_save_adjacency_list(const Graph* graph, const char* filename, const ExportOptions* options, size_t* edge_count);
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef GRAPH_EXTERNAL_H
+#define GRAPH_EXTERNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+#include "core/label_table.h"
+
+// * Out-of-core graph construction.
+// * The edge list is parsed into fixed size runs that are sorted by (from, to)
+// * and spilled to the scratch directory, then k-way merged (in several passes
+// * when there are more runs than fit the budget) straight into an on-disk
+// * adjacency file. Peak memory is bounded by memory_budget, not by edge count.
+// *
+// * Adjacency file, host byte order:
+// *   header   64 bytes: magic "NETADJ01", uint32 type, uint32 flags (1 = weighted),
+// *            uint64 node_count, uint64 arc_count, zero padding
+// *   nodes    sorted by ID: int32 id, uint32 degree, then degree arcs of
+// *            int32 target (+ double weight when weighted), targets sorted
+// * Undirected edges are stored at both ends. Duplicate edges keep the weight of
+// * the first line, self loops are dropped for undirected graphs, as in load_graph.
+
+#define DISK_DEGREE_BUCKETS 33  // bucket 0: degree 0, bucket k: degree in [2^(k-1), 2^k)
+
+typedef struct {
+    size_t memory_budget;       // bytes for run and merge buffers, at least 1 MiB
+    const char* scratch_dir;    // directory for temporary runs
+    GraphType type;
+    bool weighted;              // store weights, otherwise readers report 1.0
+    LabelTable* labels;         // string node labels are interned here, NULL = integer IDs.
+                                // The table lives in memory, outside memory_budget.
+} ExternalBuildConfig;
+
+typedef struct {
+    size_t lines;
+    size_t invalid_lines;
+    size_t edges;               // accepted edge lines
+    size_t duplicates;          // arcs dropped as duplicates
+    size_t runs;                // sorted runs spilled to disk
+    size_t merge_passes;        // intermediate merge passes before the final one
+    size_t node_count;
+    size_t arc_count;
+    size_t peak_bytes;          // largest buffer footprint of any phase
+} ExternalBuildStats;
+
+typedef struct {
+    GraphType type;
+    bool weighted;
+    size_t node_count;
+    size_t arc_count;
+    size_t self_loops;
+    size_t isolated_nodes;      // nodes without outgoing arcs
+    size_t max_degree;
+    int max_degree_id;
+    double average_degree;
+    double total_weight;        // summed over arcs
+    size_t degree_histogram[DISK_DEGREE_BUCKETS];
+} DiskGraphSummary;
+
+typedef struct DiskAdjacency DiskAdjacency;
+
+ExternalBuildConfig external_build_config_default(void);
+
+// config may be NULL for defaults, stats is optional
+Status graph_external_build(const char* edge_list, const char* output, const ExternalBuildConfig* config, ExternalBuildStats* stats);
+
+// Streaming reader over an adjacency file using a buffer of buffer_bytes
+DiskAdjacency* disk_adjacency_open(const char* path, size_t buffer_bytes);
+void disk_adjacency_close(DiskAdjacency* adjacency);
+
+GraphType disk_adjacency_type(const DiskAdjacency* adjacency);
+bool disk_adjacency_weighted(const DiskAdjacency* adjacency);
+size_t disk_adjacency_node_count(const DiskAdjacency* adjacency);
+size_t disk_adjacency_arc_count(const DiskAdjacency* adjacency);
+Status disk_adjacency_status(const DiskAdjacency* adjacency);
+
+// Advance to the next node, skipping arcs not read yet; false at the end or on error
+bool disk_adjacency_next_node(DiskAdjacency* adjacency, int* node_id, size_t* degree);
+// Read up to max arcs of the current node, weights may be NULL
+size_t disk_adjacency_read_arcs(DiskAdjacency* adjacency, int* targets, double* weights, size_t max);
+
+// Analysis mode: one streaming pass with at most memory_budget bytes of buffers
+Status disk_adjacency_summarize(const char* path, size_t memory_budget, DiskGraphSummary* summary);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef GRAPH_PERSIST_H
+#define GRAPH_PERSIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Durable graph store: snapshot + write-ahead log in one directory.
+// * Every successful mutation made through the store is appended to an
+// * in-memory log buffer; a background thread writes buffered records as one
+// * checksummed group (and syncs it), so many mutations share one write.
+// * A snapshot rotates the log to a new segment and forks a child that writes
+// * the copy-on-write image of the graph while mutations continue. Recovery
+// * loads the newest complete snapshot and replays the log segments after it;
+// * a torn group at the tail is truncated.
+// *
+// * Files: snapshot-<n>.bin holds the graph at the start of wal-<n>.log.
+// * Mutations must come from one thread at a time, like the Graph itself.
+
+typedef struct {
+    size_t group_commit_bytes;  // write a group once this much log is buffered
+    int group_commit_ms;        // or once the oldest buffered record is this old, at least 1
+    bool sync;                  // fdatasync every group
+    size_t snapshot_records;    // automatic snapshot after this many records, 0 = manual only
+} PersistConfig;
+
+typedef struct {
+    uint64_t records_logged;
+    uint64_t groups_written;
+    uint64_t bytes_logged;
+    uint64_t snapshots_written;
+    uint64_t records_replayed;  // during recovery
+    uint64_t replay_failures;   // replayed records the graph rejected
+} GraphStoreStats;
+
+typedef struct GraphStore GraphStore;
+
+PersistConfig persist_config_default(void);
+
+// Open (creating the directory if needed) and recover. type is used for new stores;
+// an existing store keeps its own type. config may be NULL for defaults.
+GraphStore* graph_store_open(const char* directory, GraphType type, const PersistConfig* config);
+
+// Flush the log, wait for a running snapshot and release the store and its graph
+Status graph_store_close(GraphStore* store);
+
+// Read access to the recovered graph, mutate it only through the store
+const Graph* graph_store_graph(const GraphStore* store);
+
+// Same semantics as the graph_* counterparts, successful mutations are logged
+Status graph_store_insert_node(GraphStore* store, int node_id, size_t initial_capacity);
+Status graph_store_remove_node(GraphStore* store, int node_id);
+Status graph_store_insert_edge(GraphStore* store, int from, int to, double weight);
+Status graph_store_update_edge(GraphStore* store, int from, int to, double weight);
+Status graph_store_remove_edge(GraphStore* store, int from, int to);
+
+// Block until every logged mutation is written (and synced when configured)
+Status graph_store_flush(GraphStore* store);
+
+// Start a background snapshot, STATUS_WARNING if one is still running
+Status graph_store_snapshot(GraphStore* store);
+
+void graph_store_stats(GraphStore* store, GraphStoreStats* stats);
+
+#endif
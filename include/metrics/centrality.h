@@ -0,0 +1,36 @@
+#ifndef CENTRALITY_H
+#define CENTRALITY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Distance based centrality via multi-source BFS (MS-BFS).
+// * Up to 512 sources share one traversal: every node keeps a bitset of the
+// * sources that reached it, so each neighbor scan advances all of them at
+// * once. Source batches run in parallel, each thread with its own bitsets
+// * (3 * node_count * batch_width / 8 bytes). Distances follow out-edges.
+
+typedef struct {
+    int batch_width;            // sources per pass: 64, 128, 256 or 512
+    int num_threads;            // 0 = one per CPU
+    const int* sources;         // node IDs, NULL = every node in insertion order
+    size_t source_count;
+} CentralityConfig;
+
+typedef struct {
+    size_t count;               // number of sources
+    int* ids;                   // source node IDs
+    double* closeness;          // (r / (n - 1)) * (r / total distance), r = nodes reached
+    double* harmonic;           // sum of 1 / d over reached nodes, divided by n - 1
+    uint64_t* hop_histogram;    // (source, node) pairs per distance, 0 .. max_distance
+    size_t max_distance;
+} CentralityResult;
+
+CentralityConfig centrality_config_default(void);
+
+Status graph_centrality(const Graph* graph, const CentralityConfig* config, CentralityResult* result);
+void centrality_result_free(CentralityResult* result);
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef HYPERANF_H
+#define HYPERANF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Approximate neighborhood function (HyperANF).
+// * Every node keeps a HyperLogLog counter of the nodes it reaches. Round t merges
+// * the counters of out-neighbors that changed in round t - 1, so after t rounds a
+// * counter estimates the ball of radius t. N(t), the number of pairs (x, y) with
+// * d(x, y) <= t, is the sum of all estimates. Relative standard error per counter
+// * is about 1.04 / sqrt(2^log2m).
+
+typedef struct {
+    int log2m;                  // registers per counter = 2^log2m, 4 .. 16
+    size_t max_iterations;      // 0 = until no counter changes
+    size_t memory_limit;        // bytes for counters and the graph snapshot, 0 = unlimited
+    double alpha;               // effective diameter percentile, usually 0.9
+    uint64_t seed;
+    int num_threads;            // 0 = one per CPU
+} HyperAnfConfig;
+
+typedef struct {
+    double* neighborhood;       // N(t) for t = 0 .. iterations
+    size_t iterations;          // rounds until counters stabilized, approximates the diameter
+    double effective_diameter;  // interpolated alpha percentile of the distance distribution
+    double average_distance;    // over reachable pairs at distance >= 1
+    int log2m;                  // precision actually used, may be lowered by memory_limit
+    double relative_error;      // 1.04 / sqrt(2^log2m)
+    size_t memory_bytes;        // peak bytes used by counters and snapshot
+} HyperAnfResult;
+
+HyperAnfConfig hyperanf_config_default(void);
+
+Status graph_hyperanf(const Graph* graph, const HyperAnfConfig* config, HyperAnfResult* result);
+void hyperanf_result_free(HyperAnfResult* result);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef LINK_PREDICTION_H
+#define LINK_PREDICTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Common neighbor similarity for link prediction.
+// * Neighborhoods are sorted CSR lists; directed graphs are scored on their
+// * undirected support (in and out neighbors, self loops dropped).
+// * Given pairs are scored by sorted list intersection (SSE2 block compares when
+// * available). The top-k mode walks every 2-hop path u - w - v once per u with a
+// * per-thread accumulator, so each candidate pair costs its shared neighbors
+// * only, and keeps the best k pairs in a bounded heap per thread.
+// * Scores of the same pair agree exactly between both modes.
+
+typedef enum {
+    LINK_COMMON_NEIGHBORS,      // |N(u) & N(v)|
+    LINK_JACCARD,               // |N(u) & N(v)| / |N(u) | N(v)|
+    LINK_ADAMIC_ADAR,           // sum over shared w of 1 / log(deg w), degree 1 adds nothing
+    LINK_RESOURCE_ALLOCATION    // sum over shared w of 1 / deg w
+} LinkScore;
+
+typedef struct {
+    LinkScore score;
+    size_t top_k;               // pairs kept by graph_link_top_k
+    bool include_adjacent;      // top-k also ranks pairs that are already linked
+    int num_threads;            // 0 = one per CPU
+} LinkConfig;
+
+typedef struct {
+    int u;
+    int v;
+    double score;
+    uint32_t common;            // shared neighbors
+} LinkPair;
+
+typedef struct {
+    size_t count;
+    LinkPair* pairs;            // descending score, ties by insertion order of u then v (u comes first)
+} LinkPrediction;
+
+LinkConfig link_config_default(void);
+
+// Fill score and common of every pair (u and v are read)
+Status graph_link_scores(const Graph* graph, LinkPair* pairs, size_t count, const LinkConfig* config);
+
+// Best config->top_k pairs that share at least one neighbor
+Status graph_link_top_k(const Graph* graph, const LinkConfig* config, LinkPrediction* result);
+void link_prediction_free(LinkPrediction* result);
+
+#endif
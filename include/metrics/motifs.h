@@ -0,0 +1,44 @@
+#ifndef MOTIFS_H
+#define MOTIFS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Directed motif census.
+// * Triads are counted without enumerating them: triangles are listed once by
+// * orienting every connected pair towards the higher (degree, index) end and
+// * intersecting sorted neighbor lists; open triads come from per-node in, out
+// * and mutual degree combinatorics minus the wedges closed by those triangles;
+// * dyadic and empty triads follow from degrees and triangle counts. Undirected
+// * graphs are treated as fully mutual. Self loops are ignored.
+
+typedef enum {
+    TRIAD_003, TRIAD_012, TRIAD_102, TRIAD_021D, TRIAD_021U, TRIAD_021C,
+    TRIAD_111D, TRIAD_111U, TRIAD_030T, TRIAD_030C, TRIAD_201, TRIAD_120D,
+    TRIAD_120U, TRIAD_120C, TRIAD_210, TRIAD_300,
+    TRIAD_COUNT
+} TriadType;
+
+typedef struct {
+    double sample_rate;         // 1.0 = exact, otherwise pivot nodes are sampled and counts scaled
+    uint64_t seed;
+    bool four_node;             // also count bi-fans and bi-parallels
+    int num_threads;            // 0 = one per CPU
+} MotifConfig;
+
+typedef struct {
+    uint64_t triads[TRIAD_COUNT];   // triad census, 003 saturates at UINT64_MAX
+    uint64_t bi_fans;               // a->c, a->d, b->c, b->d (subgraph occurrences, not induced)
+    uint64_t bi_parallels;          // a->b->d, a->c->d (subgraph occurrences, not induced)
+    bool estimated;                 // true when sample_rate < 1
+} MotifCounts;
+
+MotifConfig motif_config_default(void);
+const char* triad_name(TriadType type);
+
+Status graph_motif_census(const Graph* graph, const MotifConfig* config, MotifCounts* counts);
+
+#endif
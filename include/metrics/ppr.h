@@ -0,0 +1,53 @@
+#ifndef PPR_H
+#define PPR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Personalized PageRank (random walk with restart) by forward push
+// * (Andersen, Chung, Lang). A node pushes once its residual reaches
+// * epsilon * degree: alpha of it becomes estimate, the rest is spread over its
+// * out-edges. Residual at a node without out-edges restarts at the seeds.
+// * Work is O(1 / (alpha * epsilon)) whatever the graph size: queries read the
+// * Graph hash table directly and keep their state in sparse per-thread maps.
+// * On undirected graphs every estimate is within epsilon * degree of the exact
+// * score; the residual left over bounds the total (L1) error.
+
+typedef struct {
+    double alpha;               // restart probability per step
+    double epsilon;             // push threshold per unit of degree
+    bool weighted;              // spread residual by EdgeNode.weight instead of evenly
+    size_t top_k;               // keep the k best scores, 0 = every touched node
+    int num_threads;            // batch queries in parallel, 0 = one per CPU
+} PprConfig;
+
+typedef struct {
+    const int* seeds;
+    const double* seed_weights; // restart distribution, NULL = uniform (normalized either way)
+    size_t seed_count;
+} PprQuery;
+
+typedef struct {
+    size_t count;
+    int* ids;
+    double* scores;             // descending, ties by ID
+    size_t pushes;
+    size_t touched;             // nodes that received residual
+    double residual;            // probability mass not pushed
+} PprResult;
+
+PprConfig ppr_config_default(void);
+
+// Single query on the calling thread
+Status graph_ppr(const Graph* graph, const PprQuery* query, const PprConfig* config, PprResult* result);
+
+// Independent queries spread over threads. Every result is filled, a query that
+// fails leaves its result empty and its status is returned (the first in order).
+Status graph_ppr_batch(const Graph* graph, const PprQuery* queries, size_t count, const PprConfig* config, PprResult* results);
+
+void ppr_result_free(PprResult* result);
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SHORTEST_PATH_H
+#define SHORTEST_PATH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Point-to-point weighted shortest paths with ALT (A*, landmarks, triangle
+// * inequality). Preprocessing runs Dijkstra from (and, on directed graphs, to)
+// * a few landmarks; distances d(L, v) and d(v, L) then give lower bounds such as
+// * d(v, t) >= d(L, t) - d(L, v) that steer a bidirectional A* towards the
+// * target. Landmarks on the far side of the graph give the tightest bounds.
+// * The index keeps a weighted CSR snapshot of the graph and does not follow
+// * later changes; saved indexes are checked against the graph when loaded.
+// * Edge weights are lengths and must not be negative.
+
+typedef enum {
+    LANDMARK_FARTHEST,          // each landmark maximizes its distance to the ones before
+    LANDMARK_RANDOM
+} LandmarkSelection;
+
+typedef enum {
+    PATH_ALT,                   // bidirectional A* with landmark bounds
+    PATH_BIDIRECTIONAL,         // bidirectional Dijkstra
+    PATH_DIJKSTRA               // plain Dijkstra from the source, for reference
+} PathMethod;
+
+typedef struct {
+    size_t landmark_count;
+    LandmarkSelection selection;
+    uint64_t seed;              // LANDMARK_RANDOM draws
+    int num_threads;            // 0 = one per CPU
+} AltConfig;
+
+typedef struct {
+    double distance;            // INFINITY when the target is unreachable
+    size_t length;              // nodes on the path, 0 when unreachable
+    int* nodes;                 // source .. target
+    size_t settled;             // nodes scanned by the search
+} PathResult;
+
+typedef struct AltIndex AltIndex;
+typedef struct AltSearch AltSearch;
+
+AltConfig alt_config_default(void);
+
+Status alt_index_build(const Graph* graph, const AltConfig* config, AltIndex** index);
+void alt_index_free(AltIndex* index);
+size_t alt_index_landmarks(const AltIndex* index, int* ids, size_t capacity);
+
+// Binary index file, written to a temporary file and renamed into place
+Status alt_index_save(const AltIndex* index, const char* path);
+
+// STATUS_INVALID when the file was built for a different graph
+Status alt_index_load(const Graph* graph, const char* path, int num_threads, AltIndex** index);
+
+// Query state sized for the index, reused across queries (one per thread)
+AltSearch* alt_search_create(const AltIndex* index);
+void alt_search_free(AltSearch* search);
+
+Status alt_shortest_path(AltSearch* search, int from, int to, PathMethod method, PathResult* result);
+void path_result_free(PathResult* result);
+
+#endif
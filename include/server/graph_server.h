@@ -0,0 +1,87 @@
+#ifndef GRAPH_SERVER_H
+#define GRAPH_SERVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "utils/general_utils.h"
+#include "core/graph_build.h"
+
+// * Resident query server over a Unix domain stream socket.
+// * A poll() event loop owns all sockets; complete requests read from a
+// * connection are handed as one batch to a worker pool, which answers them in
+// * order into the connection's output buffer. Clients may pipeline: any
+// * number of requests can be written without waiting, responses come back in
+// * request order, matched by id. Queries share a read lock; edge inserts and
+// * removals take the write lock.
+// *
+// * Wire format, host byte order: fixed 24-byte QueryRequest frames in, 24-byte
+// * QueryResponse frames out. QUERY_NEIGHBORS responses are followed by value
+// * QueryNeighbor entries.
+
+typedef enum {
+    QUERY_PING = 0,
+    QUERY_NEIGHBORS,        // a                 -> value = count, then entries
+    QUERY_DEGREE,           // a                 -> value = out-degree
+    QUERY_EDGE,             // a, b              -> weight
+    QUERY_DISTANCE,         // a, b              -> value = BFS hops
+    QUERY_COMPONENT,        // a                 -> value = smallest node ID of its weak component
+    QUERY_INSERT_EDGE,      // a, b, weight      missing nodes are created
+    QUERY_REMOVE_EDGE,      // a, b
+    QUERY_OP_COUNT
+} QueryOp;
+
+typedef enum {
+    QUERY_OK = 0,
+    QUERY_NOT_FOUND,        // node, edge or path does not exist
+    QUERY_INVALID,          // unknown op
+    QUERY_FAILED            // mutation rejected or out of memory
+} QueryStatus;
+
+typedef struct {
+    uint32_t id;            // echoed in the response
+    uint8_t op;
+    uint8_t reserved[3];
+    int32_t a;
+    int32_t b;
+    double weight;
+} QueryRequest;
+
+typedef struct {
+    uint32_t id;
+    uint8_t op;
+    uint8_t status;
+    uint16_t reserved;
+    int64_t value;
+    double weight;
+} QueryResponse;
+
+typedef struct {
+    int32_t id;
+    int32_t reserved;
+    double weight;
+} QueryNeighbor;
+
+typedef struct {
+    const char* socket_path;    // replaced if it already exists
+    int num_threads;            // workers, 0 = one per CPU
+    size_t max_batch;           // requests per worker job
+    size_t max_connections;
+} ServerConfig;
+
+typedef struct GraphServer GraphServer;
+
+ServerConfig server_config_default(void);
+
+// The server serves graph in place, which must outlive it
+GraphServer* graph_server_create(Graph* graph, const ServerConfig* config);
+
+// Serve until graph_server_stop, then close every connection
+Status graph_server_run(GraphServer* server);
+
+// Ask a running server to stop; safe from signal handlers and other threads
+void graph_server_stop(GraphServer* server);
+
+void graph_server_destroy(GraphServer* server);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "utils/general_utils.h"
+
+// * Library diagnostics. Every report is counted per ErrorCode and kept in a
+// * fixed size ring buffer the caller can drain. Nothing is printed unless a
+// * sink is installed, so the default adds no I/O to the mutation path.
+// * Messages are static strings; node IDs / line numbers travel as a and b.
+
+typedef enum {
+    DIAG_DEBUG = 0,
+    DIAG_INFO,
+    DIAG_WARNING,
+    DIAG_ERROR,
+    DIAG_FATAL,     // graph integrity compromised
+    DIAG_OFF
+} DiagLevel;
+
+#define DIAG_RING_SIZE 1024    // must be a power of two
+#define DIAG_CODE_COUNT (ERR_INTERNAL + 1)
+
+typedef struct {
+    uint64_t sequence;      // report number since last reset
+    DiagLevel level;
+    ErrorCode code;
+    const char* function;
+    const char* message;
+    int a;                  // first subject (node ID, line number, ...), -1 if unused
+    int b;                  // second subject, -1 if unused
+} DiagRecord;
+
+typedef void (*DiagSink)(const DiagRecord* record, void* ctx);
+
+// Sink configuration: records at or above min_level are passed to sink (NULL disables)
+void diag_set_sink(DiagSink sink, void* ctx, DiagLevel min_level);
+// Ring buffer configuration: records at or above min_level are buffered (default DIAG_ERROR)
+void diag_set_ring_level(DiagLevel min_level);
+
+// Ready made sink printing one line per record to stderr
+void diag_stderr_sink(const DiagRecord* record, void* ctx);
+
+// Copy up to max buffered records (oldest first) into out and remove them
+size_t diag_drain(DiagRecord* out, size_t max);
+// Aggregated report counts, independent of levels and draining
+uint64_t diag_count(ErrorCode code);
+// Records overwritten before being drained
+uint64_t diag_dropped(void);
+void diag_reset(void);
+
+const char* diag_level_name(DiagLevel level);
+const char* diag_code_name(ErrorCode code);
+
+void diag_report(DiagLevel level, ErrorCode code, const char* function, const char* message, int a, int b);
+
+#define DIAG(level, code, message, a, b) diag_report((level), (code), __func__, (message), (a), (b))
+
+// Helper macro: report invalid argument and return when ptr is NULL
+#define DIAG_CHECK(ptr, value, message)\
+    do {\
+        if (!(ptr)) {\
+            DIAG(DIAG_ERROR, ERR_INVALID_ARG, message, -1, -1); return value;\
+        }\
+    } while (0)
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef FORMAT_UTILS_H
+#define FORMAT_UTILS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// * Locale independent number formatting for bulk text output.
+// * Functions write into a caller provided buffer without a terminator and
+// * return the number of characters written.
+
+#define FORMAT_INT_CHARS 11         // "-2147483648"
+#define FORMAT_UINT64_CHARS 20      // "18446744073709551615"
+#define FORMAT_DOUBLE_CHARS 32      // fallback "%.17g" output, with margin
+
+size_t format_uint64(char* out, uint64_t value);
+size_t format_int(char* out, int value);
+
+// Shortest fixed point form with up to 9 decimals that parses back to the same
+// double (1, 0.5, 2.25), otherwise "%.17g". Always round-trips through strtod.
+size_t format_double(char* out, double value);
+
+#endif
@@ -6,11 +6,12 @@
 #include <math.h>
 #include "utils/hash_table_utils.h"
 #include "utils/general_utils.h"
+#include "utils/diagnostics.h"
 #include "core/graph_build.h"
 
 # define CHECK_GRAPH \
     do {    if (!graph) {\
-        fprintf(stderr, "Error: Invalid graph passed to %s function call\n", __func__);\
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid graph", -1, -1);\
         return STATUS_INVALID;\
     }\
 } while(0);
@@ -28,15 +29,20 @@ static inline bool node_needs_resize(Node* node) {
 
 
 // Graph related utils
-bool graph_resize (Graph* graph);
-Node* find_node(Graph* graph, int node_id);
+Status graph_resize (Graph* graph);
+Status graph_reserve(Graph* graph, size_t node_count);
+Status graph_attach_node(Graph* graph, Node* node);
+Node* find_node(const Graph* graph, int node_id);
 
 // Node related utils
 Node* create_node(int node_id, size_t neighbor_capacity);
-bool node_resize(Node* node);
+Status node_resize(Node* node);
+Status node_reserve(Node* node, size_t capacity);
 
-bool node_add_edge(Node* node, int to, double weight, double* old_weight, bool overwrite);
-bool node_remove_edge(Node* node, int to, double* old_weight);
+Status node_add_edge(Node* node, int to, double weight, double* old_weight, bool overwrite);
+Status node_append_edge(Node* node, int to, double weight);
+bool node_find_edge(const Node* node, int to, size_t* position);
+Status node_remove_edge(Node* node, int to, double* old_weight);
 
 
 #endif
\ No newline at end of file
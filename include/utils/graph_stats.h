@@ -0,0 +1,111 @@
+#ifndef GRAPH_STATS_H
+#define GRAPH_STATS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core/graph_build.h"
+#include "utils/general_utils.h"
+
+// * Runtime counters are compiled in with -DGRAPH_STATS (make stats) and cost
+// * nothing otherwise. Structural figures (memory, chains, slack) are always
+// * available because graph_stats computes them on demand.
+// * Counters are process wide and updated with relaxed atomics, so lookups from
+// * parallel_for tasks are counted exactly; a snapshot taken while other threads
+// * run is consistent per counter, not across counters.
+
+#define STATS_HISTOGRAM_BUCKETS 16 // last bucket collects everything >= 15
+
+typedef struct {
+    // Hash table lookups (find_node)
+    uint64_t lookups;
+    uint64_t lookup_hits;
+    uint64_t lookup_misses;
+    uint64_t probe_histogram[STATS_HISTOGRAM_BUCKETS]; // chain entries visited per lookup
+
+    // Mutations that succeeded
+    uint64_t node_inserts;
+    uint64_t node_removes;
+    uint64_t edge_inserts;
+    uint64_t edge_updates;
+    uint64_t edge_removes;
+
+    // Duplicate edge scans in node_add_edge
+    uint64_t duplicate_scans;
+    uint64_t duplicate_scan_steps;
+    uint64_t duplicate_hits;
+
+    // Resizes
+    uint64_t graph_resizes;
+    uint64_t graph_resize_ns;
+    uint64_t node_resizes;
+    uint64_t node_resize_ns;
+    uint64_t node_resize_bytes;     // bytes reallocated by node_resize
+} GraphCounters;
+
+typedef struct {
+    bool counters_enabled;
+    GraphCounters counters;
+
+    // Hash table shape
+    size_t node_count;
+    size_t edge_count;
+    size_t bucket_count;
+    size_t used_buckets;
+    size_t longest_chain;
+    double load_factor;
+    uint64_t chain_histogram[STATS_HISTOGRAM_BUCKETS]; // buckets by chain length
+
+    // Bytes allocated per structure
+    size_t bytes_graph;
+    size_t bytes_hash_table;
+    size_t bytes_node_ids;
+    size_t bytes_nodes;
+    size_t bytes_adjacency;
+    size_t bytes_total;
+
+    // Adjacency capacity slack
+    size_t adjacency_capacity;      // EdgeNode slots allocated
+    size_t adjacency_used;          // EdgeNode slots in use
+    double adjacency_slack;         // unused fraction of allocated slots
+} GraphStats;
+
+// Process wide counters, updated through the STATS_* macros below
+extern GraphCounters graph_counters;
+
+GraphStats graph_stats(const Graph* graph);
+void graph_stats_reset(void);
+Status graph_stats_dump_json(const GraphStats* stats, FILE* out);
+
+uint64_t stats_now_ns(void);
+
+static inline size_t stats_bucket(size_t value) {
+    return value < STATS_HISTOGRAM_BUCKETS ? value : STATS_HISTOGRAM_BUCKETS - 1;
+}
+
+#ifdef GRAPH_STATS
+#define STATS_ATOMIC_ADD(field, amount) __atomic_fetch_add(&graph_counters.field, (uint64_t)(amount), __ATOMIC_RELAXED)
+#define STATS_COUNT(field) STATS_ATOMIC_ADD(field, 1)
+#define STATS_ADD(field, amount) STATS_ATOMIC_ADD(field, amount)
+#define STATS_TIMER_START(timer) uint64_t timer = stats_now_ns()
+#define STATS_TIMER_STOP(timer, field) STATS_ATOMIC_ADD(field, stats_now_ns() - (timer))
+#define STATS_PROBE_START(probes) size_t probes = 0
+#define STATS_PROBE_STEP(probes) ((probes)++)
+#define STATS_PROBE_END(probes, hit) \
+    do {\
+        STATS_ATOMIC_ADD(lookups, 1);\
+        if (hit) STATS_ATOMIC_ADD(lookup_hits, 1); else STATS_ATOMIC_ADD(lookup_misses, 1);\
+        STATS_ATOMIC_ADD(probe_histogram[stats_bucket(probes)], 1);\
+    } while (0)
+#else
+#define STATS_COUNT(field) ((void)0)
+#define STATS_ADD(field, amount) ((void)0)
+#define STATS_TIMER_START(timer) ((void)0)
+#define STATS_TIMER_STOP(timer, field) ((void)0)
+#define STATS_PROBE_START(probes) ((void)0)
+#define STATS_PROBE_STEP(probes) ((void)0)
+#define STATS_PROBE_END(probes, hit) ((void)0)
+#endif
+
+#endif
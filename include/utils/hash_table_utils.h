@@ -16,7 +16,7 @@ unsigned int hash(int id, int table_size);
 Node* pop_bucket(Node** list);
 
 // Hash table functions
-bool add_to_hash_table(Node* node, size_t table_size, Node** table);
-bool delete_from_hash_table(int id, size_t table_size, Node** table);
+Status add_to_hash_table(Node* node, size_t table_size, Node** table);
+Status delete_from_hash_table(int id, size_t table_size, Node** table);
 
 #endif
\ No newline at end of file
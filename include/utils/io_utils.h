@@ -0,0 +1,21 @@
+#ifndef IO_UTILS_H
+#define IO_UTILS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "utils/general_utils.h"
+
+// * Raw file descriptor helpers for binary formats. Short reads/writes and
+// * EINTR are retried; failures are reported through DIAG.
+
+Status write_full(int fd, const void* data, size_t length);
+Status pwrite_full(int fd, const void* data, size_t length, uint64_t offset);
+
+// Read until length bytes or end of file; returns the bytes read, -1 on error
+ssize_t read_full(int fd, void* data, size_t length);
+
+// CRC-32 (IEEE), start with crc = 0
+uint32_t crc32_update(uint32_t crc, const void* data, size_t length);
+
+#endif
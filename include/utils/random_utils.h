@@ -0,0 +1,64 @@
+#ifndef RANDOM_UTILS_H
+#define RANDOM_UTILS_H
+
+#include <stdint.h>
+
+// * Counter based seeding: a stream is fully determined by (seed, stream id),
+// * so work split into fixed chunks gives the same numbers for any thread count
+
+// Stateless 64-bit finalizer (splitmix64)
+static inline uint64_t mix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// xoshiro256** generator
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static inline uint64_t rotl64(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline void rng_seed(Rng* rng, uint64_t seed, uint64_t stream) {
+    uint64_t x = mix64(seed) ^ mix64(stream ^ 0xD1B54A32D192ED03ULL);
+    for (int i = 0; i < 4; i++) {
+        x = mix64(x + (uint64_t)i);
+        rng->s[i] = x;
+    }
+}
+
+static inline uint64_t rng_next(Rng* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+
+    return result;
+}
+
+// Uniform double in [0, 1)
+static inline double rng_uniform(Rng* rng) {
+    return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Uniform integer in [0, bound), rejection sampling keeps it unbiased
+static inline uint64_t rng_bounded(Rng* rng, uint64_t bound) {
+    if (bound <= 1) return 0;
+    uint64_t threshold = (0 - bound) % bound;
+    for (;;) {
+        uint64_t x = rng_next(rng);
+        if (x >= threshold) return x % bound;
+    }
+}
+
+#endif
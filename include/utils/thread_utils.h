@@ -0,0 +1,17 @@
+#ifndef THREAD_UTILS_H
+#define THREAD_UTILS_H
+
+#include <stddef.h>
+#include "utils/general_utils.h"
+
+// Task callback: task is the task index, thread_id is in [0, num_threads)
+typedef void (*ParallelTask)(void* ctx, size_t task, int thread_id);
+
+// Resolve a requested thread count, 0 (or negative) means one per online CPU
+int thread_count_resolve(int requested);
+
+// Run task for every index in [0, task_count) on up to num_threads threads.
+// Tasks are handed out dynamically; the calling thread works as thread 0.
+Status parallel_for(size_t task_count, int num_threads, ParallelTask task, void* ctx);
+
+#endif
@@ -0,0 +1,635 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "core/graph_batch.h"
+#include "utils/general_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+
+# define CHECK_BATCH \
+    do {    if (!batch) {\
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid batch", -1, -1);\
+        return STATUS_INVALID;\
+    }\
+} while(0);
+
+typedef enum {
+    OP_INSERT_NODE,
+    OP_REMOVE_NODE,
+    OP_INSERT_EDGE,
+    OP_UPDATE_EDGE,
+    OP_REMOVE_EDGE
+} BatchOpType;
+
+typedef struct {
+    BatchOpType type;
+    int from;           // node ID for node operations
+    int to;
+    double weight;
+    size_t capacity;
+} BatchOp;
+
+typedef enum {
+    UNDO_EDGE_ADDED,    // edge appended at the end of node->neighbors
+    UNDO_EDGE_UPDATED,  // weight holds the previous weight
+    UNDO_EDGE_REMOVED,  // edge was removed from position
+    UNDO_NODE_ADDED,
+    UNDO_NODE_REMOVED   // position indexes batch->removed
+} UndoType;
+
+// * Kept at 32 bytes, a large commit writes one entry per touched adjacency slot
+typedef struct {
+    Node* node;
+    double weight;      // removed edge weight, or previous weight for updates
+    size_t position;    // neighbor index
+    int node_id;        // removed edge target
+    UndoType type;
+} UndoEntry;
+
+// * Removed nodes stay allocated until the commit ends so rollback can relink them
+typedef struct {
+    Node* node;
+    size_t chain_position;
+    size_t id_position; // index in graph->node_ids
+} RemovedNode;
+
+// * Pending edge inserts per node, used to size neighbor arrays up front
+typedef struct {
+    int id;
+    bool used;
+    size_t count;
+} DegreeSlot;
+
+typedef struct {
+    DegreeSlot* slots;
+    size_t capacity;    // power of two
+} DegreeMap;
+
+struct GraphBatch {
+    Graph* graph;
+    BatchOp* ops;
+    size_t op_count;
+    size_t op_capacity;
+    UndoEntry* undo;
+    size_t undo_count;
+    size_t undo_capacity;
+    RemovedNode* removed;
+    size_t removed_count;
+    size_t removed_capacity;
+};
+
+// ---------------------------------------------------------------------------
+// Buffering
+// ---------------------------------------------------------------------------
+
+GraphBatch* graph_batch_begin(Graph* graph) {
+    DIAG_CHECK(graph, NULL, "invalid graph");
+
+    GraphBatch* batch = calloc(1, sizeof(GraphBatch));
+    if (!batch) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize batch", -1, -1);
+        return NULL;
+    }
+
+    batch->graph = graph;
+    return batch;
+}
+
+static Status batch_push(GraphBatch* batch, BatchOpType type, int from, int to, double weight, size_t capacity) {
+    CHECK_BATCH
+
+    if (batch->op_count == batch->op_capacity) {
+        size_t new_capacity = batch->op_capacity ? batch->op_capacity * 2 : 64;
+        BatchOp* grown = realloc(batch->ops, new_capacity * sizeof(BatchOp));
+        if (!grown) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow batch", -1, -1);
+            return STATUS_OOM;
+        }
+        batch->ops = grown;
+        batch->op_capacity = new_capacity;
+    }
+
+    BatchOp* op = &batch->ops[batch->op_count++];
+    op->type = type;
+    op->from = from;
+    op->to = to;
+    op->weight = weight;
+    op->capacity = capacity;
+    return STATUS_SUCCESS;
+}
+
+Status graph_batch_insert_node(GraphBatch* batch, int node_id, size_t initial_capacity) {
+    return batch_push(batch, OP_INSERT_NODE, node_id, -1, 0.0, initial_capacity);
+}
+
+Status graph_batch_remove_node(GraphBatch* batch, int node_id) {
+    return batch_push(batch, OP_REMOVE_NODE, node_id, -1, 0.0, 0);
+}
+
+Status graph_batch_insert_edge(GraphBatch* batch, int from, int to, double weight) {
+    CHECK_BATCH
+
+    // Rejected up front like graph_insert_edge does, the reverse edge would be a duplicate
+    if (batch->graph->type == GRAPH_UNDIRECTED && from == to) {
+        DIAG(DIAG_WARNING, ERR_EXISTS, "reverse edge already exists", to, from);
+        return STATUS_WARNING;
+    }
+    return batch_push(batch, OP_INSERT_EDGE, from, to, weight, 0);
+}
+
+Status graph_batch_update_edge(GraphBatch* batch, int from, int to, double weight) {
+    return batch_push(batch, OP_UPDATE_EDGE, from, to, weight, 0);
+}
+
+Status graph_batch_remove_edge(GraphBatch* batch, int from, int to) {
+    return batch_push(batch, OP_REMOVE_EDGE, from, to, 0.0, 0);
+}
+
+size_t graph_batch_size(const GraphBatch* batch) {
+    if (!batch) return 0;
+    return batch->op_count;
+}
+
+static void batch_free(GraphBatch* batch) {
+    if (!batch) return;
+    free(batch->ops);
+    free(batch->undo);
+    free(batch->removed);
+    free(batch);
+}
+
+void graph_batch_abort(GraphBatch* batch) {
+    // Nothing has been applied before commit, so dropping the buffer is enough
+    batch_free(batch);
+}
+
+// ---------------------------------------------------------------------------
+// Capacity reservation
+// ---------------------------------------------------------------------------
+
+static Status degree_map_init(DegreeMap* map, size_t expected) {
+    map->capacity = 16;
+    while (map->capacity < expected * 2) map->capacity *= 2;
+
+    map->slots = calloc(map->capacity, sizeof(DegreeSlot));
+    if (!map->slots) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize batch degree map", -1, -1);
+        return STATUS_OOM;
+    }
+    return STATUS_SUCCESS;
+}
+
+static DegreeSlot* degree_map_slot(DegreeMap* map, int id, bool insert) {
+    size_t index = hash(id, (int)map->capacity);
+
+    // linear probing, sized for every edge endpoint so the map stays at most half full
+    size_t probes = 0;
+    while (map->slots[index].used) {
+        if (map->slots[index].id == id) return &map->slots[index];
+        if (++probes == map->capacity) return NULL;
+        index = (index + 1) & (map->capacity - 1);
+    }
+    if (!insert) return NULL;
+
+    map->slots[index].used = true;
+    map->slots[index].id = id;
+    map->slots[index].count = 0;
+    return &map->slots[index];
+}
+
+// Helper: grow the hash table and neighbor arrays once for the whole batch
+static Status batch_reserve(GraphBatch* batch, DegreeMap* degrees) {
+    Graph* graph = batch->graph;
+    size_t node_inserts = 0;
+    size_t edge_inserts = 0;
+
+    for (size_t i = 0; i < batch->op_count; i++) {
+        if (batch->ops[i].type == OP_INSERT_NODE) node_inserts++;
+        if (batch->ops[i].type == OP_INSERT_EDGE) edge_inserts++;
+    }
+
+    // Endpoints are counted before commit knows which nodes will exist, so every one may be distinct
+    Status status = degree_map_init(degrees, 2 * edge_inserts);
+    if (status != STATUS_SUCCESS) return status;
+
+    for (size_t i = 0; i < batch->op_count; i++) {
+        const BatchOp* op = &batch->ops[i];
+        if (op->type != OP_INSERT_EDGE) continue;
+
+        bool reverse = graph->type == GRAPH_UNDIRECTED && op->from != op->to;
+        DegreeSlot* from = degree_map_slot(degrees, op->from, true);
+        DegreeSlot* to = reverse ? degree_map_slot(degrees, op->to, true) : NULL;
+        if (!from || (reverse && !to)) {
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "batch degree map is full", op->from, op->to);
+            return STATUS_ERROR;
+        }
+        from->count++;
+        if (to) to->count++;
+    }
+
+    // Single rehash for every node inserted by the batch
+    status = graph_reserve(graph, graph->node_count + node_inserts);
+    if (status != STATUS_SUCCESS) return status;
+
+    for (size_t i = 0; i < degrees->capacity; i++) {
+        if (!degrees->slots[i].used) continue;
+
+        Node* node = find_node(graph, degrees->slots[i].id);
+        if (!node) continue; // inserted by the batch, sized on creation
+
+        status = node_reserve(node, node->neighbor_count + degrees->slots[i].count);
+        if (status != STATUS_SUCCESS) return status;
+    }
+
+    // Every operation logs at most two entries, except node removal
+    size_t undo_capacity = 2 * batch->op_count + 16;
+    batch->undo = malloc(undo_capacity * sizeof(UndoEntry));
+    if (!batch->undo) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize batch undo log", -1, -1);
+        return STATUS_OOM;
+    }
+    batch->undo_capacity = undo_capacity;
+
+    return STATUS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// Undo log
+// ---------------------------------------------------------------------------
+
+// Helper: reserve an undo entry, always called before the mutation it describes
+static UndoEntry* undo_push(GraphBatch* batch, UndoType type, Node* node) {
+    if (batch->undo_count == batch->undo_capacity) {
+        size_t new_capacity = batch->undo_capacity * 2;
+        UndoEntry* grown = realloc(batch->undo, new_capacity * sizeof(UndoEntry));
+        if (!grown) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow batch undo log", -1, -1);
+            return NULL;
+        }
+        batch->undo = grown;
+        batch->undo_capacity = new_capacity;
+    }
+
+    UndoEntry* entry = &batch->undo[batch->undo_count++];
+    entry->type = type;
+    entry->node = node;
+    return entry;
+}
+
+static void neighbor_remove_at(Node* node, size_t position) {
+    size_t num_to_move = node->neighbor_count - position - 1;
+    if (num_to_move > 0) {
+        memmove(&node->neighbors[position], &node->neighbors[position + 1], num_to_move * sizeof(EdgeNode));
+    }
+
+    node->neighbor_count--;
+    node->neighbors[node->neighbor_count].node_id = -1;
+    node->neighbors[node->neighbor_count].weight = NAN;
+}
+
+// Helper: reinsert a removed edge, the slot freed by its removal is still allocated
+static void neighbor_insert_at(Node* node, size_t position, int to, double weight) {
+    size_t num_to_move = node->neighbor_count - position;
+    if (num_to_move > 0) {
+        memmove(&node->neighbors[position + 1], &node->neighbors[position], num_to_move * sizeof(EdgeNode));
+    }
+
+    node->neighbors[position].node_id = to;
+    node->neighbors[position].weight = weight;
+    node->neighbor_count++;
+}
+
+static void chain_unlink(Graph* graph, Node* node) {
+    size_t bucket = hash(node->id, graph->node_capacity);
+    Node** link = &graph->nodes[bucket];
+
+    while (*link && *link != node) link = &(*link)->next;
+    if (*link) *link = node->next;
+    node->next = NULL;
+}
+
+static void chain_link_at(Graph* graph, Node* node, size_t position) {
+    Node** link = &graph->nodes[hash(node->id, graph->node_capacity)];
+
+    for (size_t i = 0; i < position && *link; i++) link = &(*link)->next;
+    node->next = *link;
+    *link = node;
+}
+
+static void batch_rollback(GraphBatch* batch) {
+    Graph* graph = batch->graph;
+
+    while (batch->undo_count > 0) {
+        UndoEntry* entry = &batch->undo[--batch->undo_count];
+        Node* node = entry->node;
+
+        switch (entry->type) {
+            case UNDO_EDGE_ADDED:
+                node->neighbor_count--;
+                node->neighbors[node->neighbor_count].node_id = -1;
+                node->neighbors[node->neighbor_count].weight = NAN;
+                break;
+            case UNDO_EDGE_UPDATED:
+                node->neighbors[entry->position].weight = entry->weight;
+                break;
+            case UNDO_EDGE_REMOVED:
+                neighbor_insert_at(node, entry->position, entry->node_id, entry->weight);
+                break;
+            case UNDO_NODE_ADDED:
+                chain_unlink(graph, node);
+                graph->node_count--;
+                graph->node_ids[graph->node_count] = -1;
+                free(node->neighbors);
+                free(node);
+                break;
+            case UNDO_NODE_REMOVED: {
+                RemovedNode* removed = &batch->removed[entry->position];
+                chain_link_at(graph, node, removed->chain_position);
+                memmove(&graph->node_ids[removed->id_position + 1], &graph->node_ids[removed->id_position],
+                    (graph->node_count - removed->id_position) * sizeof(int));
+                graph->node_ids[removed->id_position] = node->id;
+                graph->node_count++;
+                batch->removed_count--;
+                break;
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Operations
+// ---------------------------------------------------------------------------
+
+static Status apply_insert_node(GraphBatch* batch, const BatchOp* op, DegreeMap* degrees) {
+    Graph* graph = batch->graph;
+
+    if (find_node(graph, op->from)) {
+        DIAG(DIAG_WARNING, ERR_EXISTS, "node already exists", op->from, -1);
+        return STATUS_WARNING;
+    }
+
+    size_t capacity = op->capacity ? op->capacity : INITIAL_CAPACITY;
+    DegreeSlot* pending = degree_map_slot(degrees, op->from, false);
+    if (pending && pending->count > capacity) capacity = pending->count;
+
+    Node* node = create_node(op->from, capacity);
+    if (!node) return STATUS_OOM;
+
+    if (!undo_push(batch, UNDO_NODE_ADDED, node)) {
+        free(node->neighbors);
+        free(node);
+        return STATUS_OOM;
+    }
+
+    // Capacity was reserved up front, so no resize can happen mid-batch
+    if (add_to_hash_table(node, graph->node_capacity, graph->nodes) != STATUS_SUCCESS) {
+        batch->undo_count--;
+        free(node->neighbors);
+        free(node);
+        DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", op->from, -1);
+        return STATUS_ERROR;
+    }
+    graph->node_ids[graph->node_count++] = op->from;
+
+    return STATUS_SUCCESS;
+}
+
+// Helper: remove edge at position and log it
+static Status remove_logged(GraphBatch* batch, Node* node, size_t position) {
+    UndoEntry* entry = undo_push(batch, UNDO_EDGE_REMOVED, node);
+    if (!entry) return STATUS_OOM;
+
+    entry->node_id = node->neighbors[position].node_id;
+    entry->weight = node->neighbors[position].weight;
+    entry->position = position;
+    neighbor_remove_at(node, position);
+    return STATUS_SUCCESS;
+}
+
+static Status apply_remove_node(GraphBatch* batch, const BatchOp* op) {
+    Graph* graph = batch->graph;
+    int node_id = op->from;
+
+    Node* node = find_node(graph, node_id);
+    if (!node) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", node_id, -1);
+        return STATUS_WARNING;
+    }
+
+    // Remove all edges that point to this node from other nodes
+    if (graph->type == GRAPH_UNDIRECTED) {
+        for (size_t i = 0; i < node->neighbor_count; i++) {
+            int neighbor_id = node->neighbors[i].node_id;
+            if (neighbor_id == node_id) continue;
+
+            Node* neighbor = find_node(graph, neighbor_id);
+            size_t position;
+            if (!neighbor || !node_find_edge(neighbor, node_id, &position)) {
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, found directed edge", node_id, neighbor_id);
+                return STATUS_ERROR;
+            }
+
+            Status status = remove_logged(batch, neighbor, position);
+            if (status != STATUS_SUCCESS) return status;
+        }
+    } else {
+        for (size_t i = 0; i < graph->node_capacity; i++) {
+            for (Node* current = graph->nodes[i]; current; current = current->next) {
+                size_t position;
+                if (current == node || !node_find_edge(current, node_id, &position)) continue;
+
+                Status status = remove_logged(batch, current, position);
+                if (status != STATUS_SUCCESS) return status;
+            }
+        }
+    }
+
+    if (batch->removed_count == batch->removed_capacity) {
+        size_t new_capacity = batch->removed_capacity ? batch->removed_capacity * 2 : 16;
+        RemovedNode* grown = realloc(batch->removed, new_capacity * sizeof(RemovedNode));
+        if (!grown) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow batch undo log", -1, -1);
+            return STATUS_OOM;
+        }
+        batch->removed = grown;
+        batch->removed_capacity = new_capacity;
+    }
+
+    UndoEntry* entry = undo_push(batch, UNDO_NODE_REMOVED, node);
+    if (!entry) return STATUS_OOM;
+
+    RemovedNode* removed = &batch->removed[batch->removed_count];
+    entry->position = batch->removed_count++;
+    removed->node = node;
+    removed->chain_position = 0;
+    removed->id_position = 0;
+
+    Node* current = graph->nodes[hash(node_id, graph->node_capacity)];
+    for (; current != node; current = current->next) removed->chain_position++;
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        if (graph->node_ids[i] == node_id) {
+            removed->id_position = i;
+            break;
+        }
+    }
+
+    // The node itself stays allocated until the batch is committed
+    chain_unlink(graph, node);
+    memmove(&graph->node_ids[removed->id_position], &graph->node_ids[removed->id_position + 1],
+        (graph->node_count - removed->id_position - 1) * sizeof(int));
+    graph->node_count--;
+    graph->node_ids[graph->node_count] = -1;
+
+    return STATUS_SUCCESS;
+}
+
+// Helper: append edge and log it
+static Status append_logged(GraphBatch* batch, Node* node, int to, double weight) {
+    if (!undo_push(batch, UNDO_EDGE_ADDED, node)) return STATUS_OOM;
+
+    Status status = node_append_edge(node, to, weight);
+    if (status != STATUS_SUCCESS) batch->undo_count--;
+    return status;
+}
+
+// Helper: resolve both endpoints, reports missing nodes
+static Status resolve_edge(GraphBatch* batch, const BatchOp* op, Node** from_node, Node** to_node) {
+    *from_node = find_node(batch->graph, op->from);
+    if (!*from_node) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", op->from, -1);
+        return STATUS_WARNING;
+    }
+
+    *to_node = find_node(batch->graph, op->to);
+    if (!*to_node) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", op->to, -1);
+        return STATUS_WARNING;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+static Status apply_insert_edge(GraphBatch* batch, const BatchOp* op) {
+    bool undirected = batch->graph->type == GRAPH_UNDIRECTED;
+    Node *from_node, *to_node;
+
+    Status status = resolve_edge(batch, op, &from_node, &to_node);
+    if (status != STATUS_SUCCESS) return status;
+
+    // Undirected self loops would need the reverse edge in the same array
+    if (undirected && op->from == op->to) {
+        DIAG(DIAG_WARNING, ERR_EXISTS, "reverse edge already exists", op->to, op->from);
+        return STATUS_WARNING;
+    }
+
+    if (node_find_edge(from_node, op->to, NULL) || (undirected && node_find_edge(to_node, op->from, NULL))) {
+        DIAG(DIAG_WARNING, ERR_EXISTS, "edge already exists", op->from, op->to);
+        return STATUS_WARNING;
+    }
+
+    status = append_logged(batch, from_node, op->to, op->weight);
+    if (status == STATUS_SUCCESS && undirected) status = append_logged(batch, to_node, op->from, op->weight);
+    return status;
+}
+
+static Status apply_update_edge(GraphBatch* batch, const BatchOp* op) {
+    bool undirected = batch->graph->type == GRAPH_UNDIRECTED;
+    Node *from_node, *to_node;
+    size_t forward, reverse = 0;
+
+    Status status = resolve_edge(batch, op, &from_node, &to_node);
+    if (status != STATUS_SUCCESS) return status;
+
+    if (!node_find_edge(from_node, op->to, &forward) || (undirected && !node_find_edge(to_node, op->from, &reverse))) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "edge does not exist", op->from, op->to);
+        return STATUS_WARNING;
+    }
+
+    UndoEntry* entry = undo_push(batch, UNDO_EDGE_UPDATED, from_node);
+    if (!entry) return STATUS_OOM;
+    entry->position = forward;
+    entry->weight = from_node->neighbors[forward].weight;
+    from_node->neighbors[forward].weight = op->weight;
+
+    if (undirected) {
+        entry = undo_push(batch, UNDO_EDGE_UPDATED, to_node);
+        if (!entry) return STATUS_OOM;
+        entry->position = reverse;
+        entry->weight = to_node->neighbors[reverse].weight;
+        to_node->neighbors[reverse].weight = op->weight;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+static Status apply_remove_edge(GraphBatch* batch, const BatchOp* op) {
+    bool undirected = batch->graph->type == GRAPH_UNDIRECTED;
+    Node *from_node, *to_node;
+    size_t forward, reverse = 0;
+
+    Status status = resolve_edge(batch, op, &from_node, &to_node);
+    if (status != STATUS_SUCCESS) return status;
+
+    if (!node_find_edge(from_node, op->to, &forward) || (undirected && !node_find_edge(to_node, op->from, &reverse))) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "edge does not exist", op->from, op->to);
+        return STATUS_WARNING;
+    }
+
+    status = remove_logged(batch, from_node, forward);
+    if (status == STATUS_SUCCESS && undirected && from_node != to_node) status = remove_logged(batch, to_node, reverse);
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Commit
+// ---------------------------------------------------------------------------
+
+Status graph_batch_commit(GraphBatch* batch, size_t* failed_op) {
+    CHECK_BATCH
+
+    DegreeMap degrees = {NULL, 0};
+    Status status = batch_reserve(batch, &degrees);
+    if (status != STATUS_SUCCESS && failed_op) *failed_op = batch->op_count;
+
+    for (size_t i = 0; status == STATUS_SUCCESS && i < batch->op_count; i++) {
+        const BatchOp* op = &batch->ops[i];
+
+        switch (op->type) {
+            case OP_INSERT_NODE:
+                status = apply_insert_node(batch, op, &degrees);
+                break;
+            case OP_REMOVE_NODE:
+                status = apply_remove_node(batch, op);
+                break;
+            case OP_INSERT_EDGE:
+                status = apply_insert_edge(batch, op);
+                break;
+            case OP_UPDATE_EDGE:
+                status = apply_update_edge(batch, op);
+                break;
+            case OP_REMOVE_EDGE:
+                status = apply_remove_edge(batch, op);
+                break;
+        }
+
+        if (status != STATUS_SUCCESS && failed_op) *failed_op = i;
+    }
+
+    if (status != STATUS_SUCCESS) {
+        // All or nothing: undo every applied step in reverse order
+        batch_rollback(batch);
+    } else {
+        for (size_t i = 0; i < batch->removed_count; i++) {
+            free(batch->removed[i].node->neighbors);
+            free(batch->removed[i].node);
+        }
+    }
+
+    free(degrees.slots);
+    batch_free(batch);
+    return status;
+}
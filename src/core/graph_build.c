@@ -1,10 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include "core/graph_build.h"
 #include "utils/general_utils.h"
 #include "utils/hash_table_utils.h"
 #include "utils/graph_build_utils.h"
+#include "utils/graph_stats.h"
+#include "utils/diagnostics.h"
 
 # define INITIAL_CAPACITY 4
 
@@ -12,7 +15,7 @@
 Graph* graph_create(GraphType type, size_t initial_capacity) {
     Graph *graph = malloc(sizeof(Graph));
     if (!graph) {
-        fprintf(stderr, "Fatal error: Failed to initialize graph\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize graph", -1, -1);
         return NULL;
     }
 
@@ -24,16 +27,16 @@ Graph* graph_create(GraphType type, size_t initial_capacity) {
 
     graph->node_ids = calloc(initial_capacity, sizeof(int));
     if (!graph->node_ids) {
-        fprintf(stderr, "Fatal error: Failed to initialize node id array while creating graph\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize node id array while creating graph", -1, -1);
         free(graph);
         return NULL;
     };
 
     graph->nodes = calloc(initial_capacity, sizeof(Node*));
     if (!graph->nodes) {
-        fprintf(stderr, "Fatal error: Failed to initialize node array while creating graph\n");
-        free(graph);
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize node array while creating graph", -1, -1);
         free(graph->node_ids);
+        free(graph);
         return NULL;
     };
 
@@ -75,9 +78,7 @@ Status graph_insert_node(Graph* graph, int node_id, size_t node_capacity) {
     // Check if node already exists in graph
     Node *node = find_node(graph, node_id);
     if (node) {
-        #ifdef DEBUG
-        printf("A node with ID %d already exists in the graph", node_id);
-        #endif
+        DIAG(DIAG_DEBUG, ERR_EXISTS, "node already exists", node_id, -1);
         return STATUS_WARNING;
     }
 
@@ -85,9 +86,7 @@ Status graph_insert_node(Graph* graph, int node_id, size_t node_capacity) {
     if (node_capacity <= 0) node_capacity = INITIAL_CAPACITY;
     Node* new_node = create_node(node_id, node_capacity);
     if (!new_node) {
-        // * create_node function has own error logs
-        // fprintf(stderr, "Error: Failed to initialize new node\n"); <- error log if create_node fails
-        fprintf(stderr, "Error: Graph left unchanged, node with ID %d could not be inserted\n", node_id);
+        // * create_node reports the failure, graph is left unchanged
         return STATUS_OOM; // it happens only if malloc fails
     }
 
@@ -101,7 +100,7 @@ Status graph_insert_node(Graph* graph, int node_id, size_t node_capacity) {
             return STATUS_WARNING;
         case STATUS_INVALID:
             // if node is invalid, assume graph has been corrupted 
-            fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
             free(new_node->neighbors);
             free(new_node);
             return STATUS_ERROR;
@@ -118,12 +117,11 @@ Status graph_insert_node(Graph* graph, int node_id, size_t node_capacity) {
             case STATUS_SUCCESS:
                 break;
             case STATUS_OOM:
-                // If OOM happens, graph is left unmodified
-                fprintf(stderr, "Error: Failed to resize graph, load factor might be too high\n");
+                // If OOM happens, graph is left unmodified (graph_resize reports it)
                 return STATUS_OOM;
             case STATUS_INVALID:
                 // should never happen due to previous check
-                fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
                 return STATUS_ERROR;
             default:
                 return STATUS_ERROR;
@@ -132,6 +130,7 @@ Status graph_insert_node(Graph* graph, int node_id, size_t node_capacity) {
 
     graph->node_ids[graph->node_count] = node_id;
     graph->node_count++;
+    STATS_COUNT(node_inserts);
     return STATUS_SUCCESS;
 }
 
@@ -141,9 +140,7 @@ Status graph_remove_node(Graph* graph, int node_id) {
     // Check if node exists
     Node* node = find_node(graph, node_id);
     if (!node) {
-        #ifdef DEBUG
-        printf("A node with ID %d does not exist in the graph\n", node_id);
-        #endif
+        DIAG(DIAG_DEBUG, ERR_NOT_FOUND, "node does not exist", node_id, -1);
         return STATUS_WARNING;
     }
     
@@ -153,8 +150,8 @@ Status graph_remove_node(Graph* graph, int node_id) {
             EdgeNode edge = node->neighbors[i];
             Node *current = find_node(graph, edge.node_id);  // quite sure this won't return NULL due to edges only point to existing nodes
             if (!current) {
-                fprintf(stderr, "Fatal error: Undirected graph has been corrupted. "
-                    "Edge points to non-existing node %d\n", edge.node_id);
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, edge points to non-existing node",
+                    node_id, edge.node_id);
                 return STATUS_ERROR;
             }
             
@@ -164,11 +161,12 @@ Status graph_remove_node(Graph* graph, int node_id) {
                 case STATUS_WARNING:
                     // In an undirected graph, every node's neighbor should point back to it.
                     // if it doesn't, the graph is corrupted.
-                    fprintf(stderr, "Warning: Directed edge node %d->%d, while removing node %d\n", edge.node_id, node_id, node_id);
-                    fprintf(stderr, "Fatal error: Undirected graph has been corrupted\n");
+                    DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, found directed edge",
+                        edge.node_id, node_id);
+                    return STATUS_ERROR;
                 case STATUS_INVALID:
                     // If node is invalid, assume graph has been corrupted
-                    fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+                    DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
                     return STATUS_ERROR;
                 default:
                     return STATUS_ERROR;
@@ -186,7 +184,7 @@ Status graph_remove_node(Graph* graph, int node_id) {
                         break;
                     case STATUS_INVALID:
                         // If node is invalid, assume graph has been corrupted
-                        fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+                        DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
                         return STATUS_ERROR;
                     default:
                         return STATUS_ERROR;
@@ -201,11 +199,11 @@ Status graph_remove_node(Graph* graph, int node_id) {
             break;
         case STATUS_WARNING:
             // If the node removal fails, and the edges have been removed, the graph has been corrupted
-            fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
             return STATUS_ERROR;
         case STATUS_INVALID:
             // If node is invalid, assume graph has been corrupted
-            fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
             return STATUS_ERROR;
         default:
             return STATUS_ERROR;
@@ -222,6 +220,7 @@ Status graph_remove_node(Graph* graph, int node_id) {
         }
     }
     
+    STATS_COUNT(node_removes);
     return STATUS_SUCCESS;
 }
 
@@ -230,13 +229,13 @@ Status graph_insert_edge(Graph* graph, int from, int to, double weight) {
 
     Node* from_node = find_node(graph, from);
     if (!from_node) {
-        fprintf(stderr, "Warning: A node with ID %d does not exist in the graph\n", from);
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", from, -1);
         return STATUS_WARNING;
     }
 
     Node* to_node = find_node(graph, to);
     if (!to_node) {
-        fprintf(stderr, "Warning: A node with ID %d does not exist in the graph\n", to);
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", to, -1);
         return STATUS_WARNING;
     }
 
@@ -245,14 +244,14 @@ Status graph_insert_edge(Graph* graph, int from, int to, double weight) {
             break;
         case STATUS_WARNING:
             // will throw warning if edge already exists
+            DIAG(DIAG_WARNING, ERR_EXISTS, "edge already exists", from, to);
             return STATUS_WARNING;
         case STATUS_OOM:
-            // If OOM happens, graph is left unmodified
-            fprintf(stderr, "Error: Failed to add edge %d->%d\n", from, to);
+            // If OOM happens, graph is left unmodified (node_resize reports it)
             return STATUS_OOM;
         case STATUS_INVALID:
             // If node is invalid, assume graph has been corrupted
-            fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", from, to);
             return STATUS_ERROR;
         case STATUS_ERROR:
             return STATUS_ERROR;
@@ -260,22 +259,23 @@ Status graph_insert_edge(Graph* graph, int from, int to, double weight) {
 
     if (graph->type == GRAPH_UNDIRECTED) {
         // For undirected graphs, add reverse edge
-        if (node_add_edge(to_node, from, weight, NULL, false) != STATUS_SUCCESS) {
+        Status reverse = node_add_edge(to_node, from, weight, NULL, false);
+        if (reverse != STATUS_SUCCESS) {
             // If adding reverse edge fails, undo addition of forward edge
             if (node_remove_edge(from_node, to, NULL) != STATUS_SUCCESS) {
                 // If rollback of forward edge fails, graph is corrupted
-                fprintf(stderr,
-                    "Fatal error: Undirected graph has been corrupted. " 
-                    "rollback failed to revert forward edge %d->%d\n", from, to);
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, rollback of forward edge failed",
+                    from, to);
                 return STATUS_ERROR;
             }
 
-            fprintf(stderr, "Error: Failed to add edge between nodes %d and %d"
-                "graph left unmodified\n", from, to);
+            // reverse edge already present (e.g. self loop), or node_resize reported OOM
+            if (reverse == STATUS_WARNING) DIAG(DIAG_WARNING, ERR_EXISTS, "reverse edge already exists", to, from);
             return STATUS_WARNING;
         }
     }
     
+    STATS_COUNT(edge_inserts);
     return STATUS_SUCCESS;
 }
 
@@ -284,15 +284,13 @@ Status graph_update_edge(Graph* graph, int from, int to, double weight){
 
     Node* from_node = find_node(graph, from);
     if (!from_node) {
-        fprintf(stderr, "Warning: A node with ID %d does not exist in the graph"
-            "graph left unmodified\n", from);
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", from, -1);
         return STATUS_WARNING;
     }
 
     Node* to_node = find_node(graph, to);
     if (!to_node) {
-        fprintf(stderr, "Warning: A node with ID %d does not exist in the graph, "
-            "graph left unmodified\n", to);
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", to, -1);
         return STATUS_WARNING;
     }
 
@@ -301,14 +299,13 @@ Status graph_update_edge(Graph* graph, int from, int to, double weight){
             break;
         case STATUS_WARNING:
             // will throw warning if edge does not exist
-            fprintf(stderr, "Error: Failed to edit edge %d->%d, graph left unmodified\n", from, to);
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "edge does not exist", from, to);
             return STATUS_WARNING;
         case STATUS_OOM:
-            fprintf(stderr, "Error: Failed to edit edge %d->%d, graph left unmodified\n", from, to);
             return STATUS_OOM;
         case STATUS_INVALID:
             // If node is invalid, assume graph has been corrupted
-            fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", from, to);
             return STATUS_ERROR;
         case STATUS_ERROR:
             return STATUS_ERROR;
@@ -320,17 +317,17 @@ Status graph_update_edge(Graph* graph, int from, int to, double weight){
             // If adding reverse edge fails, Undo changes to forward edge
             if (node_add_edge(from_node, to, old_weight, NULL, true) != STATUS_SUCCESS) {
                 // If rollback of forward edge fails, graph is corrupted
-                fprintf(stderr,
-                    "Fatal error: Undirected graph has been corrupted. " 
-                    "rollback failed to revert forward edge %d->%d\n", from, to);
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, rollback of forward edge failed",
+                    from, to);
                 return STATUS_ERROR;
             }
 
-            fprintf(stderr, "Error: Failed to edit edge between nodes %d and %d, graph left unmodified\n", from, to);
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "reverse edge does not exist", to, from);
             return STATUS_WARNING; 
         }
     }
 
+    STATS_COUNT(edge_updates);
     return STATUS_SUCCESS;
 }
 
@@ -339,51 +336,50 @@ Status graph_remove_edge(Graph* graph, int from, int to) {
 
     Node* from_node = find_node(graph, from);
     if (!from_node) {
-        fprintf(stderr, "Warning: A node with ID %d does not exist in the graph", from);
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", from, -1);
         return STATUS_WARNING;
     }
 
     Node* to_node = find_node(graph, to);
     if (!to_node) {
-        fprintf(stderr, "Warning: A node with ID %d does not exist in the graph", to);
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", to, -1);
         return STATUS_WARNING;
     }
 
-    switch (node_remove_edge(from_node, to, NULL)) {
+    double forward_weight = 0.0;
+    switch (node_remove_edge(from_node, to, &forward_weight)) {
         case STATUS_SUCCESS:
             break;
         case STATUS_WARNING:
             // will throw warning if edge does not exist
-            fprintf(stderr, "Error: Failed to edit edge %d->%d, graph left unmodified\n", from, to);
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "edge does not exist", from, to);
             return STATUS_WARNING;
         case STATUS_OOM:
-            fprintf(stderr, "Error: Failed to edit edge %d->%d, graph left unmodified\n", from, to);
             return STATUS_OOM;
         case STATUS_INVALID:
             // If node is invalid, assume graph has been corrupted
-            fprintf(stderr, "Fatal error: Graph has been corrupted\n");
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", from, to);
             return STATUS_ERROR;
         case STATUS_ERROR:
             return STATUS_ERROR;
     }
 
     if (graph->type == GRAPH_UNDIRECTED) {
-        // For undirected graphs, edit reverse edge
-        double old_weight = 0.0;
-        if (node_remove_edge(to_node, from, &old_weight) != STATUS_SUCCESS) {
-            // If adding reverse edge fails, Undo changes to forward edge
-            if (node_add_edge(from_node, to, old_weight, NULL, true) != STATUS_SUCCESS) {
+        // For undirected graphs, remove reverse edge
+        if (node_remove_edge(to_node, from, NULL) != STATUS_SUCCESS) {
+            // If removing reverse edge fails, restore forward edge
+            if (node_append_edge(from_node, to, forward_weight) != STATUS_SUCCESS) {
                 // If rollback of forward edge fails, graph is corrupted
-                fprintf(stderr, 
-                    "Fatal error: Undirected graph has been corrupted. "
-                    "rollback failed to restore forward edge %d->%d\n", from, to);
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, rollback of forward edge failed",
+                    from, to);
                     return STATUS_ERROR;
             }
 
-            fprintf(stderr, "Error: Failed to remove edge between nodes %d and %d, graph left unmodified\n", from, to);
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "reverse edge does not exist", to, from);
             return STATUS_WARNING;
         }
     }
 
+    STATS_COUNT(edge_removes);
     return STATUS_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "utils/general_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/thread_utils.h"
+
+#define CSR_TASK_NODES 4096         // nodes per build task
+#define INSERTION_SORT_LIMIT 32     // shorter neighbor lists are insertion sorted
+
+typedef struct {
+    uint32_t target;
+    double weight;
+} CsrArc;
+
+typedef struct {
+    const Graph* graph;
+    GraphCsr* csr;
+    Status* task_status;
+} CsrBuild;
+
+static void slots_insert(GraphCsr* csr, int node_id, uint32_t index) {
+    size_t slot = hash(node_id, (int)csr->slot_capacity);
+    while (csr->slots[slot].index != CSR_NO_INDEX) slot = (slot + 1) & (csr->slot_capacity - 1);
+
+    csr->slots[slot].id = node_id;
+    csr->slots[slot].index = index;
+}
+
+uint32_t graph_csr_index(const GraphCsr* csr, int node_id) {
+    if (!csr || !csr->slots) return CSR_NO_INDEX;
+
+    size_t slot = hash(node_id, (int)csr->slot_capacity);
+    while (csr->slots[slot].index != CSR_NO_INDEX) {
+        if (csr->slots[slot].id == node_id) return csr->slots[slot].index;
+        slot = (slot + 1) & (csr->slot_capacity - 1);
+    }
+    return CSR_NO_INDEX;
+}
+
+static int compare_arc(const void* a, const void* b) {
+    uint32_t x = ((const CsrArc*)a)->target;
+    uint32_t y = ((const CsrArc*)b)->target;
+    return (x > y) - (x < y);
+}
+
+static int compare_target(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Helper: sort one neighbor list, weights move with their targets. False on OOM.
+static bool sort_neighbors(uint32_t* targets, double* weights, size_t count, CsrArc** scratch, size_t* scratch_capacity) {
+    if (count < 2) return true;
+
+    if (!weights) {
+        if (count <= INSERTION_SORT_LIMIT) {
+            for (size_t i = 1; i < count; i++) {
+                uint32_t value = targets[i];
+                size_t j = i;
+                while (j > 0 && targets[j - 1] > value) {
+                    targets[j] = targets[j - 1];
+                    j--;
+                }
+                targets[j] = value;
+            }
+        } else {
+            qsort(targets, count, sizeof(uint32_t), compare_target);
+        }
+        return true;
+    }
+
+    if (count > *scratch_capacity) {
+        CsrArc* grown = realloc(*scratch, count * sizeof(CsrArc));
+        if (!grown) return false;
+        *scratch = grown;
+        *scratch_capacity = count;
+    }
+
+    CsrArc* arcs = *scratch;
+    for (size_t i = 0; i < count; i++) {
+        arcs[i].target = targets[i];
+        arcs[i].weight = weights[i];
+    }
+    qsort(arcs, count, sizeof(CsrArc), compare_arc);
+    for (size_t i = 0; i < count; i++) {
+        targets[i] = arcs[i].target;
+        weights[i] = arcs[i].weight;
+    }
+    return true;
+}
+
+static void build_task(void* ctx, size_t task, int thread_id) {
+    (void)thread_id;
+    CsrBuild* build = ctx;
+    GraphCsr* csr = build->csr;
+
+    size_t start = task * CSR_TASK_NODES;
+    size_t end = start + CSR_TASK_NODES < csr->node_count ? start + CSR_TASK_NODES : csr->node_count;
+    CsrArc* scratch = NULL;
+    size_t scratch_capacity = 0;
+
+    for (size_t i = start; i < end; i++) {
+        const Node* node = find_node(build->graph, csr->ids[i]);
+        size_t base = csr->offsets[i];
+
+        for (size_t j = 0; j < node->neighbor_count; j++) {
+            uint32_t target = graph_csr_index(csr, node->neighbors[j].node_id);
+            if (target == CSR_NO_INDEX) {
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "graph corrupted, edge to missing node", node->id, node->neighbors[j].node_id);
+                build->task_status[task] = STATUS_ERROR;
+                free(scratch);
+                return;
+            }
+            csr->targets[base + j] = target;
+            if (csr->weights) csr->weights[base + j] = node->neighbors[j].weight;
+        }
+
+        double* weights = csr->weights ? &csr->weights[base] : NULL;
+        if (!sort_neighbors(&csr->targets[base], weights, node->neighbor_count, &scratch, &scratch_capacity)) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to sort csr neighbors", node->id, -1);
+            build->task_status[task] = STATUS_OOM;
+            free(scratch);
+            return;
+        }
+    }
+
+    free(scratch);
+}
+
+Status graph_csr_build(const Graph* graph, GraphCsr* csr, bool with_weights, int num_threads) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(csr, STATUS_INVALID, "invalid csr");
+    memset(csr, 0, sizeof(*csr));
+
+    if (graph->node_count >= CSR_NO_INDEX) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "graph too large for csr indices", -1, -1);
+        return STATUS_INVALID;
+    }
+
+    csr->type = graph->type;
+    csr->node_count = graph->node_count;
+    csr->slot_capacity = 16;
+    while (csr->slot_capacity < 2 * csr->node_count) csr->slot_capacity *= 2;
+
+    csr->ids = malloc((csr->node_count ? csr->node_count : 1) * sizeof(int));
+    csr->offsets = malloc((csr->node_count + 1) * sizeof(size_t));
+    csr->slots = malloc(csr->slot_capacity * sizeof(CsrSlot));
+    if (!csr->ids || !csr->offsets || !csr->slots) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize csr", -1, -1);
+        graph_csr_free(csr);
+        return STATUS_OOM;
+    }
+
+    for (size_t i = 0; i < csr->slot_capacity; i++) csr->slots[i].index = CSR_NO_INDEX;
+
+    // Pass 1: index nodes and compute offsets
+    csr->offsets[0] = 0;
+    for (size_t i = 0; i < csr->node_count; i++) {
+        const Node* node = find_node(graph, graph->node_ids[i]);
+        if (!node) {
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", graph->node_ids[i], -1);
+            graph_csr_free(csr);
+            return STATUS_ERROR;
+        }
+
+        csr->ids[i] = node->id;
+        csr->offsets[i + 1] = csr->offsets[i] + node->neighbor_count;
+        slots_insert(csr, node->id, (uint32_t)i);
+    }
+    csr->arc_count = csr->offsets[csr->node_count];
+
+    size_t arcs = csr->arc_count ? csr->arc_count : 1;
+    csr->targets = malloc(arcs * sizeof(uint32_t));
+    if (with_weights) csr->weights = malloc(arcs * sizeof(double));
+
+    size_t task_count = (csr->node_count + CSR_TASK_NODES - 1) / CSR_TASK_NODES;
+    Status* task_status = calloc(task_count ? task_count : 1, sizeof(Status));
+    if (!csr->targets || (with_weights && !csr->weights) || !task_status) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize csr", -1, -1);
+        free(task_status);
+        graph_csr_free(csr);
+        return STATUS_OOM;
+    }
+
+    // Pass 2: translate and sort neighbor lists in parallel
+    CsrBuild build = {graph, csr, task_status};
+    Status status = parallel_for(task_count, num_threads, build_task, &build);
+    for (size_t i = 0; i < task_count && status == STATUS_SUCCESS; i++) status = task_status[i];
+
+    free(task_status);
+    if (status != STATUS_SUCCESS) graph_csr_free(csr);
+    return status;
+}
+
+void graph_csr_free(GraphCsr* csr) {
+    if (!csr) return;
+    free(csr->ids);
+    free(csr->offsets);
+    free(csr->targets);
+    free(csr->weights);
+    free(csr->slots);
+    memset(csr, 0, sizeof(*csr));
+}
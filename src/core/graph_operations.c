@@ -14,6 +14,7 @@ bool graph_is_directed(const Graph* graph) {
     if (graph->type == GRAPH_UNDIRECTED) return false;
 
     // Fallback: check edges to determine if directed
+    return false;
 }
 
 size_t graph_node_count(const Graph* graph) {
@@ -0,0 +1,330 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "core/graph_setops.h"
+#include "utils/general_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/thread_utils.h"
+
+#define SETOP_TASK_NODES 1024       // output nodes per task
+#define INSERTION_SORT_MAX 16
+
+typedef enum {
+    SETOP_UNION,
+    SETOP_INTERSECTION,
+    SETOP_DIFFERENCE
+} SetOp;
+
+// * Per-thread scratch, grown to the largest lists seen
+typedef struct {
+    EdgeNode* sorted_a;
+    size_t capacity_a;
+    EdgeNode* sorted_b;
+    size_t capacity_b;
+    EdgeNode* merged;
+    size_t capacity_merged;
+    Status status;
+} SetOpWorkspace;
+
+typedef struct {
+    const Graph* a;
+    const Graph* b;
+    const SetOpConfig* config;
+    SetOp op;
+
+    const int* candidates;      // node selection: IDs to test
+    bool* selected;
+
+    const int* ids;             // output nodes in order
+    size_t count;
+    Node** built;               // parallel to ids
+    SetOpWorkspace* workspaces;
+} SetOpContext;
+
+SetOpConfig setop_config_default(void) {
+    SetOpConfig config;
+    config.weights = WEIGHT_FIRST;
+    config.num_threads = 0;
+    return config;
+}
+
+// ---------------------------------------------------------------------------
+// Node selection
+// ---------------------------------------------------------------------------
+
+// Union tests the nodes of b for absence from a, intersection the nodes of a for presence in b
+static void select_task(void* arg, size_t task, int thread_id) {
+    (void)thread_id;
+    SetOpContext* ctx = arg;
+    size_t begin = task * SETOP_TASK_NODES;
+    size_t end = begin + SETOP_TASK_NODES < ctx->count ? begin + SETOP_TASK_NODES : ctx->count;
+
+    for (size_t i = begin; i < end; i++) {
+        if (ctx->op == SETOP_UNION) {
+            ctx->selected[i] = find_node(ctx->a, ctx->candidates[i]) == NULL;
+        } else {
+            ctx->selected[i] = find_node(ctx->b, ctx->candidates[i]) != NULL;
+        }
+    }
+}
+
+// Helper: output node IDs in order, NULL on OOM
+static int* select_nodes(SetOpContext* ctx, int threads, size_t* count) {
+    const Graph* a = ctx->a;
+    const Graph* b = ctx->b;
+    size_t capacity = ctx->op == SETOP_UNION ? a->node_count + b->node_count : a->node_count;
+    int* ids = malloc((capacity ? capacity : 1) * sizeof(int));
+    if (!ids) return NULL;
+
+    memcpy(ids, a->node_ids, a->node_count * sizeof(int));
+    *count = a->node_count;
+    if (ctx->op == SETOP_DIFFERENCE) return ids;
+
+    ctx->candidates = ctx->op == SETOP_UNION ? b->node_ids : a->node_ids;
+    ctx->count = ctx->op == SETOP_UNION ? b->node_count : a->node_count;
+    ctx->selected = malloc((ctx->count ? ctx->count : 1) * sizeof(bool));
+    if (!ctx->selected) {
+        free(ids);
+        return NULL;
+    }
+
+    Status status = parallel_for((ctx->count + SETOP_TASK_NODES - 1) / SETOP_TASK_NODES, threads, select_task, ctx);
+    if (status != STATUS_SUCCESS) {
+        free(ctx->selected);
+        ctx->selected = NULL;
+        free(ids);
+        return NULL;
+    }
+
+    // Union appends the nodes only b has, intersection keeps the common nodes of a
+    size_t kept = ctx->op == SETOP_UNION ? a->node_count : 0;
+    for (size_t i = 0; i < ctx->count; i++) {
+        if (ctx->selected[i]) ids[kept++] = ctx->candidates[i];
+    }
+    free(ctx->selected);
+    ctx->selected = NULL;
+
+    *count = kept;
+    return ids;
+}
+
+// ---------------------------------------------------------------------------
+// Adjacency merge
+// ---------------------------------------------------------------------------
+
+static void insertion_sort(EdgeNode* edges, size_t count) {
+    for (size_t i = 1; i < count; i++) {
+        EdgeNode edge = edges[i];
+        size_t j = i;
+        while (j > 0 && edges[j - 1].node_id > edge.node_id) {
+            edges[j] = edges[j - 1];
+            j--;
+        }
+        edges[j] = edge;
+    }
+}
+
+// Helper: quicksort by node ID with a median of three pivot, recursing into the
+// smaller side only so the stack stays logarithmic
+static void sort_edges(EdgeNode* edges, size_t count) {
+    while (count > INSERTION_SORT_MAX) {
+        int first = edges[0].node_id, middle = edges[count / 2].node_id, last = edges[count - 1].node_id;
+        int pivot = first < middle ? (middle < last ? middle : (first < last ? last : first))
+                                   : (first < last ? first : (middle < last ? last : middle));
+
+        size_t i = 0, j = count - 1;
+        for (;;) {
+            while (edges[i].node_id < pivot) i++;
+            while (edges[j].node_id > pivot) j--;
+            if (i >= j) break;
+            EdgeNode swap = edges[i];
+            edges[i] = edges[j];
+            edges[j] = swap;
+            i++;
+            j--;
+        }
+
+        // [0, j] <= pivot <= [j + 1, count)
+        size_t left = j + 1;
+        if (left < count - left) {
+            sort_edges(edges, left);
+            edges += left;
+            count -= left;
+        } else {
+            sort_edges(edges + left, count - left);
+            count = left;
+        }
+    }
+    insertion_sort(edges, count);
+}
+
+// Helper: copy of the node's neighbors sorted by ID, false on OOM
+static bool sorted_copy(const Node* node, EdgeNode** buffer, size_t* capacity) {
+    size_t count = node ? node->neighbor_count : 0;
+    if (count > *capacity) {
+        EdgeNode* grown = realloc(*buffer, count * sizeof(EdgeNode));
+        if (!grown) return false;
+        *buffer = grown;
+        *capacity = count;
+    }
+    if (count == 0) return true;
+
+    EdgeNode* edges = *buffer;
+    memcpy(edges, node->neighbors, count * sizeof(EdgeNode));
+
+    bool sorted = true;
+    for (size_t i = 1; i < count && sorted; i++) sorted = edges[i - 1].node_id < edges[i].node_id;
+    if (sorted) return true;
+
+    sort_edges(edges, count);
+    return true;
+}
+
+static double combine_weights(WeightRule rule, double first, double second) {
+    switch (rule) {
+        case WEIGHT_SECOND: return second;
+        case WEIGHT_SUM: return first + second;
+        case WEIGHT_MIN: return first < second ? first : second;
+        case WEIGHT_MAX: return first > second ? first : second;
+        case WEIGHT_MEAN: return (first + second) / 2.0;
+        default: return first;
+    }
+}
+
+// Helper: merged neighbor list of one output node, allocated at its exact size
+static Node* merge_node(const SetOpContext* ctx, SetOpWorkspace* ws, int node_id) {
+    const Node* node_a = find_node(ctx->a, node_id);
+    const Node* node_b = find_node(ctx->b, node_id);
+    size_t count_a = node_a ? node_a->neighbor_count : 0;
+    size_t count_b = node_b ? node_b->neighbor_count : 0;
+
+    if (!sorted_copy(node_a, &ws->sorted_a, &ws->capacity_a) || !sorted_copy(node_b, &ws->sorted_b, &ws->capacity_b)) return NULL;
+    if (count_a + count_b > ws->capacity_merged) {
+        EdgeNode* grown = realloc(ws->merged, (count_a + count_b) * sizeof(EdgeNode));
+        if (!grown) return NULL;
+        ws->merged = grown;
+        ws->capacity_merged = count_a + count_b;
+    }
+
+    const EdgeNode* edges_a = ws->sorted_a;
+    const EdgeNode* edges_b = ws->sorted_b;
+    EdgeNode* merged = ws->merged;
+    bool keep_a = ctx->op != SETOP_INTERSECTION;     // edges only a has
+    bool keep_b = ctx->op == SETOP_UNION;            // edges only b has
+    bool keep_both = ctx->op != SETOP_DIFFERENCE;
+    size_t i = 0, j = 0, count = 0;
+
+    while (i < count_a || j < count_b) {
+        if (j == count_b || (i < count_a && edges_a[i].node_id < edges_b[j].node_id)) {
+            if (keep_a) merged[count++] = edges_a[i];
+            i++;
+        } else if (i == count_a || edges_b[j].node_id < edges_a[i].node_id) {
+            if (keep_b) merged[count++] = edges_b[j];
+            j++;
+        } else {
+            if (keep_both) {
+                merged[count].node_id = edges_a[i].node_id;
+                merged[count].weight = combine_weights(ctx->config->weights, edges_a[i].weight, edges_b[j].weight);
+                count++;
+            }
+            i++;
+            j++;
+        }
+    }
+
+    Node* node = create_node(node_id, count ? count : 1);
+    if (!node) return NULL;
+    memcpy(node->neighbors, merged, count * sizeof(EdgeNode));
+    node->neighbor_count = count;
+    return node;
+}
+
+static void merge_task(void* arg, size_t task, int thread_id) {
+    SetOpContext* ctx = arg;
+    SetOpWorkspace* ws = &ctx->workspaces[thread_id];
+    size_t begin = task * SETOP_TASK_NODES;
+    size_t end = begin + SETOP_TASK_NODES < ctx->count ? begin + SETOP_TASK_NODES : ctx->count;
+
+    for (size_t i = begin; i < end && ws->status == STATUS_SUCCESS; i++) {
+        ctx->built[i] = merge_node(ctx, ws, ctx->ids[i]);
+        if (!ctx->built[i]) ws->status = STATUS_OOM;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Driver
+// ---------------------------------------------------------------------------
+
+static Graph* graph_setop(const Graph* a, const Graph* b, const SetOpConfig* config, SetOp op) {
+    DIAG_CHECK(a && b, NULL, "invalid graph");
+    if (a->type != b->type) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "set operations need graphs of the same type", (int)a->type, (int)b->type);
+        return NULL;
+    }
+
+    SetOpConfig defaults = setop_config_default();
+    if (!config) config = &defaults;
+    int threads = thread_count_resolve(config->num_threads);
+
+    SetOpContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.a = a;
+    ctx.b = b;
+    ctx.config = config;
+    ctx.op = op;
+
+    size_t count = 0;
+    int* ids = select_nodes(&ctx, threads, &count);
+    ctx.ids = ids;
+    ctx.count = count;
+    ctx.built = calloc(count ? count : 1, sizeof(Node*));
+    ctx.workspaces = calloc((size_t)threads, sizeof(SetOpWorkspace));
+
+    Graph* out = graph_create(a->type, 0);
+    Status status = ids && ctx.built && ctx.workspaces && out ? graph_reserve(out, count) : STATUS_OOM;
+
+    if (status == STATUS_SUCCESS) status = parallel_for((count + SETOP_TASK_NODES - 1) / SETOP_TASK_NODES, threads, merge_task, &ctx);
+    for (int t = 0; t < threads && status == STATUS_SUCCESS; t++) status = ctx.workspaces[t].status;
+
+    // The table was reserved for count nodes, attaching never rehashes
+    size_t attached = 0;
+    for (; status == STATUS_SUCCESS && attached < count; attached++) {
+        status = graph_attach_node(out, ctx.built[attached]);
+        if (status != STATUS_SUCCESS && !find_node(out, ids[attached])) break;
+    }
+
+    if (status != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to build set operation result", (int)op, -1);
+        for (size_t i = attached; ctx.built && i < count; i++) {
+            if (!ctx.built[i]) continue;
+            free(ctx.built[i]->neighbors);
+            free(ctx.built[i]);
+        }
+        if (out) graph_destroy(out);
+        out = NULL;
+    }
+
+    for (int t = 0; ctx.workspaces && t < threads; t++) {
+        free(ctx.workspaces[t].sorted_a);
+        free(ctx.workspaces[t].sorted_b);
+        free(ctx.workspaces[t].merged);
+    }
+    free(ctx.workspaces);
+    free(ctx.built);
+    free(ids);
+    return out;
+}
+
+Graph* graph_union(const Graph* a, const Graph* b, const SetOpConfig* config) {
+    return graph_setop(a, b, config, SETOP_UNION);
+}
+
+Graph* graph_intersection(const Graph* a, const Graph* b, const SetOpConfig* config) {
+    return graph_setop(a, b, config, SETOP_INTERSECTION);
+}
+
+Graph* graph_difference(const Graph* a, const Graph* b, const SetOpConfig* config) {
+    return graph_setop(a, b, config, SETOP_DIFFERENCE);
+}
@@ -0,0 +1,642 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "core/graph_build.h"
+#include "core/graph_snapshot.h"
+#include "utils/general_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+
+// * Every header of a versioned graph carries the version that allocated it and
+// * the version that allocated its neighbor array. Node comes first, so the live
+// * graph stays a plain Graph (graph_destroy and find_node work on it).
+typedef struct {
+    Node node;
+    uint64_t header_version;
+    uint64_t neighbors_version;
+} VersionedNode;
+
+typedef struct {
+    void* block;
+    uint64_t version;           // version that superseded it, seen only by older snapshots
+} RetiredBlock;
+
+struct GraphSnapshot {
+    Graph graph;
+    uint64_t version;
+    VersionedGraph* owner;
+    GraphSnapshot* older;
+    GraphSnapshot* newer;
+};
+
+struct VersionedGraph {
+    Graph* graph;
+    uint64_t version;           // stamp of blocks allocated now
+    uint64_t nodes_version;     // bucket table
+    uint64_t ids_version;       // node_ids
+
+    pthread_mutex_t lock;       // held by mutations, snapshot and release
+    GraphSnapshot* oldest;
+    GraphSnapshot* newest;
+    size_t live_snapshots;
+    bool closed;
+
+    RetiredBlock* retired;      // in version order
+    size_t retired_count;
+    size_t retired_capacity;
+
+    uint64_t headers_copied;
+    uint64_t neighbor_arrays_copied;
+    uint64_t tables_copied;
+};
+
+// Helper: can a live snapshot see a block allocated at version
+static inline bool is_shared(const VersionedGraph* versioned, uint64_t version) {
+    return versioned->newest && version <= versioned->newest->version;
+}
+
+static Status retire_reserve(VersionedGraph* versioned, size_t extra) {
+    if (versioned->retired_count + extra <= versioned->retired_capacity) return STATUS_SUCCESS;
+
+    size_t new_capacity = versioned->retired_capacity ? versioned->retired_capacity * 2 : 256;
+    while (new_capacity < versioned->retired_count + extra) new_capacity *= 2;
+    RetiredBlock* retired = realloc(versioned->retired, new_capacity * sizeof(RetiredBlock));
+    if (!retired) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow retired block list", (int)versioned->retired_count, -1);
+        return STATUS_OOM;
+    }
+    versioned->retired = retired;
+    versioned->retired_capacity = new_capacity;
+    return STATUS_SUCCESS;
+}
+
+// Helper: retire a block superseded now, space must be reserved
+static void retire_push(VersionedGraph* versioned, void* block) {
+    versioned->retired[versioned->retired_count++] = (RetiredBlock){block, versioned->version};
+}
+
+// Helper: drop a block of the live graph, deferred while a snapshot can see it
+static void discard(VersionedGraph* versioned, void* block, uint64_t version) {
+    if (is_shared(versioned, version)) retire_push(versioned, block);
+    else free(block);
+}
+
+// Helper: give the writer its own bucket table (and node_ids when ids is set)
+static Status own_tables(VersionedGraph* versioned, bool ids) {
+    Graph* graph = versioned->graph;
+
+    if (is_shared(versioned, versioned->nodes_version)) {
+        Node** nodes = malloc(graph->node_capacity * sizeof(Node*));
+        if (!nodes || retire_reserve(versioned, 1) != STATUS_SUCCESS) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to copy node table", (int)graph->node_capacity, -1);
+            free(nodes);
+            return STATUS_OOM;
+        }
+        memcpy(nodes, graph->nodes, graph->node_capacity * sizeof(Node*));
+        retire_push(versioned, graph->nodes);
+        graph->nodes = nodes;
+        versioned->nodes_version = versioned->version;
+        versioned->tables_copied++;
+    }
+
+    if (ids && is_shared(versioned, versioned->ids_version)) {
+        int* node_ids = malloc(graph->node_capacity * sizeof(int));
+        if (!node_ids || retire_reserve(versioned, 1) != STATUS_SUCCESS) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to copy node id table", (int)graph->node_capacity, -1);
+            free(node_ids);
+            return STATUS_OOM;
+        }
+        memcpy(node_ids, graph->node_ids, graph->node_capacity * sizeof(int));
+        retire_push(versioned, graph->node_ids);
+        graph->node_ids = node_ids;
+        versioned->ids_version = versioned->version;
+        versioned->tables_copied++;
+    }
+
+    return STATUS_SUCCESS;
+}
+
+// Helper: writer-owned header of node_id. Copying a shared header also copies
+// the shared headers between it and the last owned one before it in the bucket,
+// since their next pointers change. STATUS_WARNING if the node does not exist.
+static Status own_node(VersionedGraph* versioned, int node_id, VersionedNode** owned) {
+    Graph* graph = versioned->graph;
+    unsigned int bucket = hash(node_id, (int)graph->node_capacity);
+
+    Node** anchor = NULL;       // link after the last owned header, NULL for the bucket head
+    Node* target = NULL;
+    for (Node** link = &graph->nodes[bucket]; *link; link = &(*link)->next) {
+        if (!is_shared(versioned, ((VersionedNode*)*link)->header_version)) anchor = &(*link)->next;
+        if ((*link)->id == node_id) {
+            target = *link;
+            break;
+        }
+    }
+
+    if (!target) return STATUS_WARNING;
+    if (!is_shared(versioned, ((VersionedNode*)target)->header_version)) {
+        *owned = (VersionedNode*)target;
+        return STATUS_SUCCESS;
+    }
+
+    if (!anchor) {
+        Status status = own_tables(versioned, false);
+        if (status != STATUS_SUCCESS) return status;
+        anchor = &graph->nodes[bucket];
+    }
+
+    for (Node** link = anchor;; link = &(*link)->next) {
+        VersionedNode* current = (VersionedNode*)*link;
+        VersionedNode* copy = malloc(sizeof(VersionedNode));
+        if (!copy || retire_reserve(versioned, 1) != STATUS_SUCCESS) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to copy node header", current->node.id, -1);
+            free(copy);
+            return STATUS_OOM;
+        }
+
+        *copy = *current;
+        copy->header_version = versioned->version;
+        retire_push(versioned, current);
+        *link = &copy->node;
+        versioned->headers_copied++;
+
+        if (copy->node.id == node_id) {
+            *owned = copy;
+            return STATUS_SUCCESS;
+        }
+    }
+}
+
+// Helper: writer-owned header and neighbor array of node_id
+static Status own_adjacency(VersionedGraph* versioned, int node_id, VersionedNode** owned) {
+    Status status = own_node(versioned, node_id, owned);
+    if (status != STATUS_SUCCESS) return status;
+
+    VersionedNode* node = *owned;
+    if (!is_shared(versioned, node->neighbors_version)) return STATUS_SUCCESS;
+
+    size_t capacity = node->node.neighbor_capacity ? node->node.neighbor_capacity : 1;
+    EdgeNode* neighbors = malloc(capacity * sizeof(EdgeNode));
+    if (!neighbors || retire_reserve(versioned, 1) != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to copy neighbor array", node_id, (int)capacity);
+        free(neighbors);
+        return STATUS_OOM;
+    }
+
+    memcpy(neighbors, node->node.neighbors, node->node.neighbor_capacity * sizeof(EdgeNode));
+    retire_push(versioned, node->node.neighbors);
+    node->node.neighbors = neighbors;
+    node->node.neighbor_capacity = capacity;
+    node->neighbors_version = versioned->version;
+    versioned->neighbor_arrays_copied++;
+    return STATUS_SUCCESS;
+}
+
+// Helper: rehash into new_capacity buckets. Every header moves to a new chain,
+// so shared ones are copied; all allocations happen before anything is relinked.
+static Status rehash(VersionedGraph* versioned, size_t new_capacity) {
+    Graph* graph = versioned->graph;
+
+    size_t shared_headers = 0;
+    for (size_t i = 0; i < graph->node_capacity; i++) {
+        for (Node* current = graph->nodes[i]; current; current = current->next) {
+            if (is_shared(versioned, ((VersionedNode*)current)->header_version)) shared_headers++;
+        }
+    }
+
+    Node** nodes = calloc(new_capacity, sizeof(Node*));
+    int* node_ids = malloc(new_capacity * sizeof(int));
+    VersionedNode** copies = malloc((shared_headers ? shared_headers : 1) * sizeof(VersionedNode*));
+    size_t allocated = 0;
+    bool ok = nodes && node_ids && copies && retire_reserve(versioned, shared_headers + 2) == STATUS_SUCCESS;
+    for (; ok && allocated < shared_headers; allocated++) {
+        copies[allocated] = malloc(sizeof(VersionedNode));
+        if (!copies[allocated]) ok = false;
+    }
+    if (!ok) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to resize graph, keeping previous capacity", (int)new_capacity, -1);
+        for (size_t i = 0; copies && i < allocated; i++) free(copies[i]);
+        free(copies);
+        free(node_ids);
+        free(nodes);
+        return STATUS_OOM;
+    }
+
+    size_t used = 0;
+    for (size_t i = 0; i < graph->node_capacity; i++) {
+        Node* current = graph->nodes[i];
+        while (current) {
+            Node* next = current->next;
+            VersionedNode* node = (VersionedNode*)current;
+            if (is_shared(versioned, node->header_version)) {
+                VersionedNode* copy = copies[used++];
+                *copy = *node;
+                copy->header_version = versioned->version;
+                retire_push(versioned, node);
+                node = copy;
+            }
+
+            unsigned int bucket = hash(node->node.id, (int)new_capacity);
+            node->node.next = nodes[bucket];
+            nodes[bucket] = &node->node;
+            current = next;
+        }
+    }
+
+    memcpy(node_ids, graph->node_ids, graph->node_count * sizeof(int));
+    for (size_t i = graph->node_count; i < new_capacity; i++) node_ids[i] = -1;
+
+    discard(versioned, graph->nodes, versioned->nodes_version);
+    discard(versioned, graph->node_ids, versioned->ids_version);
+    graph->nodes = nodes;
+    graph->node_ids = node_ids;
+    graph->node_capacity = new_capacity;
+    versioned->nodes_version = versioned->ids_version = versioned->version;
+    versioned->headers_copied += shared_headers;
+    versioned->tables_copied++;
+
+    free(copies);
+    return STATUS_SUCCESS;
+}
+
+VersionedGraph* versioned_graph_create(Graph* graph) {
+    DIAG_CHECK(graph, NULL, "invalid graph");
+
+    VersionedGraph* versioned = calloc(1, sizeof(VersionedGraph));
+    VersionedNode** headers = malloc((graph->node_count ? graph->node_count : 1) * sizeof(VersionedNode*));
+    size_t allocated = 0;
+    bool ok = versioned && headers;
+    for (; ok && allocated < graph->node_count; allocated++) {
+        headers[allocated] = malloc(sizeof(VersionedNode));
+        if (!headers[allocated]) ok = false;
+    }
+    if (!ok) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize versioned graph", (int)graph->node_count, -1);
+        for (size_t i = 0; headers && i < allocated; i++) free(headers[i]);
+        free(headers);
+        free(versioned);
+        return NULL;
+    }
+
+    // Move every node into a versioned header, keeping chain order
+    size_t used = 0;
+    for (size_t i = 0; i < graph->node_capacity; i++) {
+        for (Node** link = &graph->nodes[i]; *link; link = &(*link)->next) {
+            VersionedNode* node = headers[used++];
+            node->node = **link;
+            node->header_version = node->neighbors_version = 0;
+            free(*link);
+            *link = &node->node;
+        }
+    }
+    free(headers);
+
+    versioned->graph = graph;
+    pthread_mutex_init(&versioned->lock, NULL);
+    return versioned;
+}
+
+static void versioned_graph_free(VersionedGraph* versioned) {
+    for (size_t i = 0; i < versioned->retired_count; i++) free(versioned->retired[i].block);
+    free(versioned->retired);
+    graph_destroy(versioned->graph);
+    pthread_mutex_destroy(&versioned->lock);
+    free(versioned);
+}
+
+void versioned_graph_destroy(VersionedGraph* versioned) {
+    if (!versioned) return;
+
+    pthread_mutex_lock(&versioned->lock);
+    versioned->closed = true;
+    bool release = versioned->live_snapshots == 0;
+    pthread_mutex_unlock(&versioned->lock);
+
+    if (release) versioned_graph_free(versioned);
+}
+
+const Graph* versioned_graph_current(const VersionedGraph* versioned) {
+    return versioned ? versioned->graph : NULL;
+}
+
+Status versioned_graph_insert_node(VersionedGraph* versioned, int node_id, size_t initial_capacity) {
+    DIAG_CHECK(versioned, STATUS_INVALID, "invalid versioned graph");
+    Graph* graph = versioned->graph;
+
+    pthread_mutex_lock(&versioned->lock);
+    Status status = STATUS_SUCCESS;
+    VersionedNode* node = NULL;
+
+    if (find_node(graph, node_id)) {
+        DIAG(DIAG_DEBUG, ERR_EXISTS, "node already exists", node_id, -1);
+        status = STATUS_WARNING;
+        goto done;
+    }
+
+    // Grow before linking the node in, so a failed resize leaves the graph as it was
+    if ((double)(graph->node_count + 1) >= ALPHA * graph->node_capacity) status = rehash(versioned, graph->node_capacity * 2);
+    else status = own_tables(versioned, true);
+    if (status != STATUS_SUCCESS) goto done;
+
+    node = malloc(sizeof(VersionedNode));
+    if (!node) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize new node", node_id, -1);
+        status = STATUS_OOM;
+        goto done;
+    }
+    node->node = (Node){node_id, NULL, 0, 0, NULL};
+    node->header_version = node->neighbors_version = versioned->version;
+    status = node_reserve(&node->node, initial_capacity ? initial_capacity : INITIAL_CAPACITY);
+    if (status != STATUS_SUCCESS) {
+        free(node);
+        goto done;
+    }
+
+    unsigned int bucket = hash(node_id, (int)graph->node_capacity);
+    node->node.next = graph->nodes[bucket];
+    graph->nodes[bucket] = &node->node;
+    graph->node_ids[graph->node_count++] = node_id;
+
+done:
+    pthread_mutex_unlock(&versioned->lock);
+    return status;
+}
+
+Status versioned_graph_remove_node(VersionedGraph* versioned, int node_id) {
+    DIAG_CHECK(versioned, STATUS_INVALID, "invalid versioned graph");
+    Graph* graph = versioned->graph;
+
+    pthread_mutex_lock(&versioned->lock);
+    Status status = STATUS_SUCCESS;
+    VersionedNode* owned = NULL;
+
+    Node* node = find_node(graph, node_id);
+    if (!node) {
+        DIAG(DIAG_DEBUG, ERR_NOT_FOUND, "node does not exist", node_id, -1);
+        status = STATUS_WARNING;
+        goto done;
+    }
+
+    // First take ownership of everything that changes, so a failure leaves the
+    // graph as it was: nodes with an edge to node_id, the header before it in
+    // its bucket and both tables.
+    if (graph->type == GRAPH_UNDIRECTED) {
+        for (size_t i = 0; i < node->neighbor_count && status == STATUS_SUCCESS; i++) {
+            status = own_adjacency(versioned, node->neighbors[i].node_id, &owned);
+            node = find_node(graph, node_id);   // its header is copied if it came first in that bucket
+        }
+    } else {
+        for (size_t i = 0; i < graph->node_count && status == STATUS_SUCCESS; i++) {
+            if (!node_find_edge(find_node(graph, graph->node_ids[i]), node_id, NULL)) continue;
+            status = own_adjacency(versioned, graph->node_ids[i], &owned);
+        }
+        node = find_node(graph, node_id);
+    }
+
+    unsigned int bucket = hash(node_id, (int)graph->node_capacity);
+    Node* previous = NULL;
+    for (Node* current = graph->nodes[bucket]; current != node; current = current->next) previous = current;
+    if (status == STATUS_SUCCESS && previous) status = own_node(versioned, previous->id, &owned);
+    if (status == STATUS_SUCCESS) status = own_tables(versioned, true);
+    if (status == STATUS_SUCCESS) status = retire_reserve(versioned, 2);
+    if (status != STATUS_SUCCESS) goto done;
+
+    // Nothing below allocates
+    node = find_node(graph, node_id);
+    if (graph->type == GRAPH_UNDIRECTED) {
+        for (size_t i = 0; i < node->neighbor_count; i++) {
+            if (node_remove_edge(find_node(graph, node->neighbors[i].node_id), node_id, NULL) != STATUS_SUCCESS) {
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "undirected graph corrupted, found directed edge",
+                    node->neighbors[i].node_id, node_id);
+                status = STATUS_ERROR;
+                goto done;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < graph->node_count; i++) {
+            node_remove_edge(find_node(graph, graph->node_ids[i]), node_id, NULL);
+        }
+    }
+
+    Node** link = &graph->nodes[bucket];
+    while (*link != node) link = &(*link)->next;
+    *link = node->next;
+
+    VersionedNode* removed = (VersionedNode*)node;
+    discard(versioned, removed->node.neighbors, removed->neighbors_version);
+    discard(versioned, removed, removed->header_version);
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        if (graph->node_ids[i] == node_id) {
+            memmove(&graph->node_ids[i], &graph->node_ids[i + 1], (graph->node_count - i - 1) * sizeof(int));
+            graph->node_count--;
+            graph->node_ids[graph->node_count] = -1;
+            break;
+        }
+    }
+
+done:
+    pthread_mutex_unlock(&versioned->lock);
+    return status;
+}
+
+// Helper: both endpoints exist, reported like graph_insert_edge
+static bool endpoints_exist(const Graph* graph, int from, int to) {
+    if (!find_node(graph, from)) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", from, -1);
+        return false;
+    }
+    if (!find_node(graph, to)) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", to, -1);
+        return false;
+    }
+    return true;
+}
+
+Status versioned_graph_insert_edge(VersionedGraph* versioned, int from, int to, double weight) {
+    DIAG_CHECK(versioned, STATUS_INVALID, "invalid versioned graph");
+    Graph* graph = versioned->graph;
+    bool undirected = graph->type == GRAPH_UNDIRECTED;
+
+    pthread_mutex_lock(&versioned->lock);
+    Status status = STATUS_WARNING;
+    VersionedNode* from_node = NULL;
+    VersionedNode* to_node = NULL;
+
+    if (!endpoints_exist(graph, from, to)) goto done;
+    if (node_find_edge(find_node(graph, from), to, NULL)) {
+        DIAG(DIAG_WARNING, ERR_EXISTS, "edge already exists", from, to);
+        goto done;
+    }
+    if (undirected && from == to) {
+        DIAG(DIAG_WARNING, ERR_EXISTS, "reverse edge already exists", to, from);
+        goto done;
+    }
+
+    status = own_adjacency(versioned, from, &from_node);
+    if (status == STATUS_SUCCESS && undirected) status = own_adjacency(versioned, to, &to_node);
+    if (status != STATUS_SUCCESS) goto done;
+
+    status = node_append_edge(&from_node->node, to, weight);
+    if (status == STATUS_SUCCESS && undirected) {
+        status = node_append_edge(&to_node->node, from, weight);
+        if (status != STATUS_SUCCESS) node_remove_edge(&from_node->node, to, NULL);
+    }
+
+done:
+    pthread_mutex_unlock(&versioned->lock);
+    return status;
+}
+
+Status versioned_graph_update_edge(VersionedGraph* versioned, int from, int to, double weight) {
+    DIAG_CHECK(versioned, STATUS_INVALID, "invalid versioned graph");
+    Graph* graph = versioned->graph;
+    bool undirected = graph->type == GRAPH_UNDIRECTED;
+
+    pthread_mutex_lock(&versioned->lock);
+    Status status = STATUS_WARNING;
+    VersionedNode* from_node = NULL;
+    VersionedNode* to_node = NULL;
+    size_t forward, reverse;
+
+    if (!endpoints_exist(graph, from, to)) goto done;
+    if (!node_find_edge(find_node(graph, from), to, NULL)
+        || (undirected && !node_find_edge(find_node(graph, to), from, NULL))) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "edge does not exist", from, to);
+        goto done;
+    }
+
+    status = own_adjacency(versioned, from, &from_node);
+    if (status == STATUS_SUCCESS && undirected) status = own_adjacency(versioned, to, &to_node);
+    if (status != STATUS_SUCCESS) goto done;
+
+    node_find_edge(&from_node->node, to, &forward);
+    from_node->node.neighbors[forward].weight = weight;
+    if (undirected) {
+        node_find_edge(&to_node->node, from, &reverse);
+        to_node->node.neighbors[reverse].weight = weight;
+    }
+
+done:
+    pthread_mutex_unlock(&versioned->lock);
+    return status;
+}
+
+Status versioned_graph_remove_edge(VersionedGraph* versioned, int from, int to) {
+    DIAG_CHECK(versioned, STATUS_INVALID, "invalid versioned graph");
+    Graph* graph = versioned->graph;
+    bool undirected = graph->type == GRAPH_UNDIRECTED;
+
+    pthread_mutex_lock(&versioned->lock);
+    Status status = STATUS_WARNING;
+    VersionedNode* from_node = NULL;
+    VersionedNode* to_node = NULL;
+
+    if (!endpoints_exist(graph, from, to)) goto done;
+    if (!node_find_edge(find_node(graph, from), to, NULL)
+        || (undirected && !node_find_edge(find_node(graph, to), from, NULL))) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "edge does not exist", from, to);
+        goto done;
+    }
+
+    status = own_adjacency(versioned, from, &from_node);
+    if (status == STATUS_SUCCESS && undirected) status = own_adjacency(versioned, to, &to_node);
+    if (status != STATUS_SUCCESS) goto done;
+
+    node_remove_edge(&from_node->node, to, NULL);
+    if (undirected) node_remove_edge(&to_node->node, from, NULL);
+
+done:
+    pthread_mutex_unlock(&versioned->lock);
+    return status;
+}
+
+void versioned_graph_stats(VersionedGraph* versioned, VersionedGraphStats* stats) {
+    if (!versioned || !stats) return;
+
+    pthread_mutex_lock(&versioned->lock);
+    stats->version = versioned->version;
+    stats->live_snapshots = versioned->live_snapshots;
+    stats->retired_blocks = versioned->retired_count;
+    stats->headers_copied = versioned->headers_copied;
+    stats->neighbor_arrays_copied = versioned->neighbor_arrays_copied;
+    stats->tables_copied = versioned->tables_copied;
+    pthread_mutex_unlock(&versioned->lock);
+}
+
+GraphSnapshot* graph_snapshot(VersionedGraph* versioned) {
+    DIAG_CHECK(versioned, NULL, "invalid versioned graph");
+
+    GraphSnapshot* snapshot = malloc(sizeof(GraphSnapshot));
+    if (!snapshot) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to take graph snapshot", -1, -1);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&versioned->lock);
+    snapshot->graph = *versioned->graph;
+    snapshot->version = versioned->version++;
+    snapshot->owner = versioned;
+    snapshot->older = versioned->newest;
+    snapshot->newer = NULL;
+    if (versioned->newest) versioned->newest->newer = snapshot;
+    else versioned->oldest = snapshot;
+    versioned->newest = snapshot;
+    versioned->live_snapshots++;
+    pthread_mutex_unlock(&versioned->lock);
+
+    return snapshot;
+}
+
+const Graph* graph_snapshot_graph(const GraphSnapshot* snapshot) {
+    return snapshot ? &snapshot->graph : NULL;
+}
+
+uint64_t graph_snapshot_version(const GraphSnapshot* snapshot) {
+    return snapshot ? snapshot->version : 0;
+}
+
+void graph_snapshot_release(GraphSnapshot* snapshot) {
+    if (!snapshot) return;
+    VersionedGraph* versioned = snapshot->owner;
+
+    pthread_mutex_lock(&versioned->lock);
+    if (snapshot->older) snapshot->older->newer = snapshot->newer;
+    else versioned->oldest = snapshot->newer;
+    if (snapshot->newer) snapshot->newer->older = snapshot->older;
+    else versioned->newest = snapshot->older;
+    versioned->live_snapshots--;
+
+    // Blocks retired at version r are seen only by snapshots older than r
+    size_t reclaimable = 0;
+    while (reclaimable < versioned->retired_count
+        && (!versioned->oldest || versioned->retired[reclaimable].version <= versioned->oldest->version)) {
+        reclaimable++;
+    }
+
+    // Hand the reclaimable prefix over so the writer is not blocked while it is freed
+    RetiredBlock* reclaimed = NULL;
+    if (reclaimable == versioned->retired_count) {
+        reclaimed = versioned->retired;
+        versioned->retired = NULL;
+        versioned->retired_count = versioned->retired_capacity = 0;
+    } else if (reclaimable) {
+        reclaimed = malloc(reclaimable * sizeof(RetiredBlock));
+        if (reclaimed) memcpy(reclaimed, versioned->retired, reclaimable * sizeof(RetiredBlock));
+        else for (size_t i = 0; i < reclaimable; i++) free(versioned->retired[i].block);
+        versioned->retired_count -= reclaimable;
+        memmove(versioned->retired, versioned->retired + reclaimable, versioned->retired_count * sizeof(RetiredBlock));
+    }
+
+    bool release = versioned->closed && versioned->live_snapshots == 0;
+    pthread_mutex_unlock(&versioned->lock);
+
+    if (reclaimed) {
+        for (size_t i = 0; i < reclaimable; i++) free(reclaimed[i].block);
+        free(reclaimed);
+    }
+    free(snapshot);
+    if (release) versioned_graph_free(versioned);
+}
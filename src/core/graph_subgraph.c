@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "core/graph_subgraph.h"
+#include "utils/general_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+
+#define BITMAP_BITS_PER_ID 64       // use a bitmap while the ID range is at most this many bits per ID
+#define BITMAP_MIN_BITS (1u << 16)
+
+typedef struct {
+    int id;
+    bool used;
+} IdSlot;
+
+// * Membership set: bitmap over [base, base + span) or open addressing fallback
+typedef struct {
+    uint64_t* bits;
+    int base;
+    size_t span;
+    IdSlot* slots;
+    size_t capacity;    // power of two
+} IdSet;
+
+struct GraphView {
+    const Graph* graph;
+    bool induced;
+    int* ids;           // induced views: selected IDs in order
+    size_t node_count;
+    IdSet members;
+    EdgePredicate predicate;
+    void* ctx;
+};
+
+// ---------------------------------------------------------------------------
+// Membership set
+// ---------------------------------------------------------------------------
+
+static Status id_set_init(IdSet* set, const int* ids, size_t n) {
+    memset(set, 0, sizeof(*set));
+    if (n == 0) return STATUS_SUCCESS;
+
+    int low = ids[0], high = ids[0];
+    for (size_t i = 1; i < n; i++) {
+        if (ids[i] < low) low = ids[i];
+        if (ids[i] > high) high = ids[i];
+    }
+
+    size_t span = (size_t)((int64_t)high - (int64_t)low + 1);
+    if (span <= n * BITMAP_BITS_PER_ID || span <= BITMAP_MIN_BITS) {
+        set->bits = calloc((span + 63) / 64, sizeof(uint64_t));
+        set->base = low;
+        set->span = span;
+        return set->bits ? STATUS_SUCCESS : STATUS_OOM;
+    }
+
+    set->capacity = 16;
+    while (set->capacity < 2 * n) set->capacity *= 2;
+    set->slots = calloc(set->capacity, sizeof(IdSlot));
+    return set->slots ? STATUS_SUCCESS : STATUS_OOM;
+}
+
+static void id_set_free(IdSet* set) {
+    free(set->bits);
+    free(set->slots);
+}
+
+static bool id_set_contains(const IdSet* set, int id) {
+    if (set->bits) {
+        size_t offset = (size_t)((int64_t)id - (int64_t)set->base);
+        if (id < set->base || offset >= set->span) return false;
+        return (set->bits[offset / 64] >> (offset % 64)) & 1;
+    }
+    if (!set->slots) return false;
+
+    size_t slot = hash(id, (int)set->capacity);
+    while (set->slots[slot].used) {
+        if (set->slots[slot].id == id) return true;
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    return false;
+}
+
+// Helper: add an ID, false if it was already present
+static bool id_set_add(IdSet* set, int id) {
+    if (set->bits) {
+        size_t offset = (size_t)((int64_t)id - (int64_t)set->base);
+        uint64_t mask = 1ULL << (offset % 64);
+        if (set->bits[offset / 64] & mask) return false;
+        set->bits[offset / 64] |= mask;
+        return true;
+    }
+
+    size_t slot = hash(id, (int)set->capacity);
+    while (set->slots[slot].used) {
+        if (set->slots[slot].id == id) return false;
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    set->slots[slot].used = true;
+    set->slots[slot].id = id;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Views
+// ---------------------------------------------------------------------------
+
+GraphView* graph_view_induced(const Graph* graph, const int* ids, size_t n) {
+    DIAG_CHECK(graph, NULL, "invalid graph");
+    DIAG_CHECK(ids || n == 0, NULL, "invalid node id list");
+
+    GraphView* view = calloc(1, sizeof(GraphView));
+    if (view) view->ids = malloc((n ? n : 1) * sizeof(int));
+    if (!view || !view->ids || id_set_init(&view->members, ids, n) != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize graph view", -1, -1);
+        graph_view_destroy(view);
+        return NULL;
+    }
+
+    view->graph = graph;
+    view->induced = true;
+
+    size_t missing = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!find_node(graph, ids[i])) {
+            missing++;
+            continue;
+        }
+        if (id_set_add(&view->members, ids[i])) view->ids[view->node_count++] = ids[i];
+    }
+    if (missing) DIAG(DIAG_WARNING, ERR_NOT_FOUND, "subgraph ids not in graph were skipped", (int)missing, -1);
+
+    return view;
+}
+
+GraphView* graph_view_filtered(const Graph* graph, EdgePredicate predicate, void* ctx) {
+    DIAG_CHECK(graph, NULL, "invalid graph");
+    DIAG_CHECK(predicate, NULL, "invalid edge predicate");
+
+    GraphView* view = calloc(1, sizeof(GraphView));
+    if (!view) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize graph view", -1, -1);
+        return NULL;
+    }
+
+    view->graph = graph;
+    view->node_count = graph->node_count;
+    view->predicate = predicate;
+    view->ctx = ctx;
+    return view;
+}
+
+void graph_view_destroy(GraphView* view) {
+    if (!view) return;
+    free(view->ids);
+    id_set_free(&view->members);
+    free(view);
+}
+
+size_t graph_view_node_count(const GraphView* view) {
+    return view ? view->node_count : 0;
+}
+
+int graph_view_node_id(const GraphView* view, size_t index) {
+    if (!view || index >= view->node_count) return -1;
+    return view->induced ? view->ids[index] : view->graph->node_ids[index];
+}
+
+bool graph_view_has_node(const GraphView* view, int node_id) {
+    if (!view) return false;
+    if (view->induced) return id_set_contains(&view->members, node_id);
+    return find_node(view->graph, node_id) != NULL;
+}
+
+static inline bool edge_visible(const GraphView* view, int from, const EdgeNode* edge) {
+    if (view->induced && !id_set_contains(&view->members, edge->node_id)) return false;
+    if (!view->predicate) return true;
+
+    if (view->graph->type == GRAPH_UNDIRECTED && edge->node_id < from) {
+        return view->predicate(edge->node_id, from, edge->weight, view->ctx);
+    }
+    return view->predicate(from, edge->node_id, edge->weight, view->ctx);
+}
+
+bool graph_view_neighbors(const GraphView* view, int node_id, GraphViewIter* iter) {
+    DIAG_CHECK(iter, false, "invalid view iterator");
+    iter->view = view;
+    iter->node = NULL;
+    iter->position = 0;
+
+    if (!view || (view->induced && !id_set_contains(&view->members, node_id))) return false;
+    iter->node = find_node(view->graph, node_id);
+    return iter->node != NULL;
+}
+
+const EdgeNode* graph_view_next(GraphViewIter* iter) {
+    if (!iter || !iter->node) return NULL;
+
+    while (iter->position < iter->node->neighbor_count) {
+        const EdgeNode* edge = &iter->node->neighbors[iter->position++];
+        if (edge_visible(iter->view, iter->node->id, edge)) return edge;
+    }
+    return NULL;
+}
+
+size_t graph_view_degree(const GraphView* view, int node_id) {
+    GraphViewIter iter;
+    size_t degree = 0;
+
+    if (!graph_view_neighbors(view, node_id, &iter)) return 0;
+    while (graph_view_next(&iter)) degree++;
+    return degree;
+}
+
+// ---------------------------------------------------------------------------
+// Materialization
+// ---------------------------------------------------------------------------
+
+Graph* graph_view_materialize(const GraphView* view) {
+    DIAG_CHECK(view, NULL, "invalid graph view");
+
+    Graph* out = graph_create(view->graph->type, 0);
+    if (!out) return NULL;
+
+    // Hash table sized once for the whole view
+    if (graph_reserve(out, view->node_count) != STATUS_SUCCESS) {
+        graph_destroy(out);
+        return NULL;
+    }
+
+    EdgeNode* scratch = NULL;
+    size_t scratch_capacity = 0;
+
+    for (size_t i = 0; i < view->node_count; i++) {
+        int node_id = graph_view_node_id(view, i);
+        const Node* source = find_node(view->graph, node_id);
+        if (!source) {
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node_id, -1);
+            break;
+        }
+
+        if (source->neighbor_count > scratch_capacity) {
+            EdgeNode* grown = realloc(scratch, source->neighbor_count * sizeof(EdgeNode));
+            if (!grown) {
+                DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to materialize graph view", node_id, -1);
+                break;
+            }
+            scratch = grown;
+            scratch_capacity = source->neighbor_count;
+        }
+
+        // Source neighbor lists hold no duplicates, kept edges are copied as is
+        size_t kept = 0;
+        for (size_t j = 0; j < source->neighbor_count; j++) {
+            if (edge_visible(view, node_id, &source->neighbors[j])) scratch[kept++] = source->neighbors[j];
+        }
+
+        Node* node = create_node(node_id, kept ? kept : 1);
+        if (!node) break;
+
+        memcpy(node->neighbors, scratch, kept * sizeof(EdgeNode));
+        node->neighbor_count = kept;
+
+        if (graph_attach_node(out, node) != STATUS_SUCCESS) {
+            if (!find_node(out, node_id)) {
+                free(node->neighbors);
+                free(node);
+            }
+            break;
+        }
+    }
+
+    free(scratch);
+    if (out->node_count != view->node_count) {
+        graph_destroy(out);
+        return NULL;
+    }
+    return out;
+}
+
+Graph* graph_induced_subgraph(const Graph* graph, const int* ids, size_t n) {
+    GraphView* view = graph_view_induced(graph, ids, n);
+    if (!view) return NULL;
+
+    Graph* out = graph_view_materialize(view);
+    graph_view_destroy(view);
+    return out;
+}
+
+Graph* graph_filter_edges(const Graph* graph, EdgePredicate predicate, void* ctx) {
+    GraphView* view = graph_view_filtered(graph, predicate, ctx);
+    if (!view) return NULL;
+
+    Graph* out = graph_view_materialize(view);
+    graph_view_destroy(view);
+    return out;
+}
@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "core/label_table.h"
+#include "utils/general_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/random_utils.h"
+
+#define ARENA_BLOCK_BYTES ((size_t)1 << 20)
+#define LARGE_LABEL_BYTES (ARENA_BLOCK_BYTES / 4)  // longer labels get a block of their own
+#define MIN_SLOTS 64
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    char data[];
+} ArenaBlock;
+
+// Arena record: a probe reads the slot, then this header and the text next to it
+typedef struct {
+    int32_t id;
+    uint32_t length;
+    uint32_t hash;
+    char text[];                // terminated
+} LabelRecord;
+
+// Open addressing slot, the hash tag skips most string compares
+typedef struct {
+    const LabelRecord* record;  // NULL = empty
+    uint32_t tag;
+} LabelSlot;
+
+struct LabelTable {
+    const LabelRecord** records;    // by ID
+    size_t count;
+    size_t capacity;
+
+    LabelSlot* slots;
+    size_t slot_capacity;       // power of two
+
+    ArenaBlock* blocks;
+    char* cursor;               // free space of the newest regular block
+    size_t remaining;
+    size_t max_length;
+};
+
+// Helper: 8 bytes at a time through the splitmix finalizer, gene symbols take one or two rounds
+static uint32_t label_hash(const char* label, size_t length) {
+    uint64_t h = (uint64_t)length;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, label, 8);
+        h = mix64(h ^ word);
+        label += 8;
+        length -= 8;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, label, length);
+    return (uint32_t)mix64(h ^ tail);
+}
+
+static size_t slots_for(size_t labels) {
+    size_t capacity = MIN_SLOTS;
+    while ((double)labels > (double)capacity * ALPHA) capacity *= 2;
+    return capacity;
+}
+
+LabelTable* label_table_create(size_t expected_labels) {
+    LabelTable* table = calloc(1, sizeof(LabelTable));
+    if (!table) return NULL;
+
+    table->capacity = expected_labels ? expected_labels : MIN_SLOTS;
+    table->slot_capacity = slots_for(expected_labels);
+    table->records = malloc(table->capacity * sizeof(LabelRecord*));
+    table->slots = calloc(table->slot_capacity, sizeof(LabelSlot));
+    if (!table->records || !table->slots) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate label table", (int)expected_labels, -1);
+        label_table_destroy(table);
+        return NULL;
+    }
+    return table;
+}
+
+void label_table_destroy(LabelTable* table) {
+    if (!table) return;
+    while (table->blocks) {
+        ArenaBlock* next = table->blocks->next;
+        free(table->blocks);
+        table->blocks = next;
+    }
+    free(table->records);
+    free(table->slots);
+    free(table);
+}
+
+// Helper: slot holding the label, or the empty slot where it belongs
+static size_t slot_probe(const LabelTable* table, const char* label, size_t length, uint32_t hash) {
+    size_t mask = table->slot_capacity - 1;
+    size_t slot = hash & mask;
+    for (;;) {
+        const LabelSlot* entry = &table->slots[slot];
+        if (!entry->record) return slot;
+        if (entry->tag == hash && entry->record->length == length && memcmp(entry->record->text, label, length) == 0) return slot;
+        slot = (slot + 1) & mask;
+    }
+}
+
+static bool slots_grow(LabelTable* table) {
+    size_t capacity = table->slot_capacity * 2;
+    LabelSlot* slots = calloc(capacity, sizeof(LabelSlot));
+    if (!slots) return false;
+
+    // Labels are distinct, so reinsertion only needs a free slot
+    for (size_t id = 0; id < table->count; id++) {
+        const LabelRecord* record = table->records[id];
+        size_t slot = record->hash & (capacity - 1);
+        while (slots[slot].record) slot = (slot + 1) & (capacity - 1);
+        slots[slot] = (LabelSlot){record, record->hash};
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->slot_capacity = capacity;
+    return true;
+}
+
+// Helper: arena record for the label, kept aligned for the next one
+static LabelRecord* arena_copy(LabelTable* table, const char* label, size_t length) {
+    size_t bytes = (sizeof(LabelRecord) + length + 1 + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+    LabelRecord* copy;
+
+    if (bytes > LARGE_LABEL_BYTES) {
+        // Linked behind the current block, which keeps its free space
+        ArenaBlock* block = malloc(sizeof(ArenaBlock) + bytes);
+        if (!block) return NULL;
+        if (table->blocks) {
+            block->next = table->blocks->next;
+            table->blocks->next = block;
+        } else {
+            block->next = NULL;
+            table->blocks = block;
+        }
+        copy = (LabelRecord*)block->data;
+    } else {
+        if (bytes > table->remaining) {
+            ArenaBlock* block = malloc(sizeof(ArenaBlock) + ARENA_BLOCK_BYTES);
+            if (!block) return NULL;
+            block->next = table->blocks;
+            table->blocks = block;
+            table->cursor = block->data;
+            table->remaining = ARENA_BLOCK_BYTES;
+        }
+        copy = (LabelRecord*)table->cursor;
+        table->cursor += bytes;
+        table->remaining -= bytes;
+    }
+
+    memcpy(copy->text, label, length);
+    copy->text[length] = '\0';
+    copy->length = (uint32_t)length;
+    return copy;
+}
+
+Status label_table_intern(LabelTable* table, const char* label, size_t length, int* id) {
+    DIAG_CHECK(table, STATUS_INVALID, "invalid label table");
+    DIAG_CHECK(label && id, STATUS_INVALID, "invalid label");
+
+    uint32_t hash = label_hash(label, length);
+    size_t slot = slot_probe(table, label, length, hash);
+    if (table->slots[slot].record) {
+        *id = table->slots[slot].record->id;
+        return STATUS_SUCCESS;
+    }
+
+    if (table->count == (size_t)INT_MAX || length > UINT32_MAX) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "label table is full", (int)table->count, -1);
+        return STATUS_INVALID;
+    }
+
+    if (table->count == table->capacity) {
+        size_t capacity = table->capacity * 2;
+        const LabelRecord** records = realloc(table->records, capacity * sizeof(LabelRecord*));
+        if (!records) return STATUS_OOM;
+        table->records = records;
+        table->capacity = capacity;
+    }
+    if ((double)(table->count + 1) > (double)table->slot_capacity * ALPHA) {
+        if (!slots_grow(table)) return STATUS_OOM;
+        slot = slot_probe(table, label, length, hash);
+    }
+
+    LabelRecord* record = arena_copy(table, label, length);
+    if (!record) return STATUS_OOM;
+
+    int new_id = (int)table->count++;
+    record->id = new_id;
+    record->hash = hash;
+    table->records[new_id] = record;
+    table->slots[slot] = (LabelSlot){record, hash};
+    if (length > table->max_length) table->max_length = length;
+
+    *id = new_id;
+    return STATUS_SUCCESS;
+}
+
+int label_table_find(const LabelTable* table, const char* label, size_t length) {
+    if (!table || !label) return -1;
+    const LabelRecord* record = table->slots[slot_probe(table, label, length, label_hash(label, length))].record;
+    return record ? record->id : -1;
+}
+
+const char* label_table_name(const LabelTable* table, int id, size_t* length) {
+    if (!table || id < 0 || (size_t)id >= table->count) return NULL;
+    if (length) *length = table->records[id]->length;
+    return table->records[id]->text;
+}
+
+size_t label_table_count(const LabelTable* table) {
+    return table ? table->count : 0;
+}
+
+size_t label_table_max_length(const LabelTable* table) {
+    return table ? table->max_length : 0;
+}
+
+Status label_table_save(const LabelTable* table, const char* path) {
+    DIAG_CHECK(table, STATUS_INVALID, "invalid label table");
+    DIAG_CHECK(path, STATUS_INVALID, "invalid file name");
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open label file", -1, -1);
+        return STATUS_ERROR;
+    }
+
+    Status status = STATUS_SUCCESS;
+    for (size_t id = 0; id < table->count && status == STATUS_SUCCESS; id++) {
+        const LabelRecord* entry = table->records[id];
+        if (memchr(entry->text, '\n', entry->length)) {
+            DIAG(DIAG_ERROR, ERR_INVALID_ARG, "label contains a line break", (int)id, -1);
+            status = STATUS_INVALID;
+        } else if (fwrite(entry->text, 1, entry->length, file) != entry->length || fputc('\n', file) == EOF) {
+            status = STATUS_ERROR;
+        }
+    }
+
+    if (fclose(file) != 0 && status == STATUS_SUCCESS) status = STATUS_ERROR;
+    if (status == STATUS_ERROR) DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write label file", -1, -1);
+    return status;
+}
+
+LabelTable* label_table_load(const char* path) {
+    DIAG_CHECK(path, NULL, "invalid file name");
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open label file", -1, -1);
+        return NULL;
+    }
+
+    LabelTable* table = label_table_create(0);
+    char* line = NULL;
+    size_t line_capacity = 0;
+    ssize_t length;
+    bool ok = table != NULL;
+
+    while (ok && (length = getline(&line, &line_capacity, file)) >= 0) {
+        if (length > 0 && line[length - 1] == '\n') length--;
+
+        // A repeated label would shift every later ID
+        int id;
+        size_t expected = table->count;
+        ok = label_table_intern(table, line, (size_t)length, &id) == STATUS_SUCCESS;
+        if (ok && (size_t)id != expected) {
+            DIAG(DIAG_ERROR, ERR_EXISTS, "duplicate label in label file", (int)expected, id);
+            ok = false;
+        }
+    }
+    ok = ok && !ferror(file);
+
+    free(line);
+    fclose(file);
+    if (!ok) {
+        label_table_destroy(table);
+        return NULL;
+    }
+    return table;
+}
@@ -0,0 +1,571 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "generators/graph_generators.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/format_utils.h"
+#include "utils/random_utils.h"
+#include "utils/thread_utils.h"
+
+#define CHUNK_EDGES (1u << 16)      // target edges per chunk, fixes the RNG stream layout
+#define CHUNKS_PER_THREAD 4         // chunks generated per thread before emitting a round
+#define BA_MAX_ATTEMPTS 8           // redraws before a self loop edge is dropped
+#define MAX_LINE_CHARS 24           // "-2147483648 -2147483648\n"
+
+static const char* model_names[] = {"rmat", "barabasi_albert", "erdos_renyi", "sbm"};
+
+typedef struct {
+    int from;
+    int to;
+} GenEdge;
+
+// * Per-slot output buffer, reused across rounds
+typedef struct {
+    GenEdge* edges;
+    size_t count;
+    size_t capacity;
+    char* text;
+    size_t text_length;
+    size_t text_capacity;
+    Status status;
+} GenChunk;
+
+typedef struct Generator Generator;
+typedef void (*ChunkFill)(const Generator* gen, size_t chunk, Rng* rng, GenChunk* out);
+
+struct Generator {
+    const GeneratorConfig* config;
+    GraphType type;
+    size_t node_count;
+    size_t chunk_count;
+    ChunkFill fill;
+
+    // Edge based models (R-MAT, Barabasi-Albert)
+    uint64_t total_edges;
+
+    // Row based models (Erdos-Renyi, SBM)
+    size_t rows_per_chunk;
+    size_t* block_starts;   // block_count + 1 entries
+    double* log_q;          // log(1 - p) per block pair
+
+    // Round state
+    GenChunk* slots;
+    size_t round_start;
+    bool format_text;
+};
+
+GeneratorConfig generator_config_default(GeneratorModel model) {
+    GeneratorConfig config;
+    memset(&config, 0, sizeof(config));
+
+    config.model = model;
+    config.seed = 1;
+    config.num_threads = 0;
+    config.allow_self_loops = false;
+    config.type = GRAPH_UNDIRECTED;
+
+    switch (model) {
+        case GEN_RMAT:
+            config.params.rmat.scale = 16;
+            config.params.rmat.edge_factor = 16;
+            config.params.rmat.a = 0.57;
+            config.params.rmat.b = 0.19;
+            config.params.rmat.c = 0.19;
+            config.params.rmat.scramble_ids = true;
+            break;
+        case GEN_BARABASI_ALBERT:
+            config.params.ba.node_count = 1u << 16;
+            config.params.ba.edges_per_node = 8;
+            break;
+        case GEN_ERDOS_RENYI:
+            config.params.er.node_count = 1u << 16;
+            config.params.er.p = 16.0 / (double)(1u << 16);
+            break;
+        case GEN_SBM:
+            // block layout has to be provided by the caller
+            break;
+    }
+
+    return config;
+}
+
+// Helper: append an edge to a chunk, records OOM in the chunk status
+static void chunk_push(GenChunk* chunk, int from, int to) {
+    if (chunk->count == chunk->capacity) {
+        size_t new_capacity = chunk->capacity ? chunk->capacity * 2 : CHUNK_EDGES;
+        GenEdge* grown = realloc(chunk->edges, new_capacity * sizeof(GenEdge));
+        if (!grown) {
+            chunk->status = STATUS_OOM;
+            return;
+        }
+        chunk->edges = grown;
+        chunk->capacity = new_capacity;
+    }
+
+    chunk->edges[chunk->count].from = from;
+    chunk->edges[chunk->count].to = to;
+    chunk->count++;
+}
+
+static void chunk_format(GenChunk* chunk) {
+    size_t needed = chunk->count * MAX_LINE_CHARS;
+    if (needed > chunk->text_capacity) {
+        char* grown = realloc(chunk->text, needed);
+        if (!grown) {
+            chunk->status = STATUS_OOM;
+            return;
+        }
+        chunk->text = grown;
+        chunk->text_capacity = needed;
+    }
+
+    char* cursor = chunk->text;
+    for (size_t i = 0; i < chunk->count; i++) {
+        cursor += format_int(cursor, chunk->edges[i].from);
+        *cursor++ = ' ';
+        cursor += format_int(cursor, chunk->edges[i].to);
+        *cursor++ = '\n';
+    }
+    chunk->text_length = (size_t)(cursor - chunk->text);
+}
+
+// ---------------------------------------------------------------------------
+// R-MAT
+// ---------------------------------------------------------------------------
+
+// Helper: bijection on [0, 2^scale), decorrelates degree from ID
+static uint64_t rmat_scramble(uint64_t x, int scale, uint64_t seed) {
+    uint64_t mask = (scale >= 64) ? ~0ULL : ((1ULL << scale) - 1);
+    int shift = (scale + 1) / 2;
+    uint64_t k1 = mix64(seed) | 1;
+    uint64_t k2 = mix64(seed ^ 0x5851F42D4C957F2DULL) | 1;
+
+    x = (x * k1) & mask;
+    x ^= x >> shift;
+    x = (x * k2) & mask;
+    x ^= x >> shift;
+    return x;
+}
+
+static void rmat_fill(const Generator* gen, size_t chunk, Rng* rng, GenChunk* out) {
+    const RmatParams* params = &gen->config->params.rmat;
+    uint64_t first = (uint64_t)chunk * CHUNK_EDGES;
+    uint64_t last = first + CHUNK_EDGES < gen->total_edges ? first + CHUNK_EDGES : gen->total_edges;
+
+    // 32-bit thresholds: every 64-bit draw decides two levels
+    const double scale32 = 4294967296.0;
+    uint64_t t_a = (uint64_t)(params->a * scale32);
+    uint64_t t_ab = (uint64_t)((params->a + params->b) * scale32);
+    uint64_t t_abc = (uint64_t)((params->a + params->b + params->c) * scale32);
+
+    for (uint64_t e = first; e < last; e++) {
+        uint64_t u = 0, v = 0;
+        uint64_t bits = 0;
+        for (int level = 0; level < params->scale; level++) {
+            if ((level & 1) == 0) bits = rng_next(rng);
+            uint64_t r = (level & 1) ? bits >> 32 : bits & 0xFFFFFFFFULL;
+
+            // Branchless quadrant pick: a -> (0,0), b -> (0,1), c -> (1,0), d -> (1,1)
+            uint64_t in_cd = r >= t_ab;
+            uint64_t in_bd = (uint64_t)(r >= t_a) ^ in_cd ^ (uint64_t)(r >= t_abc);
+            u = (u << 1) | in_cd;
+            v = (v << 1) | in_bd;
+        }
+
+        if (params->scramble_ids) {
+            u = rmat_scramble(u, params->scale, gen->config->seed);
+            v = rmat_scramble(v, params->scale, gen->config->seed);
+        }
+        if (u == v && !gen->config->allow_self_loops) continue;
+
+        chunk_push(out, (int)u, (int)v);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Barabasi-Albert (copy model)
+// * Edge e is stored at positions 2e (source) and 2e + 1 (target) of a virtual
+// * edge array. A target copies the value of a uniformly chosen earlier position,
+// * which is exactly degree proportional sampling. Choices come from a hash of the
+// * position, so every edge is resolved independently and in parallel.
+// ---------------------------------------------------------------------------
+
+static uint64_t ba_target(const Generator* gen, uint64_t edge) {
+    uint64_t per_node = gen->config->params.ba.edges_per_node;
+    uint64_t source = edge / per_node;
+
+    // The first node can only attach to itself
+    if (source == 0 && !gen->config->allow_self_loops) return UINT64_MAX;
+
+    uint64_t position = 2 * edge + 1;
+    for (uint64_t attempt = 0; attempt < BA_MAX_ATTEMPTS; attempt++) {
+        uint64_t pick = mix64(gen->config->seed ^ mix64(position * BA_MAX_ATTEMPTS + attempt)) % position;
+        uint64_t target = (pick & 1) ? ba_target(gen, pick >> 1) : (pick >> 1) / per_node;
+
+        if (target == UINT64_MAX) continue;
+        if (target != source || gen->config->allow_self_loops) return target;
+    }
+
+    return UINT64_MAX;
+}
+
+static void ba_fill(const Generator* gen, size_t chunk, Rng* rng, GenChunk* out) {
+    (void)rng;
+    uint64_t per_node = gen->config->params.ba.edges_per_node;
+    uint64_t first = (uint64_t)chunk * CHUNK_EDGES;
+    uint64_t last = first + CHUNK_EDGES < gen->total_edges ? first + CHUNK_EDGES : gen->total_edges;
+
+    for (uint64_t e = first; e < last; e++) {
+        uint64_t target = ba_target(gen, e);
+        if (target == UINT64_MAX) continue;
+        chunk_push(out, (int)(e / per_node), (int)target);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Erdos-Renyi and SBM (geometric skipping over each row)
+// ---------------------------------------------------------------------------
+
+// Helper: sample columns of [lo, hi) with probability 1 - exp(log_q)
+static void sample_row(Rng* rng, int row, size_t lo, size_t hi, double p, double log_q,
+                       bool allow_self_loops, GenChunk* out) {
+    if (p <= 0.0 || lo >= hi) return;
+
+    if (p >= 1.0) {
+        for (size_t v = lo; v < hi; v++) {
+            if ((int)v == row && !allow_self_loops) continue;
+            chunk_push(out, row, (int)v);
+        }
+        return;
+    }
+
+    size_t v = lo;
+    for (;;) {
+        double skip = floor(log(1.0 - rng_uniform(rng)) / log_q);
+        if (skip >= (double)(hi - v)) return;
+        v += (size_t)skip;
+
+        if ((int)v != row || allow_self_loops) chunk_push(out, row, (int)v);
+        v++;
+        if (v >= hi) return;
+    }
+}
+
+// Helper: column range of a row, undirected graphs only sample the upper triangle
+static size_t row_first_column(const Generator* gen, size_t row) {
+    if (gen->type == GRAPH_DIRECTED) return 0;
+    return gen->config->allow_self_loops ? row : row + 1;
+}
+
+static void er_fill(const Generator* gen, size_t chunk, Rng* rng, GenChunk* out) {
+    double p = gen->config->params.er.p;
+    size_t first = chunk * gen->rows_per_chunk;
+    size_t last = first + gen->rows_per_chunk < gen->node_count ? first + gen->rows_per_chunk : gen->node_count;
+
+    for (size_t row = first; row < last; row++) {
+        sample_row(rng, (int)row, row_first_column(gen, row), gen->node_count, p, gen->log_q[0],
+            gen->config->allow_self_loops, out);
+    }
+}
+
+static void sbm_fill(const Generator* gen, size_t chunk, Rng* rng, GenChunk* out) {
+    const SbmParams* params = &gen->config->params.sbm;
+    size_t first = chunk * gen->rows_per_chunk;
+    size_t last = first + gen->rows_per_chunk < gen->node_count ? first + gen->rows_per_chunk : gen->node_count;
+
+    size_t row_block = 0;
+    while (gen->block_starts[row_block + 1] <= first) row_block++;
+
+    for (size_t row = first; row < last; row++) {
+        while (gen->block_starts[row_block + 1] <= row) row_block++;
+        size_t lo = row_first_column(gen, row);
+
+        for (size_t b = 0; b < params->block_count; b++) {
+            size_t start = gen->block_starts[b] > lo ? gen->block_starts[b] : lo;
+            size_t end = gen->block_starts[b + 1];
+            size_t pair = row_block * params->block_count + b;
+            sample_row(rng, (int)row, start, end, params->probabilities[pair], gen->log_q[pair],
+                gen->config->allow_self_loops, out);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Driver
+// ---------------------------------------------------------------------------
+
+static Status validate_probability(double p) {
+    if (!(p >= 0.0 && p <= 1.0)) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "generator probability out of range [0, 1]", -1, -1);
+        return STATUS_INVALID;
+    }
+    return STATUS_SUCCESS;
+}
+
+// Helper: rows per chunk so a chunk holds about CHUNK_EDGES expected edges
+static size_t rows_for_degree(double expected_row_edges) {
+    if (expected_row_edges < 1.0) return CHUNK_EDGES;
+    double rows = (double)CHUNK_EDGES / expected_row_edges;
+    return rows < 1.0 ? 1 : (size_t)rows;
+}
+
+static Status generator_init(Generator* gen, const GeneratorConfig* config, GraphType type) {
+    memset(gen, 0, sizeof(*gen));
+    gen->config = config;
+    gen->type = type;
+
+    switch (config->model) {
+        case GEN_RMAT: {
+            const RmatParams* params = &config->params.rmat;
+            if (params->scale < 1 || params->scale > 30) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "R-MAT scale out of range [1, 30]", params->scale, -1);
+                return STATUS_INVALID;
+            }
+            double d = 1.0 - params->a - params->b - params->c;
+            if (validate_probability(params->a) != STATUS_SUCCESS
+                || validate_probability(params->b) != STATUS_SUCCESS
+                || validate_probability(params->c) != STATUS_SUCCESS
+                || d < -1e-9) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "R-MAT quadrant probabilities must sum to at most 1", -1, -1);
+                return STATUS_INVALID;
+            }
+            gen->node_count = (size_t)1 << params->scale;
+            gen->total_edges = (uint64_t)params->edge_factor * gen->node_count;
+            gen->chunk_count = (size_t)((gen->total_edges + CHUNK_EDGES - 1) / CHUNK_EDGES);
+            gen->fill = rmat_fill;
+            return STATUS_SUCCESS;
+        }
+        case GEN_BARABASI_ALBERT: {
+            const BarabasiAlbertParams* params = &config->params.ba;
+            if (params->node_count == 0 || params->node_count > INT_MAX || params->edges_per_node == 0) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid Barabasi-Albert parameters", -1, -1);
+                return STATUS_INVALID;
+            }
+            gen->node_count = params->node_count;
+            gen->total_edges = (uint64_t)params->node_count * params->edges_per_node;
+            gen->chunk_count = (size_t)((gen->total_edges + CHUNK_EDGES - 1) / CHUNK_EDGES);
+            gen->fill = ba_fill;
+            return STATUS_SUCCESS;
+        }
+        case GEN_ERDOS_RENYI: {
+            const ErdosRenyiParams* params = &config->params.er;
+            if (params->node_count == 0 || params->node_count > INT_MAX
+                || validate_probability(params->p) != STATUS_SUCCESS) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid Erdos-Renyi parameters", -1, -1);
+                return STATUS_INVALID;
+            }
+            gen->log_q = malloc(sizeof(double));
+            if (!gen->log_q) return STATUS_OOM;
+            gen->log_q[0] = log1p(-params->p);
+
+            double row_edges = params->p * (double)params->node_count;
+            if (type == GRAPH_UNDIRECTED) row_edges /= 2.0;
+            gen->node_count = params->node_count;
+            gen->rows_per_chunk = rows_for_degree(row_edges);
+            gen->chunk_count = (gen->node_count + gen->rows_per_chunk - 1) / gen->rows_per_chunk;
+            gen->fill = er_fill;
+            return STATUS_SUCCESS;
+        }
+        case GEN_SBM: {
+            const SbmParams* params = &config->params.sbm;
+            if (params->block_count == 0 || !params->block_sizes || !params->probabilities) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "stochastic block model needs block sizes and probabilities", -1, -1);
+                return STATUS_INVALID;
+            }
+
+            size_t pairs = params->block_count * params->block_count;
+            gen->block_starts = malloc((params->block_count + 1) * sizeof(size_t));
+            gen->log_q = malloc(pairs * sizeof(double));
+            if (!gen->block_starts || !gen->log_q) return STATUS_OOM;
+
+            gen->block_starts[0] = 0;
+            for (size_t b = 0; b < params->block_count; b++) {
+                gen->block_starts[b + 1] = gen->block_starts[b] + params->block_sizes[b];
+            }
+            gen->node_count = gen->block_starts[params->block_count];
+            if (gen->node_count == 0 || gen->node_count > INT_MAX) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "stochastic block model has invalid node count", -1, -1);
+                return STATUS_INVALID;
+            }
+
+            double expected_edges = 0.0;
+            for (size_t i = 0; i < params->block_count; i++) {
+                for (size_t j = 0; j < params->block_count; j++) {
+                    double p = params->probabilities[i * params->block_count + j];
+                    if (validate_probability(p) != STATUS_SUCCESS) return STATUS_INVALID;
+                    gen->log_q[i * params->block_count + j] = log1p(-p);
+                    expected_edges += p * (double)params->block_sizes[i] * (double)params->block_sizes[j];
+                }
+            }
+
+            double row_edges = expected_edges / (double)gen->node_count;
+            if (type == GRAPH_UNDIRECTED) row_edges /= 2.0;
+            gen->rows_per_chunk = rows_for_degree(row_edges);
+            gen->chunk_count = (gen->node_count + gen->rows_per_chunk - 1) / gen->rows_per_chunk;
+            gen->fill = sbm_fill;
+            return STATUS_SUCCESS;
+        }
+    }
+
+    DIAG(DIAG_ERROR, ERR_INVALID_ARG, "unknown generator model", (int)config->model, -1);
+    return STATUS_INVALID;
+}
+
+static void generator_free(Generator* gen, size_t slot_count) {
+    if (gen->slots) {
+        for (size_t i = 0; i < slot_count; i++) {
+            free(gen->slots[i].edges);
+            free(gen->slots[i].text);
+        }
+    }
+    free(gen->slots);
+    free(gen->block_starts);
+    free(gen->log_q);
+}
+
+static void generate_task(void* ctx, size_t task, int thread_id) {
+    (void)thread_id;
+    Generator* gen = ctx;
+    GenChunk* slot = &gen->slots[task];
+    size_t chunk = gen->round_start + task;
+
+    slot->count = 0;
+    slot->text_length = 0;
+    slot->status = STATUS_SUCCESS;
+
+    Rng rng;
+    rng_seed(&rng, gen->config->seed, chunk);
+    gen->fill(gen, chunk, &rng, slot);
+
+    if (gen->format_text && slot->status == STATUS_SUCCESS) chunk_format(slot);
+}
+
+// Emit callback, called serially for every chunk in chunk order
+typedef Status (*ChunkEmit)(void* sink, const GenChunk* chunk, size_t* emitted);
+
+static Status generator_run(Generator* gen, ChunkEmit emit, void* sink, size_t* edge_count) {
+    int threads = thread_count_resolve(gen->config->num_threads);
+    size_t slot_count = (size_t)threads * CHUNKS_PER_THREAD;
+    size_t emitted = 0;
+    Status status = STATUS_SUCCESS;
+
+    gen->slots = calloc(slot_count, sizeof(GenChunk));
+    if (!gen->slots) return STATUS_OOM;
+
+    for (gen->round_start = 0; gen->round_start < gen->chunk_count; gen->round_start += slot_count) {
+        size_t remaining = gen->chunk_count - gen->round_start;
+        size_t tasks = remaining < slot_count ? remaining : slot_count;
+
+        status = parallel_for(tasks, threads, generate_task, gen);
+        if (status != STATUS_SUCCESS) break;
+
+        for (size_t i = 0; i < tasks && status == STATUS_SUCCESS; i++) {
+            status = gen->slots[i].status;
+            if (status == STATUS_SUCCESS) status = emit(sink, &gen->slots[i], &emitted);
+        }
+        if (status != STATUS_SUCCESS) break;
+    }
+
+    if (edge_count) *edge_count = emitted;
+    generator_free(gen, slot_count);
+    return status;
+}
+
+static Status emit_to_graph(void* sink, const GenChunk* chunk, size_t* emitted) {
+    Graph* graph = sink;
+
+    for (size_t i = 0; i < chunk->count; i++) {
+        switch (graph_insert_edge(graph, chunk->edges[i].from, chunk->edges[i].to, 1.0)) {
+            case STATUS_SUCCESS:
+                (*emitted)++;
+                break;
+            case STATUS_WARNING:
+                // duplicate edge, graph left unmodified
+                break;
+            case STATUS_OOM:
+                return STATUS_OOM;
+            default:
+                return STATUS_ERROR;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+static Status emit_to_file(void* sink, const GenChunk* chunk, size_t* emitted) {
+    FILE* file = sink;
+
+    if (chunk->text_length && fwrite(chunk->text, 1, chunk->text_length, file) != chunk->text_length) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write generated edges", -1, -1);
+        return STATUS_ERROR;
+    }
+    *emitted += chunk->count;
+    return STATUS_SUCCESS;
+}
+
+Status generate_graph(Graph* graph, const GeneratorConfig* config, size_t* edge_count) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(config, STATUS_INVALID, "invalid generator config");
+
+    Generator gen;
+    Status status = generator_init(&gen, config, graph->type);
+    if (status != STATUS_SUCCESS) {
+        generator_free(&gen, 0);
+        return status;
+    }
+
+    // Size neighbor arrays for the expected average degree
+    size_t capacity = INITIAL_CAPACITY;
+    if (gen.total_edges) {
+        size_t average = (size_t)(2 * gen.total_edges / gen.node_count);
+        if (average > capacity) capacity = average;
+    }
+
+    for (size_t i = 0; i < gen.node_count; i++) {
+        status = graph_insert_node(graph, (int)i, capacity);
+        if (status != STATUS_SUCCESS && status != STATUS_WARNING) {
+            generator_free(&gen, 0);
+            return status;
+        }
+    }
+
+    gen.format_text = false;
+    return generator_run(&gen, emit_to_graph, graph, edge_count);
+}
+
+Status generate_edge_list(const char* filename, const GeneratorConfig* config, size_t* edge_count) {
+    DIAG_CHECK(filename, STATUS_INVALID, "invalid file name");
+    DIAG_CHECK(config, STATUS_INVALID, "invalid generator config");
+
+    Generator gen;
+    Status status = generator_init(&gen, config, config->type);
+    if (status != STATUS_SUCCESS) {
+        generator_free(&gen, 0);
+        return status;
+    }
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open edge list file", -1, -1);
+        generator_free(&gen, 0);
+        return STATUS_ERROR;
+    }
+
+    fprintf(file, "# model=%s seed=%llu nodes=%zu type=%s\n", model_names[config->model],
+        (unsigned long long)config->seed, gen.node_count,
+        config->type == GRAPH_DIRECTED ? "directed" : "undirected");
+
+    gen.format_text = true;
+    status = generator_run(&gen, emit_to_file, file, edge_count);
+
+    if (fclose(file) != 0 && status == STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write edge list file", -1, -1);
+        status = STATUS_ERROR;
+    }
+    return status;
+}
@@ -0,0 +1,460 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "generators/random_walks.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/format_utils.h"
+#include "utils/random_utils.h"
+#include "utils/thread_utils.h"
+
+#define CHUNK_WALKS 1024            // walks per chunk, fixes the RNG stream layout
+#define CHUNKS_PER_THREAD 4         // chunks walked per thread before emitting a round
+#define WALK_LANES 16               // walks stepped together within a chunk
+#define ALIAS_TASK_NODES 4096       // nodes per alias table build task
+
+typedef struct {
+    size_t first_walk;
+    size_t count;
+    int* nodes;                 // CHUNK_WALKS x walk_length
+    uint32_t* lengths;
+    char* text;
+    size_t text_length;
+    size_t text_capacity;
+    Status status;
+} WalkChunk;
+
+// Per-thread scratch for Vose's alias method, grown to the largest degree seen
+typedef struct {
+    double* scaled;
+    uint32_t* stack;
+    size_t capacity;
+    Status status;
+} AliasWorkspace;
+
+typedef struct {
+    const GraphCsr* csr;
+    const WalkConfig* config;
+    const uint32_t* starts;     // dense indices
+    size_t start_count;
+    size_t walk_total;
+    size_t chunk_count;
+    size_t round_start;
+
+    // Alias tables parallel to csr->targets, NULL when every out-edge is equally likely.
+    // float halves the table size, its rounding is far below sampling noise.
+    float* probability;
+    uint32_t* alias;            // position within the node's neighbor list
+    AliasWorkspace* workspaces;
+
+    bool second_order;
+    double inverse_p;
+    double inverse_q;
+    double max_alpha;
+
+    WalkChunk* slots;
+    bool format_text;
+} WalkEngine;
+
+WalkConfig walk_config_default(void) {
+    WalkConfig config;
+    config.mode = WALK_UNIFORM;
+    config.walk_length = 80;
+    config.walks_per_node = 10;
+    config.p = 1.0;
+    config.q = 1.0;
+    config.seed = 1;
+    config.num_threads = 0;
+    config.start_nodes = NULL;
+    config.start_count = 0;
+    return config;
+}
+
+// ---------------------------------------------------------------------------
+// Alias tables
+// ---------------------------------------------------------------------------
+
+static void alias_build_node(WalkEngine* engine, AliasWorkspace* ws, uint32_t node) {
+    const GraphCsr* csr = engine->csr;
+    size_t begin = csr->offsets[node];
+    size_t degree = graph_csr_degree(csr, node);
+    if (degree == 0) return;
+
+    if (degree > ws->capacity) {
+        double* scaled = realloc(ws->scaled, degree * sizeof(double));
+        if (scaled) ws->scaled = scaled;
+        uint32_t* stack = realloc(ws->stack, degree * sizeof(uint32_t));
+        if (stack) ws->stack = stack;
+        if (!scaled || !stack) {
+            ws->status = STATUS_OOM;
+            return;
+        }
+        ws->capacity = degree;
+    }
+
+    double total = 0.0;
+    for (size_t j = 0; j < degree; j++) {
+        double weight = csr->weights[begin + j];
+        if (!(weight > 0.0) || !isfinite(weight)) {
+            DIAG(DIAG_WARNING, ERR_INVALID_ARG, "walk weights must be finite and positive",
+                csr->ids[node], csr->ids[csr->targets[begin + j]]);
+            ws->status = STATUS_INVALID;
+            return;
+        }
+        total += weight;
+    }
+
+    // Small entries fill the stack from the front, large ones from the back
+    size_t small = 0, large = degree;
+    for (size_t j = 0; j < degree; j++) {
+        ws->scaled[j] = csr->weights[begin + j] * (double)degree / total;
+        if (ws->scaled[j] < 1.0) ws->stack[small++] = (uint32_t)j;
+        else ws->stack[--large] = (uint32_t)j;
+    }
+
+    while (small > 0 && large < degree) {
+        uint32_t light = ws->stack[--small];
+        uint32_t heavy = ws->stack[large++];
+        engine->probability[begin + light] = (float)ws->scaled[light];
+        engine->alias[begin + light] = heavy;
+
+        ws->scaled[heavy] = (ws->scaled[heavy] + ws->scaled[light]) - 1.0;
+        if (ws->scaled[heavy] < 1.0) ws->stack[small++] = heavy;
+        else ws->stack[--large] = heavy;
+    }
+
+    // Leftovers are 1 up to rounding
+    while (large < degree) {
+        uint32_t j = ws->stack[large++];
+        engine->probability[begin + j] = 1.0f;
+        engine->alias[begin + j] = j;
+    }
+    while (small > 0) {
+        uint32_t j = ws->stack[--small];
+        engine->probability[begin + j] = 1.0f;
+        engine->alias[begin + j] = j;
+    }
+}
+
+static void alias_task(void* ctx, size_t task, int thread_id) {
+    WalkEngine* engine = ctx;
+    AliasWorkspace* ws = &engine->workspaces[thread_id];
+    size_t begin = task * ALIAS_TASK_NODES;
+    size_t end = begin + ALIAS_TASK_NODES < engine->csr->node_count ? begin + ALIAS_TASK_NODES : engine->csr->node_count;
+
+    for (size_t v = begin; v < end && ws->status == STATUS_SUCCESS; v++) alias_build_node(engine, ws, (uint32_t)v);
+}
+
+// Helper: alias tables for weighted proposals, skipped when all weights are equal
+static Status alias_build(WalkEngine* engine, int threads) {
+    const GraphCsr* csr = engine->csr;
+
+    bool uniform = true;
+    for (size_t a = 1; a < csr->arc_count && uniform; a++) uniform = csr->weights[a] == csr->weights[0];
+    if (uniform) {
+        if (csr->arc_count && (!(csr->weights[0] > 0.0) || !isfinite(csr->weights[0]))) {
+            DIAG(DIAG_WARNING, ERR_INVALID_ARG, "walk weights must be finite and positive", -1, -1);
+            return STATUS_INVALID;
+        }
+        return STATUS_SUCCESS;
+    }
+
+    engine->probability = malloc(csr->arc_count * sizeof(float));
+    engine->alias = malloc(csr->arc_count * sizeof(uint32_t));
+    engine->workspaces = calloc((size_t)threads, sizeof(AliasWorkspace));
+    if (!engine->probability || !engine->alias || !engine->workspaces) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate alias tables", (int)csr->arc_count, -1);
+        free(engine->workspaces);       // probability and alias go with the engine
+        engine->workspaces = NULL;
+        return STATUS_OOM;
+    }
+
+    size_t task_count = (csr->node_count + ALIAS_TASK_NODES - 1) / ALIAS_TASK_NODES;
+    Status status = parallel_for(task_count, threads, alias_task, engine);
+
+    for (int t = 0; t < threads; t++) {
+        if (status == STATUS_SUCCESS) status = engine->workspaces[t].status;
+        free(engine->workspaces[t].scaled);
+        free(engine->workspaces[t].stack);
+    }
+    free(engine->workspaces);
+    engine->workspaces = NULL;
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Walks
+// ---------------------------------------------------------------------------
+
+// Helper: neighbor list position drawn from the first-order distribution
+static inline size_t draw_position(const WalkEngine* engine, Rng* rng, size_t begin, size_t degree) {
+    size_t position = (size_t)rng_bounded(rng, degree);
+    if (engine->probability && rng_uniform(rng) >= engine->probability[begin + position]) {
+        position = engine->alias[begin + position];
+    }
+    return position;
+}
+
+static bool has_arc(const GraphCsr* csr, uint32_t from, uint32_t to) {
+    size_t low = csr->offsets[from], high = csr->offsets[from + 1];
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (csr->targets[middle] < to) low = middle + 1;
+        else high = middle;
+    }
+    return low < csr->offsets[from + 1] && csr->targets[low] == to;
+}
+
+static uint32_t walk_step(const WalkEngine* engine, Rng* rng, uint32_t previous, uint32_t current) {
+    const GraphCsr* csr = engine->csr;
+    size_t begin = csr->offsets[current];
+    size_t degree = graph_csr_degree(csr, current);
+
+    if (!engine->second_order || previous == CSR_NO_INDEX) return csr->targets[begin + draw_position(engine, rng, begin, degree)];
+
+    // Rejection sampling against the first-order proposal
+    for (;;) {
+        uint32_t next = csr->targets[begin + draw_position(engine, rng, begin, degree)];
+        double alpha = next == previous ? engine->inverse_p
+            : engine->inverse_q == 1.0 || has_arc(csr, previous, next) ? 1.0 : engine->inverse_q;
+        if (alpha >= engine->max_alpha || rng_uniform(rng) * engine->max_alpha < alpha) return next;
+    }
+}
+
+static void chunk_format(WalkChunk* chunk, size_t stride) {
+    size_t needed = chunk->count * stride * (FORMAT_INT_CHARS + 1);
+    if (needed > chunk->text_capacity) {
+        char* grown = realloc(chunk->text, needed);
+        if (!grown) {
+            chunk->status = STATUS_OOM;
+            return;
+        }
+        chunk->text = grown;
+        chunk->text_capacity = needed;
+    }
+
+    char* cursor = chunk->text;
+    for (size_t i = 0; i < chunk->count; i++) {
+        const int* walk = chunk->nodes + i * stride;
+        for (uint32_t j = 0; j < chunk->lengths[i]; j++) {
+            cursor += format_int(cursor, walk[j]);
+            *cursor++ = ' ';
+        }
+        cursor[-1] = '\n';
+    }
+    chunk->text_length = (size_t)(cursor - chunk->text);
+}
+
+static void walk_task(void* ctx, size_t task, int thread_id) {
+    (void)thread_id;
+    WalkEngine* engine = ctx;
+    const GraphCsr* csr = engine->csr;
+    WalkChunk* slot = &engine->slots[task];
+    size_t chunk = engine->round_start + task;
+    size_t stride = engine->config->walk_length;
+
+    slot->first_walk = chunk * CHUNK_WALKS;
+    slot->count = engine->walk_total - slot->first_walk < CHUNK_WALKS ? engine->walk_total - slot->first_walk : CHUNK_WALKS;
+    slot->status = STATUS_SUCCESS;
+
+    Rng rng;
+    rng_seed(&rng, engine->config->seed, chunk);
+
+    // Walks advance in lockstep groups, so the cache misses of independent walks overlap
+    for (size_t group = 0; group < slot->count; group += WALK_LANES) {
+        size_t lanes = slot->count - group < WALK_LANES ? slot->count - group : WALK_LANES;
+        uint32_t previous[WALK_LANES], current[WALK_LANES];
+        uint32_t* lengths = slot->lengths + group;
+        int* walks = slot->nodes + group * stride;
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            previous[lane] = CSR_NO_INDEX;
+            current[lane] = engine->starts[(slot->first_walk + group + lane) % engine->start_count];
+            walks[lane * stride] = csr->ids[current[lane]];
+            lengths[lane] = 1;
+        }
+
+        bool moved = true;
+        for (size_t length = 1; length < stride && moved; length++) {
+            moved = false;
+            for (size_t lane = 0; lane < lanes; lane++) {
+                if (lengths[lane] != length || graph_csr_degree(csr, current[lane]) == 0) continue;
+
+                uint32_t next = walk_step(engine, &rng, previous[lane], current[lane]);
+                walks[lane * stride + length] = csr->ids[next];
+                lengths[lane]++;
+                previous[lane] = current[lane];
+                current[lane] = next;
+                moved = true;
+            }
+        }
+    }
+
+    if (engine->format_text) chunk_format(slot, stride);
+}
+
+// Emit callback, called serially for every chunk in chunk order
+typedef Status (*ChunkEmit)(void* sink, const WalkEngine* engine, const WalkChunk* chunk);
+
+static Status walks_run(WalkEngine* engine, int threads, ChunkEmit emit, void* sink, size_t* walk_count) {
+    size_t slot_count = (size_t)threads * CHUNKS_PER_THREAD;
+    size_t stride = engine->config->walk_length;
+    size_t emitted = 0;
+    Status status = STATUS_SUCCESS;
+
+    engine->slots = calloc(slot_count, sizeof(WalkChunk));
+    if (!engine->slots) status = STATUS_OOM;
+    for (size_t i = 0; i < slot_count && status == STATUS_SUCCESS; i++) {
+        engine->slots[i].nodes = malloc(CHUNK_WALKS * stride * sizeof(int));
+        engine->slots[i].lengths = malloc(CHUNK_WALKS * sizeof(uint32_t));
+        if (!engine->slots[i].nodes || !engine->slots[i].lengths) status = STATUS_OOM;
+    }
+    if (status != STATUS_SUCCESS) DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate walk buffers", (int)slot_count, -1);
+
+    for (engine->round_start = 0; status == STATUS_SUCCESS && engine->round_start < engine->chunk_count;
+        engine->round_start += slot_count) {
+        size_t remaining = engine->chunk_count - engine->round_start;
+        size_t tasks = remaining < slot_count ? remaining : slot_count;
+
+        status = parallel_for(tasks, threads, walk_task, engine);
+        for (size_t i = 0; i < tasks && status == STATUS_SUCCESS; i++) {
+            status = engine->slots[i].status;
+            if (status == STATUS_SUCCESS) status = emit(sink, engine, &engine->slots[i]);
+            if (status == STATUS_SUCCESS) emitted += engine->slots[i].count;
+        }
+    }
+
+    for (size_t i = 0; engine->slots && i < slot_count; i++) {
+        free(engine->slots[i].nodes);
+        free(engine->slots[i].lengths);
+        free(engine->slots[i].text);
+    }
+    free(engine->slots);
+    engine->slots = NULL;
+
+    if (walk_count) *walk_count = emitted;
+    return status;
+}
+
+// Helper: dense start indices, every node when config has no start nodes
+static Status resolve_starts(const GraphCsr* csr, const WalkConfig* config, uint32_t** starts, size_t* count) {
+    *count = config->start_nodes ? config->start_count : csr->node_count;
+    *starts = malloc((*count ? *count : 1) * sizeof(uint32_t));
+    if (!*starts) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate walk start nodes", (int)*count, -1);
+        return STATUS_OOM;
+    }
+
+    for (size_t i = 0; i < *count; i++) {
+        uint32_t index = config->start_nodes ? graph_csr_index(csr, config->start_nodes[i]) : (uint32_t)i;
+        if (index == CSR_NO_INDEX) {
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", config->start_nodes[i], -1);
+            return STATUS_WARNING;
+        }
+        (*starts)[i] = index;
+    }
+    return STATUS_SUCCESS;
+}
+
+static Status walks_generate(const Graph* graph, const WalkConfig* config, bool format_text,
+    ChunkEmit emit, void* sink, size_t* walk_count) {
+    if (walk_count) *walk_count = 0;
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+
+    WalkConfig defaults = walk_config_default();
+    if (!config) config = &defaults;
+    if (config->walk_length == 0 || config->walk_length > UINT32_MAX
+        || (config->start_nodes == NULL && config->start_count != 0)
+        || (config->mode == WALK_NODE2VEC && (!(config->p > 0.0) || !(config->q > 0.0)))) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid walk config", (int)config->mode, -1);
+        return STATUS_INVALID;
+    }
+
+    bool weighted = config->mode != WALK_UNIFORM;
+    GraphCsr csr;
+    int threads = thread_count_resolve(config->num_threads);
+    Status status = graph_csr_build(graph, &csr, weighted, threads);
+    if (status != STATUS_SUCCESS) return status;
+
+    WalkEngine engine;
+    memset(&engine, 0, sizeof(engine));
+    engine.csr = &csr;
+    engine.config = config;
+    engine.format_text = format_text;
+    engine.inverse_p = 1.0 / config->p;
+    engine.inverse_q = 1.0 / config->q;
+    engine.max_alpha = fmax(1.0, fmax(engine.inverse_p, engine.inverse_q));
+    engine.second_order = config->mode == WALK_NODE2VEC && (config->p != 1.0 || config->q != 1.0);
+
+    uint32_t* starts = NULL;
+    status = resolve_starts(&csr, config, &starts, &engine.start_count);
+    engine.starts = starts;
+
+    if (status == STATUS_SUCCESS && engine.start_count
+        && config->walks_per_node > SIZE_MAX / CHUNK_WALKS / engine.start_count) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "too many walks", (int)config->walks_per_node, (int)engine.start_count);
+        status = STATUS_INVALID;
+    }
+    if (status == STATUS_SUCCESS && weighted) status = alias_build(&engine, threads);
+
+    if (status == STATUS_SUCCESS) {
+        engine.walk_total = config->walks_per_node * engine.start_count;
+        engine.chunk_count = (engine.walk_total + CHUNK_WALKS - 1) / CHUNK_WALKS;
+        status = walks_run(&engine, threads, emit, sink, walk_count);
+    }
+
+    free(starts);
+    free(engine.probability);
+    free(engine.alias);
+    graph_csr_free(&csr);
+    return status;
+}
+
+typedef struct {
+    WalkSink sink;
+    void* ctx;
+} SinkAdapter;
+
+static Status emit_to_sink(void* sink, const WalkEngine* engine, const WalkChunk* chunk) {
+    SinkAdapter* adapter = sink;
+    WalkBlock block = {chunk->first_walk, chunk->count, engine->config->walk_length, chunk->nodes, chunk->lengths};
+    return adapter->sink(adapter->ctx, &block);
+}
+
+static Status emit_to_file(void* sink, const WalkEngine* engine, const WalkChunk* chunk) {
+    (void)engine;
+    FILE* file = sink;
+
+    if (chunk->text_length && fwrite(chunk->text, 1, chunk->text_length, file) != chunk->text_length) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write walks", -1, -1);
+        return STATUS_ERROR;
+    }
+    return STATUS_SUCCESS;
+}
+
+Status graph_random_walks(const Graph* graph, const WalkConfig* config, WalkSink sink, void* ctx, size_t* walk_count) {
+    DIAG_CHECK(sink, STATUS_INVALID, "invalid walk sink");
+
+    SinkAdapter adapter = {sink, ctx};
+    return walks_generate(graph, config, false, emit_to_sink, &adapter, walk_count);
+}
+
+Status graph_random_walks_to_file(const Graph* graph, const WalkConfig* config, const char* filename, size_t* walk_count) {
+    DIAG_CHECK(filename, STATUS_INVALID, "invalid file name");
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open walk file", -1, -1);
+        return STATUS_ERROR;
+    }
+
+    Status status = walks_generate(graph, config, true, emit_to_file, file, walk_count);
+    if (fclose(file) != 0 && status == STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write walk file", -1, -1);
+        status = STATUS_ERROR;
+    }
+    return status;
+}
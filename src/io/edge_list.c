@@ -1,21 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 #include "core/graph_build.h"
 #include "core/graph_operations.h"
+#include "io/edge_list.h"
 #include "utils/general_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
 
 // TODO: change bool to -1, 0, 1
 
-int main(int argc, char *argv[]) {
-    char input[100];
-
-    get_input(argc, argv, input, sizeof(input));
-
-    printf("Final input: %s\n", input);
-
-    return 0;
-}
-
 // Helper: strip leading/trailing whitespaces
 static void strip(char *str) {
     char *start = str;
@@ -56,35 +51,34 @@ void get_file_name(int argc, char *argv[], char* buffer, size_t size) {
     }
 }
 
-static Status addNode(Graph* graph, int node_id, size_t node_capacity) {
+// Helper: insert node if missing, returns number of warnings raised
+static int addNode(Graph* graph, int node_id, size_t node_capacity) {
     if (!find_node(graph, node_id)) {
         switch (graph_insert_node(graph, node_id, node_capacity)) {
             case STATUS_SUCCESS:
             case STATUS_WARNING:
                 return 0;
-            case STATUS_ERROR:
+            default:
                 return 1;
-
         }
-        bool success = graph_insert_node(graph, node_id, node_capacity);
-        if (!success) return 1;
     }
 
     return 0;
 }
 
-static Status addEdge(Graph* graph, int source, int target, double weight) {
-    bool success = graph_insert_edge(graph, source, target, weight);
-    if (!success) return 1;
+// Helper: insert edge, returns number of warnings raised
+static int addEdge(Graph* graph, int source, int target, double weight) {
+    if (graph_insert_edge(graph, source, target, weight) != STATUS_SUCCESS) return 1;
 
     return 0;
 }
 int load_graph(const char* filename, Graph* graph) {
-    CHECK_EXISTS(graph, -1, "%s", "Graph not initialized");
+    DIAG_CHECK(graph, -1, "graph not initialized");
+    DIAG_CHECK(filename, -1, "invalid file name");
 
     FILE *file = fopen(filename, "r");  // "r" for read, "w" for write, "a" for append
     if (file == NULL) {
-        fprintf(stderr, "ERROR: Failed to open file %s\n", filename);
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open edge list file", -1, -1);
         return -1;
     }
 
@@ -106,36 +100,120 @@ int load_graph(const char* filename, Graph* graph) {
         int parsed = sscanf(line, "%d %d %lf", &source, &target, &weight);
 
         if (parsed < 2) {
-            printf("Warning: Invalid line %d: '%s'\n", line_number, line);
+            DIAG(DIAG_WARNING, ERR_INVALID_ARG, "invalid edge list line", line_number, -1);
             warnings += 1;
             continue;
         }
         
-        int source = addNode(graph, source, 16);
-        int success2 = addNode(graph, target, 16);
+        int failed = addNode(graph, source, 16);
+        failed += addNode(graph, target, 16);
 
-        if (success1 && success2) {
+        if (!failed) {
             warnings += addEdge(graph, source, target, weight);
+        } else {
+            warnings += failed;
         }
-        
-        
-        #ifdef DEBUG
-        printf("Added edge %d->%d with weight %lf\n", source, target, weight);
-        #endif
     }
     
     fclose(file);
     
     if (!warnings){
-        printf("Successfully loaded graph from %s\n", filename);
+        DIAG(DIAG_INFO, ERR_NONE, "graph loaded", line_number, -1);
     } else {
-        if (warnings)
-        fprintf(stderr, "WARNING: Graph loaded incompletely from %s.\n", filename);
+        DIAG(DIAG_WARNING, ERR_NONE, "graph loaded incompletely", line_number, warnings);
     }
     return warnings;
 }
 
 
+// Helper: next whitespace separated field, NULL when the line ends
+static const char* next_field(const char** cursor, size_t* length) {
+    const char* start = *cursor;
+    while (*start && isspace((unsigned char)*start)) start++;
+    if (!*start) return NULL;
+
+    const char* end = start;
+    while (*end && !isspace((unsigned char)*end)) end++;
+    *cursor = end;
+    *length = (size_t)(end - start);
+    return start;
+}
+
+Status parse_labeled_edge(const char* line, LabelTable* labels, int* source, int* target, double* weight) {
+    const char* cursor = line;
+    size_t from_length, to_length, weight_length;
+    const char* from = next_field(&cursor, &from_length);
+    const char* to = from ? next_field(&cursor, &to_length) : NULL;
+    if (!to) return STATUS_INVALID;
+
+    *weight = 1.0; // default weight is 1.0
+    const char* weight_text = next_field(&cursor, &weight_length);
+    if (weight_text) {
+        char* end;
+        *weight = strtod(weight_text, &end);
+        if (end != weight_text + weight_length) return STATUS_INVALID;
+    }
+
+    Status status = label_table_intern(labels, from, from_length, source);
+    if (status == STATUS_SUCCESS) status = label_table_intern(labels, to, to_length, target);
+    return status;
+}
+
+int load_labeled_graph(const char* filename, Graph* graph, LabelTable* labels) {
+    DIAG_CHECK(graph, -1, "graph not initialized");
+    DIAG_CHECK(labels, -1, "label table not initialized");
+    DIAG_CHECK(filename, -1, "invalid file name");
+
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open edge list file", -1, -1);
+        return -1;
+    }
+
+    int warnings = 0;
+
+    char* line = NULL;
+    size_t line_capacity = 0;
+    int line_number = 0;
+
+    while (getline(&line, &line_capacity, file) != -1) {
+        line_number++;
+
+        // ignore comments and lines that are blank once trimmed (indentation, CRLF)
+        const char* content = line + strspn(line, " \t\r\n");
+        if (content[0] == '#' || content[0] == '\0') continue;
+
+        int source, target;
+        double weight;
+        Status parsed = parse_labeled_edge(line, labels, &source, &target, &weight);
+
+        if (parsed != STATUS_SUCCESS) {
+            if (parsed == STATUS_INVALID) DIAG(DIAG_WARNING, ERR_INVALID_ARG, "invalid edge list line", line_number, -1);
+            warnings += 1;
+            continue;
+        }
+
+        int failed = addNode(graph, source, 16);
+        failed += addNode(graph, target, 16);
+
+        if (!failed) {
+            warnings += addEdge(graph, source, target, weight);
+        } else {
+            warnings += failed;
+        }
+    }
+
+    free(line);
+    fclose(file);
+
+    if (!warnings){
+        DIAG(DIAG_INFO, ERR_NONE, "graph loaded", line_number, -1);
+    } else {
+        DIAG(DIAG_WARNING, ERR_NONE, "graph loaded incompletely", line_number, warnings);
+    }
+    return warnings;
+}
+
 
 static void string_to_lower(char *str) {
     for (int i = 0; str[i]; i++) {
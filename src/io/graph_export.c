@@ -0,0 +1,265 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "core/graph_build.h"
+#include "io/graph_export.h"
+#include "utils/general_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/format_utils.h"
+#include "utils/thread_utils.h"
+
+#define SHARD_NODES 4096            // nodes formatted per task
+#define SHARDS_PER_THREAD 4         // shards formatted per thread before a write
+#define MAX_IOV 1024                // stay below IOV_MAX on every platform
+
+// * Per-slot output buffer, reused across rounds
+typedef struct {
+    char* text;
+    size_t length;
+    size_t capacity;
+    size_t edges;
+    Status status;
+} Shard;
+
+typedef struct {
+    const Graph* graph;
+    const ExportOptions* options;
+    bool adjacency;
+    size_t node_chars;      // longest formatted node, ID or label
+    size_t round_start;     // first node index of the current round
+    Shard* shards;
+} Exporter;
+
+ExportOptions export_options_default(void) {
+    ExportOptions options;
+    options.write_weights = true;
+    options.write_header = true;
+    options.num_threads = 1;
+    options.labels = NULL;
+    return options;
+}
+
+// Helper: make room for extra characters, records OOM in the shard status
+static bool shard_reserve(Shard* shard, size_t extra) {
+    if (shard->length + extra <= shard->capacity) return true;
+
+    size_t new_capacity = shard->capacity ? shard->capacity * 2 : 1u << 16;
+    while (new_capacity < shard->length + extra) new_capacity *= 2;
+
+    char* grown = realloc(shard->text, new_capacity);
+    if (!grown) {
+        shard->status = STATUS_OOM;
+        return false;
+    }
+    shard->text = grown;
+    shard->capacity = new_capacity;
+    return true;
+}
+
+// Helper: label of the node when it has one, its ID otherwise
+static size_t format_node(char* out, const LabelTable* labels, int id) {
+    size_t length;
+    const char* label = labels ? label_table_name(labels, id, &length) : NULL;
+    if (!label) return format_int(out, id);
+
+    memcpy(out, label, length);
+    return length;
+}
+
+static void format_edge_lines(const Exporter* exporter, Shard* shard, const Node* node) {
+    bool undirected = exporter->graph->type == GRAPH_UNDIRECTED;
+    bool weights = exporter->options->write_weights;
+    const LabelTable* labels = exporter->options->labels;
+
+    if (!shard_reserve(shard, node->neighbor_count * (2 * exporter->node_chars + FORMAT_DOUBLE_CHARS + 3))) return;
+
+    char* cursor = shard->text + shard->length;
+    for (size_t i = 0; i < node->neighbor_count; i++) {
+        const EdgeNode* edge = &node->neighbors[i];
+        if (undirected && edge->node_id < node->id) continue; // written from the other end
+
+        cursor += format_node(cursor, labels, node->id);
+        *cursor++ = ' ';
+        cursor += format_node(cursor, labels, edge->node_id);
+        if (weights) {
+            *cursor++ = ' ';
+            cursor += format_double(cursor, edge->weight);
+        }
+        *cursor++ = '\n';
+        shard->edges++;
+    }
+    shard->length = (size_t)(cursor - shard->text);
+}
+
+static void format_adjacency_line(const Exporter* exporter, Shard* shard, const Node* node) {
+    bool weights = exporter->options->write_weights;
+    const LabelTable* labels = exporter->options->labels;
+    size_t entry_chars = exporter->node_chars + FORMAT_DOUBLE_CHARS + 2;
+
+    if (!shard_reserve(shard, exporter->node_chars + 1 + node->neighbor_count * entry_chars)) return;
+
+    char* cursor = shard->text + shard->length;
+    cursor += format_node(cursor, labels, node->id);
+    for (size_t i = 0; i < node->neighbor_count; i++) {
+        *cursor++ = ' ';
+        cursor += format_node(cursor, labels, node->neighbors[i].node_id);
+        if (weights) {
+            *cursor++ = ':';
+            cursor += format_double(cursor, node->neighbors[i].weight);
+        }
+    }
+    *cursor++ = '\n';
+
+    shard->edges += node->neighbor_count;
+    shard->length = (size_t)(cursor - shard->text);
+}
+
+static void export_task(void* ctx, size_t task, int thread_id) {
+    (void)thread_id;
+    Exporter* exporter = ctx;
+    const Graph* graph = exporter->graph;
+    Shard* shard = &exporter->shards[task];
+
+    shard->length = 0;
+    shard->edges = 0;
+    shard->status = STATUS_SUCCESS;
+
+    size_t start = exporter->round_start + task * SHARD_NODES;
+    size_t end = start + SHARD_NODES < graph->node_count ? start + SHARD_NODES : graph->node_count;
+
+    for (size_t i = start; i < end && shard->status == STATUS_SUCCESS; i++) {
+        const Node* node = find_node(graph, graph->node_ids[i]);
+        if (!node) {
+            DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", graph->node_ids[i], -1);
+            shard->status = STATUS_ERROR;
+            return;
+        }
+
+        if (exporter->adjacency) {
+            format_adjacency_line(exporter, shard, node);
+        } else {
+            format_edge_lines(exporter, shard, node);
+        }
+    }
+}
+
+// Helper: write every buffer, resuming after short writes
+static Status write_all(int fd, struct iovec* iov, int count) {
+    while (count > 0) {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write graph file", errno, -1);
+            return STATUS_ERROR;
+        }
+
+        size_t remaining = (size_t)written;
+        while (count > 0 && remaining >= iov->iov_len) {
+            remaining -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + remaining;
+            iov->iov_len -= remaining;
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+static Status write_header(int fd, const Exporter* exporter) {
+    char header[128];
+    int length = snprintf(header, sizeof(header), "# format=%s type=%s nodes=%zu weights=%s labels=%s\n",
+        exporter->adjacency ? "adjacency_list" : "edge_list",
+        exporter->graph->type == GRAPH_DIRECTED ? "directed" : "undirected",
+        exporter->graph->node_count, exporter->options->write_weights ? "yes" : "no",
+        exporter->options->labels ? "yes" : "no");
+
+    struct iovec iov = {header, (size_t)length};
+    return write_all(fd, &iov, 1);
+}
+
+static Status export_graph(const Graph* graph, const char* filename, const ExportOptions* options,
+                           bool adjacency, size_t* edge_count) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(filename, STATUS_INVALID, "invalid file name");
+
+    ExportOptions defaults = export_options_default();
+    if (!options) options = &defaults;
+
+    int threads = thread_count_resolve(options->num_threads);
+    size_t slot_count = (size_t)threads * SHARDS_PER_THREAD;
+    if (slot_count > MAX_IOV) slot_count = MAX_IOV;
+
+    size_t label_chars = label_table_max_length(options->labels);
+    Exporter exporter = {graph, options, adjacency, label_chars > FORMAT_INT_CHARS ? label_chars : FORMAT_INT_CHARS, 0, NULL};
+    exporter.shards = calloc(slot_count, sizeof(Shard));
+    if (!exporter.shards) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize export buffers", -1, -1);
+        return STATUS_OOM;
+    }
+
+    struct iovec* iov = malloc(slot_count * sizeof(struct iovec));
+    int fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (!iov || fd < 0) {
+        if (fd < 0) {
+            DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open graph file", errno, -1);
+        } else {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize export buffers", -1, -1);
+            close(fd);
+        }
+        free(iov);
+        free(exporter.shards);
+        return fd < 0 ? STATUS_ERROR : STATUS_OOM;
+    }
+
+    Status status = options->write_header ? write_header(fd, &exporter) : STATUS_SUCCESS;
+    size_t written = 0;
+    size_t round_nodes = slot_count * SHARD_NODES;
+
+    for (; status == STATUS_SUCCESS && exporter.round_start < graph->node_count; exporter.round_start += round_nodes) {
+        size_t remaining = graph->node_count - exporter.round_start;
+        size_t tasks = (remaining + SHARD_NODES - 1) / SHARD_NODES;
+        if (tasks > slot_count) tasks = slot_count;
+
+        status = parallel_for(tasks, threads, export_task, &exporter);
+
+        int iov_count = 0;
+        for (size_t i = 0; i < tasks && status == STATUS_SUCCESS; i++) {
+            status = exporter.shards[i].status;
+            written += exporter.shards[i].edges;
+            if (exporter.shards[i].length == 0) continue;
+
+            iov[iov_count].iov_base = exporter.shards[i].text;
+            iov[iov_count].iov_len = exporter.shards[i].length;
+            iov_count++;
+        }
+
+        if (status == STATUS_SUCCESS) status = write_all(fd, iov, iov_count);
+    }
+
+    if (close(fd) != 0 && status == STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write graph file", errno, -1);
+        status = STATUS_ERROR;
+    }
+
+    for (size_t i = 0; i < slot_count; i++) free(exporter.shards[i].text);
+    free(exporter.shards);
+    free(iov);
+
+    if (edge_count) *edge_count = written;
+    return status;
+}
+
+Status graph_save_edge_list(const Graph* graph, const char* filename, const ExportOptions* options, size_t* edge_count) {
+    return export_graph(graph, filename, options, false, edge_count);
+}
+
+Status graph_save_adjacency_list(const Graph* graph, const char* filename, const ExportOptions* options, size_t* edge_count) {
+    return export_graph(graph, filename, options, true, edge_count);
+}
@@ -0,0 +1,764 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "core/graph_build.h"
+#include "io/edge_list.h"
+#include "io/graph_external.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/io_utils.h"
+
+#define MIN_BUDGET ((size_t)1 << 20)
+#define DEFAULT_BUDGET ((size_t)64 << 20)
+#define MIN_MERGE_BUFFER ((size_t)64 << 10)     // smallest per-run read buffer
+#define MAX_FAN_IN 256                          // runs merged at once, also bounds open files
+#define RADIX_BITS 16
+#define RADIX_BUCKETS ((size_t)1 << RADIX_BITS)
+#define HEADER_BYTES 64
+#define NODE_BYTES 8
+#define FLAG_WEIGHTED 1u
+#define SUMMARY_CHUNK 1024                      // arcs read per call while summarizing
+
+static const char adjacency_magic[8] = {'N', 'E', 'T', 'A', 'D', 'J', '0', '1'};
+
+// * Parsed arc as stored in runs. A NaN weight marks a node that must exist
+// * without adding an arc, so directed sinks still get a node record.
+typedef struct {
+    int32_t from;
+    int32_t to;
+    double weight;
+} EdgeRecord;
+
+typedef struct {
+    char** paths;
+    size_t count;
+    size_t capacity;
+} RunList;
+
+typedef struct {
+    const ExternalBuildConfig* config;
+    ExternalBuildStats stats;
+    RunList runs;
+    size_t next_run;
+} ExternalBuild;
+
+typedef struct {
+    int fd;
+    EdgeRecord* buffer;
+    size_t capacity;
+    size_t count;
+    size_t position;
+} RunReader;
+
+typedef struct {
+    int fd;
+    EdgeRecord* buffer;
+    size_t capacity;
+    size_t count;
+} RunWriter;
+
+// * Streams merged records into the adjacency file. A node header is patched
+// * with its degree once the next node starts, in the buffer when it is still
+// * there, otherwise in the file.
+typedef struct {
+    int fd;
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    uint64_t flushed;       // file bytes before buffer[0]
+    uint64_t node_offset;   // file offset of the open node header
+    uint32_t degree;
+    int32_t node_id;
+    int32_t last_target;
+    bool open;
+    bool weighted;
+    size_t node_count;
+    size_t arc_count;
+    size_t duplicates;
+} AdjacencyWriter;
+
+struct DiskAdjacency {
+    int fd;
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    size_t position;
+    GraphType type;
+    bool weighted;
+    size_t node_count;
+    size_t arc_count;
+    size_t nodes_read;
+    size_t remaining;       // arcs of the current node not read yet
+    Status status;
+};
+
+typedef Status (*RecordSink)(void* ctx, const EdgeRecord* record);
+
+ExternalBuildConfig external_build_config_default(void) {
+    ExternalBuildConfig config;
+    config.memory_budget = DEFAULT_BUDGET;
+    config.scratch_dir = ".";
+    config.type = GRAPH_DIRECTED;
+    config.weighted = true;
+    config.labels = NULL;
+    return config;
+}
+
+// ---------------------------------------------------------------------------
+// Runs
+// ---------------------------------------------------------------------------
+
+static inline uint64_t record_key(const EdgeRecord* record) {
+    return ((uint64_t)((uint32_t)record->from ^ 0x80000000u) << 32) | ((uint32_t)record->to ^ 0x80000000u);
+}
+
+// Helper: stable LSD radix sort by (from, to), equal keys keep input order
+static void sort_records(EdgeRecord* records, EdgeRecord* scratch, size_t count, size_t* counts) {
+    if (count < 2) return;
+    EdgeRecord* src = records;
+    EdgeRecord* dst = scratch;
+
+    for (int shift = 0; shift < 64; shift += RADIX_BITS) {
+        memset(counts, 0, RADIX_BUCKETS * sizeof(size_t));
+        for (size_t i = 0; i < count; i++) counts[(record_key(&src[i]) >> shift) & (RADIX_BUCKETS - 1)]++;
+        if (counts[(record_key(&src[0]) >> shift) & (RADIX_BUCKETS - 1)] == count) continue; // digit is constant
+
+        size_t offset = 0;
+        for (size_t b = 0; b < RADIX_BUCKETS; b++) {
+            size_t bucket = counts[b];
+            counts[b] = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < count; i++) dst[counts[(record_key(&src[i]) >> shift) & (RADIX_BUCKETS - 1)]++] = src[i];
+
+        EdgeRecord* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != records) memcpy(records, src, count * sizeof(EdgeRecord));
+}
+
+// Helper: create a new scratch run file, the path is added to the run list
+static int run_create(ExternalBuild* build) {
+    if (build->runs.count == build->runs.capacity) {
+        size_t new_capacity = build->runs.capacity ? build->runs.capacity * 2 : 16;
+        char** grown = realloc(build->runs.paths, new_capacity * sizeof(char*));
+        if (!grown) return -1;
+        build->runs.paths = grown;
+        build->runs.capacity = new_capacity;
+    }
+
+    size_t length = strlen(build->config->scratch_dir) + 64;
+    char* path = malloc(length);
+    if (!path) return -1;
+    snprintf(path, length, "%s/netadj-%ld-%zu.run", build->config->scratch_dir, (long)getpid(), build->next_run++);
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to create scratch run", errno, -1);
+        free(path);
+        return -1;
+    }
+
+    build->runs.paths[build->runs.count++] = path;
+    return fd;
+}
+
+static void runs_clear(RunList* runs) {
+    for (size_t i = 0; i < runs->count; i++) {
+        unlink(runs->paths[i]);
+        free(runs->paths[i]);
+    }
+    free(runs->paths);
+    memset(runs, 0, sizeof(*runs));
+}
+
+static Status spill_run(ExternalBuild* build, const EdgeRecord* records, size_t count) {
+    int fd = run_create(build);
+    if (fd < 0) return STATUS_ERROR;
+
+    Status status = write_full(fd, records, count * sizeof(EdgeRecord));
+    if (close(fd) != 0 && status == STATUS_SUCCESS) status = STATUS_ERROR;
+    build->stats.runs++;
+    return status;
+}
+
+// Helper: parse the edge list into sorted runs. When everything fits a single
+// buffer nothing is spilled and the sorted records stay in memory.
+static Status build_runs(ExternalBuild* build, FILE* input, EdgeRecord* records, EdgeRecord* scratch,
+                         size_t capacity, size_t* counts, size_t* in_memory) {
+    bool undirected = build->config->type == GRAPH_UNDIRECTED;
+    LabelTable* labels = build->config->labels;
+    size_t count = 0;
+    char* line = NULL;
+    size_t line_capacity = 0;
+    Status status = STATUS_SUCCESS;
+
+    *in_memory = 0;
+    while (status == STATUS_SUCCESS && getline(&line, &line_capacity, input) != -1) {
+        build->stats.lines++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\0') continue; // comments and empty lines
+
+        int source, target;
+        double weight = 1.0;
+        bool parsed;
+        if (labels) {
+            Status parse_status = parse_labeled_edge(line, labels, &source, &target, &weight);
+            if (parse_status != STATUS_SUCCESS && parse_status != STATUS_INVALID) {
+                status = parse_status;
+                break;
+            }
+            parsed = parse_status == STATUS_SUCCESS;
+        } else {
+            parsed = sscanf(line, "%d %d %lf", &source, &target, &weight) >= 2;
+        }
+        if (!parsed || isnan(weight) || (undirected && source == target)) {
+            build->stats.invalid_lines++;
+            continue;
+        }
+
+        if (count + 2 > capacity) {
+            sort_records(records, scratch, count, counts);
+            status = spill_run(build, records, count);
+            count = 0;
+            if (status != STATUS_SUCCESS) break;
+        }
+
+        records[count++] = (EdgeRecord){source, target, weight};
+        if (undirected) {
+            records[count++] = (EdgeRecord){target, source, weight};
+        } else if (target != source) {
+            records[count++] = (EdgeRecord){target, target, NAN};
+        }
+        build->stats.edges++;
+    }
+    free(line);
+
+    if (status != STATUS_SUCCESS) return status;
+    if (ferror(input)) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to read edge list", -1, -1);
+        return STATUS_ERROR;
+    }
+
+    sort_records(records, scratch, count, counts);
+    if (build->runs.count == 0) {
+        *in_memory = count;
+        return STATUS_SUCCESS;
+    }
+    return count ? spill_run(build, records, count) : STATUS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// Merge
+// ---------------------------------------------------------------------------
+
+// Helper: refill the reader buffer, false at the end of the run or on error
+static bool run_reader_fill(RunReader* reader, Status* status) {
+    ssize_t got = read_full(reader->fd, reader->buffer, reader->capacity * sizeof(EdgeRecord));
+    if (got < 0) {
+        *status = STATUS_ERROR;
+        return false;
+    }
+    reader->count = (size_t)got / sizeof(EdgeRecord);
+    reader->position = 0;
+    return reader->count > 0;
+}
+
+// Helper: run a before run b, ties go to the earlier run so first lines win
+static inline bool merge_less(const RunReader* readers, size_t a, size_t b) {
+    uint64_t key_a = record_key(&readers[a].buffer[readers[a].position]);
+    uint64_t key_b = record_key(&readers[b].buffer[readers[b].position]);
+    return key_a < key_b || (key_a == key_b && a < b);
+}
+
+static void heap_sift_down(const RunReader* readers, size_t* heap, size_t size, size_t i) {
+    for (;;) {
+        size_t smallest = i, left = 2 * i + 1, right = left + 1;
+        if (left < size && merge_less(readers, heap[left], heap[smallest])) smallest = left;
+        if (right < size && merge_less(readers, heap[right], heap[smallest])) smallest = right;
+        if (smallest == i) return;
+
+        size_t swap = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = swap;
+        i = smallest;
+    }
+}
+
+// Helper: k-way merge of run files into sink, each run read through its own
+// share of memory (share_records records)
+static Status merge_runs(char** paths, size_t count, EdgeRecord* memory, size_t share_records, RecordSink sink, void* ctx) {
+    RunReader readers[MAX_FAN_IN];
+    size_t heap[MAX_FAN_IN];
+    size_t heap_size = 0;
+    Status status = STATUS_SUCCESS;
+
+    for (size_t i = 0; i < count; i++) readers[i].fd = -1;
+
+    for (size_t i = 0; i < count && status == STATUS_SUCCESS; i++) {
+        readers[i].fd = open(paths[i], O_RDONLY);
+        readers[i].buffer = memory + i * share_records;
+        readers[i].capacity = share_records;
+        if (readers[i].fd < 0) {
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to open scratch run", errno, -1);
+            status = STATUS_ERROR;
+        } else if (run_reader_fill(&readers[i], &status)) {
+            heap[heap_size++] = i;
+        }
+    }
+
+    for (size_t i = heap_size / 2; i-- > 0;) heap_sift_down(readers, heap, heap_size, i);
+
+    while (heap_size > 0 && status == STATUS_SUCCESS) {
+        RunReader* reader = &readers[heap[0]];
+        status = sink(ctx, &reader->buffer[reader->position]);
+
+        if (++reader->position == reader->count && !run_reader_fill(reader, &status)) {
+            heap[0] = heap[--heap_size];
+        }
+        heap_sift_down(readers, heap, heap_size, 0);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (readers[i].fd >= 0) close(readers[i].fd);
+    }
+    return status;
+}
+
+static Status run_writer_flush(RunWriter* writer) {
+    Status status = write_full(writer->fd, writer->buffer, writer->count * sizeof(EdgeRecord));
+    writer->count = 0;
+    return status;
+}
+
+static Status run_writer_push(void* ctx, const EdgeRecord* record) {
+    RunWriter* writer = ctx;
+    if (writer->count == writer->capacity) {
+        Status status = run_writer_flush(writer);
+        if (status != STATUS_SUCCESS) return status;
+    }
+    writer->buffer[writer->count++] = *record;
+    return STATUS_SUCCESS;
+}
+
+// Helper: merge groups of fan_in runs until a single final merge is left
+static Status merge_passes(ExternalBuild* build, EdgeRecord* memory, size_t fan_in, size_t share_records) {
+    while (build->runs.count > fan_in) {
+        RunList inputs = build->runs;
+        memset(&build->runs, 0, sizeof(build->runs));
+        Status status = STATUS_SUCCESS;
+
+        for (size_t first = 0; first < inputs.count && status == STATUS_SUCCESS; first += fan_in) {
+            size_t group = inputs.count - first < fan_in ? inputs.count - first : fan_in;
+
+            RunWriter writer = {run_create(build), memory + fan_in * share_records, share_records, 0};
+            if (writer.fd < 0) {
+                status = STATUS_ERROR;
+                break;
+            }
+
+            status = merge_runs(&inputs.paths[first], group, memory, share_records, run_writer_push, &writer);
+            if (status == STATUS_SUCCESS) status = run_writer_flush(&writer);
+            if (close(writer.fd) != 0 && status == STATUS_SUCCESS) status = STATUS_ERROR;
+        }
+
+        runs_clear(&inputs);
+        build->stats.merge_passes++;
+        if (status != STATUS_SUCCESS) return status;
+    }
+    return STATUS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// Adjacency writer
+// ---------------------------------------------------------------------------
+
+static Status writer_flush(AdjacencyWriter* writer) {
+    Status status = write_full(writer->fd, writer->buffer, writer->length);
+    writer->flushed += writer->length;
+    writer->length = 0;
+    return status;
+}
+
+static Status writer_put(AdjacencyWriter* writer, const void* data, size_t length) {
+    if (writer->length + length > writer->capacity) {
+        Status status = writer_flush(writer);
+        if (status != STATUS_SUCCESS) return status;
+    }
+    memcpy(writer->buffer + writer->length, data, length);
+    writer->length += length;
+    return STATUS_SUCCESS;
+}
+
+static Status writer_close_node(AdjacencyWriter* writer) {
+    if (!writer->open) return STATUS_SUCCESS;
+    writer->open = false;
+
+    if (writer->node_offset >= writer->flushed) {
+        memcpy(writer->buffer + (writer->node_offset - writer->flushed) + 4, &writer->degree, 4);
+        return STATUS_SUCCESS;
+    }
+    return pwrite_full(writer->fd, &writer->degree, 4, writer->node_offset + 4);
+}
+
+static Status adjacency_push(void* ctx, const EdgeRecord* record) {
+    AdjacencyWriter* writer = ctx;
+    Status status;
+
+    if (!writer->open || record->from != writer->node_id) {
+        status = writer_close_node(writer);
+        if (status != STATUS_SUCCESS) return status;
+
+        uint32_t header[2] = {(uint32_t)record->from, 0};
+        status = writer_put(writer, header, NODE_BYTES);
+        if (status != STATUS_SUCCESS) return status;
+
+        // the put may flush first, so the offset is taken afterwards
+        writer->node_offset = writer->flushed + writer->length - NODE_BYTES;
+        writer->node_id = record->from;
+        writer->degree = 0;
+        writer->open = true;
+        writer->node_count++;
+    }
+
+    if (isnan(record->weight)) return STATUS_SUCCESS; // node marker
+
+    // Records arrive sorted with the first line first, later copies are dropped
+    if (writer->degree > 0 && record->to == writer->last_target) {
+        writer->duplicates++;
+        return STATUS_SUCCESS;
+    }
+    if (writer->degree == UINT32_MAX) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "node degree exceeds adjacency file limit", record->from, -1);
+        return STATUS_INVALID;
+    }
+
+    status = writer_put(writer, &record->to, sizeof(int32_t));
+    if (status == STATUS_SUCCESS && writer->weighted) status = writer_put(writer, &record->weight, sizeof(double));
+    if (status != STATUS_SUCCESS) return status;
+
+    writer->last_target = record->to;
+    writer->degree++;
+    writer->arc_count++;
+    return STATUS_SUCCESS;
+}
+
+static Status writer_finish(AdjacencyWriter* writer, GraphType type) {
+    Status status = writer_close_node(writer);
+    if (status == STATUS_SUCCESS) status = writer_flush(writer);
+    if (status != STATUS_SUCCESS) return status;
+
+    char header[HEADER_BYTES] = {0};
+    uint32_t type_code = (uint32_t)type;
+    uint32_t flags = writer->weighted ? FLAG_WEIGHTED : 0;
+    uint64_t node_count = writer->node_count;
+    uint64_t arc_count = writer->arc_count;
+
+    memcpy(header, adjacency_magic, sizeof(adjacency_magic));
+    memcpy(header + 8, &type_code, 4);
+    memcpy(header + 12, &flags, 4);
+    memcpy(header + 16, &node_count, 8);
+    memcpy(header + 24, &arc_count, 8);
+    return pwrite_full(writer->fd, header, HEADER_BYTES, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Build
+// ---------------------------------------------------------------------------
+
+// Helper: phase 2, merge runs (or the in-memory run) into the adjacency file
+static Status write_adjacency(ExternalBuild* build, const char* output, char* memory, size_t budget,
+                              const EdgeRecord* in_memory, size_t in_memory_count) {
+    size_t fan_in = budget / MIN_MERGE_BUFFER - 1;
+    if (fan_in > MAX_FAN_IN) fan_in = MAX_FAN_IN;
+    size_t share_records = budget / (fan_in + 1) / sizeof(EdgeRecord);
+
+    Status status = merge_passes(build, (EdgeRecord*)memory, fan_in, share_records);
+    if (status != STATUS_SUCCESS) return status;
+
+    AdjacencyWriter writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.weighted = build->config->weighted;
+    writer.fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer.fd < 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to create adjacency file", errno, -1);
+        return STATUS_ERROR;
+    }
+
+    // In-memory records live at the start of memory, the writer takes the tail
+    size_t reserved = in_memory ? in_memory_count * sizeof(EdgeRecord) : fan_in * share_records * sizeof(EdgeRecord);
+    writer.buffer = memory + reserved;
+    writer.capacity = budget - reserved;
+
+    char zero[HEADER_BYTES] = {0};
+    status = writer_put(&writer, zero, HEADER_BYTES);
+
+    if (in_memory) {
+        for (size_t i = 0; i < in_memory_count && status == STATUS_SUCCESS; i++) status = adjacency_push(&writer, &in_memory[i]);
+    } else if (status == STATUS_SUCCESS) {
+        status = merge_runs(build->runs.paths, build->runs.count, (EdgeRecord*)memory, share_records, adjacency_push, &writer);
+    }
+
+    if (status == STATUS_SUCCESS) status = writer_finish(&writer, build->config->type);
+    if (close(writer.fd) != 0 && status == STATUS_SUCCESS) status = STATUS_ERROR;
+    if (status != STATUS_SUCCESS) unlink(output);
+
+    build->stats.node_count = writer.node_count;
+    build->stats.arc_count = writer.arc_count;
+    build->stats.duplicates = writer.duplicates;
+    return status;
+}
+
+Status graph_external_build(const char* edge_list, const char* output, const ExternalBuildConfig* config, ExternalBuildStats* stats) {
+    DIAG_CHECK(edge_list, STATUS_INVALID, "invalid file name");
+    DIAG_CHECK(output, STATUS_INVALID, "invalid file name");
+
+    ExternalBuildConfig defaults = external_build_config_default();
+    if (!config) config = &defaults;
+    if (config->memory_budget < MIN_BUDGET || !config->scratch_dir) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "external build needs a scratch directory and at least 1 MiB", -1, -1);
+        return STATUS_INVALID;
+    }
+
+    FILE* input = fopen(edge_list, "r");
+    if (!input) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open edge list file", -1, -1);
+        return STATUS_ERROR;
+    }
+
+    ExternalBuild build;
+    memset(&build, 0, sizeof(build));
+    build.config = config;
+
+    // Phase 1 splits the budget into the radix counts, the run and its sort scratch
+    size_t budget = config->memory_budget;
+    size_t counts_bytes = RADIX_BUCKETS * sizeof(size_t);
+    size_t run_capacity = (budget - counts_bytes) / (2 * sizeof(EdgeRecord));
+
+    char* memory = malloc(budget);
+    if (!memory) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate external build budget", -1, -1);
+        fclose(input);
+        return STATUS_OOM;
+    }
+
+    EdgeRecord* records = (EdgeRecord*)memory;
+    EdgeRecord* scratch = records + run_capacity;
+    size_t* counts = (size_t*)(scratch + run_capacity);
+
+    size_t in_memory = 0;
+    Status status = build_runs(&build, input, records, scratch, run_capacity, counts, &in_memory);
+    fclose(input);
+
+    if (status == STATUS_SUCCESS) {
+        bool single = build.runs.count == 0;
+        status = write_adjacency(&build, output, memory, budget, single ? records : NULL, in_memory);
+    }
+
+    build.stats.peak_bytes = budget;
+    runs_clear(&build.runs);
+    free(memory);
+
+    if (build.stats.invalid_lines) DIAG(DIAG_WARNING, ERR_INVALID_ARG, "edge list lines skipped", (int)build.stats.invalid_lines, -1);
+    if (status == STATUS_SUCCESS) DIAG(DIAG_INFO, ERR_NONE, "external graph built", (int)build.stats.runs, (int)build.stats.merge_passes);
+    if (stats) *stats = build.stats;
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+// Helper: copy length bytes from the stream, refilling the buffer as needed
+static bool reader_take(DiskAdjacency* adjacency, void* data, size_t length) {
+    char* cursor = data;
+    while (length > 0) {
+        if (adjacency->position == adjacency->length) {
+            ssize_t got = read_full(adjacency->fd, adjacency->buffer, adjacency->capacity);
+            if (got <= 0) {
+                if (got == 0) DIAG(DIAG_ERROR, ERR_INTERNAL, "adjacency file is truncated", -1, -1);
+                adjacency->status = STATUS_ERROR;
+                return false;
+            }
+            adjacency->length = (size_t)got;
+            adjacency->position = 0;
+        }
+
+        size_t chunk = adjacency->length - adjacency->position;
+        if (chunk > length) chunk = length;
+        memcpy(cursor, adjacency->buffer + adjacency->position, chunk);
+        adjacency->position += chunk;
+        cursor += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+static bool reader_skip(DiskAdjacency* adjacency, uint64_t length) {
+    size_t buffered = adjacency->length - adjacency->position;
+    if (length <= buffered) {
+        adjacency->position += (size_t)length;
+        return true;
+    }
+
+    if (lseek(adjacency->fd, (off_t)(length - buffered), SEEK_CUR) < 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to seek adjacency file", errno, -1);
+        adjacency->status = STATUS_ERROR;
+        return false;
+    }
+    adjacency->position = adjacency->length = 0;
+    return true;
+}
+
+DiskAdjacency* disk_adjacency_open(const char* path, size_t buffer_bytes) {
+    DIAG_CHECK(path, NULL, "invalid file name");
+
+    DiskAdjacency* adjacency = calloc(1, sizeof(DiskAdjacency));
+    if (!adjacency) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize adjacency reader", -1, -1);
+        return NULL;
+    }
+
+    adjacency->capacity = buffer_bytes < HEADER_BYTES ? HEADER_BYTES : buffer_bytes;
+    adjacency->buffer = malloc(adjacency->capacity);
+    adjacency->fd = open(path, O_RDONLY);
+    if (!adjacency->buffer || adjacency->fd < 0) {
+        DIAG(DIAG_ERROR, adjacency->buffer ? ERR_NOT_FOUND : ERR_NO_MEMORY, "failed to open adjacency file", -1, -1);
+        disk_adjacency_close(adjacency);
+        return NULL;
+    }
+
+    char header[HEADER_BYTES];
+    uint32_t type_code, flags;
+    uint64_t node_count, arc_count;
+    if (!reader_take(adjacency, header, HEADER_BYTES) || memcmp(header, adjacency_magic, sizeof(adjacency_magic)) != 0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "not an adjacency file", -1, -1);
+        disk_adjacency_close(adjacency);
+        return NULL;
+    }
+
+    memcpy(&type_code, header + 8, 4);
+    memcpy(&flags, header + 12, 4);
+    memcpy(&node_count, header + 16, 8);
+    memcpy(&arc_count, header + 24, 8);
+
+    adjacency->type = type_code == GRAPH_UNDIRECTED ? GRAPH_UNDIRECTED : GRAPH_DIRECTED;
+    adjacency->weighted = flags & FLAG_WEIGHTED;
+    adjacency->node_count = (size_t)node_count;
+    adjacency->arc_count = (size_t)arc_count;
+    adjacency->status = STATUS_SUCCESS;
+    return adjacency;
+}
+
+void disk_adjacency_close(DiskAdjacency* adjacency) {
+    if (!adjacency) return;
+    if (adjacency->fd >= 0) close(adjacency->fd);
+    free(adjacency->buffer);
+    free(adjacency);
+}
+
+GraphType disk_adjacency_type(const DiskAdjacency* adjacency) {
+    return adjacency ? adjacency->type : GRAPH_DIRECTED;
+}
+
+bool disk_adjacency_weighted(const DiskAdjacency* adjacency) {
+    return adjacency ? adjacency->weighted : false;
+}
+
+size_t disk_adjacency_node_count(const DiskAdjacency* adjacency) {
+    return adjacency ? adjacency->node_count : 0;
+}
+
+size_t disk_adjacency_arc_count(const DiskAdjacency* adjacency) {
+    return adjacency ? adjacency->arc_count : 0;
+}
+
+Status disk_adjacency_status(const DiskAdjacency* adjacency) {
+    return adjacency ? adjacency->status : STATUS_INVALID;
+}
+
+bool disk_adjacency_next_node(DiskAdjacency* adjacency, int* node_id, size_t* degree) {
+    if (!adjacency || adjacency->status != STATUS_SUCCESS) return false;
+    if (adjacency->nodes_read == adjacency->node_count) return false;
+
+    size_t arc_bytes = sizeof(int32_t) + (adjacency->weighted ? sizeof(double) : 0);
+    if (adjacency->remaining && !reader_skip(adjacency, (uint64_t)adjacency->remaining * arc_bytes)) return false;
+
+    uint32_t header[2];
+    if (!reader_take(adjacency, header, NODE_BYTES)) return false;
+
+    adjacency->nodes_read++;
+    adjacency->remaining = header[1];
+    if (node_id) *node_id = (int32_t)header[0];
+    if (degree) *degree = adjacency->remaining;
+    return true;
+}
+
+size_t disk_adjacency_read_arcs(DiskAdjacency* adjacency, int* targets, double* weights, size_t max) {
+    if (!adjacency || adjacency->status != STATUS_SUCCESS) return 0;
+
+    size_t count = max < adjacency->remaining ? max : adjacency->remaining;
+    for (size_t i = 0; i < count; i++) {
+        int32_t target;
+        double weight = 1.0;
+        if (!reader_take(adjacency, &target, sizeof(target))) return i;
+        if (adjacency->weighted && !reader_take(adjacency, &weight, sizeof(weight))) return i;
+
+        if (targets) targets[i] = target;
+        if (weights) weights[i] = weight;
+        adjacency->remaining--;
+    }
+    return count;
+}
+
+Status disk_adjacency_summarize(const char* path, size_t memory_budget, DiskGraphSummary* summary) {
+    DIAG_CHECK(summary, STATUS_INVALID, "invalid summary");
+    memset(summary, 0, sizeof(*summary));
+
+    DiskAdjacency* adjacency = disk_adjacency_open(path, memory_budget);
+    if (!adjacency) return STATUS_ERROR;
+
+    summary->type = adjacency->type;
+    summary->weighted = adjacency->weighted;
+    summary->node_count = adjacency->node_count;
+    summary->arc_count = adjacency->arc_count;
+    summary->max_degree_id = -1;
+
+    int targets[SUMMARY_CHUNK];
+    double weights[SUMMARY_CHUNK];
+    int node_id;
+    size_t degree, degree_seen = 0;
+
+    while (disk_adjacency_next_node(adjacency, &node_id, &degree)) {
+        if (degree == 0) summary->isolated_nodes++;
+        if (degree > summary->max_degree || degree_seen == 0) {
+            summary->max_degree = degree;
+            summary->max_degree_id = node_id;
+        }
+        degree_seen++;
+
+        size_t bucket = degree ? (size_t)(64 - __builtin_clzll((unsigned long long)degree)) : 0;
+        summary->degree_histogram[bucket < DISK_DEGREE_BUCKETS ? bucket : DISK_DEGREE_BUCKETS - 1]++;
+
+        size_t got;
+        while ((got = disk_adjacency_read_arcs(adjacency, targets, weights, SUMMARY_CHUNK)) > 0) {
+            for (size_t i = 0; i < got; i++) {
+                summary->self_loops += targets[i] == node_id;
+                summary->total_weight += weights[i];
+            }
+        }
+    }
+
+    Status status = adjacency->status;
+    disk_adjacency_close(adjacency);
+
+    if (status == STATUS_SUCCESS) {
+        summary->average_degree = summary->node_count ? (double)summary->arc_count / (double)summary->node_count : 0.0;
+    }
+    return status;
+}
@@ -0,0 +1,818 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "core/graph_build.h"
+#include "io/graph_persist.h"
+#include "utils/general_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/io_utils.h"
+
+#define WAL_HEADER_BYTES 16         // magic, uint32 type, uint32 reserved
+#define FRAME_HEADER_BYTES 8        // uint32 payload length, uint32 crc
+#define SNAPSHOT_HEADER_BYTES 32    // magic, uint32 type, uint32 reserved, uint64 nodes, uint64 arcs
+#define MAX_RECORD_BYTES 17         // op, from, to, weight
+#define ARC_BYTES 12                // int32 target, double weight
+#define SNAPSHOT_BUFFER ((size_t)1 << 20)
+
+static const char wal_magic[8] = {'N', 'E', 'T', 'W', 'A', 'L', '0', '1'};
+static const char snapshot_magic[8] = {'N', 'E', 'T', 'S', 'N', 'A', 'P', '1'};
+static const char snapshot_end[8] = {'N', 'E', 'T', 'S', 'N', 'E', 'N', 'D'};
+
+typedef enum {
+    OP_INSERT_NODE = 1,     // id
+    OP_REMOVE_NODE,         // id
+    OP_INSERT_EDGE,         // from, to, weight
+    OP_UPDATE_EDGE,         // from, to, weight
+    OP_REMOVE_EDGE          // from, to
+} LogOp;
+
+struct GraphStore {
+    Graph* graph;
+    PersistConfig config;
+    char* directory;
+    GraphStoreStats stats;
+    bool failed;                // a record could not be logged, further mutations are refused
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        // flusher: data buffered, flush requested or stopping
+    pthread_cond_t flushed;     // writers: buffer space freed or records made durable
+    pthread_t flusher;
+    bool flusher_running;
+    bool stopping;
+    bool flush_requested;
+
+    // Double buffered log: writers fill active, the flusher writes spare
+    char* active;
+    char* spare;
+    size_t active_length;
+    size_t capacity;
+    uint64_t appended;          // records appended
+    uint64_t durable;           // records written by the flusher
+    Status io_status;
+
+    int wal_fd;
+    uint64_t segment;           // current log segment
+    uint64_t oldest_segment;    // oldest file still on disk
+
+    pid_t snapshot_pid;         // running snapshot child, 0 if none
+    uint64_t snapshot_segment;
+    size_t since_snapshot;
+    char* snapshot_buffer;      // preallocated so the child never allocates
+};
+
+PersistConfig persist_config_default(void) {
+    PersistConfig config;
+    config.group_commit_bytes = (size_t)1 << 20;
+    config.group_commit_ms = 5;
+    config.sync = true;
+    config.snapshot_records = 0;
+    return config;
+}
+
+static char* store_path(const GraphStore* store, const char* prefix, uint64_t segment, const char* suffix) {
+    size_t length = strlen(store->directory) + strlen(prefix) + strlen(suffix) + 32;
+    char* path = malloc(length);
+    if (path) snprintf(path, length, "%s/%s-%llu%s", store->directory, prefix, (unsigned long long)segment, suffix);
+    return path;
+}
+
+static void remove_segment_file(const GraphStore* store, const char* prefix, uint64_t segment, const char* suffix) {
+    char* path = store_path(store, prefix, segment, suffix);
+    if (path) unlink(path);
+    free(path);
+}
+
+// ---------------------------------------------------------------------------
+// Log records
+// ---------------------------------------------------------------------------
+
+static size_t record_encode(char* out, LogOp op, int from, int to, double weight) {
+    int32_t a = from, b = to;
+    size_t length = 1;
+
+    out[0] = (char)op;
+    memcpy(out + length, &a, 4);
+    length += 4;
+    if (op == OP_INSERT_NODE || op == OP_REMOVE_NODE) return length;
+
+    memcpy(out + length, &b, 4);
+    length += 4;
+    if (op == OP_REMOVE_EDGE) return length;
+
+    memcpy(out + length, &weight, 8);
+    return length + 8;
+}
+
+// Helper: apply one record, returns bytes consumed or 0 if the record is malformed
+static size_t record_apply(Graph* graph, const char* data, size_t available, Status* status) {
+    if (available < 5) return 0;
+
+    LogOp op = (LogOp)(unsigned char)data[0];
+    int32_t a, b = 0;
+    double weight = 0.0;
+    size_t length = op == OP_INSERT_NODE || op == OP_REMOVE_NODE ? 5 : op == OP_REMOVE_EDGE ? 9 : 17;
+    if (op < OP_INSERT_NODE || op > OP_REMOVE_EDGE || available < length) return 0;
+
+    memcpy(&a, data + 1, 4);
+    if (length > 5) memcpy(&b, data + 5, 4);
+    if (length > 9) memcpy(&weight, data + 9, 8);
+
+    switch (op) {
+        case OP_INSERT_NODE: *status = graph_insert_node(graph, a, 0); break;
+        case OP_REMOVE_NODE: *status = graph_remove_node(graph, a); break;
+        case OP_INSERT_EDGE: *status = graph_insert_edge(graph, a, b, weight); break;
+        case OP_UPDATE_EDGE: *status = graph_update_edge(graph, a, b, weight); break;
+        case OP_REMOVE_EDGE: *status = graph_remove_edge(graph, a, b); break;
+    }
+    return length;
+}
+
+// ---------------------------------------------------------------------------
+// Group commit
+// ---------------------------------------------------------------------------
+
+static Status wal_write_group(GraphStore* store, int fd, const char* payload, size_t length) {
+    uint32_t header[2] = {(uint32_t)length, crc32_update(0, payload, length)};
+
+    Status status = write_full(fd, header, FRAME_HEADER_BYTES);
+    if (status == STATUS_SUCCESS) status = write_full(fd, payload, length);
+    if (status == STATUS_SUCCESS && store->config.sync && fdatasync(fd) != 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to sync write-ahead log", errno, -1);
+        status = STATUS_ERROR;
+    }
+    return status;
+}
+
+// Helper: collect a finished snapshot child and drop the files it replaces, called locked
+static void snapshot_reap(GraphStore* store, bool block) {
+    if (!store->snapshot_pid) return;
+
+    int exit_status = 0;
+    pid_t done = waitpid(store->snapshot_pid, &exit_status, block ? 0 : WNOHANG);
+    if (done == 0) return;
+
+    store->snapshot_pid = 0;
+    if (done < 0 || !WIFEXITED(exit_status) || WEXITSTATUS(exit_status) != 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "background snapshot failed, log kept", (int)store->snapshot_segment, -1);
+        return;
+    }
+
+    store->stats.snapshots_written++;
+    for (uint64_t s = store->oldest_segment; s < store->snapshot_segment; s++) {
+        remove_segment_file(store, "snapshot", s, ".bin");
+        remove_segment_file(store, "wal", s, ".log");
+    }
+    store->oldest_segment = store->snapshot_segment;
+}
+
+static void* flusher_main(void* arg) {
+    GraphStore* store = arg;
+
+    pthread_mutex_lock(&store->lock);
+    while (!(store->stopping && store->active_length == 0)) {
+        if (!store->stopping && !store->flush_requested && store->active_length < store->config.group_commit_bytes) {
+            if (store->active_length == 0 && !store->snapshot_pid) {
+                // Idle: the first appended record wakes the flusher and starts the group timer
+                pthread_cond_wait(&store->wake, &store->lock);
+                continue;
+            }
+
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += (long)store->config.group_commit_ms * 1000000L;
+            deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+            deadline.tv_nsec %= 1000000000L;
+
+            int waited = pthread_cond_timedwait(&store->wake, &store->lock, &deadline);
+            snapshot_reap(store, false);
+            if (waited != ETIMEDOUT) continue;  // woken early, recheck why
+        }
+
+        store->flush_requested = false;
+        if (store->active_length == 0) continue;
+
+        // Swap buffers so writers keep appending while this group is written
+        char* group = store->active;
+        size_t length = store->active_length;
+        uint64_t target = store->appended;
+        int fd = store->wal_fd;
+        store->active = store->spare;
+        store->spare = group;
+        store->active_length = 0;
+        pthread_cond_broadcast(&store->flushed);
+
+        pthread_mutex_unlock(&store->lock);
+        Status status = wal_write_group(store, fd, group, length);
+        pthread_mutex_lock(&store->lock);
+
+        if (status != STATUS_SUCCESS) store->io_status = status;
+        store->durable = target;
+        store->stats.groups_written++;
+        store->stats.bytes_logged += length + FRAME_HEADER_BYTES;
+        pthread_cond_broadcast(&store->flushed);
+    }
+    pthread_mutex_unlock(&store->lock);
+    return NULL;
+}
+
+static Status log_append(GraphStore* store, const char* record, size_t length) {
+    pthread_mutex_lock(&store->lock);
+
+    // Backpressure: wait for the flusher to hand back the spare buffer
+    while (store->active_length + length > store->capacity && store->io_status == STATUS_SUCCESS) {
+        store->flush_requested = true;
+        pthread_cond_signal(&store->wake);
+        pthread_cond_wait(&store->flushed, &store->lock);
+    }
+
+    Status status = store->io_status;
+    if (status == STATUS_SUCCESS) {
+        memcpy(store->active + store->active_length, record, length);
+        store->active_length += length;
+        store->appended++;
+        store->stats.records_logged++;
+        if (store->active_length == length || store->active_length >= store->config.group_commit_bytes) {
+            pthread_cond_signal(&store->wake);
+        }
+    }
+
+    pthread_mutex_unlock(&store->lock);
+    return status;
+}
+
+// Helper: log a mutation that was applied, a failed append stops further writes
+static Status store_log(GraphStore* store, LogOp op, int from, int to, double weight) {
+    char record[MAX_RECORD_BYTES];
+    size_t length = record_encode(record, op, from, to, weight);
+
+    Status status = log_append(store, record, length);
+    if (status != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "mutation applied but not logged, store is read only", from, to);
+        store->failed = true;
+        return status;
+    }
+
+    // Reset before triggering, so records logged while a snapshot runs do not retrigger
+    // it and a failed one is retried only after another snapshot_records records
+    if (store->config.snapshot_records && ++store->since_snapshot >= store->config.snapshot_records) {
+        store->since_snapshot = 0;
+        Status snapshot = graph_store_snapshot(store);
+        if (snapshot != STATUS_SUCCESS && snapshot != STATUS_WARNING) {
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "automatic snapshot failed, log keeps growing", (int)snapshot, -1);
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+Status graph_store_flush(GraphStore* store) {
+    DIAG_CHECK(store, STATUS_INVALID, "invalid graph store");
+
+    pthread_mutex_lock(&store->lock);
+    uint64_t target = store->appended;
+    store->flush_requested = true;
+    pthread_cond_signal(&store->wake);
+    while (store->durable < target && store->io_status == STATUS_SUCCESS) {
+        pthread_cond_wait(&store->flushed, &store->lock);
+    }
+    Status status = store->io_status;
+    pthread_mutex_unlock(&store->lock);
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Snapshots
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int fd;
+    char* buffer;
+    size_t length;
+    bool ok;
+} SnapshotWriter;
+
+static void snapshot_put(SnapshotWriter* writer, const void* data, size_t length) {
+    if (writer->length + length > SNAPSHOT_BUFFER) {
+        writer->ok = writer->ok && write_full(writer->fd, writer->buffer, writer->length) == STATUS_SUCCESS;
+        writer->length = 0;
+    }
+    memcpy(writer->buffer + writer->length, data, length);
+    writer->length += length;
+}
+
+// Runs in the forked child: only writes the inherited image, never allocates
+static bool snapshot_write(const GraphStore* store, const char* temp_path, const char* path) {
+    const Graph* graph = store->graph;
+    SnapshotWriter writer = {open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644), store->snapshot_buffer, 0, true};
+    if (writer.fd < 0) return false;
+
+    uint64_t arcs = 0;
+    for (size_t i = 0; i < graph->node_count; i++) arcs += find_node(graph, graph->node_ids[i])->neighbor_count;
+
+    char header[SNAPSHOT_HEADER_BYTES] = {0};
+    uint32_t type = (uint32_t)graph->type;
+    uint64_t nodes = graph->node_count;
+    memcpy(header, snapshot_magic, 8);
+    memcpy(header + 8, &type, 4);
+    memcpy(header + 16, &nodes, 8);
+    memcpy(header + 24, &arcs, 8);
+    snapshot_put(&writer, header, SNAPSHOT_HEADER_BYTES);
+
+    // Insertion order and neighbor order are kept, so recovery is exact
+    for (size_t i = 0; i < graph->node_count; i++) {
+        const Node* node = find_node(graph, graph->node_ids[i]);
+        int32_t id = node->id;
+        uint32_t degree = (uint32_t)node->neighbor_count;
+        snapshot_put(&writer, &id, 4);
+        snapshot_put(&writer, &degree, 4);
+
+        for (size_t j = 0; j < node->neighbor_count; j++) {
+            int32_t target = node->neighbors[j].node_id;
+            snapshot_put(&writer, &target, 4);
+            snapshot_put(&writer, &node->neighbors[j].weight, 8);
+        }
+    }
+    snapshot_put(&writer, snapshot_end, 8);
+
+    writer.ok = writer.ok && write_full(writer.fd, writer.buffer, writer.length) == STATUS_SUCCESS;
+    writer.ok = writer.ok && fsync(writer.fd) == 0;
+    writer.ok = close(writer.fd) == 0 && writer.ok;
+    if (!writer.ok || rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+
+    int dir = open(store->directory, O_RDONLY);
+    if (dir >= 0) {
+        fsync(dir);
+        close(dir);
+    }
+    return true;
+}
+
+// Helper: start a new log segment, the old one is complete once this returns
+static Status wal_rotate(GraphStore* store, uint64_t segment) {
+    char* path = store_path(store, "wal", segment, ".log");
+    if (!path) return STATUS_OOM;
+
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    free(path);
+    if (fd < 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to create write-ahead log", errno, -1);
+        return STATUS_ERROR;
+    }
+
+    char header[WAL_HEADER_BYTES] = {0};
+    uint32_t type = (uint32_t)store->graph->type;
+    memcpy(header, wal_magic, 8);
+    memcpy(header + 8, &type, 4);
+    if (write_full(fd, header, WAL_HEADER_BYTES) != STATUS_SUCCESS || (store->config.sync && fsync(fd) != 0)) {
+        close(fd);
+        return STATUS_ERROR;
+    }
+
+    pthread_mutex_lock(&store->lock);
+    int old_fd = store->wal_fd;
+    store->wal_fd = fd;
+    store->segment = segment;
+    pthread_mutex_unlock(&store->lock);
+
+    if (old_fd >= 0) close(old_fd);
+    return STATUS_SUCCESS;
+}
+
+Status graph_store_snapshot(GraphStore* store) {
+    DIAG_CHECK(store, STATUS_INVALID, "invalid graph store");
+
+    pthread_mutex_lock(&store->lock);
+    snapshot_reap(store, false);
+    bool busy = store->snapshot_pid != 0;
+    pthread_mutex_unlock(&store->lock);
+    if (busy) {
+        DIAG(DIAG_INFO, ERR_EXISTS, "snapshot already running", (int)store->snapshot_segment, -1);
+        return STATUS_WARNING;
+    }
+
+    // Everything logged so far belongs to the segment the snapshot replaces
+    Status status = graph_store_flush(store);
+    if (status != STATUS_SUCCESS) return status;
+
+    uint64_t segment = store->segment + 1;
+    char* temp_path = store_path(store, "snapshot", segment, ".tmp");
+    char* path = store_path(store, "snapshot", segment, ".bin");
+    if (!temp_path || !path) status = STATUS_OOM;
+    if (status == STATUS_SUCCESS) status = wal_rotate(store, segment);
+
+    if (status == STATUS_SUCCESS) {
+        pid_t pid = fork();
+        if (pid == 0) _exit(snapshot_write(store, temp_path, path) ? 0 : 1);
+
+        if (pid < 0) {
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to start background snapshot", errno, -1);
+            status = STATUS_ERROR;
+        } else {
+            pthread_mutex_lock(&store->lock);
+            store->snapshot_pid = pid;
+            store->snapshot_segment = segment;
+            pthread_cond_signal(&store->wake);     // the flusher polls for the child while it runs
+            pthread_mutex_unlock(&store->lock);
+            store->since_snapshot = 0;
+        }
+    }
+
+    free(temp_path);
+    free(path);
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Recovery
+// ---------------------------------------------------------------------------
+
+static Graph* snapshot_load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    char header[SNAPSHOT_HEADER_BYTES];
+    uint32_t type;
+    uint64_t nodes;
+    Graph* graph = NULL;
+    bool ok = fread(header, 1, SNAPSHOT_HEADER_BYTES, file) == SNAPSHOT_HEADER_BYTES && memcmp(header, snapshot_magic, 8) == 0;
+
+    if (ok) {
+        memcpy(&type, header + 8, 4);
+        memcpy(&nodes, header + 16, 8);
+        graph = graph_create(type == GRAPH_UNDIRECTED ? GRAPH_UNDIRECTED : GRAPH_DIRECTED, 0);
+        ok = graph && graph_reserve(graph, (size_t)nodes) == STATUS_SUCCESS;
+    }
+
+    for (uint64_t i = 0; ok && i < nodes; i++) {
+        int32_t id;
+        uint32_t degree;
+        ok = fread(&id, 4, 1, file) == 1 && fread(&degree, 4, 1, file) == 1 && !find_node(graph, id);
+        if (!ok) break;
+
+        Node* node = create_node(id, degree ? degree : 1);
+        ok = node != NULL;
+        for (uint32_t j = 0; ok && j < degree; j++) {
+            char arc[ARC_BYTES];
+            ok = fread(arc, ARC_BYTES, 1, file) == 1;
+            if (!ok) break;
+            memcpy(&node->neighbors[j].node_id, arc, 4);
+            memcpy(&node->neighbors[j].weight, arc + 4, 8);
+        }
+        if (node) node->neighbor_count = degree;
+
+        if (ok) ok = graph_attach_node(graph, node) == STATUS_SUCCESS;
+        else if (node) {
+            free(node->neighbors);
+            free(node);
+        }
+    }
+
+    char end[8];
+    ok = ok && fread(end, 1, 8, file) == 8 && memcmp(end, snapshot_end, 8) == 0;
+    fclose(file);
+
+    if (!ok) {
+        if (graph) graph_destroy(graph);
+        DIAG(DIAG_WARNING, ERR_INTERNAL, "ignoring incomplete snapshot", -1, -1);
+        return NULL;
+    }
+    return graph;
+}
+
+// Helper: replay one log segment, a damaged tail is cut off; false if the segment was damaged
+static bool wal_replay(GraphStore* store, const char* path, bool* read_type, GraphType* type) {
+    int fd = open(path, O_RDWR);
+    if (fd < 0) return false;
+
+    char header[WAL_HEADER_BYTES];
+    uint64_t valid = 0;
+    bool intact = read_full(fd, header, WAL_HEADER_BYTES) == WAL_HEADER_BYTES && memcmp(header, wal_magic, 8) == 0;
+    char* payload = NULL;
+    size_t payload_capacity = 0;
+
+    if (intact) {
+        valid = WAL_HEADER_BYTES;
+        if (!*read_type) {
+            uint32_t code;
+            memcpy(&code, header + 8, 4);
+            *type = code == GRAPH_UNDIRECTED ? GRAPH_UNDIRECTED : GRAPH_DIRECTED;
+            *read_type = true;
+        }
+        if (!store->graph) store->graph = graph_create(*type, 0);
+        intact = store->graph != NULL;
+    }
+
+    while (intact) {
+        uint32_t frame[2];
+        ssize_t got = read_full(fd, frame, FRAME_HEADER_BYTES);
+        if (got == 0) break;    // clean end
+        if (got != FRAME_HEADER_BYTES) {
+            intact = false;
+            break;
+        }
+
+        if (frame[0] > payload_capacity) {
+            char* grown = realloc(payload, frame[0]);
+            if (!grown) {
+                intact = false;
+                break;
+            }
+            payload = grown;
+            payload_capacity = frame[0];
+        }
+        if (read_full(fd, payload, frame[0]) != (ssize_t)frame[0] || crc32_update(0, payload, frame[0]) != frame[1]) {
+            intact = false;
+            break;
+        }
+
+        for (size_t offset = 0; offset < frame[0];) {
+            Status status = STATUS_SUCCESS;
+            size_t length = record_apply(store->graph, payload + offset, frame[0] - offset, &status);
+            if (length == 0) break;
+            offset += length;
+            store->stats.records_replayed++;
+            if (status != STATUS_SUCCESS) store->stats.replay_failures++;
+        }
+        valid += FRAME_HEADER_BYTES + frame[0];
+    }
+
+    if (!intact) {
+        DIAG(DIAG_WARNING, ERR_INTERNAL, "truncating damaged write-ahead log tail", (int)valid, -1);
+        if (ftruncate(fd, (off_t)valid) != 0) DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to truncate write-ahead log", errno, -1);
+    }
+
+    free(payload);
+    close(fd);
+    return intact;
+}
+
+static int compare_segments(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Helper: parse "<prefix>-<n><suffix>"
+static bool parse_segment(const char* name, const char* prefix, const char* suffix, uint64_t* segment) {
+    size_t prefix_length = strlen(prefix);
+    if (strncmp(name, prefix, prefix_length) != 0 || name[prefix_length] != '-') return false;
+
+    char* end;
+    errno = 0;
+    unsigned long long value = strtoull(name + prefix_length + 1, &end, 10);
+    if (errno || end == name + prefix_length + 1 || strcmp(end, suffix) != 0) return false;
+    *segment = value;
+    return true;
+}
+
+typedef struct {
+    uint64_t* items;
+    size_t count;
+    size_t capacity;
+} SegmentList;
+
+static bool segment_list_add(SegmentList* list, uint64_t segment) {
+    if (list->count == list->capacity) {
+        size_t new_capacity = list->capacity ? list->capacity * 2 : 8;
+        uint64_t* grown = realloc(list->items, new_capacity * sizeof(uint64_t));
+        if (!grown) return false;
+        list->items = grown;
+        list->capacity = new_capacity;
+    }
+    list->items[list->count++] = segment;
+    return true;
+}
+
+static Status store_recover(GraphStore* store, GraphType type) {
+    DIR* dir = opendir(store->directory);
+    if (!dir) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open store directory", errno, -1);
+        return STATUS_ERROR;
+    }
+
+    SegmentList snapshots = {0}, logs = {0};
+    Status status = STATUS_SUCCESS;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL && status == STATUS_SUCCESS) {
+        uint64_t segment;
+        if (parse_segment(entry->d_name, "snapshot", ".bin", &segment)) {
+            if (!segment_list_add(&snapshots, segment)) status = STATUS_OOM;
+        } else if (parse_segment(entry->d_name, "wal", ".log", &segment)) {
+            if (!segment_list_add(&logs, segment)) status = STATUS_OOM;
+        } else if (parse_segment(entry->d_name, "snapshot", ".tmp", &segment)) {
+            remove_segment_file(store, "snapshot", segment, ".tmp");  // interrupted snapshot
+        }
+    }
+    closedir(dir);
+
+    // A new store has no segments and no lists
+    if (snapshots.count) qsort(snapshots.items, snapshots.count, sizeof(uint64_t), compare_segments);
+    if (logs.count) qsort(logs.items, logs.count, sizeof(uint64_t), compare_segments);
+
+    // Newest complete snapshot wins, older ones are superseded
+    uint64_t base = 0;
+    for (size_t i = snapshots.count; status == STATUS_SUCCESS && i-- > 0 && !store->graph;) {
+        char* path = store_path(store, "snapshot", snapshots.items[i], ".bin");
+        if (!path) {
+            status = STATUS_OOM;
+            break;
+        }
+        store->graph = snapshot_load(path);
+        if (store->graph) base = snapshots.items[i];
+        free(path);
+    }
+
+    bool read_type = store->graph != NULL;
+    GraphType stored_type = store->graph ? store->graph->type : type;
+    uint64_t last = base;
+    bool damaged = false;
+
+    for (size_t i = 0; i < logs.count && status == STATUS_SUCCESS; i++) {
+        uint64_t segment = logs.items[i];
+        char* path = store_path(store, "wal", segment, ".log");
+        if (!path) {
+            status = STATUS_OOM;
+            break;
+        }
+
+        if (segment < base || damaged) {
+            // Covered by the snapshot, or written after a damaged record and not replayable
+            if (damaged) DIAG(DIAG_ERROR, ERR_INTERNAL, "dropping log segment after damaged record", (int)segment, -1);
+            unlink(path);
+        } else {
+            damaged = !wal_replay(store, path, &read_type, &stored_type);
+            last = segment;
+        }
+        free(path);
+    }
+
+    for (size_t i = 0; i < snapshots.count; i++) {
+        if (snapshots.items[i] < base) remove_segment_file(store, "snapshot", snapshots.items[i], ".bin");
+    }
+
+    bool existing = snapshots.count || logs.count;
+    free(snapshots.items);
+    free(logs.items);
+    if (status != STATUS_SUCCESS) return status;
+
+    if (!store->graph) store->graph = graph_create(stored_type, 0);
+    if (!store->graph) return STATUS_OOM;
+    if (existing && stored_type != type) DIAG(DIAG_INFO, ERR_NONE, "store keeps its recorded graph type", (int)stored_type, (int)type);
+    if (store->stats.replay_failures) DIAG(DIAG_WARNING, ERR_INTERNAL, "log records rejected during replay", (int)store->stats.replay_failures, -1);
+
+    store->oldest_segment = base;
+    store->segment = existing ? last + 1 : 0;
+    return wal_rotate(store, store->segment);
+}
+
+// ---------------------------------------------------------------------------
+// Store
+// ---------------------------------------------------------------------------
+
+GraphStore* graph_store_open(const char* directory, GraphType type, const PersistConfig* config) {
+    DIAG_CHECK(directory, NULL, "invalid store directory");
+
+    PersistConfig defaults = persist_config_default();
+    if (!config) config = &defaults;
+    // A zero timer would make the flusher spin on an already passed deadline
+    if (config->group_commit_bytes < MAX_RECORD_BYTES || config->group_commit_ms <= 0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid persistence config", -1, -1);
+        return NULL;
+    }
+
+    if (mkdir(directory, 0755) != 0 && errno != EEXIST) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to create store directory", errno, -1);
+        return NULL;
+    }
+
+    GraphStore* store = calloc(1, sizeof(GraphStore));
+    if (!store) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize graph store", -1, -1);
+        return NULL;
+    }
+
+    store->config = *config;
+    store->wal_fd = -1;
+    store->capacity = 2 * config->group_commit_bytes;
+    store->directory = malloc(strlen(directory) + 1);
+    store->active = malloc(store->capacity);
+    store->spare = malloc(store->capacity);
+    store->snapshot_buffer = malloc(SNAPSHOT_BUFFER);
+    pthread_mutex_init(&store->lock, NULL);
+    pthread_cond_init(&store->wake, NULL);
+    pthread_cond_init(&store->flushed, NULL);
+
+    if (!store->directory || !store->active || !store->spare || !store->snapshot_buffer) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize graph store", -1, -1);
+        graph_store_close(store);
+        return NULL;
+    }
+    strcpy(store->directory, directory);
+
+    if (store_recover(store, type) != STATUS_SUCCESS) {
+        graph_store_close(store);
+        return NULL;
+    }
+
+    if (pthread_create(&store->flusher, NULL, flusher_main, store) != 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to start log flusher", -1, -1);
+        graph_store_close(store);
+        return NULL;
+    }
+    store->flusher_running = true;
+
+    DIAG(DIAG_INFO, ERR_NONE, "graph store recovered", (int)store->stats.records_replayed, (int)store->segment);
+    return store;
+}
+
+Status graph_store_close(GraphStore* store) {
+    if (!store) return STATUS_INVALID;
+
+    Status status = STATUS_SUCCESS;
+    if (store->flusher_running) {
+        status = graph_store_flush(store);
+
+        pthread_mutex_lock(&store->lock);
+        snapshot_reap(store, true);
+        store->stopping = true;
+        pthread_cond_signal(&store->wake);
+        pthread_mutex_unlock(&store->lock);
+        pthread_join(store->flusher, NULL);
+    }
+
+    if (store->wal_fd >= 0) {
+        if (store->config.sync && fsync(store->wal_fd) != 0 && status == STATUS_SUCCESS) status = STATUS_ERROR;
+        close(store->wal_fd);
+    }
+
+    pthread_mutex_destroy(&store->lock);
+    pthread_cond_destroy(&store->wake);
+    pthread_cond_destroy(&store->flushed);
+    if (store->graph) graph_destroy(store->graph);
+    free(store->directory);
+    free(store->active);
+    free(store->spare);
+    free(store->snapshot_buffer);
+    free(store);
+    return status;
+}
+
+const Graph* graph_store_graph(const GraphStore* store) {
+    return store ? store->graph : NULL;
+}
+
+void graph_store_stats(GraphStore* store, GraphStoreStats* stats) {
+    if (!store || !stats) return;
+    pthread_mutex_lock(&store->lock);
+    *stats = store->stats;
+    pthread_mutex_unlock(&store->lock);
+}
+
+// Helper: refuse mutations once logging failed, the log no longer matches the graph
+#define CHECK_STORE \
+    if (!store) {\
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid graph store", -1, -1);\
+        return STATUS_INVALID;\
+    }\
+    if (store->failed) return STATUS_ERROR;
+
+Status graph_store_insert_node(GraphStore* store, int node_id, size_t initial_capacity) {
+    CHECK_STORE
+    Status status = graph_insert_node(store->graph, node_id, initial_capacity);
+    return status == STATUS_SUCCESS ? store_log(store, OP_INSERT_NODE, node_id, 0, 0.0) : status;
+}
+
+Status graph_store_remove_node(GraphStore* store, int node_id) {
+    CHECK_STORE
+    Status status = graph_remove_node(store->graph, node_id);
+    return status == STATUS_SUCCESS ? store_log(store, OP_REMOVE_NODE, node_id, 0, 0.0) : status;
+}
+
+Status graph_store_insert_edge(GraphStore* store, int from, int to, double weight) {
+    CHECK_STORE
+    Status status = graph_insert_edge(store->graph, from, to, weight);
+    return status == STATUS_SUCCESS ? store_log(store, OP_INSERT_EDGE, from, to, weight) : status;
+}
+
+Status graph_store_update_edge(GraphStore* store, int from, int to, double weight) {
+    CHECK_STORE
+    Status status = graph_update_edge(store->graph, from, to, weight);
+    return status == STATUS_SUCCESS ? store_log(store, OP_UPDATE_EDGE, from, to, weight) : status;
+}
+
+Status graph_store_remove_edge(GraphStore* store, int from, int to) {
+    CHECK_STORE
+    Status status = graph_remove_edge(store->graph, from, to);
+    return status == STATUS_SUCCESS ? store_log(store, OP_REMOVE_EDGE, from, to, 0.0) : status;
+}
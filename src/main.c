@@ -1,55 +1,111 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include "core/graph_build.h"
-#include "core/graph_operations.h"
-
-#define N 4
-
-/*
-int main(int argc, char* argv[]) {
-    printf("Network Analysis Toolkit v0.1.0\n");
-    
-    if (argc < 2) {
-        printf("Usage: %s <network_file>\n", argv[0]);
-        return 1;
-    }
-    
-    // TODO: Implement network loading and analysis
-    printf("Loading network from: %s\n", argv[1]);
-    
-    return 0;
-}
-*/
-
-int main() {
-    printf("Network Analysis Toolkit - Testing Basic Graph\n");
-
-    // initialize small graph
-    Graph* g = graph_create(GRAPH_UNDIRECTED, 4);
-    if (!g) {
-        fprintf(stderr, "Failed to create graph\n");
-        return 1;
-    }
-
-    // adding nodes
-    printf("Adding nodes 1, 2, 3...\n");
-    graph_insert_node(g, 1, N);
-    graph_insert_node(g, 2, N);
-    graph_insert_node(g, 3, N);
-
-    // Add edges
-    printf("Adding edges...\n");
-    graph_insert_edge(g, 1, 2, 1.5);
-    graph_insert_edge(g, 2, 3, 2.0);
-    graph_insert_edge(g, 3, 1, 0.8);
-
-    // check result
-    printf("Graph has %zu nodes and %zu edges\n",
-        graph_node_count(g), graph_edge_count(g));
-
-    // clean up
-    graph_destroy(g);
-    printf("Test completed succesfully.\n");
-
-    return 0;
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "core/graph_build.h"
+#include "core/graph_operations.h"
+#include "io/edge_list.h"
+#include "server/graph_server.h"
+#include "utils/diagnostics.h"
+
+#define N 4
+
+/*
+int main(int argc, char* argv[]) {
+    printf("Network Analysis Toolkit v0.1.0\n");
+    
+    if (argc < 2) {
+        printf("Usage: %s <network_file>\n", argv[0]);
+        return 1;
+    }
+    
+    // TODO: Implement network loading and analysis
+    printf("Loading network from: %s\n", argv[1]);
+    
+    return 0;
+}
+*/
+
+static GraphServer* running_server = NULL;
+
+static void handle_stop(int signal_number) {
+    (void)signal_number;
+    graph_server_stop(running_server);
+}
+
+// serve <socket> <edge_list> [directed]: keep the graph resident and answer queries
+static int serve(const char* socket_path, const char* filename, GraphType type) {
+    Graph* g = graph_create(type, 1024);
+    if (!g) {
+        fprintf(stderr, "Failed to create graph\n");
+        return 1;
+    }
+    if (load_graph(filename, g) < 0) {
+        fprintf(stderr, "Failed to load %s\n", filename);
+        graph_destroy(g);
+        return 1;
+    }
+
+    ServerConfig config = server_config_default();
+    config.socket_path = socket_path;
+    running_server = graph_server_create(g, &config);
+    if (!running_server) {
+        graph_destroy(g);
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    printf("Serving %zu nodes on %s\n", graph_node_count(g), socket_path);
+    Status status = graph_server_run(running_server);
+
+    graph_server_destroy(running_server);
+    running_server = NULL;
+    graph_destroy(g);
+    return status == STATUS_SUCCESS ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    // library diagnostics are silent by default
+    diag_set_sink(diag_stderr_sink, NULL, DIAG_WARNING);
+
+    if (argc >= 4 && strcmp(argv[1], "serve") == 0) {
+        GraphType type = argc >= 5 && strcmp(argv[4], "directed") == 0 ? GRAPH_DIRECTED : GRAPH_UNDIRECTED;
+        return serve(argv[2], argv[3], type);
+    }
+
+    printf("Network Analysis Toolkit - Testing Basic Graph\n");
+
+    // initialize small graph
+    Graph* g = graph_create(GRAPH_UNDIRECTED, 4);
+    if (!g) {
+        fprintf(stderr, "Failed to create graph\n");
+        return 1;
+    }
+
+    // adding nodes
+    printf("Adding nodes 1, 2, 3...\n");
+    graph_insert_node(g, 1, N);
+    graph_insert_node(g, 2, N);
+    graph_insert_node(g, 3, N);
+
+    // Add edges
+    printf("Adding edges...\n");
+    graph_insert_edge(g, 1, 2, 1.5);
+    graph_insert_edge(g, 2, 3, 2.0);
+    graph_insert_edge(g, 3, 1, 0.8);
+
+    // check result
+    printf("Graph has %zu nodes and %zu edges\n",
+        graph_node_count(g), graph_edge_count(g));
+
+    // clean up
+    graph_destroy(g);
+    printf("Test completed succesfully.\n");
+
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "metrics/centrality.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/thread_utils.h"
+
+#define MAX_WORDS 8     // 512 sources per batch
+
+// * Per-thread traversal state, allocated on the thread's first batch
+typedef struct {
+    uint64_t* seen;
+    uint64_t* frontier;
+    uint64_t* next;
+    uint64_t* histogram;
+    size_t histogram_capacity;
+    Status status;
+} MsBfsWorkspace;
+
+typedef struct {
+    const GraphCsr* csr;
+    const uint32_t* sources;    // dense indices
+    size_t source_count;
+    size_t words;               // 64-bit words per node bitset
+    MsBfsWorkspace* workspaces;
+    CentralityResult* result;
+} MsBfs;
+
+CentralityConfig centrality_config_default(void) {
+    CentralityConfig config;
+    config.batch_width = 256;
+    config.num_threads = 0;
+    config.sources = NULL;
+    config.source_count = 0;
+    return config;
+}
+
+static bool workspace_init(MsBfsWorkspace* ws, size_t node_count, size_t words) {
+    size_t cells = (node_count ? node_count : 1) * words;
+    ws->seen = malloc(cells * sizeof(uint64_t));
+    ws->frontier = malloc(cells * sizeof(uint64_t));
+    ws->next = malloc(cells * sizeof(uint64_t));
+    ws->histogram_capacity = 64;
+    ws->histogram = calloc(ws->histogram_capacity, sizeof(uint64_t));
+    return ws->seen && ws->frontier && ws->next && ws->histogram;
+}
+
+static void workspace_free(MsBfsWorkspace* ws) {
+    free(ws->seen);
+    free(ws->frontier);
+    free(ws->next);
+    free(ws->histogram);
+}
+
+static bool histogram_add(MsBfsWorkspace* ws, size_t distance, uint64_t pairs) {
+    if (distance >= ws->histogram_capacity) {
+        size_t new_capacity = ws->histogram_capacity * 2;
+        while (new_capacity <= distance) new_capacity *= 2;
+
+        uint64_t* grown = realloc(ws->histogram, new_capacity * sizeof(uint64_t));
+        if (!grown) return false;
+        memset(grown + ws->histogram_capacity, 0, (new_capacity - ws->histogram_capacity) * sizeof(uint64_t));
+        ws->histogram = grown;
+        ws->histogram_capacity = new_capacity;
+    }
+
+    ws->histogram[distance] += pairs;
+    return true;
+}
+
+// Helper: one MS-BFS over up to 64 * words sources. words is a small constant at
+// every call site so the bitset loops unroll.
+static inline void msbfs_batch(const MsBfs* bfs, MsBfsWorkspace* ws, size_t first, size_t count, size_t words) {
+    const GraphCsr* csr = bfs->csr;
+    size_t n = csr->node_count;
+    uint64_t* seen = ws->seen;
+    uint64_t* frontier = ws->frontier;
+    uint64_t* next = ws->next;
+
+    uint64_t reached[MAX_WORDS * 64] = {0};
+    uint64_t total_distance[MAX_WORDS * 64] = {0};
+    double harmonic[MAX_WORDS * 64] = {0};
+    uint64_t level_hits[MAX_WORDS * 64];
+
+    memset(seen, 0, n * words * sizeof(uint64_t));
+    memset(frontier, 0, n * words * sizeof(uint64_t));
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t source = bfs->sources[first + i];
+        seen[source * words + i / 64] |= 1ULL << (i % 64);
+        frontier[source * words + i / 64] |= 1ULL << (i % 64);
+    }
+    if (!histogram_add(ws, 0, count)) {
+        ws->status = STATUS_OOM;
+        return;
+    }
+
+    for (size_t distance = 1;; distance++) {
+        memset(next, 0, n * words * sizeof(uint64_t));
+
+        // Push every active source set to all neighbors in one scan
+        for (size_t v = 0; v < n; v++) {
+            const uint64_t* bits = &frontier[v * words];
+            uint64_t any = 0;
+            for (size_t w = 0; w < words; w++) any |= bits[w];
+            if (!any) continue;
+
+            for (size_t e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+                uint64_t* target = &next[(size_t)csr->targets[e] * words];
+                for (size_t w = 0; w < words; w++) target[w] |= bits[w];
+            }
+        }
+
+        memset(level_hits, 0, count * sizeof(uint64_t));
+        uint64_t discovered = 0;
+
+        for (size_t u = 0; u < n; u++) {
+            uint64_t* fresh = &frontier[u * words];
+            uint64_t* visited = &seen[u * words];
+            const uint64_t* incoming = &next[u * words];
+
+            for (size_t w = 0; w < words; w++) {
+                uint64_t bits = incoming[w] & ~visited[w];
+                fresh[w] = bits;
+                if (!bits) continue;
+
+                visited[w] |= bits;
+                discovered += (uint64_t)__builtin_popcountll(bits);
+                while (bits) {
+                    level_hits[w * 64 + (size_t)__builtin_ctzll(bits)]++;
+                    bits &= bits - 1;
+                }
+            }
+        }
+
+        if (!discovered) break;
+
+        double inverse = 1.0 / (double)distance;
+        for (size_t i = 0; i < count; i++) {
+            reached[i] += level_hits[i];
+            total_distance[i] += level_hits[i] * distance;
+            harmonic[i] += (double)level_hits[i] * inverse;
+        }
+
+        if (!histogram_add(ws, distance, discovered)) {
+            ws->status = STATUS_OOM;
+            return;
+        }
+    }
+
+    CentralityResult* result = bfs->result;
+    double others = n > 1 ? (double)(n - 1) : 1.0;
+    for (size_t i = 0; i < count; i++) {
+        double r = (double)reached[i];
+        result->closeness[first + i] = total_distance[i] ? (r / others) * (r / (double)total_distance[i]) : 0.0;
+        result->harmonic[first + i] = harmonic[i] / others;
+    }
+}
+
+static void batch_task(void* ctx, size_t task, int thread_id) {
+    MsBfs* bfs = ctx;
+    MsBfsWorkspace* ws = &bfs->workspaces[thread_id];
+    if (ws->status != STATUS_SUCCESS) return;
+
+    if (!ws->seen && !workspace_init(ws, bfs->csr->node_count, bfs->words)) {
+        ws->status = STATUS_OOM;
+        return;
+    }
+
+    size_t width = bfs->words * 64;
+    size_t first = task * width;
+    size_t count = first + width < bfs->source_count ? width : bfs->source_count - first;
+
+    switch (bfs->words) {
+        case 1: msbfs_batch(bfs, ws, first, count, 1); break;
+        case 2: msbfs_batch(bfs, ws, first, count, 2); break;
+        case 4: msbfs_batch(bfs, ws, first, count, 4); break;
+        default: msbfs_batch(bfs, ws, first, count, 8); break;
+    }
+}
+
+// Helper: dense source indices, every node when config has no sources
+static Status resolve_sources(const GraphCsr* csr, const CentralityConfig* config, CentralityResult* result, uint32_t** sources) {
+    size_t count = config->sources ? config->source_count : csr->node_count;
+
+    *sources = malloc((count ? count : 1) * sizeof(uint32_t));
+    result->ids = malloc((count ? count : 1) * sizeof(int));
+    result->closeness = calloc(count ? count : 1, sizeof(double));
+    result->harmonic = calloc(count ? count : 1, sizeof(double));
+    if (!*sources || !result->ids || !result->closeness || !result->harmonic) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize centrality result", -1, -1);
+        return STATUS_OOM;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t index = config->sources ? graph_csr_index(csr, config->sources[i]) : (uint32_t)i;
+        if (index == CSR_NO_INDEX) {
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", config->sources[i], -1);
+            return STATUS_WARNING;
+        }
+        (*sources)[i] = index;
+        result->ids[i] = csr->ids[index];
+    }
+
+    result->count = count;
+    return STATUS_SUCCESS;
+}
+
+Status graph_centrality(const Graph* graph, const CentralityConfig* config, CentralityResult* result) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(result, STATUS_INVALID, "invalid result");
+    memset(result, 0, sizeof(*result));
+
+    CentralityConfig defaults = centrality_config_default();
+    if (!config) config = &defaults;
+
+    int width = config->batch_width;
+    if (width != 64 && width != 128 && width != 256 && width != 512) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "batch width must be 64, 128, 256 or 512", width, -1);
+        return STATUS_INVALID;
+    }
+    if (config->sources == NULL && config->source_count != 0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid source list", -1, -1);
+        return STATUS_INVALID;
+    }
+
+    GraphCsr csr;
+    Status status = graph_csr_build(graph, &csr, false, config->num_threads);
+    if (status != STATUS_SUCCESS) return status;
+
+    uint32_t* sources = NULL;
+    status = resolve_sources(&csr, config, result, &sources);
+
+    size_t words = (size_t)width / 64;
+    size_t batch_count = (result->count + (size_t)width - 1) / (size_t)width;
+    int threads = thread_count_resolve(config->num_threads);
+    if ((size_t)threads > batch_count) threads = batch_count ? (int)batch_count : 1;
+
+    MsBfs bfs = {&csr, sources, result->count, words, NULL, result};
+    if (status == STATUS_SUCCESS) {
+        bfs.workspaces = calloc((size_t)threads, sizeof(MsBfsWorkspace));
+        if (!bfs.workspaces) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize centrality workspace", -1, -1);
+            status = STATUS_OOM;
+        }
+    }
+
+    if (status == STATUS_SUCCESS) status = parallel_for(batch_count, threads, batch_task, &bfs);
+
+    // Merge per-thread histograms, counts are exact so order does not matter
+    size_t length = 0;
+    for (int t = 0; bfs.workspaces && t < threads; t++) {
+        if (bfs.workspaces[t].status != STATUS_SUCCESS && status == STATUS_SUCCESS) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to run multi-source bfs", t, -1);
+            status = bfs.workspaces[t].status;
+        }
+        for (size_t d = 0; bfs.workspaces[t].histogram && d < bfs.workspaces[t].histogram_capacity; d++) {
+            if (bfs.workspaces[t].histogram[d] && d + 1 > length) length = d + 1;
+        }
+    }
+
+    if (status == STATUS_SUCCESS) {
+        result->hop_histogram = calloc(length ? length : 1, sizeof(uint64_t));
+        if (!result->hop_histogram) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize hop histogram", -1, -1);
+            status = STATUS_OOM;
+        }
+    }
+
+    if (status == STATUS_SUCCESS) {
+        result->max_distance = length ? length - 1 : 0;
+        for (int t = 0; t < threads; t++) {
+            size_t limit = bfs.workspaces[t].histogram_capacity < length ? bfs.workspaces[t].histogram_capacity : length;
+            for (size_t d = 0; bfs.workspaces[t].histogram && d < limit; d++) {
+                result->hop_histogram[d] += bfs.workspaces[t].histogram[d];
+            }
+        }
+    }
+
+    for (int t = 0; bfs.workspaces && t < threads; t++) workspace_free(&bfs.workspaces[t]);
+    free(bfs.workspaces);
+    free(sources);
+    graph_csr_free(&csr);
+
+    if (status != STATUS_SUCCESS) centrality_result_free(result);
+    return status;
+}
+
+void centrality_result_free(CentralityResult* result) {
+    if (!result) return;
+    free(result->ids);
+    free(result->closeness);
+    free(result->harmonic);
+    free(result->hop_histogram);
+    memset(result, 0, sizeof(*result));
+}
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "metrics/hyperanf.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/random_utils.h"
+#include "utils/thread_utils.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define ANF_TASK_NODES 1024     // nodes per update task
+#define MIN_LOG2M 4
+#define MAX_LOG2M 16
+
+typedef struct {
+    const GraphCsr* csr;
+    size_t registers;           // per counter
+    int log2m;
+    uint8_t* current;
+    uint8_t* next;
+    uint8_t* changed;           // per node, set when the counter grew last round
+    uint8_t* next_changed;
+    double* estimates;          // per node, cached size estimate of the counter
+    double* task_sums;          // per task, summed in task order for determinism
+    size_t* task_changes;
+    double inverse_powers[65];  // 2^-k
+    double alpha_mm;            // bias constant * m^2
+} HyperAnf;
+
+HyperAnfConfig hyperanf_config_default(void) {
+    HyperAnfConfig config;
+    config.log2m = 10;
+    config.max_iterations = 0;
+    config.memory_limit = 0;
+    config.alpha = 0.9;
+    config.seed = 1;
+    config.num_threads = 0;
+    return config;
+}
+
+// Helper: dst = max(dst, src) register-wise, true if any register grew
+static bool registers_merge(uint8_t* restrict dst, const uint8_t* restrict src, size_t count) {
+    size_t i = 0;
+    bool grew = false;
+
+#ifdef __SSE2__
+    // count is a power of two >= 16
+    for (; i + 16 <= count; i += 16) {
+        __m128i old_value = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i merged = _mm_max_epu8(old_value, _mm_loadu_si128((const __m128i*)(src + i)));
+        grew |= _mm_movemask_epi8(_mm_cmpeq_epi8(merged, old_value)) != 0xFFFF;
+        _mm_storeu_si128((__m128i*)(dst + i), merged);
+    }
+#endif
+
+    for (; i < count; i++) {
+        uint8_t merged = src[i] > dst[i] ? src[i] : dst[i];
+        grew |= merged != dst[i];
+        dst[i] = merged;
+    }
+    return grew;
+}
+
+static double counter_estimate(const HyperAnf* anf, const uint8_t* counter) {
+    double sum = 0.0;
+    size_t zeros = 0;
+
+    for (size_t i = 0; i < anf->registers; i++) {
+        sum += anf->inverse_powers[counter[i]];
+        zeros += counter[i] == 0;
+    }
+
+    double estimate = anf->alpha_mm / sum;
+    double m = (double)anf->registers;
+
+    // Small range correction (linear counting)
+    if (estimate <= 2.5 * m && zeros > 0) estimate = m * log(m / (double)zeros);
+    return estimate;
+}
+
+static void counter_add(const HyperAnf* anf, uint8_t* counter, uint64_t seed, size_t index) {
+    uint64_t h = mix64(seed ^ mix64((uint64_t)index));
+    size_t slot = (size_t)(h & (anf->registers - 1));
+    uint64_t rest = h >> anf->log2m;
+
+    uint8_t rank = rest ? (uint8_t)(__builtin_ctzll(rest) + 1) : (uint8_t)(64 - anf->log2m + 1);
+    if (rank > counter[slot]) counter[slot] = rank;
+}
+
+static void update_task(void* ctx, size_t task, int thread_id) {
+    (void)thread_id;
+    HyperAnf* anf = ctx;
+    const GraphCsr* csr = anf->csr;
+    size_t m = anf->registers;
+
+    size_t start = task * ANF_TASK_NODES;
+    size_t end = start + ANF_TASK_NODES < csr->node_count ? start + ANF_TASK_NODES : csr->node_count;
+    double sum = 0.0;
+    size_t changes = 0;
+
+    for (size_t x = start; x < end; x++) {
+        uint8_t* counter = anf->next + x * m;
+        memcpy(counter, anf->current + x * m, m);
+
+        // Unchanged neighbors were already merged in an earlier round
+        bool grew = false;
+        for (size_t e = csr->offsets[x]; e < csr->offsets[x + 1]; e++) {
+            uint32_t y = csr->targets[e];
+            if (anf->changed[y]) grew |= registers_merge(counter, anf->current + (size_t)y * m, m);
+        }
+
+        anf->next_changed[x] = grew;
+        if (grew) {
+            anf->estimates[x] = counter_estimate(anf, counter);
+            changes++;
+        }
+        sum += anf->estimates[x];
+    }
+
+    anf->task_sums[task] = sum;
+    anf->task_changes[task] = changes;
+}
+
+// Helper: bytes needed for counters at the given precision
+static size_t anf_bytes(size_t node_count, size_t task_count, int log2m) {
+    size_t registers = (size_t)1 << log2m;
+    return 2 * node_count * registers + 2 * node_count + node_count * sizeof(double)
+        + task_count * (sizeof(double) + sizeof(size_t));
+}
+
+static size_t csr_bytes(const GraphCsr* csr) {
+    return csr->node_count * (sizeof(int) + sizeof(size_t)) + sizeof(size_t)
+        + csr->arc_count * sizeof(uint32_t) + csr->slot_capacity * sizeof(CsrSlot);
+}
+
+static void anf_free(HyperAnf* anf) {
+    free(anf->current);
+    free(anf->next);
+    free(anf->changed);
+    free(anf->next_changed);
+    free(anf->estimates);
+    free(anf->task_sums);
+    free(anf->task_changes);
+}
+
+// Helper: distance statistics from the neighborhood function
+static void summarize(HyperAnfResult* result, double alpha) {
+    const double* n = result->neighborhood;
+    size_t last = result->iterations;
+
+    double reachable = n[last] - n[0];
+    double weighted = 0.0;
+    for (size_t t = 1; t <= last; t++) weighted += (double)t * (n[t] - n[t - 1]);
+    result->average_distance = reachable > 0.0 ? weighted / reachable : 0.0;
+
+    double threshold = alpha * n[last];
+    result->effective_diameter = 0.0;
+    for (size_t t = 0; t <= last; t++) {
+        if (n[t] < threshold) continue;
+        if (t > 0 && n[t] > n[t - 1]) {
+            result->effective_diameter = (double)(t - 1) + (threshold - n[t - 1]) / (n[t] - n[t - 1]);
+        } else {
+            result->effective_diameter = (double)t;
+        }
+        break;
+    }
+}
+
+Status graph_hyperanf(const Graph* graph, const HyperAnfConfig* config, HyperAnfResult* result) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(result, STATUS_INVALID, "invalid result");
+    memset(result, 0, sizeof(*result));
+
+    HyperAnfConfig defaults = hyperanf_config_default();
+    if (!config) config = &defaults;
+    if (config->log2m < MIN_LOG2M || config->log2m > MAX_LOG2M || config->alpha <= 0.0 || config->alpha > 1.0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid hyperanf config", config->log2m, -1);
+        return STATUS_INVALID;
+    }
+
+    GraphCsr csr;
+    Status status = graph_csr_build(graph, &csr, false, config->num_threads);
+    if (status != STATUS_SUCCESS) return status;
+
+    size_t n = csr.node_count;
+    size_t task_count = (n + ANF_TASK_NODES - 1) / ANF_TASK_NODES;
+
+    // Lower precision until counters fit next to the snapshot
+    int log2m = config->log2m;
+    size_t snapshot = csr_bytes(&csr);
+    while (config->memory_limit && log2m > MIN_LOG2M && snapshot + anf_bytes(n, task_count, log2m) > config->memory_limit) log2m--;
+    if (config->memory_limit && snapshot + anf_bytes(n, task_count, log2m) > config->memory_limit) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "hyperanf memory limit too small", (int)log2m, -1);
+        graph_csr_free(&csr);
+        return STATUS_OOM;
+    }
+    if (log2m < config->log2m) DIAG(DIAG_INFO, ERR_NONE, "hyperanf precision lowered to fit memory limit", log2m, config->log2m);
+
+    HyperAnf anf;
+    memset(&anf, 0, sizeof(anf));
+    anf.csr = &csr;
+    anf.log2m = log2m;
+    anf.registers = (size_t)1 << log2m;
+
+    size_t counters = n ? n : 1;
+    size_t tasks = task_count ? task_count : 1;
+    anf.current = calloc(counters, anf.registers);
+    anf.next = malloc(counters * anf.registers);
+    anf.changed = malloc(counters);
+    anf.next_changed = malloc(counters);
+    anf.estimates = malloc(counters * sizeof(double));
+    anf.task_sums = calloc(tasks, sizeof(double));
+    anf.task_changes = calloc(tasks, sizeof(size_t));
+
+    size_t max_rounds = config->max_iterations ? config->max_iterations : n + 1;
+    size_t history_capacity = 64 < max_rounds + 1 ? 64 : max_rounds + 1;
+    result->neighborhood = malloc(history_capacity * sizeof(double));
+
+    if (!anf.current || !anf.next || !anf.changed || !anf.next_changed || !anf.estimates
+        || !anf.task_sums || !anf.task_changes || !result->neighborhood) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize hyperanf counters", -1, -1);
+        anf_free(&anf);
+        graph_csr_free(&csr);
+        hyperanf_result_free(result);
+        return STATUS_OOM;
+    }
+
+    double m = (double)anf.registers;
+    double bias = anf.registers == 16 ? 0.673 : anf.registers == 32 ? 0.697 : anf.registers == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / m);
+    anf.alpha_mm = bias * m * m;
+    for (int k = 0; k <= 64; k++) anf.inverse_powers[k] = ldexp(1.0, -k);
+
+    // Round 0: every counter holds only its own node. A single set register is
+    // always in the linear counting range, so all initial estimates are equal.
+    double initial = m * log(m / (m - 1.0));
+    for (size_t x = 0; x < n; x++) {
+        counter_add(&anf, anf.current + x * anf.registers, config->seed, x);
+        anf.estimates[x] = initial;
+        anf.changed[x] = 1;
+    }
+    result->neighborhood[0] = initial * (double)n;
+
+    double total;
+
+    size_t rounds = 0;
+    while (rounds < max_rounds && status == STATUS_SUCCESS) {
+        status = parallel_for(task_count, config->num_threads, update_task, &anf);
+        if (status != STATUS_SUCCESS) break;
+
+        size_t changes = 0;
+        total = 0.0;
+        for (size_t i = 0; i < task_count; i++) {
+            total += anf.task_sums[i];
+            changes += anf.task_changes[i];
+        }
+        if (changes == 0) break;
+
+        if (rounds + 2 > history_capacity) {
+            size_t new_capacity = history_capacity * 2;
+            double* grown = realloc(result->neighborhood, new_capacity * sizeof(double));
+            if (!grown) {
+                DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow neighborhood function", -1, -1);
+                status = STATUS_OOM;
+                break;
+            }
+            result->neighborhood = grown;
+            history_capacity = new_capacity;
+        }
+
+        rounds++;
+        // Estimates are per counter, the union can not shrink
+        result->neighborhood[rounds] = total > result->neighborhood[rounds - 1] ? total : result->neighborhood[rounds - 1];
+
+        uint8_t* swap = anf.current;
+        anf.current = anf.next;
+        anf.next = swap;
+        swap = anf.changed;
+        anf.changed = anf.next_changed;
+        anf.next_changed = swap;
+    }
+
+    if (status == STATUS_SUCCESS) {
+        result->iterations = rounds;
+        result->log2m = log2m;
+        result->relative_error = 1.04 / sqrt(m);
+        result->memory_bytes = snapshot + anf_bytes(n, task_count, log2m);
+        summarize(result, config->alpha);
+    } else {
+        hyperanf_result_free(result);
+    }
+
+    anf_free(&anf);
+    graph_csr_free(&csr);
+    return status;
+}
+
+void hyperanf_result_free(HyperAnfResult* result) {
+    if (!result) return;
+    free(result->neighborhood);
+    memset(result, 0, sizeof(*result));
+}
@@ -0,0 +1,457 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "metrics/link_prediction.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/thread_utils.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define PAIR_TASK_PAIRS 4096    // given pairs per task
+#define TOP_K_TASK_NODES 64     // source nodes per top-k task
+
+// Ranked pair by dense index, converted to IDs at the end
+typedef struct {
+    uint32_t u;
+    uint32_t v;
+    double score;
+    uint32_t common;
+} Candidate;
+
+typedef struct {
+    uint32_t* counts;           // per node, shared neighbors with the current u
+    double* sums;               // per node, summed contributions (Adamic-Adar, RA only)
+    uint32_t* marks;            // per node, u + 1 when adjacent to the current u
+    uint32_t* touched;
+    Candidate* heap;            // min-heap, the worst kept candidate at the root
+    size_t heap_size;
+} LinkWorkspace;
+
+typedef struct {
+    const GraphCsr* csr;
+    const LinkConfig* config;
+    size_t node_count;
+    const size_t* offsets;      // symmetric sorted neighbor lists
+    const uint32_t* targets;
+    size_t* support_offsets;    // owned, directed graphs only
+    uint32_t* support_targets;
+    double* contributions;      // per node, weight of being a shared neighbor
+
+    LinkPair* pairs;
+    size_t pair_count;
+    Status* task_status;
+    LinkWorkspace* workspaces;
+} LinkContext;
+
+LinkConfig link_config_default(void) {
+    LinkConfig config;
+    config.score = LINK_ADAMIC_ADAR;
+    config.top_k = 100;
+    config.include_adjacent = false;
+    config.num_threads = 0;
+    return config;
+}
+
+void link_prediction_free(LinkPrediction* result) {
+    if (!result) return;
+    free(result->pairs);
+    result->pairs = NULL;
+    result->count = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+// Helper: undirected support of a directed CSR, sorted in and out neighbors without self loops
+static Status build_support(LinkContext* ctx) {
+    const GraphCsr* csr = ctx->csr;
+    size_t n = csr->node_count;
+    size_t arcs = csr->arc_count ? csr->arc_count : 1;
+
+    size_t* in_offsets = calloc(n + 1, sizeof(size_t));
+    uint32_t* in_sources = malloc(arcs * sizeof(uint32_t));
+    size_t* cursor = malloc((n ? n : 1) * sizeof(size_t));
+    ctx->support_offsets = malloc((n + 1) * sizeof(size_t));
+    ctx->support_targets = malloc(2 * arcs * sizeof(uint32_t));
+    if (!in_offsets || !in_sources || !cursor || !ctx->support_offsets || !ctx->support_targets) {
+        free(in_offsets);
+        free(in_sources);
+        free(cursor);
+        return STATUS_OOM;
+    }
+
+    // Transpose, sources come out sorted
+    for (size_t e = 0; e < csr->arc_count; e++) in_offsets[csr->targets[e] + 1]++;
+    for (size_t v = 0; v < n; v++) in_offsets[v + 1] += in_offsets[v];
+    memcpy(cursor, in_offsets, n * sizeof(size_t));
+    for (size_t u = 0; u < n; u++) {
+        for (size_t e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) in_sources[cursor[csr->targets[e]]++] = (uint32_t)u;
+    }
+
+    // Merge both sorted lists of every node
+    size_t count = 0;
+    for (size_t u = 0; u < n; u++) {
+        ctx->support_offsets[u] = count;
+        size_t i = csr->offsets[u], i_end = csr->offsets[u + 1];
+        size_t j = in_offsets[u], j_end = in_offsets[u + 1];
+        while (i < i_end || j < j_end) {
+            uint32_t out = i < i_end ? csr->targets[i] : UINT32_MAX;
+            uint32_t in = j < j_end ? in_sources[j] : UINT32_MAX;
+            uint32_t target = out < in ? out : in;
+            if (out == target) i++;
+            if (in == target) j++;
+            if (target != (uint32_t)u) ctx->support_targets[count++] = target;
+        }
+    }
+    ctx->support_offsets[n] = count;
+
+    free(in_offsets);
+    free(in_sources);
+    free(cursor);
+    ctx->offsets = ctx->support_offsets;
+    ctx->targets = ctx->support_targets;
+    return STATUS_SUCCESS;
+}
+
+static Status link_setup(LinkContext* ctx) {
+    size_t n = ctx->csr->node_count;
+    ctx->node_count = n;
+    ctx->offsets = ctx->csr->offsets;
+    ctx->targets = ctx->csr->targets;
+
+    if (ctx->csr->type == GRAPH_DIRECTED && build_support(ctx) != STATUS_SUCCESS) return STATUS_OOM;
+
+    ctx->contributions = malloc((n ? n : 1) * sizeof(double));
+    if (!ctx->contributions) return STATUS_OOM;
+
+    for (size_t w = 0; w < n; w++) {
+        double degree = (double)(ctx->offsets[w + 1] - ctx->offsets[w]);
+        switch (ctx->config->score) {
+            case LINK_ADAMIC_ADAR:
+                ctx->contributions[w] = degree > 1.0 ? 1.0 / log(degree) : 0.0;
+                break;
+            case LINK_RESOURCE_ALLOCATION:
+                ctx->contributions[w] = degree > 0.0 ? 1.0 / degree : 0.0;
+                break;
+            default:
+                ctx->contributions[w] = 1.0;
+                break;
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+static void link_teardown(LinkContext* ctx) {
+    free(ctx->support_offsets);
+    free(ctx->support_targets);
+    free(ctx->contributions);
+}
+
+static double pair_score(const LinkContext* ctx, uint32_t u, uint32_t v, uint32_t common, double sum) {
+    switch (ctx->config->score) {
+        case LINK_COMMON_NEIGHBORS:
+            return (double)common;
+        case LINK_JACCARD: {
+            size_t united = (ctx->offsets[u + 1] - ctx->offsets[u]) + (ctx->offsets[v + 1] - ctx->offsets[v]) - common;
+            return united ? (double)common / (double)united : 0.0;
+        }
+        default:
+            return sum;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Given pairs
+// ---------------------------------------------------------------------------
+
+// Helper: shared entries of two sorted lists, contributions summed in ascending order
+static uint32_t intersect(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, const double* contributions, double* sum) {
+    size_t i = 0, j = 0;
+    uint32_t common = 0;
+    double total = 0.0;
+
+#ifdef __SSE2__
+    // Compare blocks of 4 against all rotations of the other block, then advance
+    // the block with the smaller maximum (both when equal)
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(hits));
+        while (mask) {
+            int k = __builtin_ctz((unsigned)mask);
+            total += contributions[a[i + (size_t)k]];
+            common++;
+            mask &= mask - 1;
+        }
+
+        uint32_t a_max = a[i + 3], b_max = b[j + 3];
+        if (a_max <= b_max) i += 4;
+        if (b_max <= a_max) j += 4;
+    }
+#endif
+
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            total += contributions[a[i]];
+            common++;
+            i++;
+            j++;
+        }
+    }
+
+    *sum = total;
+    return common;
+}
+
+static void pairs_task(void* arg, size_t task, int thread_id) {
+    (void)thread_id;
+    LinkContext* ctx = arg;
+    size_t begin = task * PAIR_TASK_PAIRS;
+    size_t end = begin + PAIR_TASK_PAIRS;
+    if (end > ctx->pair_count) end = ctx->pair_count;
+
+    Status status = STATUS_SUCCESS;
+    for (size_t i = begin; i < end; i++) {
+        LinkPair* pair = &ctx->pairs[i];
+        uint32_t u = graph_csr_index(ctx->csr, pair->u);
+        uint32_t v = graph_csr_index(ctx->csr, pair->v);
+        if (u == CSR_NO_INDEX || v == CSR_NO_INDEX) {
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", u == CSR_NO_INDEX ? pair->u : pair->v, -1);
+            pair->score = 0.0;
+            pair->common = 0;
+            status = STATUS_WARNING;
+            continue;
+        }
+
+        double sum;
+        pair->common = intersect(ctx->targets + ctx->offsets[u], ctx->offsets[u + 1] - ctx->offsets[u],
+            ctx->targets + ctx->offsets[v], ctx->offsets[v + 1] - ctx->offsets[v], ctx->contributions, &sum);
+        pair->score = pair_score(ctx, u, v, pair->common, sum);
+    }
+    ctx->task_status[task] = status;
+}
+
+Status graph_link_scores(const Graph* graph, LinkPair* pairs, size_t count, const LinkConfig* config) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(pairs || count == 0, STATUS_INVALID, "invalid pairs");
+
+    LinkConfig defaults = link_config_default();
+    if (!config) config = &defaults;
+    if (count == 0) return STATUS_SUCCESS;
+
+    int threads = thread_count_resolve(config->num_threads);
+    GraphCsr csr;
+    Status status = graph_csr_build(graph, &csr, false, threads);
+    if (status != STATUS_SUCCESS) return status;
+
+    LinkContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.csr = &csr;
+    ctx.config = config;
+    ctx.pairs = pairs;
+    ctx.pair_count = count;
+
+    size_t task_count = (count + PAIR_TASK_PAIRS - 1) / PAIR_TASK_PAIRS;
+    ctx.task_status = malloc(task_count * sizeof(Status));
+    if (!ctx.task_status || link_setup(&ctx) != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize link prediction", -1, -1);
+        status = STATUS_OOM;
+    }
+
+    if (status == STATUS_SUCCESS) {
+        status = parallel_for(task_count, threads, pairs_task, &ctx);
+        for (size_t t = 0; t < task_count && status == STATUS_SUCCESS; t++) status = ctx.task_status[t];
+    }
+
+    free(ctx.task_status);
+    link_teardown(&ctx);
+    graph_csr_free(&csr);
+    return status;
+}
+
+// ---------------------------------------------------------------------------
+// Top-k
+// ---------------------------------------------------------------------------
+
+// Helper: a ranks below b
+static inline bool ranks_below(const Candidate* a, const Candidate* b) {
+    if (a->score != b->score) return a->score < b->score;
+    if (a->u != b->u) return a->u > b->u;
+    return a->v > b->v;
+}
+
+static void heap_offer(LinkWorkspace* ws, size_t capacity, const Candidate* candidate) {
+    Candidate* heap = ws->heap;
+    size_t i;
+
+    if (ws->heap_size < capacity) {
+        i = ws->heap_size++;
+        while (i > 0 && ranks_below(candidate, &heap[(i - 1) / 2])) {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        heap[i] = *candidate;
+        return;
+    }
+
+    if (!ranks_below(&heap[0], candidate)) return;
+
+    // Replace the root and sift down
+    i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= ws->heap_size) break;
+        if (child + 1 < ws->heap_size && ranks_below(&heap[child + 1], &heap[child])) child++;
+        if (!ranks_below(&heap[child], candidate)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = *candidate;
+}
+
+static void top_k_task(void* arg, size_t task, int thread_id) {
+    LinkContext* ctx = arg;
+    LinkWorkspace* ws = &ctx->workspaces[thread_id];
+    const size_t* offsets = ctx->offsets;
+    const uint32_t* targets = ctx->targets;
+    bool sums = ctx->config->score == LINK_ADAMIC_ADAR || ctx->config->score == LINK_RESOURCE_ALLOCATION;
+
+    size_t begin = task * TOP_K_TASK_NODES;
+    size_t end = begin + TOP_K_TASK_NODES < ctx->node_count ? begin + TOP_K_TASK_NODES : ctx->node_count;
+
+    for (size_t u = begin; u < end; u++) {
+        uint32_t stamp = (uint32_t)u + 1;
+        for (size_t e = offsets[u]; e < offsets[u + 1]; e++) ws->marks[targets[e]] = stamp;
+
+        // Every path u - w - v with v after u, contributions added in ascending w
+        size_t touched = 0;
+        for (size_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            uint32_t w = targets[e];
+            double contribution = ctx->contributions[w];
+            for (size_t f = offsets[w + 1]; f > offsets[w] && targets[f - 1] > u; f--) {
+                uint32_t v = targets[f - 1];
+                if (ws->counts[v]++ == 0) ws->touched[touched++] = v;
+                if (sums) ws->sums[v] += contribution;
+            }
+        }
+
+        for (size_t i = 0; i < touched; i++) {
+            uint32_t v = ws->touched[i];
+            if (ctx->config->include_adjacent || ws->marks[v] != stamp) {
+                Candidate candidate = {(uint32_t)u, v, 0.0, ws->counts[v]};
+                candidate.score = pair_score(ctx, (uint32_t)u, v, ws->counts[v], sums ? ws->sums[v] : 0.0);
+                heap_offer(ws, ctx->config->top_k, &candidate);
+            }
+            ws->counts[v] = 0;
+            if (sums) ws->sums[v] = 0.0;
+        }
+    }
+}
+
+static int compare_candidates(const void* a, const void* b) {
+    const Candidate* x = a;
+    const Candidate* y = b;
+    if (ranks_below(y, x)) return -1;
+    if (ranks_below(x, y)) return 1;
+    return 0;
+}
+
+Status graph_link_top_k(const Graph* graph, const LinkConfig* config, LinkPrediction* result) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(result, STATUS_INVALID, "invalid link prediction result");
+
+    LinkConfig defaults = link_config_default();
+    if (!config) config = &defaults;
+    result->count = 0;
+    result->pairs = NULL;
+    if (config->top_k == 0) return STATUS_SUCCESS;
+
+    int threads = thread_count_resolve(config->num_threads);
+    // Every thread keeps a heap of top_k candidates and the merge holds all of them
+    if (config->top_k > SIZE_MAX / ((size_t)threads * sizeof(Candidate))) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "top_k too large", threads, -1);
+        return STATUS_INVALID;
+    }
+
+    GraphCsr csr;
+    Status status = graph_csr_build(graph, &csr, false, threads);
+    if (status != STATUS_SUCCESS) return status;
+
+    LinkContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.csr = &csr;
+    ctx.config = config;
+
+    size_t n = csr.node_count ? csr.node_count : 1;
+    ctx.workspaces = calloc((size_t)threads, sizeof(LinkWorkspace));
+    if (!ctx.workspaces || link_setup(&ctx) != STATUS_SUCCESS) status = STATUS_OOM;
+    for (int t = 0; t < threads && status == STATUS_SUCCESS; t++) {
+        LinkWorkspace* ws = &ctx.workspaces[t];
+        ws->counts = calloc(n, sizeof(uint32_t));
+        ws->sums = calloc(n, sizeof(double));
+        ws->marks = calloc(n, sizeof(uint32_t));
+        ws->touched = malloc(n * sizeof(uint32_t));
+        ws->heap = malloc(config->top_k * sizeof(Candidate));
+        if (!ws->counts || !ws->sums || !ws->marks || !ws->touched || !ws->heap) status = STATUS_OOM;
+    }
+    if (status != STATUS_SUCCESS) DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize link prediction", threads, -1);
+
+    if (status == STATUS_SUCCESS) {
+        size_t task_count = (csr.node_count + TOP_K_TASK_NODES - 1) / TOP_K_TASK_NODES;
+        status = parallel_for(task_count, threads, top_k_task, &ctx);
+    }
+
+    // Merge the per-thread heaps
+    Candidate* merged = NULL;
+    size_t merged_count = 0;
+    if (status == STATUS_SUCCESS) {
+        merged = malloc((size_t)threads * config->top_k * sizeof(Candidate));
+        if (!merged) status = STATUS_OOM;
+    }
+    if (status == STATUS_SUCCESS) {
+        for (int t = 0; t < threads; t++) {
+            memcpy(merged + merged_count, ctx.workspaces[t].heap, ctx.workspaces[t].heap_size * sizeof(Candidate));
+            merged_count += ctx.workspaces[t].heap_size;
+        }
+        qsort(merged, merged_count, sizeof(Candidate), compare_candidates);
+        if (merged_count > config->top_k) merged_count = config->top_k;
+
+        result->pairs = malloc((merged_count ? merged_count : 1) * sizeof(LinkPair));
+        if (!result->pairs) status = STATUS_OOM;
+    }
+    if (status == STATUS_SUCCESS) {
+        for (size_t i = 0; i < merged_count; i++) {
+            result->pairs[i] = (LinkPair){csr.ids[merged[i].u], csr.ids[merged[i].v], merged[i].score, merged[i].common};
+        }
+        result->count = merged_count;
+    }
+
+    free(merged);
+    for (int t = 0; ctx.workspaces && t < threads; t++) {
+        free(ctx.workspaces[t].counts);
+        free(ctx.workspaces[t].sums);
+        free(ctx.workspaces[t].marks);
+        free(ctx.workspaces[t].touched);
+        free(ctx.workspaces[t].heap);
+    }
+    free(ctx.workspaces);
+    link_teardown(&ctx);
+    graph_csr_free(&csr);
+    return status;
+}
@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "metrics/motifs.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/random_utils.h"
+#include "utils/thread_utils.h"
+
+#define MOTIF_TASK_NODES 256    // pivot nodes per task
+
+// Relation of a connected pair seen from the row node
+#define ARC_OUT 1
+#define ARC_IN 2
+#define ARC_MUTUAL 3
+
+enum { WEDGE_OO, WEDGE_II, WEDGE_IO, WEDGE_MM, WEDGE_MO, WEDGE_MI, WEDGE_TYPES };
+
+static const char* triad_names[TRIAD_COUNT] = {
+    "003", "012", "102", "021D", "021U", "021C", "111D", "111U",
+    "030T", "030C", "201", "120D", "120U", "120C", "210", "300"
+};
+
+// Triad class (TriadType + 1) of a labeled triple (a, b, c) indexed by the arc bits
+// b->a 1, a->b 2, b->c 4, c->b 8, a->c 16, c->a 32
+static const uint8_t triad_codes[64] = {
+    1, 2, 2, 3, 2, 4, 6, 8, 2, 6, 5, 7, 3, 8, 7, 11,
+    2, 6, 4, 8, 5, 9, 9, 13, 6, 10, 9, 14, 7, 14, 12, 15,
+    2, 5, 6, 7, 6, 9, 10, 14, 4, 9, 9, 12, 8, 13, 14, 15,
+    3, 7, 8, 11, 7, 12, 14, 15, 8, 14, 13, 15, 11, 15, 15, 16
+};
+
+// Wedge type from the two relations at its center
+static const uint8_t wedge_types[4][4] = {
+    {0, 0, 0, 0},
+    {0, WEDGE_OO, WEDGE_IO, WEDGE_MO},
+    {0, WEDGE_IO, WEDGE_II, WEDGE_MI},
+    {0, WEDGE_MO, WEDGE_MI, WEDGE_MM}
+};
+
+// Triad formed by a wedge whose ends are not connected
+static const TriadType open_triads[WEDGE_TYPES] = {
+    TRIAD_021D, TRIAD_021U, TRIAD_021C, TRIAD_201, TRIAD_111U, TRIAD_111D
+};
+
+// * Integer tallies per task, summed in task order
+typedef struct {
+    uint64_t closed[TRIAD_COUNT];
+    uint64_t closed_wedges[WEDGE_TYPES];
+    uint64_t asymmetric_in_triangles;   // asymmetric pairs summed over triangles
+    uint64_t mutual_in_triangles;
+    uint64_t bi_fans;
+    uint64_t bi_parallels;
+} MotifTally;
+
+// * Per-thread counters for 4-node motifs, allocated on first use
+typedef struct {
+    uint32_t* counts;
+    uint32_t* touched;
+    Status status;
+} MotifWorkspace;
+
+typedef struct {
+    const GraphCsr* csr;        // out-neighbors, sorted
+    size_t* in_offsets;         // transpose, sorted
+    uint32_t* in_sources;
+
+    // Support graph: every connected pair once per endpoint with its relation
+    size_t* offsets;
+    uint32_t* targets;
+    uint8_t* codes;
+
+    // Support pairs towards the higher (degree, index) end
+    size_t* up_offsets;
+    uint32_t* up_targets;
+    uint8_t* up_codes;
+
+    const MotifConfig* config;
+    MotifTally* tallies;
+    MotifWorkspace* workspaces;
+} MotifCensus;
+
+MotifConfig motif_config_default(void) {
+    MotifConfig config;
+    config.sample_rate = 1.0;
+    config.seed = 1;
+    config.four_node = true;
+    config.num_threads = 0;
+    return config;
+}
+
+const char* triad_name(TriadType type) {
+    if (type < 0 || type >= TRIAD_COUNT) return "unknown";
+    return triad_names[type];
+}
+
+static inline uint8_t flip(uint8_t code) {
+    return (uint8_t)(((code & ARC_OUT) << 1) | ((code & ARC_IN) >> 1));
+}
+
+static inline bool is_pivot(const MotifConfig* config, size_t node) {
+    if (config->sample_rate >= 1.0) return true;
+    uint64_t h = mix64(config->seed ^ mix64((uint64_t)node));
+    return (double)(h >> 11) * 0x1.0p-53 < config->sample_rate;
+}
+
+// ---------------------------------------------------------------------------
+// Setup
+// ---------------------------------------------------------------------------
+
+// Helper: transpose the out-neighbor lists, sources come out sorted
+static Status build_transpose(MotifCensus* census) {
+    const GraphCsr* csr = census->csr;
+    size_t n = csr->node_count;
+
+    census->in_offsets = calloc(n + 1, sizeof(size_t));
+    census->in_sources = malloc((csr->arc_count ? csr->arc_count : 1) * sizeof(uint32_t));
+    size_t* cursor = malloc((n ? n : 1) * sizeof(size_t));
+    if (!census->in_offsets || !census->in_sources || !cursor) {
+        free(cursor);
+        return STATUS_OOM;
+    }
+
+    for (size_t e = 0; e < csr->arc_count; e++) census->in_offsets[csr->targets[e] + 1]++;
+    for (size_t v = 0; v < n; v++) census->in_offsets[v + 1] += census->in_offsets[v];
+    memcpy(cursor, census->in_offsets, n * sizeof(size_t));
+
+    for (size_t u = 0; u < n; u++) {
+        for (size_t e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            census->in_sources[cursor[csr->targets[e]]++] = (uint32_t)u;
+        }
+    }
+
+    free(cursor);
+    return STATUS_SUCCESS;
+}
+
+// Helper: merge sorted out and in lists of u, NULL targets only counts
+static size_t merge_support(const MotifCensus* census, size_t u, uint32_t* targets, uint8_t* codes) {
+    const GraphCsr* csr = census->csr;
+    size_t i = csr->offsets[u], i_end = csr->offsets[u + 1];
+    size_t j = census->in_offsets[u], j_end = census->in_offsets[u + 1];
+    size_t count = 0;
+
+    while (i < i_end || j < j_end) {
+        uint32_t out = i < i_end ? csr->targets[i] : UINT32_MAX;
+        uint32_t in = j < j_end ? census->in_sources[j] : UINT32_MAX;
+        uint32_t target = out < in ? out : in;
+        uint8_t code = (uint8_t)((out == target ? ARC_OUT : 0) | (in == target ? ARC_IN : 0));
+
+        if (out == target) i++;
+        if (in == target) j++;
+        if (target == (uint32_t)u) continue; // self loop
+
+        if (targets) {
+            targets[count] = target;
+            codes[count] = code;
+        }
+        count++;
+    }
+    return count;
+}
+
+static inline bool ranks_above(const size_t* offsets, uint32_t u, uint32_t x) {
+    size_t du = offsets[u + 1] - offsets[u];
+    size_t dx = offsets[x + 1] - offsets[x];
+    return dx > du || (dx == du && x > u);
+}
+
+static Status build_support(MotifCensus* census) {
+    size_t n = census->csr->node_count;
+
+    census->offsets = malloc((n + 1) * sizeof(size_t));
+    census->up_offsets = malloc((n + 1) * sizeof(size_t));
+    if (!census->offsets || !census->up_offsets) return STATUS_OOM;
+
+    census->offsets[0] = 0;
+    for (size_t u = 0; u < n; u++) census->offsets[u + 1] = census->offsets[u] + merge_support(census, u, NULL, NULL);
+
+    size_t pairs = census->offsets[n] ? census->offsets[n] : 1;
+    census->targets = malloc(pairs * sizeof(uint32_t));
+    census->codes = malloc(pairs);
+    if (!census->targets || !census->codes) return STATUS_OOM;
+
+    for (size_t u = 0; u < n; u++) merge_support(census, u, &census->targets[census->offsets[u]], &census->codes[census->offsets[u]]);
+
+    // Orientation: every pair is kept at its lower ranked end only
+    census->up_offsets[0] = 0;
+    for (size_t u = 0; u < n; u++) {
+        size_t up = 0;
+        for (size_t e = census->offsets[u]; e < census->offsets[u + 1]; e++) {
+            up += ranks_above(census->offsets, (uint32_t)u, census->targets[e]);
+        }
+        census->up_offsets[u + 1] = census->up_offsets[u] + up;
+    }
+
+    size_t up_pairs = census->up_offsets[n] ? census->up_offsets[n] : 1;
+    census->up_targets = malloc(up_pairs * sizeof(uint32_t));
+    census->up_codes = malloc(up_pairs);
+    if (!census->up_targets || !census->up_codes) return STATUS_OOM;
+
+    for (size_t u = 0; u < n; u++) {
+        size_t cursor = census->up_offsets[u];
+        for (size_t e = census->offsets[u]; e < census->offsets[u + 1]; e++) {
+            if (!ranks_above(census->offsets, (uint32_t)u, census->targets[e])) continue;
+            census->up_targets[cursor] = census->targets[e];
+            census->up_codes[cursor] = census->codes[e];
+            cursor++;
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
+static void census_free(MotifCensus* census, int threads) {
+    free(census->in_offsets);
+    free(census->in_sources);
+    free(census->offsets);
+    free(census->targets);
+    free(census->codes);
+    free(census->up_offsets);
+    free(census->up_targets);
+    free(census->up_codes);
+    free(census->tallies);
+    for (int t = 0; census->workspaces && t < threads; t++) {
+        free(census->workspaces[t].counts);
+        free(census->workspaces[t].touched);
+    }
+    free(census->workspaces);
+}
+
+// ---------------------------------------------------------------------------
+// Counting
+// ---------------------------------------------------------------------------
+
+static void count_triangles(const MotifCensus* census, uint32_t a, MotifTally* tally) {
+    const size_t* offsets = census->up_offsets;
+    const uint32_t* targets = census->up_targets;
+    const uint8_t* codes = census->up_codes;
+
+    for (size_t e = offsets[a]; e < offsets[a + 1]; e++) {
+        uint32_t b = targets[e];
+        uint8_t ab = codes[e];
+
+        // Sorted intersection of the oriented lists of a and b
+        size_t i = offsets[a], i_end = offsets[a + 1];
+        size_t j = offsets[b], j_end = offsets[b + 1];
+        while (i < i_end && j < j_end) {
+            if (targets[i] < targets[j]) {
+                i++;
+            } else if (targets[i] > targets[j]) {
+                j++;
+            } else {
+                uint8_t ac = codes[i++];
+                uint8_t bc = codes[j++];
+
+                unsigned code = ((ab & ARC_IN) ? 1u : 0u) | ((ab & ARC_OUT) ? 2u : 0u)
+                    | ((bc & ARC_OUT) ? 4u : 0u) | ((bc & ARC_IN) ? 8u : 0u)
+                    | ((ac & ARC_OUT) ? 16u : 0u) | ((ac & ARC_IN) ? 32u : 0u);
+                tally->closed[triad_codes[code] - 1]++;
+
+                tally->closed_wedges[wedge_types[ab][ac]]++;
+                tally->closed_wedges[wedge_types[flip(ab)][bc]]++;
+                tally->closed_wedges[wedge_types[flip(ac)][flip(bc)]]++;
+
+                unsigned mutual = (ab == ARC_MUTUAL) + (ac == ARC_MUTUAL) + (bc == ARC_MUTUAL);
+                tally->mutual_in_triangles += mutual;
+                tally->asymmetric_in_triangles += 3 - mutual;
+            }
+        }
+    }
+}
+
+// Helper: sum of C(count, 2) over touched entries, resets the counters
+static uint64_t drain_pairs(MotifWorkspace* ws, size_t touched) {
+    uint64_t pairs = 0;
+    for (size_t i = 0; i < touched; i++) {
+        uint64_t count = ws->counts[ws->touched[i]];
+        pairs += count * (count - 1) / 2;
+        ws->counts[ws->touched[i]] = 0;
+    }
+    return pairs;
+}
+
+static void count_four_node(const MotifCensus* census, MotifWorkspace* ws, uint32_t a, MotifTally* tally) {
+    const GraphCsr* csr = census->csr;
+    size_t touched = 0;
+
+    // Bi-fan: pairs a < b with two common out-neighbors
+    for (size_t e = csr->offsets[a]; e < csr->offsets[a + 1]; e++) {
+        uint32_t c = csr->targets[e];
+        if (c == a) continue;
+
+        for (size_t f = census->in_offsets[c]; f < census->in_offsets[c + 1]; f++) {
+            uint32_t b = census->in_sources[f];
+            if (b <= a || b == c) continue;
+            if (ws->counts[b]++ == 0) ws->touched[touched++] = b;
+        }
+    }
+    tally->bi_fans += drain_pairs(ws, touched);
+
+    // Bi-parallel: pairs of two-paths a -> x -> d through different middles
+    touched = 0;
+    for (size_t e = csr->offsets[a]; e < csr->offsets[a + 1]; e++) {
+        uint32_t b = csr->targets[e];
+        if (b == a) continue;
+
+        for (size_t f = csr->offsets[b]; f < csr->offsets[b + 1]; f++) {
+            uint32_t d = csr->targets[f];
+            if (d == a || d == b) continue;
+            if (ws->counts[d]++ == 0) ws->touched[touched++] = d;
+        }
+    }
+    tally->bi_parallels += drain_pairs(ws, touched);
+}
+
+static void census_task(void* ctx, size_t task, int thread_id) {
+    MotifCensus* census = ctx;
+    MotifTally* tally = &census->tallies[task];
+    MotifWorkspace* ws = &census->workspaces[thread_id];
+    size_t n = census->csr->node_count;
+
+    if (census->config->four_node && !ws->counts && ws->status == STATUS_SUCCESS) {
+        ws->counts = calloc(n, sizeof(uint32_t));
+        ws->touched = malloc(n * sizeof(uint32_t));
+        if (!ws->counts || !ws->touched) ws->status = STATUS_OOM;
+    }
+
+    size_t start = task * MOTIF_TASK_NODES;
+    size_t end = start + MOTIF_TASK_NODES < n ? start + MOTIF_TASK_NODES : n;
+
+    for (size_t a = start; a < end; a++) {
+        if (!is_pivot(census->config, a)) continue;
+
+        count_triangles(census, (uint32_t)a, tally);
+        if (census->config->four_node && ws->status == STATUS_SUCCESS) count_four_node(census, ws, (uint32_t)a, tally);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Census
+// ---------------------------------------------------------------------------
+
+static uint64_t scaled(uint64_t value, double rate) {
+    if (rate >= 1.0) return value;
+    return (uint64_t)llround((double)value / rate);
+}
+
+// Helper: C(n, 3), saturating
+static uint64_t choose3(uint64_t n) {
+    if (n < 3) return 0;
+
+    uint64_t a = n, b = n - 1, c = n - 2;
+    if (a % 2 == 0) a /= 2; else b /= 2;
+    if (a % 3 == 0) a /= 3; else if (b % 3 == 0) b /= 3; else c /= 3;
+
+    if (a > UINT64_MAX / b) return UINT64_MAX;
+    uint64_t ab = a * b;
+    if (ab > UINT64_MAX / c) return UINT64_MAX;
+    return ab * c;
+}
+
+static void summarize(const MotifCensus* census, const MotifTally* total, MotifCounts* counts) {
+    double rate = census->config->sample_rate;
+    size_t n = census->csr->node_count;
+
+    for (int t = 0; t < TRIAD_COUNT; t++) counts->triads[t] = scaled(total->closed[t], rate);
+
+    // Open triads: all wedges by center relations minus those closed by a triangle
+    uint64_t wedges[WEDGE_TYPES] = {0};
+    int64_t asymmetric_sum = 0, mutual_sum = 0;
+
+    for (size_t u = 0; u < n; u++) {
+        uint64_t out = 0, in = 0, mutual = 0;
+        for (size_t e = census->offsets[u]; e < census->offsets[u + 1]; e++) {
+            uint8_t code = census->codes[e];
+            out += code == ARC_OUT;
+            in += code == ARC_IN;
+            mutual += code == ARC_MUTUAL;
+
+            // Dyads: third nodes adjacent to neither end, triangles are added back below
+            uint32_t v = census->targets[e];
+            if (v < u) continue;
+            int64_t apart = (int64_t)n - (int64_t)(census->offsets[u + 1] - census->offsets[u])
+                - (int64_t)(census->offsets[v + 1] - census->offsets[v]);
+            if (code == ARC_MUTUAL) mutual_sum += apart; else asymmetric_sum += apart;
+        }
+
+        wedges[WEDGE_OO] += out * (out ? out - 1 : 0) / 2;
+        wedges[WEDGE_II] += in * (in ? in - 1 : 0) / 2;
+        wedges[WEDGE_IO] += in * out;
+        wedges[WEDGE_MM] += mutual * (mutual ? mutual - 1 : 0) / 2;
+        wedges[WEDGE_MO] += mutual * out;
+        wedges[WEDGE_MI] += mutual * in;
+    }
+
+    for (int w = 0; w < WEDGE_TYPES; w++) {
+        uint64_t closed = scaled(total->closed_wedges[w], rate);
+        counts->triads[open_triads[w]] = wedges[w] > closed ? wedges[w] - closed : 0;
+    }
+
+    int64_t dyads = asymmetric_sum + (int64_t)scaled(total->asymmetric_in_triangles, rate);
+    counts->triads[TRIAD_012] = dyads > 0 ? (uint64_t)dyads : 0;
+    dyads = mutual_sum + (int64_t)scaled(total->mutual_in_triangles, rate);
+    counts->triads[TRIAD_102] = dyads > 0 ? (uint64_t)dyads : 0;
+
+    uint64_t connected = 0;
+    for (int t = TRIAD_012; t < TRIAD_COUNT; t++) connected += counts->triads[t];
+    uint64_t all = choose3(n);
+    counts->triads[TRIAD_003] = all == UINT64_MAX ? UINT64_MAX : (all > connected ? all - connected : 0);
+
+    counts->bi_fans = scaled(total->bi_fans, rate);
+    counts->bi_parallels = scaled(total->bi_parallels, rate);
+    counts->estimated = rate < 1.0;
+}
+
+Status graph_motif_census(const Graph* graph, const MotifConfig* config, MotifCounts* counts) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(counts, STATUS_INVALID, "invalid motif counts");
+    memset(counts, 0, sizeof(*counts));
+
+    MotifConfig defaults = motif_config_default();
+    if (!config) config = &defaults;
+    if (!(config->sample_rate > 0.0 && config->sample_rate <= 1.0)) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "motif sample rate must be in (0, 1]", -1, -1);
+        return STATUS_INVALID;
+    }
+
+    GraphCsr csr;
+    Status status = graph_csr_build(graph, &csr, false, config->num_threads);
+    if (status != STATUS_SUCCESS) return status;
+
+    MotifCensus census;
+    memset(&census, 0, sizeof(census));
+    census.csr = &csr;
+    census.config = config;
+
+    size_t task_count = (csr.node_count + MOTIF_TASK_NODES - 1) / MOTIF_TASK_NODES;
+    int threads = thread_count_resolve(config->num_threads);
+    if ((size_t)threads > task_count) threads = task_count ? (int)task_count : 1;
+
+    status = build_transpose(&census);
+    if (status == STATUS_SUCCESS) status = build_support(&census);
+    if (status == STATUS_SUCCESS) {
+        census.tallies = calloc(task_count ? task_count : 1, sizeof(MotifTally));
+        census.workspaces = calloc((size_t)threads, sizeof(MotifWorkspace));
+        if (!census.tallies || !census.workspaces) status = STATUS_OOM;
+    }
+    if (status == STATUS_OOM) DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize motif census", -1, -1);
+
+    if (status == STATUS_SUCCESS) status = parallel_for(task_count, threads, census_task, &census);
+
+    for (int t = 0; status == STATUS_SUCCESS && t < threads; t++) {
+        if (census.workspaces[t].status != STATUS_SUCCESS) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize motif counters", t, -1);
+            status = census.workspaces[t].status;
+        }
+    }
+
+    if (status == STATUS_SUCCESS) {
+        MotifTally total;
+        memset(&total, 0, sizeof(total));
+        for (size_t i = 0; i < task_count; i++) {
+            const MotifTally* tally = &census.tallies[i];
+            for (int t = 0; t < TRIAD_COUNT; t++) total.closed[t] += tally->closed[t];
+            for (int w = 0; w < WEDGE_TYPES; w++) total.closed_wedges[w] += tally->closed_wedges[w];
+            total.asymmetric_in_triangles += tally->asymmetric_in_triangles;
+            total.mutual_in_triangles += tally->mutual_in_triangles;
+            total.bi_fans += tally->bi_fans;
+            total.bi_parallels += tally->bi_parallels;
+        }
+        summarize(&census, &total, counts);
+    }
+
+    census_free(&census, threads);
+    graph_csr_free(&csr);
+    return status;
+}
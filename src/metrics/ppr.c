@@ -0,0 +1,408 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "core/graph_build.h"
+#include "metrics/ppr.h"
+#include "utils/general_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/thread_utils.h"
+
+#define MIN_MAP_CAPACITY 1024
+#define MIN_QUEUE_CAPACITY 256
+
+// * Sparse per-query state, stamped with the query epoch so a new query starts
+// * without clearing the map
+typedef struct {
+    int id;
+    uint32_t epoch;
+    bool queued;
+    const Node* node;
+    double estimate;
+    double residual;
+} PprEntry;
+
+typedef struct {
+    PprEntry* entries;
+    size_t capacity;            // power of two
+    size_t count;
+    uint32_t epoch;
+
+    int* touched;               // IDs in first touch order, for result collection
+    size_t touched_capacity;
+
+    int* queue;                 // ring buffer of IDs waiting to push
+    size_t queue_capacity;      // power of two
+    size_t queue_head;
+    size_t queue_size;
+
+    double* seed_weights;       // normalized restart distribution
+    size_t seed_capacity;
+
+    Status status;
+} PprWorkspace;
+
+typedef struct {
+    const Graph* graph;
+    const PprQuery* queries;
+    const PprConfig* config;
+    PprResult* results;
+    Status* statuses;
+    PprWorkspace* workspaces;
+} PprBatch;
+
+PprConfig ppr_config_default(void) {
+    PprConfig config;
+    config.alpha = 0.15;
+    config.epsilon = 1e-6;
+    config.weighted = false;
+    config.top_k = 0;
+    config.num_threads = 0;
+    return config;
+}
+
+void ppr_result_free(PprResult* result) {
+    if (!result) return;
+    free(result->ids);
+    free(result->scores);
+    memset(result, 0, sizeof(PprResult));
+}
+
+static void workspace_free(PprWorkspace* ws) {
+    free(ws->entries);
+    free(ws->touched);
+    free(ws->queue);
+    free(ws->seed_weights);
+}
+
+// Helper: slot of id in a map of the given capacity, empty slot if absent
+static size_t map_probe(const PprEntry* entries, size_t capacity, uint32_t epoch, int id) {
+    size_t mask = capacity - 1;
+    size_t slot = hash(id, (int)capacity);
+    while (entries[slot].epoch == epoch && entries[slot].id != id) slot = (slot + 1) & mask;
+    return slot;
+}
+
+static Status map_grow(PprWorkspace* ws) {
+    size_t capacity = ws->capacity ? ws->capacity * 2 : MIN_MAP_CAPACITY;
+    PprEntry* entries = calloc(capacity, sizeof(PprEntry));
+    if (!entries) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow PPR workspace", (int)capacity, -1);
+        return STATUS_OOM;
+    }
+
+    // * Epoch 0 marks empty slots in the fresh table, live entries are restamped 1
+    for (size_t i = 0; i < ws->count; i++) {
+        const PprEntry* entry = &ws->entries[map_probe(ws->entries, ws->capacity, ws->epoch, ws->touched[i])];
+        size_t slot = map_probe(entries, capacity, 1, entry->id);
+        entries[slot] = *entry;
+        entries[slot].epoch = 1;
+    }
+
+    free(ws->entries);
+    ws->entries = entries;
+    ws->capacity = capacity;
+    ws->epoch = 1;
+    return STATUS_SUCCESS;
+}
+
+// Helper: entry of id, created with zero mass on first touch (NULL on OOM or a
+// dangling edge). Pointers are valid until the next entry is created.
+static PprEntry* entry_get(PprWorkspace* ws, const Graph* graph, int id) {
+    size_t slot = map_probe(ws->entries, ws->capacity, ws->epoch, id);
+    if (ws->entries[slot].epoch == ws->epoch) return &ws->entries[slot];
+
+    if ((ws->count + 1) * 2 > ws->capacity || ws->count == ws->touched_capacity) {
+        if (ws->count == ws->touched_capacity) {
+            size_t new_capacity = ws->touched_capacity * 2;
+            int* touched = realloc(ws->touched, new_capacity * sizeof(int));
+            if (!touched) {
+                DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow PPR workspace", (int)new_capacity, -1);
+                ws->status = STATUS_OOM;
+                return NULL;
+            }
+            ws->touched = touched;
+            ws->touched_capacity = new_capacity;
+        }
+        if ((ws->count + 1) * 2 > ws->capacity) {
+            ws->status = map_grow(ws);
+            if (ws->status != STATUS_SUCCESS) return NULL;
+        }
+        slot = map_probe(ws->entries, ws->capacity, ws->epoch, id);
+    }
+
+    const Node* node = find_node(graph, id);
+    if (!node) {
+        DIAG(DIAG_FATAL, ERR_INTERNAL, "graph corrupted, edge points to non-existing node", id, -1);
+        ws->status = STATUS_ERROR;
+        return NULL;
+    }
+
+    ws->entries[slot] = (PprEntry){id, ws->epoch, false, node, 0.0, 0.0};
+    ws->touched[ws->count++] = id;
+    return &ws->entries[slot];
+}
+
+static Status queue_push(PprWorkspace* ws, int id) {
+    if (ws->queue_size == ws->queue_capacity) {
+        size_t capacity = ws->queue_capacity * 2;
+        int* queue = malloc(capacity * sizeof(int));
+        if (!queue) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to grow PPR queue", (int)capacity, -1);
+            return STATUS_OOM;
+        }
+        for (size_t i = 0; i < ws->queue_size; i++) queue[i] = ws->queue[(ws->queue_head + i) & (ws->queue_capacity - 1)];
+        free(ws->queue);
+        ws->queue = queue;
+        ws->queue_capacity = capacity;
+        ws->queue_head = 0;
+    }
+
+    ws->queue[(ws->queue_head + ws->queue_size) & (ws->queue_capacity - 1)] = id;
+    ws->queue_size++;
+    return STATUS_SUCCESS;
+}
+
+// Helper: add mass to id's residual, queueing it once it crosses the threshold
+static Status add_residual(PprWorkspace* ws, const Graph* graph, double epsilon, int id, double mass) {
+    PprEntry* entry = entry_get(ws, graph, id);
+    if (!entry) return ws->status;
+
+    entry->residual += mass;
+    size_t degree = entry->node->neighbor_count ? entry->node->neighbor_count : 1;
+    if (entry->queued || entry->residual < epsilon * (double)degree) return STATUS_SUCCESS;
+
+    entry->queued = true;
+    return queue_push(ws, id);
+}
+
+static Status workspace_init(PprWorkspace* ws, size_t seed_count) {
+    if (!ws->entries) {
+        ws->touched_capacity = MIN_MAP_CAPACITY / 2;
+        ws->queue_capacity = MIN_QUEUE_CAPACITY;
+        ws->touched = malloc(ws->touched_capacity * sizeof(int));
+        ws->queue = malloc(ws->queue_capacity * sizeof(int));
+        if (!ws->touched || !ws->queue || map_grow(ws) != STATUS_SUCCESS) {
+            // entries stays NULL, so the next call starts over from nothing
+            free(ws->touched);
+            free(ws->queue);
+            ws->touched = NULL;
+            ws->queue = NULL;
+            return STATUS_OOM;
+        }
+    }
+    if (seed_count > ws->seed_capacity) {
+        double* weights = realloc(ws->seed_weights, seed_count * sizeof(double));
+        if (!weights) return STATUS_OOM;
+        ws->seed_weights = weights;
+        ws->seed_capacity = seed_count;
+    }
+
+    if (++ws->epoch == 0) {
+        memset(ws->entries, 0, ws->capacity * sizeof(PprEntry));
+        ws->epoch = 1;
+    }
+    ws->count = 0;
+    ws->queue_head = ws->queue_size = 0;
+    ws->status = STATUS_SUCCESS;
+    return STATUS_SUCCESS;
+}
+
+// Helper: normalized restart distribution of a query
+static Status seed_distribution(const Graph* graph, const PprQuery* query, double* weights) {
+    double total = 0.0;
+    for (size_t i = 0; i < query->seed_count; i++) {
+        if (!find_node(graph, query->seeds[i])) {
+            DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", query->seeds[i], -1);
+            return STATUS_WARNING;
+        }
+        weights[i] = query->seed_weights ? query->seed_weights[i] : 1.0;
+        if (!(weights[i] >= 0.0) || !isfinite(weights[i])) {
+            DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid seed weight", query->seeds[i], -1);
+            return STATUS_INVALID;
+        }
+        total += weights[i];
+    }
+
+    if (!(total > 0.0)) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "seed weights sum to zero", (int)query->seed_count, -1);
+        return STATUS_INVALID;
+    }
+    for (size_t i = 0; i < query->seed_count; i++) weights[i] /= total;
+    return STATUS_SUCCESS;
+}
+
+static Status push_loop(PprWorkspace* ws, const Graph* graph, const PprQuery* query, const PprConfig* config, size_t* pushes) {
+    const double* seed_weights = ws->seed_weights;
+    double spread = 1.0 - config->alpha;
+    Status status = STATUS_SUCCESS;
+
+    for (size_t i = 0; i < query->seed_count && status == STATUS_SUCCESS; i++) {
+        status = add_residual(ws, graph, config->epsilon, query->seeds[i], seed_weights[i]);
+    }
+
+    while (ws->queue_size && status == STATUS_SUCCESS) {
+        int id = ws->queue[ws->queue_head];
+        ws->queue_head = (ws->queue_head + 1) & (ws->queue_capacity - 1);
+        ws->queue_size--;
+
+        PprEntry* entry = entry_get(ws, graph, id);
+        const Node* node = entry->node;
+        double mass = entry->residual;
+        entry->queued = false;
+        entry->estimate += config->alpha * mass;
+        entry->residual = 0.0;
+        (*pushes)++;
+
+        // entry is not used below, creating neighbors may move it
+        if (node->neighbor_count == 0) {
+            for (size_t i = 0; i < query->seed_count && status == STATUS_SUCCESS; i++) {
+                status = add_residual(ws, graph, config->epsilon, query->seeds[i], spread * mass * seed_weights[i]);
+            }
+            continue;
+        }
+
+        double share = spread * mass / (double)node->neighbor_count;
+        if (config->weighted) {
+            double total = 0.0;
+            for (size_t j = 0; j < node->neighbor_count; j++) total += node->neighbors[j].weight;
+            if (!(total > 0.0) || !isfinite(total)) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "PPR weights must be finite, non-negative and not all zero", id, -1);
+                return STATUS_INVALID;
+            }
+            share = spread * mass / total;
+        }
+
+        for (size_t j = 0; j < node->neighbor_count && status == STATUS_SUCCESS; j++) {
+            double weight = config->weighted ? node->neighbors[j].weight : 1.0;
+            if (weight < 0.0) {
+                DIAG(DIAG_ERROR, ERR_INVALID_ARG, "PPR weights must be finite, non-negative and not all zero", id, node->neighbors[j].node_id);
+                return STATUS_INVALID;
+            }
+            status = add_residual(ws, graph, config->epsilon, node->neighbors[j].node_id, share * weight);
+        }
+    }
+    return status;
+}
+
+static int compare_scores(const void* a, const void* b) {
+    const PprEntry* x = a;
+    const PprEntry* y = b;
+    if (x->estimate != y->estimate) return x->estimate > y->estimate ? -1 : 1;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+static Status collect_result(PprWorkspace* ws, const PprConfig* config, PprResult* result) {
+    // * Entries are copied out in touch order and sorted, the map is not needed afterwards
+    PprEntry* ranked = malloc((ws->count ? ws->count : 1) * sizeof(PprEntry));
+    if (!ranked) return STATUS_OOM;
+
+    size_t count = 0;
+    for (size_t i = 0; i < ws->count; i++) {
+        const PprEntry* entry = &ws->entries[map_probe(ws->entries, ws->capacity, ws->epoch, ws->touched[i])];
+        result->residual += entry->residual;
+        if (entry->estimate > 0.0) ranked[count++] = *entry;
+    }
+    qsort(ranked, count, sizeof(PprEntry), compare_scores);
+    if (config->top_k && count > config->top_k) count = config->top_k;
+
+    result->ids = malloc((count ? count : 1) * sizeof(int));
+    result->scores = malloc((count ? count : 1) * sizeof(double));
+    if (!result->ids || !result->scores) {
+        free(ranked);
+        return STATUS_OOM;
+    }
+    for (size_t i = 0; i < count; i++) {
+        result->ids[i] = ranked[i].id;
+        result->scores[i] = ranked[i].estimate;
+    }
+    result->count = count;
+    result->touched = ws->count;
+
+    free(ranked);
+    return STATUS_SUCCESS;
+}
+
+static Status ppr_query(PprWorkspace* ws, const Graph* graph, const PprQuery* query, const PprConfig* config, PprResult* result) {
+    memset(result, 0, sizeof(PprResult));
+    if (!query->seeds || query->seed_count == 0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "PPR query without seeds", -1, -1);
+        return STATUS_INVALID;
+    }
+
+    Status status = workspace_init(ws, query->seed_count);
+    if (status != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize PPR workspace", -1, -1);
+        return status;
+    }
+
+    status = seed_distribution(graph, query, ws->seed_weights);
+    if (status == STATUS_SUCCESS) status = push_loop(ws, graph, query, config, &result->pushes);
+    if (status == STATUS_SUCCESS) status = collect_result(ws, config, result);
+    if (status != STATUS_SUCCESS) ppr_result_free(result);
+    return status;
+}
+
+static Status validate(const Graph* graph, const PprConfig* config) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    if (!(config->alpha > 0.0 && config->alpha <= 1.0) || !(config->epsilon > 0.0)) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid PPR config", -1, -1);
+        return STATUS_INVALID;
+    }
+    return STATUS_SUCCESS;
+}
+
+Status graph_ppr(const Graph* graph, const PprQuery* query, const PprConfig* config, PprResult* result) {
+    DIAG_CHECK(query, STATUS_INVALID, "invalid PPR query");
+    DIAG_CHECK(result, STATUS_INVALID, "invalid PPR result");
+
+    PprConfig defaults = ppr_config_default();
+    if (!config) config = &defaults;
+    memset(result, 0, sizeof(PprResult));
+    Status status = validate(graph, config);
+    if (status != STATUS_SUCCESS) return status;
+
+    PprWorkspace ws;
+    memset(&ws, 0, sizeof(ws));
+    status = ppr_query(&ws, graph, query, config, result);
+    workspace_free(&ws);
+    return status;
+}
+
+static void batch_task(void* ctx, size_t task, int thread_id) {
+    PprBatch* batch = ctx;
+    batch->statuses[task] = ppr_query(&batch->workspaces[thread_id], batch->graph, &batch->queries[task],
+        batch->config, &batch->results[task]);
+}
+
+Status graph_ppr_batch(const Graph* graph, const PprQuery* queries, size_t count, const PprConfig* config, PprResult* results) {
+    DIAG_CHECK(queries || count == 0, STATUS_INVALID, "invalid PPR queries");
+    DIAG_CHECK(results || count == 0, STATUS_INVALID, "invalid PPR results");
+
+    PprConfig defaults = ppr_config_default();
+    if (!config) config = &defaults;
+    for (size_t i = 0; i < count; i++) memset(&results[i], 0, sizeof(PprResult));
+    Status status = validate(graph, config);
+    if (status != STATUS_SUCCESS || count == 0) return status;
+
+    int threads = thread_count_resolve(config->num_threads);
+    if ((size_t)threads > count) threads = (int)count;
+
+    PprBatch batch = {graph, queries, config, results, NULL, NULL};
+    batch.statuses = malloc(count * sizeof(Status));
+    batch.workspaces = calloc((size_t)threads, sizeof(PprWorkspace));
+    if (!batch.statuses || !batch.workspaces) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate PPR batch", (int)count, -1);
+        status = STATUS_OOM;
+    }
+
+    if (status == STATUS_SUCCESS) status = parallel_for(count, threads, batch_task, &batch);
+    for (size_t i = 0; i < count && status == STATUS_SUCCESS; i++) status = batch.statuses[i];
+
+    for (int t = 0; batch.workspaces && t < threads; t++) workspace_free(&batch.workspaces[t]);
+    free(batch.workspaces);
+    free(batch.statuses);
+    return status;
+}
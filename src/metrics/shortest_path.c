@@ -0,0 +1,742 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "core/graph_build.h"
+#include "core/graph_csr.h"
+#include "metrics/shortest_path.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/io_utils.h"
+#include "utils/random_utils.h"
+#include "utils/thread_utils.h"
+
+#define INDEX_HEADER_BYTES 40       // magic, uint32 type, uint32 landmarks, uint64 nodes, uint64 arcs, uint32 graph crc, uint32 payload crc
+#define MIN_HEAP_CAPACITY 256
+#define NO_PARENT UINT32_MAX
+
+static const char index_magic[8] = {'N', 'E', 'T', 'A', 'L', 'T', '0', '1'};
+
+typedef struct {
+    const size_t* offsets;
+    const uint32_t* targets;
+    const double* weights;
+} Adjacency;
+
+// Lazy binary heap: a shorter distance pushes a new entry, stale ones are skipped on pop
+typedef struct {
+    double key;
+    uint32_t node;
+} HeapEntry;
+
+typedef struct {
+    HeapEntry* entries;
+    size_t size;
+    size_t capacity;
+} MinHeap;
+
+struct AltIndex {
+    GraphCsr csr;               // forward arcs with weights
+    size_t* in_offsets;         // reverse arcs, directed graphs only
+    uint32_t* in_sources;
+    double* in_weights;
+
+    size_t landmark_count;
+    uint32_t* landmarks;
+    float* from_landmark;       // d(L, v) at [v * landmark_count + l], rounded down
+    float* to_landmark;         // d(v, L), same array as from_landmark when undirected
+};
+
+typedef struct {
+    Adjacency arcs;
+    uint32_t* seen;             // query epoch when reached
+    uint32_t* done;             // query epoch when settled
+    double* dist;
+    double* potential;          // lower bound of the remaining distance
+    uint32_t* parent;
+    MinHeap heap;
+} SearchSide;
+
+struct AltSearch {
+    const AltIndex* index;
+    uint32_t epoch;
+    SearchSide sides[2];        // forward from the source, backward from the target
+};
+
+typedef struct {
+    AltIndex* index;
+    double** dist;              // per thread, node_count entries
+    MinHeap* heaps;             // per thread
+    Status* statuses;           // per thread
+    bool backward;              // tasks compute d(v, L) instead of d(L, v)
+} LandmarkBuild;
+
+AltConfig alt_config_default(void) {
+    AltConfig config;
+    config.landmark_count = 16;
+    config.selection = LANDMARK_FARTHEST;
+    config.seed = 1;
+    config.num_threads = 0;
+    return config;
+}
+
+void path_result_free(PathResult* result) {
+    if (!result) return;
+    free(result->nodes);
+    result->nodes = NULL;
+    result->length = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Heap and Dijkstra
+// ---------------------------------------------------------------------------
+
+static bool heap_push(MinHeap* heap, double key, uint32_t node) {
+    if (heap->size == heap->capacity) {
+        size_t capacity = heap->capacity ? heap->capacity * 2 : MIN_HEAP_CAPACITY;
+        HeapEntry* entries = realloc(heap->entries, capacity * sizeof(HeapEntry));
+        if (!entries) return false;
+        heap->entries = entries;
+        heap->capacity = capacity;
+    }
+
+    size_t i = heap->size++;
+    while (i > 0 && heap->entries[(i - 1) / 2].key > key) {
+        heap->entries[i] = heap->entries[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->entries[i] = (HeapEntry){key, node};
+    return true;
+}
+
+static HeapEntry heap_pop(MinHeap* heap) {
+    HeapEntry top = heap->entries[0];
+    HeapEntry last = heap->entries[--heap->size];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= heap->size) break;
+        if (child + 1 < heap->size && heap->entries[child + 1].key < heap->entries[child].key) child++;
+        if (heap->entries[child].key >= last.key) break;
+        heap->entries[i] = heap->entries[child];
+        i = child;
+    }
+    if (heap->size > 0) heap->entries[i] = last;
+    return top;
+}
+
+// Helper: distances from source to every node, INFINITY when unreachable
+static Status dijkstra_all(const Adjacency* arcs, size_t node_count, uint32_t source, double* dist, MinHeap* heap) {
+    for (size_t v = 0; v < node_count; v++) dist[v] = INFINITY;
+    dist[source] = 0.0;
+    heap->size = 0;
+    if (!heap_push(heap, 0.0, source)) return STATUS_OOM;
+
+    while (heap->size > 0) {
+        HeapEntry top = heap_pop(heap);
+        if (top.key > dist[top.node]) continue;
+
+        for (size_t e = arcs->offsets[top.node]; e < arcs->offsets[top.node + 1]; e++) {
+            uint32_t w = arcs->targets[e];
+            double candidate = top.key + arcs->weights[e];
+            if (candidate < dist[w]) {
+                dist[w] = candidate;
+                if (!heap_push(heap, candidate, w)) return STATUS_OOM;
+            }
+        }
+    }
+    return STATUS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// Index
+// ---------------------------------------------------------------------------
+
+static Adjacency forward_arcs(const AltIndex* index) {
+    return (Adjacency){index->csr.offsets, index->csr.targets, index->csr.weights};
+}
+
+static Adjacency backward_arcs(const AltIndex* index) {
+    if (index->csr.type == GRAPH_UNDIRECTED) return forward_arcs(index);
+    return (Adjacency){index->in_offsets, index->in_sources, index->in_weights};
+}
+
+// Helper: a float that does not exceed distance, so bounds built from it stay admissible
+static float round_down(double distance) {
+    if (distance > FLT_MAX) return isinf(distance) ? INFINITY : FLT_MAX;
+    float rounded = (float)distance;
+    if ((double)rounded > distance) rounded = nextafterf(rounded, 0.0f);
+    return rounded;
+}
+
+static void store_distances(AltIndex* index, float* table, size_t landmark, const double* dist) {
+    size_t count = index->landmark_count;
+    for (size_t v = 0; v < index->csr.node_count; v++) table[v * count + landmark] = round_down(dist[v]);
+}
+
+void alt_index_free(AltIndex* index) {
+    if (!index) return;
+    graph_csr_free(&index->csr);
+    free(index->in_offsets);
+    free(index->in_sources);
+    free(index->in_weights);
+    free(index->landmarks);
+    if (index->to_landmark != index->from_landmark) free(index->to_landmark);
+    free(index->from_landmark);
+    free(index);
+}
+
+// Helper: weighted CSR, reverse arcs and distance tables for landmark_count landmarks
+static Status index_prepare(const Graph* graph, size_t landmark_count, int num_threads, AltIndex** out) {
+    AltIndex* index = calloc(1, sizeof(AltIndex));
+    if (!index) return STATUS_OOM;
+
+    Status status = graph_csr_build(graph, &index->csr, true, num_threads);
+    if (status != STATUS_SUCCESS) {
+        free(index);
+        return status;
+    }
+
+    const GraphCsr* csr = &index->csr;
+    size_t n = csr->node_count;
+    for (size_t e = 0; e < csr->arc_count; e++) {
+        if (!(csr->weights[e] >= 0.0)) {
+            DIAG(DIAG_ERROR, ERR_INVALID_ARG, "edge weights must not be negative", csr->ids[csr->targets[e]], -1);
+            alt_index_free(index);
+            return STATUS_INVALID;
+        }
+    }
+
+    if (csr->type == GRAPH_DIRECTED) {
+        index->in_offsets = calloc(n + 1, sizeof(size_t));
+        index->in_sources = malloc((csr->arc_count ? csr->arc_count : 1) * sizeof(uint32_t));
+        index->in_weights = malloc((csr->arc_count ? csr->arc_count : 1) * sizeof(double));
+        size_t* cursor = malloc((n ? n : 1) * sizeof(size_t));
+        if (!index->in_offsets || !index->in_sources || !index->in_weights || !cursor) {
+            free(cursor);
+            alt_index_free(index);
+            return STATUS_OOM;
+        }
+
+        for (size_t e = 0; e < csr->arc_count; e++) index->in_offsets[csr->targets[e] + 1]++;
+        for (size_t v = 0; v < n; v++) index->in_offsets[v + 1] += index->in_offsets[v];
+        memcpy(cursor, index->in_offsets, n * sizeof(size_t));
+        for (size_t u = 0; u < n; u++) {
+            for (size_t e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                size_t slot = cursor[csr->targets[e]]++;
+                index->in_sources[slot] = (uint32_t)u;
+                index->in_weights[slot] = csr->weights[e];
+            }
+        }
+        free(cursor);
+    }
+
+    size_t entries = n * landmark_count;
+    index->landmark_count = landmark_count;
+    index->landmarks = malloc((landmark_count ? landmark_count : 1) * sizeof(uint32_t));
+    index->from_landmark = malloc((entries ? entries : 1) * sizeof(float));
+    index->to_landmark = csr->type == GRAPH_DIRECTED ? malloc((entries ? entries : 1) * sizeof(float)) : index->from_landmark;
+    if (!index->landmarks || !index->from_landmark || !index->to_landmark) {
+        alt_index_free(index);
+        return STATUS_OOM;
+    }
+
+    *out = index;
+    return STATUS_SUCCESS;
+}
+
+static void landmark_task(void* arg, size_t task, int thread_id) {
+    LandmarkBuild* build = arg;
+    AltIndex* index = build->index;
+    if (build->statuses[thread_id] != STATUS_SUCCESS) return;
+
+    Adjacency arcs = build->backward ? backward_arcs(index) : forward_arcs(index);
+    double* dist = build->dist[thread_id];
+    Status status = dijkstra_all(&arcs, index->csr.node_count, index->landmarks[task], dist, &build->heaps[thread_id]);
+    if (status == STATUS_SUCCESS) store_distances(index, build->backward ? index->to_landmark : index->from_landmark, task, dist);
+    build->statuses[thread_id] = status;
+}
+
+// Helper: candidate order for the next landmark. Reached nodes by distance come first,
+// then unreached ones (another component), then nodes at distance 0.
+static bool farther(double a, double b) {
+    int rank_a = a == 0.0 ? 0 : a == INFINITY ? 1 : 2;
+    int rank_b = b == 0.0 ? 0 : b == INFINITY ? 1 : 2;
+    return rank_a != rank_b ? rank_a > rank_b : a > b;
+}
+
+// Helper: landmarks one at a time, each the node farthest from all chosen so far.
+// The first search starts at the highest degree node, inside the main component. Fills d(L, v).
+static Status select_farthest(LandmarkBuild* build) {
+    AltIndex* index = build->index;
+    size_t n = index->csr.node_count;
+    Adjacency arcs = forward_arcs(index);
+    double* dist = build->dist[0];
+    double* nearest = malloc(n * sizeof(double));
+    bool* chosen = calloc(n, sizeof(bool));
+    if (!nearest || !chosen) {
+        free(nearest);
+        free(chosen);
+        return STATUS_OOM;
+    }
+
+    uint32_t start = 0;
+    for (uint32_t v = 1; v < n; v++) {
+        if (graph_csr_degree(&index->csr, v) > graph_csr_degree(&index->csr, start)) start = v;
+    }
+    Status status = dijkstra_all(&arcs, n, start, nearest, &build->heaps[0]);
+
+    for (size_t l = 0; l < index->landmark_count && status == STATUS_SUCCESS; l++) {
+        size_t best = n;
+        for (size_t v = 0; v < n; v++) {
+            if (!chosen[v] && (best == n || farther(nearest[v], nearest[best]))) best = v;
+        }
+
+        chosen[best] = true;
+        index->landmarks[l] = (uint32_t)best;
+        status = dijkstra_all(&arcs, n, (uint32_t)best, dist, &build->heaps[0]);
+        if (status != STATUS_SUCCESS) break;
+
+        store_distances(index, index->from_landmark, l, dist);
+        for (size_t v = 0; v < n; v++) {
+            if (l == 0 || dist[v] < nearest[v]) nearest[v] = dist[v];
+        }
+    }
+
+    free(nearest);
+    free(chosen);
+    return status;
+}
+
+// Helper: distinct landmarks drawn uniformly by a partial shuffle
+static Status select_random(AltIndex* index, uint64_t seed) {
+    size_t n = index->csr.node_count;
+    uint32_t* order = malloc(n * sizeof(uint32_t));
+    if (!order) return STATUS_OOM;
+    for (size_t v = 0; v < n; v++) order[v] = (uint32_t)v;
+
+    Rng rng;
+    rng_seed(&rng, seed, 0);
+    for (size_t l = 0; l < index->landmark_count; l++) {
+        size_t pick = l + (size_t)rng_bounded(&rng, n - l);
+        uint32_t swap = order[l];
+        order[l] = order[pick];
+        order[pick] = swap;
+        index->landmarks[l] = order[l];
+    }
+    free(order);
+    return STATUS_SUCCESS;
+}
+
+static Status run_landmark_tasks(LandmarkBuild* build, int threads, bool backward) {
+    build->backward = backward;
+    Status status = parallel_for(build->index->landmark_count, threads, landmark_task, build);
+    for (int t = 0; t < threads && status == STATUS_SUCCESS; t++) status = build->statuses[t];
+    return status;
+}
+
+Status alt_index_build(const Graph* graph, const AltConfig* config, AltIndex** index) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(index, STATUS_INVALID, "invalid index output");
+    *index = NULL;
+
+    AltConfig defaults = alt_config_default();
+    if (!config) config = &defaults;
+
+    int threads = thread_count_resolve(config->num_threads);
+    size_t landmark_count = config->landmark_count;
+    if (landmark_count > graph->node_count) landmark_count = graph->node_count;
+
+    AltIndex* built;
+    Status status = index_prepare(graph, landmark_count, threads, &built);
+    if (status != STATUS_SUCCESS) return status;
+
+    size_t n = built->csr.node_count;
+    LandmarkBuild build = {built, calloc((size_t)threads, sizeof(double*)), calloc((size_t)threads, sizeof(MinHeap)),
+        calloc((size_t)threads, sizeof(Status)), false};
+    if (!build.dist || !build.heaps || !build.statuses) status = STATUS_OOM;
+    for (int t = 0; t < threads && status == STATUS_SUCCESS; t++) {
+        build.dist[t] = malloc((n ? n : 1) * sizeof(double));
+        if (!build.dist[t]) status = STATUS_OOM;
+    }
+
+    if (status == STATUS_SUCCESS && landmark_count > 0) {
+        if (config->selection == LANDMARK_RANDOM) {
+            status = select_random(built, config->seed);
+            if (status == STATUS_SUCCESS) status = run_landmark_tasks(&build, threads, false);
+        } else {
+            status = select_farthest(&build);
+        }
+        if (status == STATUS_SUCCESS && built->csr.type == GRAPH_DIRECTED) status = run_landmark_tasks(&build, threads, true);
+    }
+
+    for (int t = 0; build.dist && t < threads; t++) free(build.dist[t]);
+    for (int t = 0; build.heaps && t < threads; t++) free(build.heaps[t].entries);
+    free(build.dist);
+    free(build.heaps);
+    free(build.statuses);
+
+    if (status != STATUS_SUCCESS) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to build landmark index", (int)landmark_count, -1);
+        alt_index_free(built);
+        return status;
+    }
+    *index = built;
+    return STATUS_SUCCESS;
+}
+
+size_t alt_index_landmarks(const AltIndex* index, int* ids, size_t capacity) {
+    if (!index) return 0;
+    for (size_t l = 0; l < index->landmark_count && l < capacity; l++) ids[l] = index->csr.ids[index->landmarks[l]];
+    return index->landmark_count;
+}
+
+// ---------------------------------------------------------------------------
+// Serialization
+// ---------------------------------------------------------------------------
+
+// Helper: checksum of the graph the index was built for
+static uint32_t graph_fingerprint(const GraphCsr* csr) {
+    uint32_t crc = crc32_update(0, csr->ids, csr->node_count * sizeof(int));
+    crc = crc32_update(crc, csr->offsets, (csr->node_count + 1) * sizeof(size_t));
+    crc = crc32_update(crc, csr->targets, csr->arc_count * sizeof(uint32_t));
+    return crc32_update(crc, csr->weights, csr->arc_count * sizeof(double));
+}
+
+static size_t table_bytes(const AltIndex* index) {
+    return index->csr.node_count * index->landmark_count * sizeof(float);
+}
+
+static uint32_t payload_crc(const AltIndex* index) {
+    uint32_t crc = crc32_update(0, index->landmarks, index->landmark_count * sizeof(uint32_t));
+    crc = crc32_update(crc, index->from_landmark, table_bytes(index));
+    if (index->csr.type == GRAPH_DIRECTED) crc = crc32_update(crc, index->to_landmark, table_bytes(index));
+    return crc;
+}
+
+static void index_header(const AltIndex* index, char* header) {
+    uint32_t type = (uint32_t)index->csr.type;
+    uint32_t landmarks = (uint32_t)index->landmark_count;
+    uint64_t nodes = index->csr.node_count;
+    uint64_t arcs = index->csr.arc_count;
+    uint32_t fingerprint = graph_fingerprint(&index->csr);
+    uint32_t crc = payload_crc(index);
+
+    memset(header, 0, INDEX_HEADER_BYTES);
+    memcpy(header, index_magic, 8);
+    memcpy(header + 8, &type, 4);
+    memcpy(header + 12, &landmarks, 4);
+    memcpy(header + 16, &nodes, 8);
+    memcpy(header + 24, &arcs, 8);
+    memcpy(header + 32, &fingerprint, 4);
+    memcpy(header + 36, &crc, 4);
+}
+
+Status alt_index_save(const AltIndex* index, const char* path) {
+    DIAG_CHECK(index, STATUS_INVALID, "invalid index");
+    DIAG_CHECK(path, STATUS_INVALID, "invalid path");
+
+    size_t length = strlen(path);
+    char* temp_path = malloc(length + 5);
+    if (!temp_path) return STATUS_OOM;
+    memcpy(temp_path, path, length);
+    memcpy(temp_path + length, ".tmp", 5);
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to create index file", errno, -1);
+        free(temp_path);
+        return STATUS_ERROR;
+    }
+
+    char header[INDEX_HEADER_BYTES];
+    index_header(index, header);
+    bool ok = write_full(fd, header, INDEX_HEADER_BYTES) == STATUS_SUCCESS;
+    ok = ok && write_full(fd, index->landmarks, index->landmark_count * sizeof(uint32_t)) == STATUS_SUCCESS;
+    ok = ok && write_full(fd, index->from_landmark, table_bytes(index)) == STATUS_SUCCESS;
+    if (index->csr.type == GRAPH_DIRECTED) ok = ok && write_full(fd, index->to_landmark, table_bytes(index)) == STATUS_SUCCESS;
+    ok = ok && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+
+    if (!ok || rename(temp_path, path) != 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write index file", errno, -1);
+        unlink(temp_path);
+        free(temp_path);
+        return STATUS_ERROR;
+    }
+    free(temp_path);
+    return STATUS_SUCCESS;
+}
+
+Status alt_index_load(const Graph* graph, const char* path, int num_threads, AltIndex** index) {
+    DIAG_CHECK(graph, STATUS_INVALID, "invalid graph");
+    DIAG_CHECK(path, STATUS_INVALID, "invalid path");
+    DIAG_CHECK(index, STATUS_INVALID, "invalid index output");
+    *index = NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        DIAG(DIAG_ERROR, ERR_NOT_FOUND, "failed to open index file", errno, -1);
+        return STATUS_ERROR;
+    }
+
+    char header[INDEX_HEADER_BYTES];
+    uint32_t landmarks = 0;
+    if (read_full(fd, header, INDEX_HEADER_BYTES) != INDEX_HEADER_BYTES || memcmp(header, index_magic, 8) != 0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "not a landmark index file", -1, -1);
+        close(fd);
+        return STATUS_ERROR;
+    }
+    memcpy(&landmarks, header + 12, 4);
+
+    AltIndex* loaded = NULL;
+    Status status = landmarks <= graph->node_count ? index_prepare(graph, landmarks, thread_count_resolve(num_threads), &loaded) : STATUS_INVALID;
+
+    // The header must match the one the index would be saved with, minus the payload checksum
+    char expected[INDEX_HEADER_BYTES];
+    if (status == STATUS_SUCCESS) {
+        index_header(loaded, expected);
+        if (memcmp(header, expected, 36) != 0) status = STATUS_INVALID;
+    }
+    if (status == STATUS_INVALID) DIAG(DIAG_WARNING, ERR_INVALID_ARG, "index was built for a different graph", (int)landmarks, -1);
+
+    if (status == STATUS_SUCCESS) {
+        bool ok = read_full(fd, loaded->landmarks, landmarks * sizeof(uint32_t)) == (ssize_t)(landmarks * sizeof(uint32_t));
+        ok = ok && read_full(fd, loaded->from_landmark, table_bytes(loaded)) == (ssize_t)table_bytes(loaded);
+        if (loaded->csr.type == GRAPH_DIRECTED) ok = ok && read_full(fd, loaded->to_landmark, table_bytes(loaded)) == (ssize_t)table_bytes(loaded);
+
+        uint32_t crc;
+        memcpy(&crc, header + 36, 4);
+        if (!ok || payload_crc(loaded) != crc) {
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "landmark index file is damaged", -1, -1);
+            status = STATUS_ERROR;
+        }
+    }
+    close(fd);
+
+    if (status != STATUS_SUCCESS) {
+        alt_index_free(loaded);
+        return status;
+    }
+    *index = loaded;
+    return STATUS_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+static void side_free(SearchSide* side) {
+    free(side->seen);
+    free(side->done);
+    free(side->dist);
+    free(side->potential);
+    free(side->parent);
+    free(side->heap.entries);
+}
+
+void alt_search_free(AltSearch* search) {
+    if (!search) return;
+    side_free(&search->sides[0]);
+    side_free(&search->sides[1]);
+    free(search);
+}
+
+AltSearch* alt_search_create(const AltIndex* index) {
+    DIAG_CHECK(index, NULL, "invalid index");
+
+    AltSearch* search = calloc(1, sizeof(AltSearch));
+    if (!search) return NULL;
+    search->index = index;
+
+    size_t n = index->csr.node_count ? index->csr.node_count : 1;
+    for (int s = 0; s < 2; s++) {
+        SearchSide* side = &search->sides[s];
+        side->arcs = s == 0 ? forward_arcs(index) : backward_arcs(index);
+        side->seen = calloc(n, sizeof(uint32_t));
+        side->done = calloc(n, sizeof(uint32_t));
+        side->dist = malloc(n * sizeof(double));
+        side->potential = malloc(n * sizeof(double));
+        side->parent = malloc(n * sizeof(uint32_t));
+        if (!side->seen || !side->done || !side->dist || !side->potential || !side->parent) {
+            DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to allocate path search", (int)n, -1);
+            alt_search_free(search);
+            return NULL;
+        }
+    }
+    return search;
+}
+
+// Helper: landmark lower bound of d(x, y). INFINITY when the landmarks prove y unreachable from x.
+static double landmark_bound(const AltIndex* index, uint32_t x, uint32_t y) {
+    size_t count = index->landmark_count;
+    const float* from_x = &index->from_landmark[x * count];
+    const float* from_y = &index->from_landmark[y * count];
+    const float* to_x = &index->to_landmark[x * count];
+    const float* to_y = &index->to_landmark[y * count];
+    const double slack = 1.0 + FLT_EPSILON;     // stored distances are rounded down by less than this
+    double best = 0.0;
+
+    for (size_t l = 0; l < count; l++) {
+        // d(x, y) >= d(L, y) - d(L, x)
+        if (from_x[l] != INFINITY) {
+            if (from_y[l] == INFINITY) return INFINITY;
+            double bound = from_y[l] - from_x[l] * slack;
+            if (bound > best) best = bound;
+        }
+        // d(x, y) >= d(x, L) - d(y, L)
+        if (to_y[l] != INFINITY) {
+            if (to_x[l] == INFINITY) return INFINITY;
+            double bound = to_x[l] - to_y[l] * slack;
+            if (bound > best) best = bound;
+        }
+    }
+    return best;
+}
+
+// Helper: averaged potential (d(v, target) - d(source, v)) / 2 of the forward side, negated for
+// the backward one, so both searches see the same consistent reduced lengths. INFINITY when v
+// lies on no path from source to target.
+static double side_potential(const AltIndex* index, int side, uint32_t v, uint32_t source, uint32_t target) {
+    double to_target = landmark_bound(index, v, target);
+    double from_source = landmark_bound(index, source, v);
+    if (to_target == INFINITY || from_source == INFINITY) return INFINITY;
+    return side == 0 ? (to_target - from_source) / 2.0 : (from_source - to_target) / 2.0;
+}
+
+static bool side_start(AltSearch* search, SearchSide* side, uint32_t node, double potential) {
+    side->heap.size = 0;
+    side->seen[node] = search->epoch;
+    side->dist[node] = 0.0;
+    side->potential[node] = potential;
+    side->parent[node] = NO_PARENT;
+    return heap_push(&side->heap, potential, node);
+}
+
+// Helper: source .. meet from the forward parents, then meet .. target from the backward ones
+static Status path_collect(const AltSearch* search, uint32_t meet, double distance, PathResult* result) {
+    const SearchSide* forward = &search->sides[0];
+    const SearchSide* backward = &search->sides[1];
+    uint32_t after_meet = backward->seen[meet] == search->epoch ? backward->parent[meet] : NO_PARENT;
+
+    size_t head = 0, length = 0;
+    for (uint32_t v = meet; v != NO_PARENT; v = forward->parent[v]) head++;
+    length = head;
+    for (uint32_t v = after_meet; v != NO_PARENT; v = backward->parent[v]) length++;
+
+    result->nodes = malloc(length * sizeof(int));
+    if (!result->nodes) return STATUS_OOM;
+
+    const int* ids = search->index->csr.ids;
+    size_t i = head;
+    for (uint32_t v = meet; v != NO_PARENT; v = forward->parent[v]) result->nodes[--i] = ids[v];
+    i = head;
+    for (uint32_t v = after_meet; v != NO_PARENT; v = backward->parent[v]) result->nodes[i++] = ids[v];
+
+    result->length = length;
+    result->distance = distance;
+    return STATUS_SUCCESS;
+}
+
+Status alt_shortest_path(AltSearch* search, int from, int to, PathMethod method, PathResult* result) {
+    DIAG_CHECK(search, STATUS_INVALID, "invalid path search");
+    DIAG_CHECK(result, STATUS_INVALID, "invalid path result");
+
+    result->distance = INFINITY;
+    result->length = 0;
+    result->nodes = NULL;
+    result->settled = 0;
+
+    const AltIndex* index = search->index;
+    uint32_t source = graph_csr_index(&index->csr, from);
+    uint32_t target = graph_csr_index(&index->csr, to);
+    if (source == CSR_NO_INDEX || target == CSR_NO_INDEX) {
+        DIAG(DIAG_WARNING, ERR_NOT_FOUND, "node does not exist", source == CSR_NO_INDEX ? from : to, -1);
+        return STATUS_WARNING;
+    }
+
+    if (++search->epoch == 0) {
+        size_t n = index->csr.node_count;
+        for (int s = 0; s < 2; s++) {
+            memset(search->sides[s].seen, 0, n * sizeof(uint32_t));
+            memset(search->sides[s].done, 0, n * sizeof(uint32_t));
+        }
+        search->epoch = 1;
+    }
+    uint32_t epoch = search->epoch;
+
+    bool guided = method == PATH_ALT && index->landmark_count > 0;
+    int side_count = method == PATH_DIJKSTRA ? 1 : 2;
+    double start = guided ? landmark_bound(index, source, target) / 2.0 : 0.0;
+    if (start == INFINITY) return STATUS_SUCCESS;
+
+    if (!side_start(search, &search->sides[0], source, start)) return STATUS_OOM;
+    if (source == target) return path_collect(search, source, 0.0, result);
+    if (side_count == 2 && !side_start(search, &search->sides[1], target, start)) return STATUS_OOM;
+
+    double best = INFINITY;         // shortest path found so far
+    uint32_t meet = NO_PARENT;
+    size_t settled = 0;
+
+    for (;;) {
+        SearchSide* forward = &search->sides[0];
+        SearchSide* backward = &search->sides[1];
+        int s = 0;
+
+        if (side_count == 1) {
+            if (forward->heap.size == 0) break;
+        } else {
+            // Potentials of both sides cancel, so every path still unseen is at least this long
+            if (forward->heap.size == 0 || backward->heap.size == 0) break;
+            double forward_key = forward->heap.entries[0].key;
+            double backward_key = backward->heap.entries[0].key;
+            if (forward_key + backward_key >= best) break;
+            s = backward_key < forward_key;
+        }
+
+        SearchSide* side = &search->sides[s];
+        SearchSide* other = &search->sides[1 - s];
+        uint32_t v = heap_pop(&side->heap).node;
+        if (side->done[v] == epoch) continue;
+        side->done[v] = epoch;
+        settled++;
+
+        if (side_count == 1 && v == target) {
+            best = side->dist[v];
+            meet = v;
+            break;
+        }
+        // Arcs of a node settled from both ends lead to no shorter path
+        if (side_count == 2 && other->done[v] == epoch) continue;
+
+        double distance = side->dist[v];
+        for (size_t e = side->arcs.offsets[v]; e < side->arcs.offsets[v + 1]; e++) {
+            uint32_t w = side->arcs.targets[e];
+            double candidate = distance + side->arcs.weights[e];
+
+            if (side->seen[w] != epoch) {
+                side->seen[w] = epoch;
+                side->dist[w] = INFINITY;
+                side->potential[w] = guided ? side_potential(index, s, w, source, target) : 0.0;
+            }
+            if (candidate >= side->dist[w] || side->potential[w] == INFINITY) continue;
+
+            side->dist[w] = candidate;
+            side->parent[w] = v;
+            if (!heap_push(&side->heap, candidate + side->potential[w], w)) return STATUS_OOM;
+
+            if (side_count == 2 && other->seen[w] == epoch && candidate + other->dist[w] < best) {
+                best = candidate + other->dist[w];
+                meet = w;
+            }
+        }
+    }
+
+    result->settled = settled;
+    if (meet == NO_PARENT) return STATUS_SUCCESS;
+    return path_collect(search, meet, best, result);
+}
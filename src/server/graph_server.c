@@ -0,0 +1,833 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "core/graph_build.h"
+#include "server/graph_server.h"
+#include "utils/general_utils.h"
+#include "utils/hash_table_utils.h"
+#include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
+#include "utils/thread_utils.h"
+
+#define DEFAULT_MAX_BATCH 256
+#define DEFAULT_MAX_CONNECTIONS 1024
+#define MAX_OUTPUT_PENDING ((size_t)4 << 20)    // stop dispatching while this much output is unsent
+#define MIN_INPUT_BUFFER ((size_t)64 << 10)
+#define WAKE_JOB 'j'
+#define WAKE_STOP 's'
+#define NO_SLOT UINT32_MAX
+
+// * Per-connection state. The event loop owns everything except batch and
+// * reply while busy is set, which belong to the worker running the job.
+typedef struct Connection {
+    int fd;
+    char* input;
+    size_t input_length;
+    size_t input_capacity;
+    char* output;
+    size_t output_length;
+    size_t output_sent;
+    size_t output_capacity;
+    QueryRequest* batch;
+    size_t batch_count;
+    char* reply;
+    size_t reply_length;
+    size_t reply_capacity;
+    bool busy;
+    bool eof;
+    bool broken;
+    struct Connection* next;    // job or done queue link
+} Connection;
+
+// * BFS visited set: open addressing stamped with a query epoch, so clearing is O(1)
+typedef struct {
+    int id;
+    uint32_t epoch;
+    uint32_t depth;
+} VisitSlot;
+
+typedef struct {
+    VisitSlot* slots;
+    size_t capacity;            // power of two
+    uint32_t epoch;
+    int* queue;
+    size_t queue_capacity;
+} BfsWorkspace;
+
+// * Weak components: union-find over node slots, maintained on inserts and
+// * rebuilt lazily after a removal. Finds do not compress paths so readers can
+// * share it; union by size keeps trees shallow.
+typedef struct {
+    int* keys;
+    uint32_t* values;
+    size_t map_capacity;        // power of two
+    uint32_t* parent;
+    uint32_t* size;
+    int* min_id;
+    size_t count;
+    size_t capacity;
+    bool valid;
+} ComponentIndex;
+
+typedef struct {
+    struct GraphServer* server;
+    BfsWorkspace bfs;
+} Worker;
+
+struct GraphServer {
+    Graph* graph;
+    ServerConfig config;
+    int listen_fd;
+    int wake[2];                // self pipe: job completions and stop requests
+
+    pthread_rwlock_t graph_lock;
+    ComponentIndex components;
+
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_ready;
+    Connection* jobs_head;
+    Connection* jobs_tail;
+    Connection* done;
+    bool workers_stopping;
+
+    pthread_t* threads;
+    Worker* workers;
+    int worker_count;
+
+    Connection** connections;
+    size_t connection_count;
+    struct pollfd* fds;
+};
+
+ServerConfig server_config_default(void) {
+    ServerConfig config;
+    config.socket_path = "network_analyzer.sock";
+    config.num_threads = 0;
+    config.max_batch = DEFAULT_MAX_BATCH;
+    config.max_connections = DEFAULT_MAX_CONNECTIONS;
+    return config;
+}
+
+// ---------------------------------------------------------------------------
+// Components
+// ---------------------------------------------------------------------------
+
+static uint32_t component_slot(const ComponentIndex* index, int id) {
+    if (!index->map_capacity) return NO_SLOT;
+
+    size_t mask = index->map_capacity - 1;
+    for (size_t i = hash(id, (int)index->map_capacity);; i = (i + 1) & mask) {
+        if (index->values[i] == NO_SLOT) return NO_SLOT;
+        if (index->keys[i] == id) return index->values[i];
+    }
+}
+
+static bool component_grow(ComponentIndex* index, size_t count) {
+    if (count > index->capacity) {
+        size_t new_capacity = index->capacity ? index->capacity : 64;
+        while (new_capacity < count) new_capacity *= 2;
+
+        uint32_t* parent = realloc(index->parent, new_capacity * sizeof(uint32_t));
+        if (parent) index->parent = parent;
+        uint32_t* size = realloc(index->size, new_capacity * sizeof(uint32_t));
+        if (size) index->size = size;
+        int* min_id = realloc(index->min_id, new_capacity * sizeof(int));
+        if (min_id) index->min_id = min_id;
+        if (!parent || !size || !min_id) return false;
+        index->capacity = new_capacity;
+    }
+
+    if (count * 2 <= index->map_capacity) return true;
+
+    size_t map_capacity = index->map_capacity ? index->map_capacity * 2 : 128;
+    while (map_capacity < count * 2) map_capacity *= 2;
+    int* keys = malloc(map_capacity * sizeof(int));
+    uint32_t* values = malloc(map_capacity * sizeof(uint32_t));
+    if (!keys || !values) {
+        free(keys);
+        free(values);
+        return false;
+    }
+
+    memset(values, 0xFF, map_capacity * sizeof(uint32_t));
+    for (size_t i = 0; i < index->map_capacity; i++) {
+        if (index->values[i] == NO_SLOT) continue;
+        size_t slot = hash(index->keys[i], (int)map_capacity);
+        while (values[slot] != NO_SLOT) slot = (slot + 1) & (map_capacity - 1);
+        keys[slot] = index->keys[i];
+        values[slot] = index->values[i];
+    }
+
+    free(index->keys);
+    free(index->values);
+    index->keys = keys;
+    index->values = values;
+    index->map_capacity = map_capacity;
+    return true;
+}
+
+// Helper: slot of id, added as a singleton if missing; NO_SLOT on OOM
+static uint32_t component_add(ComponentIndex* index, int id) {
+    uint32_t slot = component_slot(index, id);
+    if (slot != NO_SLOT) return slot;
+    if (!component_grow(index, index->count + 1)) return NO_SLOT;
+
+    size_t i = hash(id, (int)index->map_capacity);
+    while (index->values[i] != NO_SLOT) i = (i + 1) & (index->map_capacity - 1);
+
+    slot = (uint32_t)index->count++;
+    index->keys[i] = id;
+    index->values[i] = slot;
+    index->parent[slot] = slot;
+    index->size[slot] = 1;
+    index->min_id[slot] = id;
+    return slot;
+}
+
+static uint32_t component_find(const ComponentIndex* index, uint32_t slot) {
+    while (index->parent[slot] != slot) slot = index->parent[slot];
+    return slot;
+}
+
+static void component_union(ComponentIndex* index, uint32_t a, uint32_t b) {
+    a = component_find(index, a);
+    b = component_find(index, b);
+    if (a == b) return;
+
+    if (index->size[a] < index->size[b]) {
+        uint32_t swap = a;
+        a = b;
+        b = swap;
+    }
+    index->parent[b] = a;
+    index->size[a] += index->size[b];
+    if (index->min_id[b] < index->min_id[a]) index->min_id[a] = index->min_id[b];
+}
+
+static bool component_rebuild(ComponentIndex* index, const Graph* graph) {
+    index->count = 0;
+    if (index->map_capacity) memset(index->values, 0xFF, index->map_capacity * sizeof(uint32_t));
+    if (!component_grow(index, graph->node_count)) return false;
+
+    for (size_t i = 0; i < graph->node_count; i++) component_add(index, graph->node_ids[i]);
+    for (size_t i = 0; i < graph->node_count; i++) {
+        const Node* node = find_node(graph, graph->node_ids[i]);
+        uint32_t from = component_slot(index, node->id);
+        for (size_t j = 0; j < node->neighbor_count; j++) {
+            component_union(index, from, component_slot(index, node->neighbors[j].node_id));
+        }
+    }
+
+    index->valid = true;
+    return true;
+}
+
+static void component_free(ComponentIndex* index) {
+    free(index->keys);
+    free(index->values);
+    free(index->parent);
+    free(index->size);
+    free(index->min_id);
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+// Helper: mark id visited at depth, false if it already was
+static bool bfs_visit(BfsWorkspace* ws, int id, uint32_t depth) {
+    size_t mask = ws->capacity - 1;
+    for (size_t i = hash(id, (int)ws->capacity);; i = (i + 1) & mask) {
+        if (ws->slots[i].epoch != ws->epoch) {
+            ws->slots[i] = (VisitSlot){id, ws->epoch, depth};
+            return true;
+        }
+        if (ws->slots[i].id == id) return false;
+    }
+}
+
+static QueryStatus bfs_distance(const Graph* graph, BfsWorkspace* ws, int from, int to, int64_t* hops) {
+    if (!find_node(graph, from) || !find_node(graph, to)) return QUERY_NOT_FOUND;
+    if (from == to) {
+        *hops = 0;
+        return QUERY_OK;
+    }
+
+    size_t needed = 16;
+    while (needed < graph->node_count * 2) needed *= 2;
+    if (needed > ws->capacity) {
+        VisitSlot* slots = calloc(needed, sizeof(VisitSlot));
+        if (!slots) return QUERY_FAILED;
+        free(ws->slots);
+        ws->slots = slots;
+        ws->capacity = needed;
+        ws->epoch = 0;
+    }
+    if (graph->node_count > ws->queue_capacity) {
+        int* queue = realloc(ws->queue, graph->node_count * sizeof(int));
+        if (!queue) return QUERY_FAILED;
+        ws->queue = queue;
+        ws->queue_capacity = graph->node_count;
+    }
+
+    if (++ws->epoch == 0) {
+        memset(ws->slots, 0, ws->capacity * sizeof(VisitSlot));
+        ws->epoch = 1;
+    }
+
+    size_t head = 0, tail = 0;
+    ws->queue[tail++] = from;
+    bfs_visit(ws, from, 0);
+
+    for (uint32_t depth = 1; head < tail; depth++) {
+        size_t level_end = tail;
+        for (; head < level_end; head++) {
+            const Node* node = find_node(graph, ws->queue[head]);
+            for (size_t j = 0; j < node->neighbor_count; j++) {
+                int next = node->neighbors[j].node_id;
+                if (!bfs_visit(ws, next, depth)) continue;
+                if (next == to) {
+                    *hops = depth;
+                    return QUERY_OK;
+                }
+                ws->queue[tail++] = next;
+            }
+        }
+    }
+    return QUERY_NOT_FOUND;
+}
+
+// Helper: append to the reply buffer, false on OOM
+static bool reply_put(Connection* conn, const void* data, size_t length) {
+    if (conn->reply_length + length > conn->reply_capacity) {
+        size_t new_capacity = conn->reply_capacity ? conn->reply_capacity * 2 : 4096;
+        while (new_capacity < conn->reply_length + length) new_capacity *= 2;
+        char* grown = realloc(conn->reply, new_capacity);
+        if (!grown) return false;
+        conn->reply = grown;
+        conn->reply_capacity = new_capacity;
+    }
+    memcpy(conn->reply + conn->reply_length, data, length);
+    conn->reply_length += length;
+    return true;
+}
+
+typedef enum { LOCK_NONE, LOCK_READ, LOCK_WRITE } LockMode;
+
+static void lock_switch(GraphServer* server, LockMode* mode, LockMode wanted) {
+    if (*mode == wanted || (*mode == LOCK_WRITE && wanted == LOCK_READ)) return;
+    if (*mode != LOCK_NONE) pthread_rwlock_unlock(&server->graph_lock);
+    if (wanted == LOCK_WRITE) pthread_rwlock_wrlock(&server->graph_lock);
+    else pthread_rwlock_rdlock(&server->graph_lock);
+    *mode = wanted;
+}
+
+static QueryStatus insert_edge(GraphServer* server, int from, int to, double weight) {
+    Graph* graph = server->graph;
+    ComponentIndex* components = &server->components;
+
+    // Refuse what graph_insert_edge would refuse before any endpoint is created
+    if (graph->type == GRAPH_UNDIRECTED && from == to) return QUERY_FAILED;
+    if (node_find_edge(find_node(graph, from), to, NULL)) return QUERY_FAILED;
+
+    int ids[2] = {from, to};
+    bool created[2] = {false, false};
+    QueryStatus status = QUERY_OK;
+    for (int i = 0; i < 2 && status == QUERY_OK; i++) {
+        if (find_node(graph, ids[i])) continue;
+        if (graph_insert_node(graph, ids[i], 0) != STATUS_SUCCESS) {
+            status = QUERY_FAILED;
+            continue;
+        }
+        created[i] = true;
+        if (components->valid && component_add(components, ids[i]) == NO_SLOT) components->valid = false;
+    }
+    if (status == QUERY_OK && graph_insert_edge(graph, from, to, weight) != STATUS_SUCCESS) status = QUERY_FAILED;
+
+    if (status != QUERY_OK) {
+        // Out of memory: drop the endpoints this request created, their component slots go stale
+        for (int i = 0; i < 2; i++) {
+            if (!created[i]) continue;
+            graph_remove_node(graph, ids[i]);
+            components->valid = false;
+        }
+        return status;
+    }
+    if (components->valid) component_union(components, component_slot(components, from), component_slot(components, to));
+    return QUERY_OK;
+}
+
+static void answer(GraphServer* server, Worker* worker, Connection* conn, const QueryRequest* request, LockMode* mode) {
+    Graph* graph = server->graph;
+    QueryResponse response = {request->id, request->op, QUERY_OK, 0, 0, 0.0};
+    const Node* node = NULL;
+    size_t position;
+    uint32_t slot;
+
+    switch ((QueryOp)request->op) {
+        case QUERY_PING:
+            break;
+        case QUERY_NEIGHBORS:
+        case QUERY_DEGREE:
+            node = find_node(graph, request->a);
+            if (!node) response.status = QUERY_NOT_FOUND;
+            else response.value = (int64_t)node->neighbor_count;
+            break;
+        case QUERY_EDGE:
+            node = find_node(graph, request->a);
+            if (node && node_find_edge(node, request->b, &position)) response.weight = node->neighbors[position].weight;
+            else response.status = QUERY_NOT_FOUND;
+            node = NULL;
+            break;
+        case QUERY_DISTANCE:
+            response.status = bfs_distance(graph, &worker->bfs, request->a, request->b, &response.value);
+            break;
+        case QUERY_COMPONENT:
+            if (!find_node(graph, request->a)) {
+                response.status = QUERY_NOT_FOUND;
+                break;
+            }
+            if (!server->components.valid) {
+                // The upgrade drops the read lock, so the node is looked up again below
+                lock_switch(server, mode, LOCK_WRITE);
+                if (!server->components.valid && !component_rebuild(&server->components, graph)) {
+                    response.status = QUERY_FAILED;
+                    break;
+                }
+            }
+            slot = find_node(graph, request->a) ? component_slot(&server->components, request->a) : NO_SLOT;
+            if (slot == NO_SLOT) response.status = QUERY_NOT_FOUND;
+            else response.value = server->components.min_id[component_find(&server->components, slot)];
+            break;
+        case QUERY_INSERT_EDGE:
+            response.status = insert_edge(server, request->a, request->b, request->weight);
+            break;
+        case QUERY_REMOVE_EDGE:
+            switch (graph_remove_edge(graph, request->a, request->b)) {
+                case STATUS_SUCCESS:
+                    server->components.valid = false;
+                    break;
+                case STATUS_WARNING:
+                    response.status = QUERY_NOT_FOUND;
+                    break;
+                default:
+                    response.status = QUERY_FAILED;
+                    break;
+            }
+            break;
+        default:
+            response.status = QUERY_INVALID;
+            break;
+    }
+
+    if (request->op != QUERY_NEIGHBORS) node = NULL;
+    if (!reply_put(conn, &response, sizeof(response))) {
+        conn->broken = true;
+        return;
+    }
+
+    for (size_t j = 0; node && j < node->neighbor_count; j++) {
+        QueryNeighbor entry = {node->neighbors[j].node_id, 0, node->neighbors[j].weight};
+        if (!reply_put(conn, &entry, sizeof(entry))) {
+            conn->broken = true;
+            return;
+        }
+    }
+}
+
+static void run_batch(Worker* worker, Connection* conn) {
+    GraphServer* server = worker->server;
+    LockMode mode = LOCK_NONE;
+
+    conn->reply_length = 0;
+    for (size_t i = 0; i < conn->batch_count && !conn->broken; i++) {
+        uint8_t op = conn->batch[i].op;
+        lock_switch(server, &mode, op == QUERY_INSERT_EDGE || op == QUERY_REMOVE_EDGE ? LOCK_WRITE : LOCK_READ);
+        answer(server, worker, conn, &conn->batch[i], &mode);
+    }
+    if (mode != LOCK_NONE) pthread_rwlock_unlock(&server->graph_lock);
+}
+
+static void* worker_main(void* arg) {
+    Worker* worker = arg;
+    GraphServer* server = worker->server;
+
+    pthread_mutex_lock(&server->queue_lock);
+    for (;;) {
+        while (!server->jobs_head && !server->workers_stopping) pthread_cond_wait(&server->queue_ready, &server->queue_lock);
+        if (!server->jobs_head) break;
+
+        Connection* conn = server->jobs_head;
+        server->jobs_head = conn->next;
+        if (!server->jobs_head) server->jobs_tail = NULL;
+        pthread_mutex_unlock(&server->queue_lock);
+
+        run_batch(worker, conn);
+
+        pthread_mutex_lock(&server->queue_lock);
+        conn->next = server->done;
+        server->done = conn;
+
+        char signal = WAKE_JOB;
+        if (write(server->wake[1], &signal, 1) < 0 && errno != EAGAIN) {
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to wake server loop", errno, -1);
+        }
+    }
+    pthread_mutex_unlock(&server->queue_lock);
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Connections
+// ---------------------------------------------------------------------------
+
+static void connection_free(Connection* conn) {
+    if (!conn) return;
+    if (conn->fd >= 0) close(conn->fd);
+    free(conn->input);
+    free(conn->output);
+    free(conn->batch);
+    free(conn->reply);
+    free(conn);
+}
+
+static Connection* connection_create(const GraphServer* server, int fd) {
+    Connection* conn = calloc(1, sizeof(Connection));
+    if (!conn) return NULL;
+
+    conn->fd = fd;
+    conn->input_capacity = 4 * server->config.max_batch * sizeof(QueryRequest);
+    if (conn->input_capacity < MIN_INPUT_BUFFER) conn->input_capacity = MIN_INPUT_BUFFER;
+    conn->input = malloc(conn->input_capacity);
+    conn->batch = malloc(server->config.max_batch * sizeof(QueryRequest));
+    if (!conn->input || !conn->batch) {
+        conn->fd = -1;
+        connection_free(conn);
+        return NULL;
+    }
+    return conn;
+}
+
+static void connection_read(Connection* conn) {
+    while (conn->input_length < conn->input_capacity) {
+        ssize_t got = recv(conn->fd, conn->input + conn->input_length, conn->input_capacity - conn->input_length, 0);
+        if (got > 0) {
+            conn->input_length += (size_t)got;
+            continue;
+        }
+        if (got == 0) conn->eof = true;
+        else if (errno == EINTR) continue;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK) conn->broken = true;
+        return;
+    }
+}
+
+static void connection_flush(Connection* conn) {
+    while (conn->output_sent < conn->output_length) {
+        ssize_t sent = send(conn->fd, conn->output + conn->output_sent, conn->output_length - conn->output_sent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            conn->output_sent += (size_t)sent;
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) conn->broken = true;
+        return;
+    }
+    conn->output_sent = conn->output_length = 0;
+}
+
+// Helper: move a finished reply to the output queue, swapping buffers when possible
+static void connection_complete(Connection* conn) {
+    conn->busy = false;
+    if (conn->output_length == conn->output_sent) {
+        char* swap = conn->output;
+        size_t capacity = conn->output_capacity;
+        conn->output = conn->reply;
+        conn->output_capacity = conn->reply_capacity;
+        conn->output_length = conn->reply_length;
+        conn->output_sent = 0;
+        conn->reply = swap;
+        conn->reply_capacity = capacity;
+    } else {
+        size_t needed = conn->output_length + conn->reply_length;
+        if (needed > conn->output_capacity) {
+            char* grown = realloc(conn->output, needed);
+            if (!grown) {
+                conn->broken = true;
+                return;
+            }
+            conn->output = grown;
+            conn->output_capacity = needed;
+        }
+        memcpy(conn->output + conn->output_length, conn->reply, conn->reply_length);
+        conn->output_length += conn->reply_length;
+    }
+    conn->reply_length = 0;
+    connection_flush(conn);
+}
+
+static void connection_dispatch(GraphServer* server, Connection* conn) {
+    size_t complete = conn->input_length / sizeof(QueryRequest);
+    if (conn->busy || conn->broken || complete == 0) return;
+    if (conn->output_length - conn->output_sent > MAX_OUTPUT_PENDING) return;
+
+    size_t count = complete < server->config.max_batch ? complete : server->config.max_batch;
+    size_t bytes = count * sizeof(QueryRequest);
+    memcpy(conn->batch, conn->input, bytes);
+    memmove(conn->input, conn->input + bytes, conn->input_length - bytes);
+    conn->input_length -= bytes;
+    conn->batch_count = count;
+    conn->busy = true;
+    conn->next = NULL;
+
+    pthread_mutex_lock(&server->queue_lock);
+    if (server->jobs_tail) server->jobs_tail->next = conn;
+    else server->jobs_head = conn;
+    server->jobs_tail = conn;
+    pthread_cond_signal(&server->queue_ready);
+    pthread_mutex_unlock(&server->queue_lock);
+}
+
+static void accept_connections(GraphServer* server) {
+    while (server->connection_count < server->config.max_connections) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) DIAG(DIAG_WARNING, ERR_INTERNAL, "failed to accept connection", errno, -1);
+            return;
+        }
+
+        Connection* conn = NULL;
+        if (fcntl(fd, F_SETFL, O_NONBLOCK) == 0) conn = connection_create(server, fd);
+        if (!conn) {
+            DIAG(DIAG_WARNING, ERR_NO_MEMORY, "dropping connection", fd, -1);
+            close(fd);
+            continue;
+        }
+        server->connections[server->connection_count++] = conn;
+    }
+}
+
+// Helper: drain the self pipe and hand finished jobs back, true if stop was requested
+static bool collect_wakeups(GraphServer* server) {
+    bool stop = false;
+    char signals[256];
+    ssize_t got;
+    while ((got = read(server->wake[0], signals, sizeof(signals))) > 0) {
+        for (ssize_t i = 0; i < got; i++) stop |= signals[i] == WAKE_STOP;
+    }
+
+    pthread_mutex_lock(&server->queue_lock);
+    Connection* done = server->done;
+    server->done = NULL;
+    pthread_mutex_unlock(&server->queue_lock);
+
+    while (done) {
+        Connection* next = done->next;
+        connection_complete(done);
+        done = next;
+    }
+    return stop;
+}
+
+// ---------------------------------------------------------------------------
+// Server
+// ---------------------------------------------------------------------------
+
+static Status open_socket(GraphServer* server) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(server->config.socket_path) >= sizeof(address.sun_path)) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "socket path too long", -1, -1);
+        return STATUS_INVALID;
+    }
+    strcpy(address.sun_path, server->config.socket_path);
+
+    unlink(server->config.socket_path);
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->listen_fd < 0 || bind(server->listen_fd, (struct sockaddr*)&address, sizeof(address)) != 0
+        || listen(server->listen_fd, 128) != 0 || fcntl(server->listen_fd, F_SETFL, O_NONBLOCK) != 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to open server socket", errno, -1);
+        return STATUS_ERROR;
+    }
+    return STATUS_SUCCESS;
+}
+
+GraphServer* graph_server_create(Graph* graph, const ServerConfig* config) {
+    DIAG_CHECK(graph, NULL, "invalid graph");
+
+    ServerConfig defaults = server_config_default();
+    if (!config) config = &defaults;
+    if (!config->socket_path || config->max_batch == 0 || config->max_connections == 0) {
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid server config", -1, -1);
+        return NULL;
+    }
+
+    GraphServer* server = calloc(1, sizeof(GraphServer));
+    if (!server) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize server", -1, -1);
+        return NULL;
+    }
+
+    server->graph = graph;
+    server->config = *config;
+    server->listen_fd = -1;
+    server->wake[0] = server->wake[1] = -1;
+    pthread_rwlock_init(&server->graph_lock, NULL);
+    pthread_mutex_init(&server->queue_lock, NULL);
+    pthread_cond_init(&server->queue_ready, NULL);
+
+    server->worker_count = thread_count_resolve(config->num_threads);
+    server->threads = calloc((size_t)server->worker_count, sizeof(pthread_t));
+    server->workers = calloc((size_t)server->worker_count, sizeof(Worker));
+    server->connections = calloc(config->max_connections, sizeof(Connection*));
+    server->fds = calloc(config->max_connections + 2, sizeof(struct pollfd));
+    if (!server->threads || !server->workers || !server->connections || !server->fds) {
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize server", -1, -1);
+        graph_server_destroy(server);
+        return NULL;
+    }
+
+    if (pipe(server->wake) != 0 || fcntl(server->wake[0], F_SETFL, O_NONBLOCK) != 0
+        || fcntl(server->wake[1], F_SETFL, O_NONBLOCK) != 0) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to create wake pipe", errno, -1);
+        graph_server_destroy(server);
+        return NULL;
+    }
+
+    if (open_socket(server) != STATUS_SUCCESS || !component_rebuild(&server->components, graph)) {
+        graph_server_destroy(server);
+        return NULL;
+    }
+
+    int started = 0;
+    for (; started < server->worker_count; started++) {
+        server->workers[started].server = server;
+        if (pthread_create(&server->threads[started], NULL, worker_main, &server->workers[started]) != 0) break;
+    }
+    if (started < server->worker_count) {
+        DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to start server workers", started, server->worker_count);
+        server->worker_count = started;
+        graph_server_destroy(server);
+        return NULL;
+    }
+
+    return server;
+}
+
+Status graph_server_run(GraphServer* server) {
+    DIAG_CHECK(server, STATUS_INVALID, "invalid server");
+    DIAG(DIAG_INFO, ERR_NONE, "server listening", (int)server->graph->node_count, server->worker_count);
+
+    bool stop = false;
+    while (!stop) {
+        struct pollfd* fds = server->fds;
+        fds[0] = (struct pollfd){server->listen_fd, server->connection_count < server->config.max_connections ? POLLIN : 0, 0};
+        fds[1] = (struct pollfd){server->wake[0], POLLIN, 0};
+
+        for (size_t i = 0; i < server->connection_count; i++) {
+            Connection* conn = server->connections[i];
+            short events = 0;
+            if (!conn->eof && conn->input_length < conn->input_capacity) events |= POLLIN;
+            if (conn->output_sent < conn->output_length) events |= POLLOUT;
+            fds[i + 2] = (struct pollfd){conn->fd, events, 0};
+        }
+
+        if (poll(fds, server->connection_count + 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "server poll failed", errno, -1);
+            break;
+        }
+
+        if (fds[1].revents) stop = collect_wakeups(server);
+
+        size_t polled = server->connection_count;
+        for (size_t i = 0; i < polled; i++) {
+            Connection* conn = server->connections[i];
+            short revents = fds[i + 2].revents;
+            if (revents & (POLLIN | POLLHUP)) connection_read(conn);
+            if (revents & POLLERR) conn->broken = true;
+            if (revents & POLLOUT) connection_flush(conn);
+        }
+
+        if (fds[0].revents & POLLIN) accept_connections(server);
+
+        // Dispatch new batches and retire finished connections
+        size_t kept = 0;
+        for (size_t i = 0; i < server->connection_count; i++) {
+            Connection* conn = server->connections[i];
+            connection_dispatch(server, conn);
+
+            bool drained = conn->output_sent == conn->output_length && conn->input_length < sizeof(QueryRequest);
+            if (!conn->busy && (conn->broken || (conn->eof && drained))) {
+                connection_free(conn);
+                continue;
+            }
+            server->connections[kept++] = conn;
+        }
+        server->connection_count = kept;
+    }
+
+    // Let in-flight jobs finish before their connections are released
+    for (;;) {
+        bool busy = false;
+        for (size_t i = 0; i < server->connection_count; i++) busy |= server->connections[i]->busy;
+        if (!busy) break;
+
+        struct pollfd wake = {server->wake[0], POLLIN, 0};
+        poll(&wake, 1, -1);
+        collect_wakeups(server);
+    }
+
+    for (size_t i = 0; i < server->connection_count; i++) connection_free(server->connections[i]);
+    server->connection_count = 0;
+    return STATUS_SUCCESS;
+}
+
+void graph_server_stop(GraphServer* server) {
+    if (!server) return;
+    char signal = WAKE_STOP;
+    ssize_t written = write(server->wake[1], &signal, 1);
+    (void)written;
+}
+
+void graph_server_destroy(GraphServer* server) {
+    if (!server) return;
+
+    pthread_mutex_lock(&server->queue_lock);
+    server->workers_stopping = true;
+    pthread_cond_broadcast(&server->queue_ready);
+    pthread_mutex_unlock(&server->queue_lock);
+    for (int i = 0; i < server->worker_count; i++) pthread_join(server->threads[i], NULL);
+
+    for (size_t i = 0; i < server->connection_count; i++) connection_free(server->connections[i]);
+    for (int i = 0; server->workers && i < server->worker_count; i++) {
+        free(server->workers[i].bfs.slots);
+        free(server->workers[i].bfs.queue);
+    }
+
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+        unlink(server->config.socket_path);
+    }
+    if (server->wake[0] >= 0) close(server->wake[0]);
+    if (server->wake[1] >= 0) close(server->wake[1]);
+
+    component_free(&server->components);
+    pthread_rwlock_destroy(&server->graph_lock);
+    pthread_mutex_destroy(&server->queue_lock);
+    pthread_cond_destroy(&server->queue_ready);
+    free(server->threads);
+    free(server->workers);
+    free(server->connections);
+    free(server->fds);
+    free(server);
+}
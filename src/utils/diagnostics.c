@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+
+static pthread_mutex_t diag_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static DiagSink diag_sink = NULL;
+static void* diag_sink_ctx = NULL;
+static DiagLevel diag_sink_level = DIAG_OFF;
+static DiagLevel diag_ring_level = DIAG_ERROR;     // warnings from insert/load loops stay off the lock
+
+static DiagRecord diag_ring[DIAG_RING_SIZE];
+static uint64_t diag_head = 0;      // next record to drain
+static uint64_t diag_tail = 0;      // next slot to write
+static uint64_t diag_overwritten = 0;
+static uint64_t diag_sequence = 0;
+static uint64_t diag_counts[DIAG_CODE_COUNT];
+
+static const char* level_names[] = {"debug", "info", "warning", "error", "fatal", "off"};
+static const char* code_names[] = {"none", "exists", "not_found", "no_memory", "invalid_arg", "internal"};
+
+const char* diag_level_name(DiagLevel level) {
+    if (level < DIAG_DEBUG || level > DIAG_OFF) return "unknown";
+    return level_names[level];
+}
+
+const char* diag_code_name(ErrorCode code) {
+    if (code < ERR_NONE || code > ERR_INTERNAL) return "unknown";
+    return code_names[code];
+}
+
+void diag_set_sink(DiagSink sink, void* ctx, DiagLevel min_level) {
+    pthread_mutex_lock(&diag_lock);
+    diag_sink = sink;
+    diag_sink_ctx = ctx;
+    __atomic_store_n(&diag_sink_level, sink ? min_level : DIAG_OFF, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&diag_lock);
+}
+
+void diag_set_ring_level(DiagLevel min_level) {
+    pthread_mutex_lock(&diag_lock);
+    __atomic_store_n(&diag_ring_level, min_level, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&diag_lock);
+}
+
+void diag_stderr_sink(const DiagRecord* record, void* ctx) {
+    (void)ctx;
+    fprintf(stderr, "%s: %s (%s", diag_level_name(record->level), record->message, record->function);
+    if (record->a != -1) fprintf(stderr, ", %d", record->a);
+    if (record->b != -1) fprintf(stderr, ", %d", record->b);
+    fprintf(stderr, ")\n");
+}
+
+void diag_report(DiagLevel level, ErrorCode code, const char* function, const char* message, int a, int b) {
+    if (code >= ERR_NONE && code <= ERR_INTERNAL) {
+        __atomic_fetch_add(&diag_counts[code], 1, __ATOMIC_RELAXED);
+    }
+
+    // Fast path: nothing buffered and nobody listening
+    if (level < __atomic_load_n(&diag_ring_level, __ATOMIC_RELAXED)
+        && level < __atomic_load_n(&diag_sink_level, __ATOMIC_RELAXED)) return;
+
+    DiagRecord record = {0, level, code, function, message, a, b};
+    DiagSink sink = NULL;
+    void* sink_ctx = NULL;
+
+    pthread_mutex_lock(&diag_lock);
+    record.sequence = diag_sequence++;
+    if (level >= __atomic_load_n(&diag_ring_level, __ATOMIC_RELAXED)) {
+        if (diag_tail - diag_head == DIAG_RING_SIZE) {
+            // Ring full: drop the oldest record
+            diag_head++;
+            diag_overwritten++;
+        }
+        diag_ring[diag_tail & (DIAG_RING_SIZE - 1)] = record;
+        diag_tail++;
+    }
+    if (level >= __atomic_load_n(&diag_sink_level, __ATOMIC_RELAXED)) {
+        sink = diag_sink;
+        sink_ctx = diag_sink_ctx;
+    }
+    pthread_mutex_unlock(&diag_lock);
+
+    if (sink) sink(&record, sink_ctx);
+}
+
+size_t diag_drain(DiagRecord* out, size_t max) {
+    if (!out) return 0;
+
+    pthread_mutex_lock(&diag_lock);
+    size_t drained = 0;
+    while (drained < max && diag_head < diag_tail) {
+        out[drained++] = diag_ring[diag_head & (DIAG_RING_SIZE - 1)];
+        diag_head++;
+    }
+    pthread_mutex_unlock(&diag_lock);
+
+    return drained;
+}
+
+uint64_t diag_count(ErrorCode code) {
+    if (code < ERR_NONE || code > ERR_INTERNAL) return 0;
+    return __atomic_load_n(&diag_counts[code], __ATOMIC_RELAXED);
+}
+
+uint64_t diag_dropped(void) {
+    pthread_mutex_lock(&diag_lock);
+    uint64_t dropped = diag_overwritten;
+    pthread_mutex_unlock(&diag_lock);
+    return dropped;
+}
+
+void diag_reset(void) {
+    pthread_mutex_lock(&diag_lock);
+    diag_head = diag_tail = 0;
+    diag_overwritten = 0;
+    diag_sequence = 0;
+    for (size_t i = 0; i < DIAG_CODE_COUNT; i++) __atomic_store_n(&diag_counts[i], 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&diag_lock);
+}
@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "utils/format_utils.h"
+
+#define MAX_DECIMALS 9
+#define EXACT_INTEGER_LIMIT 9007199254740992.0     // 2^53
+
+static const double powers_of_ten[MAX_DECIMALS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+size_t format_uint64(char* out, uint64_t value) {
+    char digits[FORMAT_UINT64_CHARS];
+    size_t length = 0;
+
+    do {
+        digits[length++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+
+    for (size_t i = 0; i < length; i++) out[i] = digits[length - 1 - i];
+    return length;
+}
+
+size_t format_int(char* out, int value) {
+    if (value >= 0) return format_uint64(out, (uint64_t)value);
+
+    // negate in 64 bits so INT_MIN does not overflow
+    out[0] = '-';
+    return 1 + format_uint64(out + 1, (uint64_t)(-(int64_t)value));
+}
+
+// Helper: write value / 10^decimals, scaled is a non-negative integer below 2^53
+static size_t format_scaled(char* out, uint64_t scaled, int decimals) {
+    uint64_t divisor = (uint64_t)powers_of_ten[decimals];
+    size_t length = format_uint64(out, scaled / divisor);
+    if (decimals == 0) return length;
+
+    uint64_t fraction = scaled % divisor;
+    out[length++] = '.';
+    for (int i = decimals - 1; i >= 0; i--) {
+        out[length + (size_t)i] = (char)('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return length + (size_t)decimals;
+}
+
+size_t format_double(char* out, double value) {
+    if (isfinite(value)) {
+        double magnitude = fabs(value);
+        size_t sign = 0;
+        if (signbit(value) && magnitude != 0.0) out[sign++] = '-';
+
+        // Most weights are integers or short decimals: find the fewest decimals
+        // whose fixed point form converts back to exactly the same double
+        for (int decimals = 0; decimals <= MAX_DECIMALS; decimals++) {
+            double scaled = magnitude * powers_of_ten[decimals];
+            if (scaled >= EXACT_INTEGER_LIMIT) break;
+
+            double rounded = floor(scaled + 0.5);
+            if (rounded / powers_of_ten[decimals] == magnitude) {
+                return sign + format_scaled(out + sign, (uint64_t)rounded, decimals);
+            }
+        }
+    }
+
+    // Rare path: very large, very small or long mantissas, inf and nan
+    char buffer[FORMAT_DOUBLE_CHARS + 8];
+    int length = snprintf(buffer, sizeof(buffer), "%.17g", value);
+    if (length < 0) length = 0;
+    if (length > FORMAT_DOUBLE_CHARS) length = FORMAT_DOUBLE_CHARS;
+    memcpy(out, buffer, (size_t)length);
+    return (size_t)length;
+}
@@ -6,21 +6,22 @@
 #include "utils/general_utils.h"
 #include "utils/hash_table_utils.h"
 #include "utils/graph_build_utils.h"
+#include "utils/graph_stats.h"
+#include "utils/diagnostics.h"
 
 # define CHECK_NODE \
     if (!node) {\
-        fprintf(stderr, "Error: Invalid node passed to %s function call\n", __func__);\
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid node", -1, -1);\
         return STATUS_INVALID;\
     }
 
-//Helper: resize nodes array
-Status graph_resize (Graph* graph) {
-    CHECK_GRAPH
-    
-    size_t new_capacity = graph->node_capacity * 2; // * 1.5 to reduce the hash table alpha to 0.5
+//Helper: rehash nodes array into a table of new_capacity buckets
+static Status graph_rehash(Graph* graph, size_t new_capacity) {
+    STATS_TIMER_START(resize_timer);
+
     Node **new_nodes = calloc(new_capacity, sizeof(Node*));
     if (!new_nodes) {
-        fprintf(stderr, "Error: Failed to rezize graph, keeping previous capacity\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to resize graph, keeping previous capacity", -1, -1);
         return STATUS_OOM;
     }
 
@@ -36,12 +37,12 @@ Status graph_resize (Graph* graph) {
                     break;
                 case STATUS_INVALID: // should never happen
                     // If node is invalid, assume graph has been corrupted
-                    fprintf(stderr, "Fatal error: Graph has been corrupted during resize");
+                    DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted during resize", -1, -1);
                     free(new_nodes);
                     return STATUS_ERROR;
                 case STATUS_WARNING: // should never happen
                     // if node already exists in the new table, assume graph has been corrupted
-                    fprintf(stderr, "Fatal error: Graph has been corrupted during resize");
+                    DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted during resize", current->id, -1);
                     free(new_nodes);
                     return STATUS_ERROR;
                 default:
@@ -54,7 +55,7 @@ Status graph_resize (Graph* graph) {
     
     int *new_id_array = realloc(graph->node_ids, new_capacity * sizeof(int));
     if (!new_id_array) {
-        fprintf(stderr, "Error: Failed to rezize graph, keeping previous capacity\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to resize graph, keeping previous capacity", -1, -1);
         free(new_nodes);
         return STATUS_OOM;
     }
@@ -64,20 +65,64 @@ Status graph_resize (Graph* graph) {
     graph->node_ids = new_id_array;
     graph->node_capacity = new_capacity;
 
+    STATS_COUNT(graph_resizes);
+    STATS_TIMER_STOP(resize_timer, graph_resize_ns);
+    return STATUS_SUCCESS;
+}
+
+//Helper: resize nodes array
+Status graph_resize (Graph* graph) {
+    CHECK_GRAPH
+    
+    size_t new_capacity = graph->node_capacity * 2; // * 1.5 to reduce the hash table alpha to 0.5
+    return graph_rehash(graph, new_capacity);
+}
+
+// Grow the nodes array once so node_count nodes fit without further resizes
+Status graph_reserve(Graph* graph, size_t node_count) {
+    CHECK_GRAPH
+
+    size_t new_capacity = graph->node_capacity ? graph->node_capacity : INITIAL_CAPACITY;
+    while (node_count >= ALPHA * new_capacity) new_capacity *= 2;
+
+    if (new_capacity == graph->node_capacity) return STATUS_SUCCESS;
+    return graph_rehash(graph, new_capacity);
+}
+
+// Link a new node into the hash table and node_ids, the caller guarantees the ID is unused
+Status graph_attach_node(Graph* graph, Node* node) {
+    CHECK_GRAPH
+    CHECK_NODE
+
+    if (add_to_hash_table(node, graph->node_capacity, graph->nodes) != STATUS_SUCCESS) {
+        DIAG(DIAG_FATAL, ERR_INTERNAL, "graph has been corrupted", node->id, -1);
+        return STATUS_ERROR;
+    }
+
+    // node_ids has node_capacity slots and node_count stays below ALPHA * node_capacity
+    graph->node_ids[graph->node_count++] = node->id;
+
+    if (graph_needs_resize(graph)) return graph_resize(graph);
     return STATUS_SUCCESS;
 }
 
 // Helper: find Node by ID (Hash table lookup)
-Node* find_node(Graph* graph, int node_id) {
+Node* find_node(const Graph* graph, int node_id) {
     if (!graph) return NULL;
     unsigned int index = hash(node_id, graph->node_capacity);
     Node *current = graph->nodes[index];
+    STATS_PROBE_START(probes);
 
     while (current) {
-        if (current->id == node_id) return current;  // found
+        STATS_PROBE_STEP(probes);
+        if (current->id == node_id) {
+            STATS_PROBE_END(probes, true);
+            return current;  // found
+        }
         current = current->next;
     }
     
+    STATS_PROBE_END(probes, false);
     return NULL;  // not found
 }
 
@@ -85,7 +130,7 @@ Node* create_node(int node_id, size_t neighbor_capacity) {
     // Allocate memory for new node
     Node* new_node = malloc(sizeof(Node));
     if (!new_node) {
-        fprintf(stderr, "Error: Failed to initialize new node\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize new node", node_id, -1);
         return NULL;
     }
     
@@ -97,7 +142,7 @@ Node* create_node(int node_id, size_t neighbor_capacity) {
     // Initialize neighbors array
     new_node->neighbors = malloc(neighbor_capacity * sizeof(EdgeNode));
     if (!new_node->neighbors) {
-        fprintf(stderr, "Error: Failed to initialize new node\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to initialize new node", node_id, -1);
         free(new_node);
         return NULL;
     }
@@ -114,10 +159,20 @@ Node* create_node(int node_id, size_t neighbor_capacity) {
 Status node_resize(Node* node) {
     CHECK_NODE
 
-    size_t new_capacity = node->neighbor_capacity * 2;
+    size_t new_capacity = node->neighbor_capacity ? node->neighbor_capacity * 2 : INITIAL_CAPACITY;
+    return node_reserve(node, new_capacity);
+}
+
+// Grow neighbors array to hold at least capacity edges
+Status node_reserve(Node* node, size_t capacity) {
+    CHECK_NODE
+    if (capacity <= node->neighbor_capacity) return STATUS_SUCCESS;
+    STATS_TIMER_START(resize_timer);
+
+    size_t new_capacity = capacity;
     EdgeNode* new_neighbors = realloc(node->neighbors, new_capacity * sizeof(EdgeNode));
     if (!new_neighbors) {
-        fprintf(stderr, "Error: Failed to resize node\n");
+        DIAG(DIAG_ERROR, ERR_NO_MEMORY, "failed to resize node, keeping previous version", node->id, -1);
         return STATUS_OOM;
     }
 
@@ -129,6 +184,10 @@ Status node_resize(Node* node) {
 
     node->neighbors = new_neighbors;
     node->neighbor_capacity = new_capacity;
+
+    STATS_COUNT(node_resizes);
+    STATS_ADD(node_resize_bytes, new_capacity * sizeof(EdgeNode));
+    STATS_TIMER_STOP(resize_timer, node_resize_ns);
     return STATUS_SUCCESS;
 }
 
@@ -145,16 +204,19 @@ Status node_add_edge(Node* node, int to, double weight, double* old_weight, bool
             }
         }
         
-        fprintf(stderr, "Error: Edge from node %d to node %d does not exist\n", node->id, to);
+        // edge does not exist, callers decide whether that deserves a report
         return STATUS_WARNING;
     } else {
         // Check if edge already exists
+        STATS_COUNT(duplicate_scans);
         for (size_t i = 0; i < node->neighbor_count; i++) {
             if (node->neighbors[i].node_id == to) {
-                printf("Edge from node %d to node %d already exists\n", node->id, to);
+                STATS_COUNT(duplicate_hits);
+                STATS_ADD(duplicate_scan_steps, i + 1);
                 return STATUS_WARNING;
             }
         }
+        STATS_ADD(duplicate_scan_steps, node->neighbor_count);
     }
 
     // Check if node needs to be resized
@@ -163,16 +225,27 @@ Status node_add_edge(Node* node, int to, double weight, double* old_weight, bool
             case STATUS_SUCCESS:
             break;
             case STATUS_OOM:
-                fprintf(stderr, "Error: Failed to resize node %d, keeping previous version\n", node->id);
                 return STATUS_OOM;
             default:
                 // should never happen
-                fprintf(stderr, "Fatal error: Node %d has been corrupted during resize\n", node->id);
+                DIAG(DIAG_FATAL, ERR_INTERNAL, "node has been corrupted during resize", node->id, -1);
                 return STATUS_ERROR;
         }
     }
 
     // Add new edge/neighbor
+    return node_append_edge(node, to, weight);
+}
+
+// Append edge without duplicate check, caller guarantees the edge is new
+Status node_append_edge(Node* node, int to, double weight) {
+    CHECK_NODE
+
+    if (node_needs_resize(node)) {
+        Status status = node_resize(node);
+        if (status != STATUS_SUCCESS) return status;
+    }
+
     EdgeNode* new_neighbor = &node->neighbors[node->neighbor_count];
     new_neighbor->node_id = to;
     new_neighbor->weight = weight;
@@ -181,6 +254,19 @@ Status node_add_edge(Node* node, int to, double weight, double* old_weight, bool
     return STATUS_SUCCESS;
 }
 
+// Locate edge to -> position in neighbors array
+bool node_find_edge(const Node* node, int to, size_t* position) {
+    if (!node) return false;
+
+    for (size_t i = 0; i < node->neighbor_count; i++) {
+        if (node->neighbors[i].node_id == to) {
+            if (position) *position = i;
+            return true;
+        }
+    }
+    return false;
+}
+
 Status node_remove_edge(Node* node, int to, double* old_weight) {
     CHECK_NODE
 
@@ -204,8 +290,6 @@ Status node_remove_edge(Node* node, int to, double* old_weight) {
         }
     }
 
-    #ifdef DEBUG
-    fprintf(stderr, "Error: Edge from node %d to node %d does not exist\n", node->id, to);
-    #endif
+    // edge does not exist, callers decide whether that deserves a report
     return STATUS_WARNING;
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "core/graph_build.h"
+#include "core/graph_operations.h"
+#include "utils/general_utils.h"
+#include "utils/graph_stats.h"
+#include "utils/diagnostics.h"
+
+GraphCounters graph_counters;
+
+// GraphCounters holds only uint64_t fields, walked as an array for atomic access
+#define COUNTER_FIELDS (sizeof(GraphCounters) / sizeof(uint64_t))
+
+uint64_t stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void graph_stats_reset(void) {
+    uint64_t* fields = (uint64_t*)&graph_counters;
+    for (size_t i = 0; i < COUNTER_FIELDS; i++) __atomic_store_n(&fields[i], 0, __ATOMIC_RELAXED);
+}
+
+#ifdef GRAPH_STATS
+// Helper: copy of the counters, every field read atomically
+static GraphCounters counters_snapshot(void) {
+    GraphCounters copy;
+    uint64_t* fields = (uint64_t*)&graph_counters;
+    uint64_t* out = (uint64_t*)&copy;
+    for (size_t i = 0; i < COUNTER_FIELDS; i++) out[i] = __atomic_load_n(&fields[i], __ATOMIC_RELAXED);
+    return copy;
+}
+#endif
+
+GraphStats graph_stats(const Graph* graph) {
+    GraphStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    #ifdef GRAPH_STATS
+    stats.counters_enabled = true;
+    stats.counters = counters_snapshot();
+    #endif
+
+    if (!graph) return stats;
+
+    stats.node_count = graph->node_count;
+    stats.edge_count = graph_edge_count(graph);
+    stats.bucket_count = graph->node_capacity;
+    stats.load_factor = graph->node_capacity ? (double)graph->node_count / (double)graph->node_capacity : 0.0;
+
+    stats.bytes_graph = sizeof(Graph);
+    stats.bytes_hash_table = graph->node_capacity * sizeof(Node*);
+    stats.bytes_node_ids = graph->node_capacity * sizeof(int);
+
+    for (size_t i = 0; i < graph->node_capacity; i++) {
+        size_t chain = 0;
+
+        for (Node* current = graph->nodes[i]; current; current = current->next) {
+            chain++;
+            stats.bytes_nodes += sizeof(Node);
+            stats.bytes_adjacency += current->neighbor_capacity * sizeof(EdgeNode);
+            stats.adjacency_capacity += current->neighbor_capacity;
+            stats.adjacency_used += current->neighbor_count;
+        }
+
+        if (chain) stats.used_buckets++;
+        if (chain > stats.longest_chain) stats.longest_chain = chain;
+        stats.chain_histogram[stats_bucket(chain)]++;
+    }
+
+    stats.bytes_total = stats.bytes_graph + stats.bytes_hash_table + stats.bytes_node_ids
+        + stats.bytes_nodes + stats.bytes_adjacency;
+    stats.adjacency_slack = stats.adjacency_capacity
+        ? 1.0 - (double)stats.adjacency_used / (double)stats.adjacency_capacity : 0.0;
+
+    return stats;
+}
+
+// Helper: write a histogram as a JSON array
+static void dump_histogram(FILE* out, const char* name, const uint64_t* histogram) {
+    fprintf(out, "  \"%s\": [", name);
+    for (size_t i = 0; i < STATS_HISTOGRAM_BUCKETS; i++) {
+        fprintf(out, "%s%llu", i ? ", " : "", (unsigned long long)histogram[i]);
+    }
+    fprintf(out, "],\n");
+}
+
+Status graph_stats_dump_json(const GraphStats* stats, FILE* out) {
+    DIAG_CHECK(stats, STATUS_INVALID, "invalid stats");
+    DIAG_CHECK(out, STATUS_INVALID, "invalid stream");
+
+    const GraphCounters* c = &stats->counters;
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"counters_enabled\": %s,\n", stats->counters_enabled ? "true" : "false");
+    fprintf(out, "  \"nodes\": %zu,\n  \"edges\": %zu,\n", stats->node_count, stats->edge_count);
+    fprintf(out, "  \"hash_table\": {\"buckets\": %zu, \"used_buckets\": %zu, \"longest_chain\": %zu, "
+        "\"load_factor\": %.4f},\n", stats->bucket_count, stats->used_buckets, stats->longest_chain,
+        stats->load_factor);
+    dump_histogram(out, "chain_length_histogram", stats->chain_histogram);
+    fprintf(out, "  \"bytes\": {\"graph\": %zu, \"hash_table\": %zu, \"node_ids\": %zu, \"nodes\": %zu, "
+        "\"adjacency\": %zu, \"total\": %zu},\n", stats->bytes_graph, stats->bytes_hash_table,
+        stats->bytes_node_ids, stats->bytes_nodes, stats->bytes_adjacency, stats->bytes_total);
+    fprintf(out, "  \"adjacency\": {\"capacity\": %zu, \"used\": %zu, \"slack\": %.4f},\n",
+        stats->adjacency_capacity, stats->adjacency_used, stats->adjacency_slack);
+
+    fprintf(out, "  \"lookups\": {\"total\": %llu, \"hits\": %llu, \"misses\": %llu},\n",
+        (unsigned long long)c->lookups, (unsigned long long)c->lookup_hits,
+        (unsigned long long)c->lookup_misses);
+    dump_histogram(out, "probe_histogram", c->probe_histogram);
+    fprintf(out, "  \"operations\": {\"node_inserts\": %llu, \"node_removes\": %llu, \"edge_inserts\": %llu, "
+        "\"edge_updates\": %llu, \"edge_removes\": %llu},\n",
+        (unsigned long long)c->node_inserts, (unsigned long long)c->node_removes,
+        (unsigned long long)c->edge_inserts, (unsigned long long)c->edge_updates,
+        (unsigned long long)c->edge_removes);
+    fprintf(out, "  \"duplicate_scans\": {\"scans\": %llu, \"steps\": %llu, \"hits\": %llu},\n",
+        (unsigned long long)c->duplicate_scans, (unsigned long long)c->duplicate_scan_steps,
+        (unsigned long long)c->duplicate_hits);
+    fprintf(out, "  \"resizes\": {\"graph\": %llu, \"graph_ns\": %llu, \"node\": %llu, \"node_ns\": %llu, "
+        "\"node_bytes\": %llu}\n",
+        (unsigned long long)c->graph_resizes, (unsigned long long)c->graph_resize_ns,
+        (unsigned long long)c->node_resizes, (unsigned long long)c->node_resize_ns,
+        (unsigned long long)c->node_resize_bytes);
+    fprintf(out, "}\n");
+
+    return ferror(out) ? STATUS_ERROR : STATUS_SUCCESS;
+}
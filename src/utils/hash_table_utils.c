@@ -5,10 +5,11 @@
 #include "utils/general_utils.h"
 #include "utils/hash_table_utils.h"
 #include "utils/graph_build_utils.h"
+#include "utils/diagnostics.h"
 
 # define CHECK_TABLE \
     do {    if (!table) {\
-        fprintf(stderr, "Error: Invalid hash table passed to %s function call\n", __func__);\
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "invalid hash table", -1, -1);\
         return STATUS_ERROR;\
     }\
 } while(0);
@@ -49,7 +50,7 @@ Node* pop_bucket(Node** bucket) {
 Status add_to_hash_table(Node* node, size_t table_size, Node** table) {
     CHECK_TABLE
     if (!node) {
-        fprintf(stderr, "Error: Trying to add NULL node to hash table\n");
+        DIAG(DIAG_ERROR, ERR_INVALID_ARG, "trying to add NULL node to hash table", -1, -1);
         return STATUS_INVALID;
     }
 
@@ -59,10 +60,7 @@ Status add_to_hash_table(Node* node, size_t table_size, Node** table) {
 
     // Check if node already exists
     if (exists_in_bucket(node->id, head)) {
-            #ifdef DEBUG
-            printf("A node with ID %d already exists in the graph\n", node->id);
-            #endif
-            return STATUS_WARNING; // node already exists
+            return STATUS_WARNING; // node already exists, callers report it
         
     } else {
             // Add node to hash table
@@ -99,8 +97,5 @@ Status delete_from_hash_table(int id, size_t table_size, Node** table) {
         current = current->next;
     }
 
-    #ifdef DEBUG
-    printf("Node with ID %d does not exist in the graph\n", id);
-    #endif
-    return STATUS_WARNING;
+    return STATUS_WARNING; // node does not exist, callers report it
 }
\ No newline at end of file
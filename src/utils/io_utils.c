@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "utils/io_utils.h"
+#include "utils/general_utils.h"
+#include "utils/diagnostics.h"
+
+static uint32_t crc_table[256];
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+Status write_full(int fd, const void* data, size_t length) {
+    const char* cursor = data;
+    while (length > 0) {
+        ssize_t written = write(fd, cursor, length);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write file", errno, -1);
+            return STATUS_ERROR;
+        }
+        cursor += written;
+        length -= (size_t)written;
+    }
+    return STATUS_SUCCESS;
+}
+
+Status pwrite_full(int fd, const void* data, size_t length, uint64_t offset) {
+    const char* cursor = data;
+    while (length > 0) {
+        ssize_t written = pwrite(fd, cursor, length, (off_t)offset);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to write file", errno, -1);
+            return STATUS_ERROR;
+        }
+        cursor += written;
+        length -= (size_t)written;
+        offset += (uint64_t)written;
+    }
+    return STATUS_SUCCESS;
+}
+
+ssize_t read_full(int fd, void* data, size_t length) {
+    char* cursor = data;
+    size_t total = 0;
+    while (total < length) {
+        ssize_t got = read(fd, cursor + total, length - total);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            DIAG(DIAG_ERROR, ERR_INTERNAL, "failed to read file", errno, -1);
+            return -1;
+        }
+        if (got == 0) break;
+        total += (size_t)got;
+    }
+    return (ssize_t)total;
+}
+
+static void crc_table_init(void) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        crc_table[i] = crc;
+    }
+}
+
+uint32_t crc32_update(uint32_t crc, const void* data, size_t length) {
+    pthread_once(&crc_once, crc_table_init);
+
+    const unsigned char* bytes = data;
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) crc = crc_table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
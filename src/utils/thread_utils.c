@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "utils/general_utils.h"
+#include "utils/thread_utils.h"
+#include "utils/diagnostics.h"
+
+typedef struct {
+    ParallelTask task;
+    void* ctx;
+    size_t task_count;
+    size_t next_task; // * shared counter, only touched through __atomic builtins
+} ParallelJob;
+
+typedef struct {
+    ParallelJob* job;
+    int thread_id;
+} ParallelWorker;
+
+int thread_count_resolve(int requested) {
+    if (requested > 0) return requested;
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+}
+
+static void run_tasks(ParallelJob* job, int thread_id) {
+    for (;;) {
+        size_t task = __atomic_fetch_add(&job->next_task, 1, __ATOMIC_RELAXED);
+        if (task >= job->task_count) return;
+        job->task(job->ctx, task, thread_id);
+    }
+}
+
+static void* worker_main(void* arg) {
+    ParallelWorker* worker = arg;
+    run_tasks(worker->job, worker->thread_id);
+    return NULL;
+}
+
+Status parallel_for(size_t task_count, int num_threads, ParallelTask task, void* ctx) {
+    DIAG_CHECK(task, STATUS_INVALID, "invalid task");
+    if (task_count == 0) return STATUS_SUCCESS;
+
+    num_threads = thread_count_resolve(num_threads);
+    if ((size_t)num_threads > task_count) num_threads = (int)task_count;
+
+    ParallelJob job = {task, ctx, task_count, 0};
+    if (num_threads == 1) {
+        run_tasks(&job, 0);
+        return STATUS_SUCCESS;
+    }
+
+    pthread_t* threads = malloc((size_t)num_threads * sizeof(pthread_t));
+    ParallelWorker* workers = malloc((size_t)num_threads * sizeof(ParallelWorker));
+    if (!threads || !workers) {
+        // Fall back to running everything on the calling thread
+        free(threads);
+        free(workers);
+        run_tasks(&job, 0);
+        return STATUS_SUCCESS;
+    }
+
+    // If a thread fails to start, the remaining ones simply pick up its share
+    int started = 0;
+    for (int i = 1; i < num_threads; i++) {
+        workers[started].job = &job;
+        workers[started].thread_id = i;
+        if (pthread_create(&threads[started], NULL, worker_main, &workers[started]) != 0) break;
+        started++;
+    }
+
+    run_tasks(&job, 0);
+
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+
+    free(threads);
+    free(workers);
+    return STATUS_SUCCESS;
+}
@@ -0,0 +1,711 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "core/graph_operations.h"
+#include "core/graph_batch.h"
+#include "core/graph_csr.h"
+#include "core/graph_subgraph.h"
+#include "core/graph_snapshot.h"
+#include "core/label_table.h"
+#include "core/graph_setops.h"
+#include "generators/graph_generators.h"
+#include "test_helpers.h"
+
+// ---------------------------------------------------------------------------
+// graph_build
+// ---------------------------------------------------------------------------
+
+static void test_insert_and_find_nodes(void) {
+    Graph* graph = graph_create(GRAPH_DIRECTED, 0);
+    EXPECT(graph != NULL);
+
+    // Enough nodes to force several table resizes
+    for (int id = 0; id < 1000; id++) EXPECT(graph_insert_node(graph, id * 7, 0) == STATUS_SUCCESS);
+    EXPECT(graph_node_count(graph) == 1000);
+    EXPECT(graph_insert_node(graph, 21, 0) == STATUS_WARNING);
+    EXPECT(graph_node_count(graph) == 1000);
+
+    for (int id = 0; id < 1000; id++) EXPECT(find_node(graph, id * 7) != NULL);
+    EXPECT(find_node(graph, 1) == NULL);
+    EXPECT(graph->node_ids[0] == 0 && graph->node_ids[999] == 999 * 7);
+
+    graph_destroy(graph);
+}
+
+static void test_undirected_edges(void) {
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 0; id < 4; id++) graph_insert_node(graph, id, 0);
+
+    EXPECT(graph_insert_edge(graph, 0, 1, 2.5) == STATUS_SUCCESS);
+    EXPECT(graph_insert_edge(graph, 1, 2, 1.0) == STATUS_SUCCESS);
+    EXPECT(graph_insert_edge(graph, 1, 0, 9.0) == STATUS_WARNING);
+    EXPECT(graph_insert_edge(graph, 3, 3, 1.0) == STATUS_WARNING);
+    EXPECT(graph_insert_edge(graph, 0, 42, 1.0) == STATUS_WARNING);
+
+    EXPECT(test_edge_weight(graph, 0, 1) == 2.5 && test_edge_weight(graph, 1, 0) == 2.5);
+    EXPECT(test_degree(graph, 3) == 0);
+    EXPECT(graph_edge_count(graph) == 2);
+
+    EXPECT(graph_update_edge(graph, 1, 0, 4.0) == STATUS_SUCCESS);
+    EXPECT(test_edge_weight(graph, 0, 1) == 4.0 && test_edge_weight(graph, 1, 0) == 4.0);
+    EXPECT(graph_update_edge(graph, 0, 2, 1.0) == STATUS_WARNING);
+
+    EXPECT(graph_remove_edge(graph, 2, 1) == STATUS_SUCCESS);
+    EXPECT(isnan(test_edge_weight(graph, 1, 2)) && isnan(test_edge_weight(graph, 2, 1)));
+    EXPECT(graph_remove_edge(graph, 2, 1) == STATUS_WARNING);
+    EXPECT(graph_edge_count(graph) == 1);
+
+    graph_destroy(graph);
+}
+
+static void test_directed_edges(void) {
+    Graph* graph = graph_create(GRAPH_DIRECTED, 0);
+    for (int id = 0; id < 3; id++) graph_insert_node(graph, id, 0);
+
+    EXPECT(graph_insert_edge(graph, 0, 1, 1.0) == STATUS_SUCCESS);
+    EXPECT(graph_insert_edge(graph, 1, 0, 2.0) == STATUS_SUCCESS);
+    EXPECT(graph_insert_edge(graph, 2, 2, 3.0) == STATUS_SUCCESS);
+    EXPECT(test_edge_weight(graph, 0, 1) == 1.0 && test_edge_weight(graph, 1, 0) == 2.0);
+    EXPECT(graph_edge_count(graph) == 3);
+    EXPECT(graph_is_directed(graph));
+
+    graph_destroy(graph);
+}
+
+static void test_remove_node(void) {
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    for (size_t t = 0; t < 2; t++) {
+        Graph* graph = graph_create(types[t], 0);
+        for (int id = 0; id < 5; id++) graph_insert_node(graph, id, 0);
+        for (int id = 1; id < 5; id++) graph_insert_edge(graph, id, 0, 1.0);
+        graph_insert_edge(graph, 0, 4, 1.0);
+        graph_insert_edge(graph, 2, 3, 1.0);
+
+        EXPECT(graph_remove_node(graph, 0) == STATUS_SUCCESS);
+        EXPECT(graph_remove_node(graph, 0) == STATUS_WARNING);
+        EXPECT(graph_node_count(graph) == 4);
+        EXPECT(find_node(graph, 0) == NULL);
+        for (int id = 1; id < 5; id++) EXPECT(isnan(test_edge_weight(graph, id, 0)));
+        EXPECT(test_edge_weight(graph, 2, 3) == 1.0);
+        EXPECT(graph_edge_count(graph) == 1);
+
+        // node_ids stays in insertion order without the removed ID
+        EXPECT(graph->node_ids[0] == 1 && graph->node_ids[3] == 4);
+        graph_destroy(graph);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// graph_batch
+// ---------------------------------------------------------------------------
+
+static Graph* small_graph(GraphType type) {
+    Graph* graph = graph_create(type, 0);
+    for (int id = 0; id < 6; id++) graph_insert_node(graph, id, 0);
+    for (int id = 0; id < 5; id++) graph_insert_edge(graph, id, id + 1, 1.0 + id);
+    graph_insert_edge(graph, 0, 3, 7.0);
+    return graph;
+}
+
+static void test_batch_commit(void) {
+    Graph* graph = small_graph(GRAPH_UNDIRECTED);
+    GraphBatch* batch = graph_batch_begin(graph);
+    EXPECT(graph_batch_insert_node(batch, 10, 0) == STATUS_SUCCESS);
+    graph_batch_insert_edge(batch, 10, 0, 0.5);
+    graph_batch_update_edge(batch, 1, 2, 9.0);
+    graph_batch_remove_edge(batch, 0, 3);
+    graph_batch_remove_node(batch, 5);
+    EXPECT(graph_batch_size(batch) == 5);
+
+    size_t failed = 99;
+    EXPECT(graph_batch_commit(batch, &failed) == STATUS_SUCCESS);
+    EXPECT(failed == 99);
+    EXPECT(graph_node_count(graph) == 6 && find_node(graph, 5) == NULL);
+    EXPECT(test_edge_weight(graph, 0, 10) == 0.5 && test_edge_weight(graph, 10, 0) == 0.5);
+    EXPECT(test_edge_weight(graph, 2, 1) == 9.0);
+    EXPECT(isnan(test_edge_weight(graph, 3, 0)));
+    EXPECT(isnan(test_edge_weight(graph, 4, 5)));
+    EXPECT(graph_edge_count(graph) == 5);
+    graph_destroy(graph);
+}
+
+static void test_batch_rollback_restores_graph(void) {
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    for (size_t t = 0; t < 2; t++) {
+        Graph* graph = small_graph(types[t]);
+        char* before = test_describe(graph);
+
+        GraphBatch* batch = graph_batch_begin(graph);
+        for (int id = 100; id < 150; id++) graph_batch_insert_node(batch, id, 0);
+        for (int id = 100; id < 149; id++) graph_batch_insert_edge(batch, id, id + 1, 2.0);
+        graph_batch_remove_node(batch, 3);
+        graph_batch_update_edge(batch, 0, 1, 5.0);
+        graph_batch_remove_edge(batch, 1, 2);
+        graph_batch_insert_edge(batch, 4, 100, 1.0);
+        graph_batch_insert_edge(batch, 4, 100, 1.0);    // duplicate, fails the whole batch
+
+        size_t failed = 0;
+        EXPECT(graph_batch_commit(batch, &failed) == STATUS_WARNING);
+        EXPECT(failed == 50 + 49 + 4);
+
+        char* after = test_describe(graph);
+        EXPECT(before && after && strcmp(before, after) == 0);
+        EXPECT(find_node(graph, 100) == NULL && graph_node_count(graph) == 6);
+        free(before);
+        free(after);
+        graph_destroy(graph);
+    }
+}
+
+static void test_batch_abort(void) {
+    Graph* graph = small_graph(GRAPH_DIRECTED);
+    char* before = test_describe(graph);
+    GraphBatch* batch = graph_batch_begin(graph);
+    graph_batch_remove_node(batch, 0);
+    graph_batch_insert_node(batch, 7, 0);
+    graph_batch_abort(batch);
+
+    char* after = test_describe(graph);
+    EXPECT(before && after && strcmp(before, after) == 0);
+    free(before);
+    free(after);
+    graph_destroy(graph);
+}
+
+static void test_batch_edges_to_new_nodes(void) {
+    // More distinct endpoints than nodes in the graph used to fill the degree map
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    GraphBatch* batch = graph_batch_begin(graph);
+    for (int i = 0; i < 40; i++) graph_batch_insert_edge(batch, i, i + 1000, 1.0);
+    size_t failed = 99;
+    EXPECT(graph_batch_commit(batch, &failed) == STATUS_WARNING);
+    EXPECT(failed == 0 && graph_node_count(graph) == 0);
+
+    batch = graph_batch_begin(graph);
+    for (int i = 0; i < 40; i++) {
+        graph_batch_insert_node(batch, i, 0);
+        graph_batch_insert_node(batch, i + 1000, 0);
+    }
+    for (int i = 0; i < 40; i++) graph_batch_insert_edge(batch, i, i + 1000, 1.0);
+    EXPECT(graph_batch_commit(batch, NULL) == STATUS_SUCCESS);
+    EXPECT(graph_node_count(graph) == 80 && graph_edge_count(graph) == 40);
+    EXPECT(test_edge_weight(graph, 1039, 39) == 1.0);
+    graph_destroy(graph);
+}
+
+static void test_batch_self_loops(void) {
+    Graph* graph = small_graph(GRAPH_UNDIRECTED);
+    GraphBatch* batch = graph_batch_begin(graph);
+    EXPECT(graph_batch_insert_edge(batch, 2, 2, 1.0) == STATUS_WARNING);
+    EXPECT(graph_batch_size(batch) == 0);
+    EXPECT(graph_batch_commit(batch, NULL) == STATUS_SUCCESS);
+    EXPECT(test_degree(graph, 2) == 2);
+    graph_destroy(graph);
+
+    // Directed self loops are accepted, like graph_insert_edge does
+    graph = small_graph(GRAPH_DIRECTED);
+    batch = graph_batch_begin(graph);
+    EXPECT(graph_batch_insert_edge(batch, 2, 2, 3.0) == STATUS_SUCCESS);
+    EXPECT(graph_batch_commit(batch, NULL) == STATUS_SUCCESS);
+    EXPECT(test_edge_weight(graph, 2, 2) == 3.0 && test_degree(graph, 2) == 2);
+
+    batch = graph_batch_begin(graph);
+    graph_batch_remove_edge(batch, 2, 2);
+    EXPECT(graph_batch_commit(batch, NULL) == STATUS_SUCCESS);
+    EXPECT(test_degree(graph, 2) == 1);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// graph_csr
+// ---------------------------------------------------------------------------
+
+static void test_csr_layout(void) {
+    Graph* graph = graph_create(GRAPH_DIRECTED, 0);
+    int ids[] = {40, 10, 30, 20};
+    for (size_t i = 0; i < 4; i++) graph_insert_node(graph, ids[i], 0);
+    graph_insert_edge(graph, 40, 20, 1.5);
+    graph_insert_edge(graph, 40, 10, 2.5);
+    graph_insert_edge(graph, 40, 30, 3.5);
+    graph_insert_edge(graph, 20, 40, 4.5);
+
+    GraphCsr csr;
+    EXPECT(graph_csr_build(graph, &csr, true, 1) == STATUS_SUCCESS);
+    EXPECT(csr.node_count == 4 && csr.arc_count == 4);
+    for (uint32_t i = 0; i < 4; i++) {
+        EXPECT(csr.ids[i] == ids[i]);
+        EXPECT(graph_csr_index(&csr, ids[i]) == i);
+    }
+    EXPECT(graph_csr_index(&csr, 50) == CSR_NO_INDEX);
+
+    // Neighbors of 40 sorted by index: 10 (1), 30 (2), 20 (3)
+    EXPECT(graph_csr_degree(&csr, 0) == 3 && graph_csr_degree(&csr, 1) == 0);
+    EXPECT(csr.targets[0] == 1 && csr.targets[1] == 2 && csr.targets[2] == 3);
+    EXPECT(csr.weights[0] == 2.5 && csr.weights[1] == 3.5 && csr.weights[2] == 1.5);
+    EXPECT(csr.targets[csr.offsets[3]] == 0 && csr.weights[csr.offsets[3]] == 4.5);
+    graph_csr_free(&csr);
+
+    EXPECT(graph_csr_build(graph, &csr, false, 1) == STATUS_SUCCESS);
+    EXPECT(csr.weights == NULL);
+    graph_csr_free(&csr);
+    graph_destroy(graph);
+}
+
+static void test_csr_thread_independent(void) {
+    GeneratorConfig config = generator_config_default(GEN_RMAT);
+    config.params.rmat.scale = 12;
+    config.params.rmat.edge_factor = 8;
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    generate_graph(graph, &config, NULL);
+
+    GraphCsr one, four;
+    EXPECT(graph_csr_build(graph, &one, true, 1) == STATUS_SUCCESS);
+    EXPECT(graph_csr_build(graph, &four, true, 4) == STATUS_SUCCESS);
+    EXPECT(one.arc_count == 2 * graph_edge_count(graph) && four.arc_count == one.arc_count);
+    EXPECT(memcmp(one.offsets, four.offsets, (one.node_count + 1) * sizeof(size_t)) == 0);
+    EXPECT(memcmp(one.targets, four.targets, one.arc_count * sizeof(uint32_t)) == 0);
+
+    size_t unsorted = 0;
+    for (uint32_t v = 0; v < one.node_count; v++) {
+        for (size_t e = one.offsets[v] + 1; e < one.offsets[v + 1]; e++) unsorted += one.targets[e - 1] >= one.targets[e];
+    }
+    EXPECT(unsorted == 0);
+
+    graph_csr_free(&one);
+    graph_csr_free(&four);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// graph_subgraph
+// ---------------------------------------------------------------------------
+
+static bool heavy_edge(int from, int to, double weight, void* ctx) {
+    (void)from;
+    (void)to;
+    return weight >= *(const double*)ctx;
+}
+
+static bool ordered_edge(int from, int to, double weight, void* ctx) {
+    (void)weight;
+    (void)ctx;
+    return from < to;
+}
+
+static void test_induced_subgraph(void) {
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    for (size_t t = 0; t < 2; t++) {
+        Graph* graph = small_graph(types[t]);
+        int ids[] = {3, 0, 1, 3, 42};
+
+        GraphView* view = graph_view_induced(graph, ids, 5);
+        EXPECT(view != NULL);
+        EXPECT(graph_view_node_count(view) == 3);
+        EXPECT(graph_view_node_id(view, 0) == 3 && graph_view_node_id(view, 2) == 1);
+        EXPECT(graph_view_has_node(view, 0) && !graph_view_has_node(view, 2) && !graph_view_has_node(view, 42));
+        EXPECT(graph_view_degree(view, 0) == 2);
+
+        // Iteration yields exactly the edges among the selected nodes
+        GraphViewIter iter;
+        size_t seen = 0;
+        EXPECT(graph_view_neighbors(view, 0, &iter));
+        for (const EdgeNode* edge = graph_view_next(&iter); edge; edge = graph_view_next(&iter)) {
+            seen++;
+            EXPECT(edge->node_id == 1 || edge->node_id == 3);
+        }
+        EXPECT(seen == 2);
+        EXPECT(!graph_view_neighbors(view, 4, &iter));
+
+        Graph* sub = graph_view_materialize(view);
+        Graph* expected = graph_create(types[t], 0);
+        graph_insert_node(expected, 3, 0);
+        graph_insert_node(expected, 0, 0);
+        graph_insert_node(expected, 1, 0);
+        graph_insert_edge(expected, 0, 1, 1.0);
+        graph_insert_edge(expected, 0, 3, 7.0);
+        EXPECT(sub && test_graphs_equal(sub, expected));
+        EXPECT(sub && sub->node_ids[0] == 3 && sub->node_ids[2] == 1);
+
+        Graph* direct = graph_induced_subgraph(graph, ids, 5);
+        EXPECT(direct && test_graphs_equal(direct, expected));
+
+        graph_destroy(direct);
+        graph_destroy(expected);
+        graph_destroy(sub);
+        graph_view_destroy(view);
+        graph_destroy(graph);
+    }
+}
+
+static void test_filtered_edges(void) {
+    Graph* graph = small_graph(GRAPH_UNDIRECTED);
+    double threshold = 3.0;
+
+    GraphView* view = graph_view_filtered(graph, heavy_edge, &threshold);
+    EXPECT(graph_view_node_count(view) == 6);
+    EXPECT(graph_view_degree(view, 0) == 1 && graph_view_degree(view, 3) == 3);
+    graph_view_destroy(view);
+
+    Graph* heavy = graph_filter_edges(graph, heavy_edge, &threshold);
+    EXPECT(heavy && graph_node_count(heavy) == 6 && graph_edge_count(heavy) == 4);
+    EXPECT(heavy && test_edge_weight(heavy, 3, 0) == 7.0 && test_edge_weight(heavy, 4, 3) == 4.0);
+    EXPECT(heavy && isnan(test_edge_weight(heavy, 1, 2)));
+    graph_destroy(heavy);
+
+    // Undirected edges are offered once as (min, max), so both directions are kept
+    Graph* all = graph_filter_edges(graph, ordered_edge, NULL);
+    EXPECT(all && test_graphs_equal(all, graph));
+    graph_destroy(all);
+
+    Graph* directed = small_graph(GRAPH_DIRECTED);
+    graph_insert_edge(directed, 3, 0, 1.0);
+    Graph* forward = graph_filter_edges(directed, ordered_edge, NULL);
+    EXPECT(forward && graph_edge_count(forward) == 6 && isnan(test_edge_weight(forward, 3, 0)));
+    graph_destroy(forward);
+    graph_destroy(directed);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// graph_snapshot
+// ---------------------------------------------------------------------------
+
+static void test_snapshot_isolation(void) {
+    VersionedGraph* versioned = versioned_graph_create(small_graph(GRAPH_UNDIRECTED));
+    Graph* expected = small_graph(GRAPH_UNDIRECTED);
+    EXPECT(versioned != NULL);
+    if (!versioned) return;
+
+    char* before = test_describe(versioned_graph_current(versioned));
+    GraphSnapshot* snapshot = graph_snapshot(versioned);
+    EXPECT(snapshot != NULL);
+    EXPECT(graph_snapshot_version(snapshot) == 0);
+
+    // Enough nodes for several resizes while the snapshot is live
+    for (int id = 100; id < 400; id++) {
+        EXPECT(versioned_graph_insert_node(versioned, id, 0) == STATUS_SUCCESS);
+        graph_insert_node(expected, id, 0);
+        EXPECT(versioned_graph_insert_edge(versioned, id, id % 6, 0.5) == STATUS_SUCCESS);
+        graph_insert_edge(expected, id, id % 6, 0.5);
+    }
+    EXPECT(versioned_graph_insert_node(versioned, 100, 0) == STATUS_WARNING);
+    EXPECT(versioned_graph_insert_edge(versioned, 4, 4, 1.0) != STATUS_SUCCESS);
+    EXPECT(versioned_graph_update_edge(versioned, 1, 2, 9.0) == STATUS_SUCCESS);
+    graph_update_edge(expected, 1, 2, 9.0);
+    EXPECT(versioned_graph_remove_edge(versioned, 0, 3) == STATUS_SUCCESS);
+    graph_remove_edge(expected, 0, 3);
+    EXPECT(versioned_graph_remove_node(versioned, 2) == STATUS_SUCCESS);
+    graph_remove_node(expected, 2);
+    EXPECT(versioned_graph_remove_node(versioned, 2) == STATUS_WARNING);
+
+    EXPECT(test_graphs_equal(versioned_graph_current(versioned), expected));
+    char* frozen = test_describe(graph_snapshot_graph(snapshot));
+    EXPECT(before && frozen && strcmp(before, frozen) == 0);
+
+    VersionedGraphStats stats;
+    versioned_graph_stats(versioned, &stats);
+    EXPECT(stats.live_snapshots == 1);
+    EXPECT(stats.retired_blocks > 0);
+    EXPECT(stats.tables_copied > 0);
+
+    graph_snapshot_release(snapshot);
+    versioned_graph_stats(versioned, &stats);
+    EXPECT(stats.live_snapshots == 0);
+    EXPECT(stats.retired_blocks == 0);
+
+    free(before);
+    free(frozen);
+    graph_destroy(expected);
+    versioned_graph_destroy(versioned);
+}
+
+static void test_snapshot_versions_during_growth(void) {
+    VersionedGraph* versioned = versioned_graph_create(graph_create(GRAPH_DIRECTED, 0));
+    EXPECT(versioned != NULL);
+    if (!versioned) return;
+
+    // One snapshot every 50 inserts, each must keep seeing exactly its prefix
+    GraphSnapshot* snapshots[20];
+    for (int round = 0; round < 20; round++) {
+        for (int id = round * 50; id < (round + 1) * 50; id++) {
+            EXPECT(versioned_graph_insert_node(versioned, id, 0) == STATUS_SUCCESS);
+            if (id > 0) EXPECT(versioned_graph_insert_edge(versioned, id, id - 1, (double)id) == STATUS_SUCCESS);
+        }
+        snapshots[round] = graph_snapshot(versioned);
+        EXPECT(snapshots[round] != NULL);
+    }
+    EXPECT(graph_snapshot_version(snapshots[19]) > graph_snapshot_version(snapshots[0]));
+
+    for (int round = 0; round < 20; round++) {
+        const Graph* graph = graph_snapshot_graph(snapshots[round]);
+        int count = (round + 1) * 50;
+        EXPECT(graph->node_count == (size_t)count);
+        EXPECT(find_node(graph, count) == NULL);
+        for (int id = 1; id < count; id++) {
+            EXPECT(test_edge_weight(graph, id, id - 1) == (double)id);
+        }
+    }
+
+    // Destroying first hands the memory to the last snapshot
+    versioned_graph_destroy(versioned);
+    for (int round = 0; round < 20; round += 2) graph_snapshot_release(snapshots[round]);
+    EXPECT(graph_snapshot_graph(snapshots[19])->node_count == 1000);
+    for (int round = 1; round < 20; round += 2) graph_snapshot_release(snapshots[round]);
+}
+
+// ---------------------------------------------------------------------------
+// label_table
+// ---------------------------------------------------------------------------
+
+static void test_label_table_intern(void) {
+    LabelTable* table = label_table_create(0);
+    EXPECT(table != NULL);
+    if (!table) return;
+
+    int id;
+    EXPECT(label_table_intern(table, "TP53", 4, &id) == STATUS_SUCCESS && id == 0);
+    EXPECT(label_table_intern(table, "TP53X", 4, &id) == STATUS_SUCCESS && id == 0);    // only length bytes count
+    EXPECT(label_table_intern(table, "MDM2", 4, &id) == STATUS_SUCCESS && id == 1);
+    EXPECT(label_table_intern(table, "TP5", 3, &id) == STATUS_SUCCESS && id == 2);
+    EXPECT(label_table_intern(table, "", 0, &id) == STATUS_SUCCESS && id == 3);
+    EXPECT(label_table_count(table) == 4 && label_table_max_length(table) == 4);
+
+    size_t length = 0;
+    EXPECT(strcmp(label_table_name(table, 2, &length), "TP5") == 0 && length == 3);
+    EXPECT(label_table_name(table, 4, NULL) == NULL && label_table_name(table, -1, NULL) == NULL);
+    EXPECT(label_table_find(table, "MDM2", 4) == 1);
+    EXPECT(label_table_find(table, "MDM", 3) == -1);
+    EXPECT(label_table_intern(table, NULL, 0, &id) == STATUS_INVALID);
+
+    // Enough labels for several slot resizes and arena blocks, plus one label past the block size
+    char label[32];
+    bool dense = true;
+    for (int i = 0; i < 100000; i++) {
+        int length_i = snprintf(label, sizeof(label), "GENE%d", i);
+        dense = dense && label_table_intern(table, label, (size_t)length_i, &id) == STATUS_SUCCESS && id == 4 + i;
+    }
+    EXPECT(dense);
+    size_t large_length = (size_t)1 << 21;
+    char* large = malloc(large_length);
+    memset(large, 'x', large_length);
+    EXPECT(label_table_intern(table, large, large_length, &id) == STATUS_SUCCESS && id == 100004);
+    EXPECT(label_table_intern(table, "after", 5, &id) == STATUS_SUCCESS && id == 100005);
+
+    bool found = true;
+    for (int i = 0; i < 100000; i++) {
+        int length_i = snprintf(label, sizeof(label), "GENE%d", i);
+        const char* name = label_table_name(table, 4 + i, &length);
+        found = found && label_table_find(table, label, (size_t)length_i) == 4 + i;
+        found = found && name && length == (size_t)length_i && strcmp(name, label) == 0;
+    }
+    EXPECT(found);
+    EXPECT(label_table_find(table, large, large_length) == 100004);
+    EXPECT(label_table_max_length(table) == large_length);
+    EXPECT(strcmp(label_table_name(table, 0, NULL), "TP53") == 0);
+
+    free(large);
+    label_table_destroy(table);
+}
+
+static void test_label_table_save_load(void) {
+    LabelTable* table = label_table_create(16);
+    const char* labels[] = {"BRCA1", "BRCA2", "", "EGFR", "HLA-A*02:01"};
+    int id;
+    for (int i = 0; i < 5; i++) label_table_intern(table, labels[i], strlen(labels[i]), &id);
+
+    char path[64];
+    test_temp_path(path, sizeof(path), "labels");
+    EXPECT(label_table_save(table, path) == STATUS_SUCCESS);
+    LabelTable* loaded = label_table_load(path);
+    EXPECT(loaded != NULL && label_table_count(loaded) == 5);
+    for (int i = 0; loaded && i < 5; i++) {
+        EXPECT(strcmp(label_table_name(loaded, i, NULL), labels[i]) == 0);
+        EXPECT(label_table_find(loaded, labels[i], strlen(labels[i])) == i);
+    }
+    label_table_destroy(loaded);
+
+    // A line break cannot be saved, a repeated line cannot be loaded
+    label_table_intern(table, "two\nlines", 9, &id);
+    EXPECT(label_table_save(table, path) == STATUS_INVALID);
+    label_table_destroy(table);
+
+    char duplicate[64];
+    test_write_file(duplicate, sizeof(duplicate), "labels", "A\nB\nA\n");
+    EXPECT(label_table_load(duplicate) == NULL);
+    EXPECT(label_table_load("/nonexistent/labels.txt") == NULL);
+    unlink(path);
+    unlink(duplicate);
+}
+
+// ---------------------------------------------------------------------------
+// graph_setops
+// ---------------------------------------------------------------------------
+
+// Helper: nodes first .. last inserted in a scrambled order, pseudo-random edges and weights
+static Graph* setop_graph(GraphType type, int first, int last, uint32_t salt) {
+    Graph* graph = graph_create(type, 0);
+    int count = last - first + 1;
+    for (int i = 0; i < count; i++) graph_insert_node(graph, first + (i * 37) % count, 0);
+    for (int u = first; u <= last; u++) {
+        for (int v = type == GRAPH_UNDIRECTED ? u + 1 : first; v <= last; v++) {
+            uint32_t h = ((uint32_t)u * 2654435761u) ^ ((uint32_t)v * 40503u) ^ salt;
+            h ^= h >> 13;
+            h *= 0x5bd1e995u;
+            h ^= h >> 15;
+            if (u != v && h % 9 == 0) graph_insert_edge(graph, u, v, 0.5 + (double)(h % 17));
+        }
+    }
+    return graph;
+}
+
+// Helper: is the output node order the one the header promises
+static bool setop_node_order(const Graph* result, const Graph* a, const Graph* b, int op) {
+    size_t k = 0;
+    for (size_t i = 0; i < a->node_count; i++) {
+        int id = a->node_ids[i];
+        if (op == 1 && !find_node(b, id)) continue;
+        if (k >= result->node_count || result->node_ids[k++] != id) return false;
+    }
+    for (size_t i = 0; op == 0 && i < b->node_count; i++) {
+        int id = b->node_ids[i];
+        if (find_node(a, id)) continue;
+        if (k >= result->node_count || result->node_ids[k++] != id) return false;
+    }
+    return k == result->node_count;
+}
+
+static double combine(WeightRule rule, double first, double second) {
+    switch (rule) {
+        case WEIGHT_SECOND: return second;
+        case WEIGHT_SUM: return first + second;
+        case WEIGHT_MIN: return fmin(first, second);
+        case WEIGHT_MAX: return fmax(first, second);
+        case WEIGHT_MEAN: return (first + second) / 2.0;
+        default: return first;
+    }
+}
+
+// Helper: every edge of the result is expected and every expected edge is there (op 0 union, 1 intersection, 2 difference)
+static bool setop_edges(const Graph* result, const Graph* a, const Graph* b, int op, WeightRule rule) {
+    size_t expected_arcs = 0, result_arcs = 0;
+    for (size_t i = 0; i < result->node_count; i++) {
+        int u = result->node_ids[i];
+        const Node* node = find_node(result, u);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            if (e > 0 && node->neighbors[e - 1].node_id >= node->neighbors[e].node_id) return false;
+        }
+        result_arcs += node->neighbor_count;
+
+        for (size_t j = 0; j < result->node_count; j++) {
+            int v = result->node_ids[j];
+            double in_a = test_edge_weight(a, u, v), in_b = test_edge_weight(b, u, v);
+            double expected = NAN;
+            if (op == 0) expected = isnan(in_a) ? in_b : isnan(in_b) ? in_a : combine(rule, in_a, in_b);
+            if (op == 1 && !isnan(in_a) && !isnan(in_b)) expected = combine(rule, in_a, in_b);
+            if (op == 2 && isnan(in_b)) expected = in_a;
+
+            double got = test_edge_weight(result, u, v);
+            if (isnan(expected) != isnan(got) || (!isnan(got) && got != expected)) return false;
+            expected_arcs += !isnan(expected);
+        }
+    }
+    return expected_arcs == result_arcs;
+}
+
+static void test_setops_match_brute_force(void) {
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    WeightRule rules[] = {WEIGHT_FIRST, WEIGHT_SECOND, WEIGHT_SUM, WEIGHT_MIN, WEIGHT_MAX, WEIGHT_MEAN};
+    Graph* (*ops[])(const Graph*, const Graph*, const SetOpConfig*) = {graph_union, graph_intersection, graph_difference};
+
+    for (int t = 0; t < 2; t++) {
+        Graph* a = setop_graph(types[t], 0, 79, 1);
+        Graph* b = setop_graph(types[t], 40, 119, 2);
+        // Shared edges with different weights
+        for (int u = 40; u < 79; u += 3) {
+            if (graph_insert_edge(a, u, u + 1, 2.0) != STATUS_SUCCESS) graph_update_edge(a, u, u + 1, 2.0);
+            if (graph_insert_edge(b, u, u + 1, 5.0) != STATUS_SUCCESS) graph_update_edge(b, u, u + 1, 5.0);
+        }
+
+        for (int op = 0; op < 3; op++) {
+            for (int r = 0; r < 6; r++) {
+                SetOpConfig config = setop_config_default();
+                config.weights = rules[r];
+                config.num_threads = 1;
+                Graph* serial = ops[op](a, b, &config);
+                config.num_threads = 4;
+                Graph* parallel = ops[op](a, b, &config);
+                EXPECT(serial && parallel);
+                if (serial && parallel) {
+                    EXPECT(serial->type == types[t]);
+                    EXPECT(setop_node_order(serial, a, b, op));
+                    EXPECT(setop_edges(serial, a, b, op, rules[r]));
+                    char* serial_text = test_describe(serial);
+                    char* parallel_text = test_describe(parallel);
+                    EXPECT(serial_text && parallel_text && strcmp(serial_text, parallel_text) == 0);
+                    free(serial_text);
+                    free(parallel_text);
+                }
+                graph_destroy(serial);
+                graph_destroy(parallel);
+            }
+        }
+        graph_destroy(a);
+        graph_destroy(b);
+    }
+}
+
+static void test_setops_edge_cases(void) {
+    Graph* a = small_graph(GRAPH_UNDIRECTED);
+    Graph* directed = small_graph(GRAPH_DIRECTED);
+    Graph* empty = graph_create(GRAPH_UNDIRECTED, 0);
+
+    EXPECT(graph_union(a, directed, NULL) == NULL);
+    EXPECT(graph_intersection(a, NULL, NULL) == NULL);
+
+    // With itself: union and intersection are copies, the difference keeps the nodes only
+    Graph* same = graph_union(a, a, NULL);
+    EXPECT(same && test_graphs_equal(same, a));
+    graph_destroy(same);
+    same = graph_intersection(a, a, NULL);
+    EXPECT(same && test_graphs_equal(same, a));
+    graph_destroy(same);
+    Graph* none = graph_difference(a, a, NULL);
+    EXPECT(none && none->node_count == a->node_count && graph_edge_count(none) == 0);
+    graph_destroy(none);
+
+    Graph* nothing = graph_intersection(a, empty, NULL);
+    EXPECT(nothing && nothing->node_count == 0);
+    graph_destroy(nothing);
+    Graph* all = graph_difference(a, empty, NULL);
+    EXPECT(all && test_graphs_equal(all, a));
+    graph_destroy(all);
+
+    graph_destroy(a);
+    graph_destroy(directed);
+    graph_destroy(empty);
+}
+
+int main(void) {
+    printf("test_core\n");
+    RUN_TEST(test_insert_and_find_nodes);
+    RUN_TEST(test_undirected_edges);
+    RUN_TEST(test_directed_edges);
+    RUN_TEST(test_remove_node);
+    RUN_TEST(test_batch_commit);
+    RUN_TEST(test_batch_rollback_restores_graph);
+    RUN_TEST(test_batch_abort);
+    RUN_TEST(test_batch_edges_to_new_nodes);
+    RUN_TEST(test_batch_self_loops);
+    RUN_TEST(test_csr_layout);
+    RUN_TEST(test_csr_thread_independent);
+    RUN_TEST(test_induced_subgraph);
+    RUN_TEST(test_filtered_edges);
+    RUN_TEST(test_snapshot_isolation);
+    RUN_TEST(test_snapshot_versions_during_growth);
+    RUN_TEST(test_label_table_intern);
+    RUN_TEST(test_label_table_save_load);
+    RUN_TEST(test_setops_match_brute_force);
+    RUN_TEST(test_setops_edge_cases);
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,475 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "generators/graph_generators.h"
+#include "generators/random_walks.h"
+#include "io/edge_list.h"
+#include "test_helpers.h"
+
+// Helper: generated graph, NULL on failure
+static Graph* generate(const GeneratorConfig* config, GraphType type, size_t* edges) {
+    Graph* graph = graph_create(type, 0);
+    if (graph && generate_graph(graph, config, edges) != STATUS_SUCCESS) {
+        graph_destroy(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+// Helper: whole file into a malloc'd string
+static char* read_text(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = malloc((size_t)size + 1);
+    if (text) text[fread(text, 1, (size_t)size, file)] = '\0';
+    fclose(file);
+    return text;
+}
+
+static bool has_self_loop(const Graph* graph) {
+    for (size_t i = 0; i < graph->node_count; i++) {
+        if (!isnan(test_edge_weight(graph, graph->node_ids[i], graph->node_ids[i]))) return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// graph_generators
+// ---------------------------------------------------------------------------
+
+static void test_rmat_thread_independent(void) {
+    GeneratorConfig config = generator_config_default(GEN_RMAT);
+    config.params.rmat.scale = 10;
+    config.params.rmat.edge_factor = 8;
+    config.seed = 7;
+
+    size_t edges_1, edges_4;
+    config.num_threads = 1;
+    Graph* one = generate(&config, GRAPH_UNDIRECTED, &edges_1);
+    config.num_threads = 4;
+    Graph* four = generate(&config, GRAPH_UNDIRECTED, &edges_4);
+
+    EXPECT(one && four);
+    if (one && four) {
+        EXPECT(graph_node_count(one) == 1024);
+        EXPECT(edges_1 == edges_4 && edges_1 == graph_edge_count(one));
+        EXPECT(edges_1 > 0 && edges_1 <= 8 * 1024);
+        EXPECT(test_graphs_equal(one, four));
+        EXPECT(!has_self_loop(one));
+    }
+    graph_destroy(one);
+    graph_destroy(four);
+
+    // Another seed gives another graph
+    config.seed = 8;
+    Graph* other = generate(&config, GRAPH_UNDIRECTED, NULL);
+    config.seed = 7;
+    Graph* same = generate(&config, GRAPH_UNDIRECTED, NULL);
+    EXPECT(other && same && !test_graphs_equal(other, same));
+    graph_destroy(other);
+    graph_destroy(same);
+}
+
+static void test_erdos_renyi_extremes(void) {
+    GeneratorConfig config = generator_config_default(GEN_ERDOS_RENYI);
+    config.params.er.node_count = 50;
+    config.params.er.p = 1.0;
+
+    size_t edges;
+    Graph* complete = generate(&config, GRAPH_UNDIRECTED, &edges);
+    EXPECT(complete && edges == 50 * 49 / 2);
+    EXPECT(complete && !has_self_loop(complete));
+    graph_destroy(complete);
+
+    Graph* directed = generate(&config, GRAPH_DIRECTED, &edges);
+    EXPECT(directed && edges == 50 * 49);
+    graph_destroy(directed);
+
+    config.params.er.p = 0.0;
+    Graph* empty = generate(&config, GRAPH_UNDIRECTED, &edges);
+    EXPECT(empty && edges == 0 && graph_node_count(empty) == 50);
+    graph_destroy(empty);
+
+    config.params.er.p = 1.5;
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    EXPECT(generate_graph(graph, &config, NULL) == STATUS_INVALID);
+    graph_destroy(graph);
+}
+
+static void test_erdos_renyi_density(void) {
+    GeneratorConfig config = generator_config_default(GEN_ERDOS_RENYI);
+    config.params.er.node_count = 2000;
+    config.params.er.p = 0.01;
+
+    size_t edges;
+    Graph* graph = generate(&config, GRAPH_UNDIRECTED, &edges);
+    // Expected 19990 edges, standard deviation about 140
+    EXPECT(graph && edges > 19000 && edges < 21000);
+    graph_destroy(graph);
+}
+
+static void test_sbm_blocks(void) {
+    size_t sizes[] = {30, 20};
+    double probabilities[] = {1.0, 0.0, 0.0, 1.0};
+    GeneratorConfig config = generator_config_default(GEN_SBM);
+    config.params.sbm.block_count = 2;
+    config.params.sbm.block_sizes = sizes;
+    config.params.sbm.probabilities = probabilities;
+
+    size_t edges;
+    Graph* graph = generate(&config, GRAPH_UNDIRECTED, &edges);
+    EXPECT(graph && edges == 30 * 29 / 2 + 20 * 19 / 2);
+    if (graph) {
+        EXPECT(graph_node_count(graph) == 50);
+        EXPECT(isnan(test_edge_weight(graph, 0, 30)) && isnan(test_edge_weight(graph, 29, 49)));
+        EXPECT(test_edge_weight(graph, 30, 49) == 1.0);
+    }
+    graph_destroy(graph);
+}
+
+static void test_barabasi_albert(void) {
+    GeneratorConfig config = generator_config_default(GEN_BARABASI_ALBERT);
+    config.params.ba.node_count = 2000;
+    config.params.ba.edges_per_node = 3;
+
+    size_t edges;
+    Graph* graph = generate(&config, GRAPH_UNDIRECTED, &edges);
+    EXPECT(graph && graph_node_count(graph) == 2000);
+    EXPECT(graph && edges > 0 && edges <= 3 * 2000);
+
+    // Preferential attachment grows hubs well above the average degree of 6
+    size_t max_degree = 0;
+    for (int id = 0; graph && id < 2000; id++) {
+        if (test_degree(graph, id) > max_degree) max_degree = test_degree(graph, id);
+    }
+    EXPECT(max_degree > 30);
+    EXPECT(graph && !has_self_loop(graph));
+    graph_destroy(graph);
+}
+
+static void test_edge_list_file(void) {
+    GeneratorConfig config = generator_config_default(GEN_RMAT);
+    config.params.rmat.scale = 8;
+    config.params.rmat.edge_factor = 4;
+    config.type = GRAPH_DIRECTED;
+
+    char path_1[64], path_3[64];
+    test_temp_path(path_1, sizeof(path_1), "test_gen");
+    test_temp_path(path_3, sizeof(path_3), "test_gen");
+    size_t lines_1, lines_3;
+    config.num_threads = 1;
+    EXPECT(generate_edge_list(path_1, &config, &lines_1) == STATUS_SUCCESS);
+    config.num_threads = 3;
+    EXPECT(generate_edge_list(path_3, &config, &lines_3) == STATUS_SUCCESS);
+
+    char* text_1 = read_text(path_1);
+    char* text_3 = read_text(path_3);
+    EXPECT(text_1 && text_3 && strcmp(text_1, text_3) == 0);
+    EXPECT(lines_1 == lines_3 && lines_1 > 0 && lines_1 <= 4 * 256);
+
+    // The file loads back into the same graph generate_graph builds
+    Graph* loaded = graph_create(GRAPH_DIRECTED, 0);
+    load_graph(path_1, loaded);
+    Graph* generated = generate(&config, GRAPH_DIRECTED, NULL);
+    EXPECT(generated && graph_edge_count(loaded) == graph_edge_count(generated));
+
+    free(text_1);
+    free(text_3);
+    graph_destroy(loaded);
+    graph_destroy(generated);
+    unlink(path_1);
+    unlink(path_3);
+}
+
+// ---------------------------------------------------------------------------
+// random_walks
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int* nodes;                 // walk_count x stride
+    uint32_t* lengths;
+    size_t walk_count;
+    size_t stride;
+    size_t capacity;
+    size_t blocks;
+    bool in_order;
+    int stop_after;             // blocks before the sink fails, -1 = never
+} WalkCorpus;
+
+static Status collect_walks(void* ctx, const WalkBlock* block) {
+    WalkCorpus* corpus = ctx;
+    if (corpus->stop_after >= 0 && corpus->blocks == (size_t)corpus->stop_after) return STATUS_ERROR;
+    corpus->blocks++;
+    if (block->first_walk != corpus->walk_count) corpus->in_order = false;
+
+    size_t needed = corpus->walk_count + block->count;
+    if (needed > corpus->capacity) {
+        size_t capacity = corpus->capacity ? corpus->capacity : 64;
+        while (capacity < needed) capacity *= 2;
+        int* nodes = realloc(corpus->nodes, capacity * block->stride * sizeof(int));
+        if (!nodes) return STATUS_OOM;
+        corpus->nodes = nodes;
+        uint32_t* lengths = realloc(corpus->lengths, capacity * sizeof(uint32_t));
+        if (!lengths) return STATUS_OOM;
+        corpus->lengths = lengths;
+        corpus->capacity = capacity;
+    }
+    corpus->stride = block->stride;
+    memcpy(corpus->nodes + corpus->walk_count * block->stride, block->nodes, block->count * block->stride * sizeof(int));
+    memcpy(corpus->lengths + corpus->walk_count, block->lengths, block->count * sizeof(uint32_t));
+    corpus->walk_count = needed;
+    return STATUS_SUCCESS;
+}
+
+// Helper: whole corpus, NULL nodes on failure
+static WalkCorpus walk_corpus(const Graph* graph, const WalkConfig* config, Status* status) {
+    WalkCorpus corpus = {NULL, NULL, 0, 0, 0, 0, true, -1};
+    size_t count = 0;
+    *status = graph_random_walks(graph, config, collect_walks, &corpus, &count);
+    EXPECT(count == corpus.walk_count);
+    return corpus;
+}
+
+static bool corpus_equal(const WalkCorpus* a, const WalkCorpus* b) {
+    if (a->walk_count != b->walk_count || a->stride != b->stride) return false;
+    for (size_t w = 0; w < a->walk_count; w++) {
+        if (a->lengths[w] != b->lengths[w]) return false;
+        if (memcmp(a->nodes + w * a->stride, b->nodes + w * b->stride, a->lengths[w] * sizeof(int)) != 0) return false;
+    }
+    return true;
+}
+
+static void corpus_free(WalkCorpus* corpus) {
+    free(corpus->nodes);
+    free(corpus->lengths);
+}
+
+// Helper: every step follows an edge and only dead ends cut a walk short
+static bool corpus_valid(const Graph* graph, const WalkCorpus* corpus) {
+    for (size_t w = 0; w < corpus->walk_count; w++) {
+        const int* walk = corpus->nodes + w * corpus->stride;
+        uint32_t length = corpus->lengths[w];
+        if (length == 0 || length > corpus->stride) return false;
+        for (uint32_t i = 1; i < length; i++) {
+            if (isnan(test_edge_weight(graph, walk[i - 1], walk[i]))) return false;
+        }
+        if (length < corpus->stride && test_degree(graph, walk[length - 1]) != 0) return false;
+    }
+    return true;
+}
+
+static void test_walks_valid_and_thread_independent(void) {
+    GeneratorConfig generator = generator_config_default(GEN_ERDOS_RENYI);
+    generator.params.er.node_count = 300;
+    generator.params.er.p = 0.02;
+    generator.seed = 5;
+    Graph* graph = generate(&generator, GRAPH_DIRECTED, NULL);
+    EXPECT(graph != NULL);
+    if (!graph) return;
+    for (size_t i = 0; i < graph->node_count; i++) {
+        Node* node = find_node(graph, graph->node_ids[i]);
+        for (size_t e = 0; e < node->neighbor_count; e++) node->neighbors[e].weight = 1.0 + (double)((node->id + e) % 4);
+    }
+
+    WalkMode modes[] = {WALK_UNIFORM, WALK_WEIGHTED, WALK_NODE2VEC};
+    for (int m = 0; m < 3; m++) {
+        WalkConfig config = walk_config_default();
+        config.mode = modes[m];
+        config.walk_length = 12;
+        config.walks_per_node = 3;
+        config.p = 0.5;
+        config.q = 2.0;
+        config.seed = 11;
+        config.num_threads = 1;
+
+        Status status;
+        WalkCorpus serial = walk_corpus(graph, &config, &status);
+        EXPECT(status == STATUS_SUCCESS);
+        config.num_threads = 4;
+        WalkCorpus parallel = walk_corpus(graph, &config, &status);
+        EXPECT(status == STATUS_SUCCESS);
+        config.seed = 12;
+        WalkCorpus reseeded = walk_corpus(graph, &config, &status);
+
+        EXPECT(serial.walk_count == 3 * graph->node_count);
+        EXPECT(serial.in_order && parallel.in_order);
+        EXPECT(corpus_valid(graph, &serial));
+        EXPECT(corpus_equal(&serial, &parallel));
+        EXPECT(!corpus_equal(&serial, &reseeded));
+
+        // Walk w starts at node w % starts, in insertion order
+        bool starts_ok = true;
+        for (size_t w = 0; w < serial.walk_count; w++) {
+            starts_ok = starts_ok && serial.nodes[w * serial.stride] == graph->node_ids[w % graph->node_count];
+        }
+        EXPECT(starts_ok);
+
+        corpus_free(&serial);
+        corpus_free(&parallel);
+        corpus_free(&reseeded);
+    }
+    graph_destroy(graph);
+}
+
+// Helper: share of walks whose step-th node is target
+static double step_share(const WalkCorpus* corpus, size_t step, int target) {
+    size_t hits = 0;
+    for (size_t w = 0; w < corpus->walk_count; w++) {
+        if (corpus->lengths[w] > step && corpus->nodes[w * corpus->stride + step] == target) hits++;
+    }
+    return (double)hits / (double)corpus->walk_count;
+}
+
+static void test_walks_bias(void) {
+    // Star 0 -> {1, 2} with weights 1 and 3, and an undirected path 10 - 11 - 12
+    Graph* star = graph_create(GRAPH_DIRECTED, 0);
+    for (int id = 0; id < 3; id++) graph_insert_node(star, id, 0);
+    graph_insert_edge(star, 0, 1, 1.0);
+    graph_insert_edge(star, 0, 2, 3.0);
+    Graph* path = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 10; id < 13; id++) graph_insert_node(path, id, 0);
+    graph_insert_edge(path, 10, 11, 1.0);
+    graph_insert_edge(path, 11, 12, 1.0);
+
+    int star_start = 0, path_start = 10;
+    WalkConfig config = walk_config_default();
+    config.walk_length = 3;
+    config.walks_per_node = 20000;
+    config.start_nodes = &star_start;
+    config.start_count = 1;
+
+    Status status;
+    WalkCorpus uniform = walk_corpus(star, &config, &status);
+    EXPECT(status == STATUS_SUCCESS);
+    EXPECT_NEAR(step_share(&uniform, 1, 2), 0.5, 0.02);
+    config.mode = WALK_WEIGHTED;
+    WalkCorpus weighted = walk_corpus(star, &config, &status);
+    EXPECT(status == STATUS_SUCCESS);
+    EXPECT_NEAR(step_share(&weighted, 1, 2), 0.75, 0.02);
+
+    // Leaves have no out-edges, so every walk stops after one step
+    bool stopped = true;
+    for (size_t w = 0; w < weighted.walk_count; w++) stopped = stopped && weighted.lengths[w] == 2;
+    EXPECT(stopped);
+
+    // From 11 after 10: return weight 1/p against 1/q for moving on
+    config.mode = WALK_NODE2VEC;
+    config.start_nodes = &path_start;
+    config.p = 0.25;
+    config.q = 1.0;
+    WalkCorpus returning = walk_corpus(path, &config, &status);
+    EXPECT(status == STATUS_SUCCESS);
+    EXPECT_NEAR(step_share(&returning, 2, 10), 0.8, 0.02);
+    config.p = 4.0;
+    WalkCorpus outward = walk_corpus(path, &config, &status);
+    EXPECT(status == STATUS_SUCCESS);
+    EXPECT_NEAR(step_share(&outward, 2, 10), 0.2, 0.02);
+
+    corpus_free(&uniform);
+    corpus_free(&weighted);
+    corpus_free(&returning);
+    corpus_free(&outward);
+    graph_destroy(star);
+    graph_destroy(path);
+}
+
+static void test_walks_errors_and_file(void) {
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 0; id < 4; id++) graph_insert_node(graph, id, 0);
+    graph_insert_edge(graph, 0, 1, 1.0);
+    graph_insert_edge(graph, 1, 2, -1.0);
+    graph_insert_edge(graph, 2, 3, 1.0);
+
+    WalkConfig config = walk_config_default();
+    config.walk_length = 5;
+    config.walks_per_node = 2;
+    Status status;
+
+    // Negative weights only matter to weighted walks
+    WalkCorpus corpus = walk_corpus(graph, &config, &status);
+    EXPECT(status == STATUS_SUCCESS);
+    EXPECT(corpus_valid(graph, &corpus));
+    corpus_free(&corpus);
+    config.mode = WALK_WEIGHTED;
+    corpus = walk_corpus(graph, &config, &status);
+    EXPECT(status != STATUS_SUCCESS);
+    corpus_free(&corpus);
+    config.mode = WALK_UNIFORM;
+
+    int missing = 42;
+    config.start_nodes = &missing;
+    config.start_count = 1;
+    corpus = walk_corpus(graph, &config, &status);
+    EXPECT(status == STATUS_WARNING);
+    corpus_free(&corpus);
+    config.start_nodes = NULL;
+    config.start_count = 0;
+
+    config.walk_length = 0;
+    corpus = walk_corpus(graph, &config, &status);
+    EXPECT(status == STATUS_INVALID);
+    corpus_free(&corpus);
+    config.walk_length = 5;
+    config.mode = WALK_NODE2VEC;
+    config.q = 0.0;
+    corpus = walk_corpus(graph, &config, &status);
+    EXPECT(status == STATUS_INVALID);
+    corpus_free(&corpus);
+    config.mode = WALK_UNIFORM;
+    config.q = 1.0;
+
+    // A failing sink stops the run with its status
+    config.walks_per_node = 5000;
+    WalkCorpus stopped = {NULL, NULL, 0, 0, 0, 0, true, 1};
+    size_t count = 0;
+    EXPECT(graph_random_walks(graph, &config, collect_walks, &stopped, &count) == STATUS_ERROR);
+    EXPECT(count == stopped.walk_count && count < 20000);
+    corpus_free(&stopped);
+    config.walks_per_node = 2;
+
+    // The file holds the same walks, one per line
+    char path[64];
+    test_temp_path(path, sizeof(path), "walks");
+    corpus = walk_corpus(graph, &config, &status);
+    EXPECT(graph_random_walks_to_file(graph, &config, path, &count) == STATUS_SUCCESS);
+    EXPECT(count == corpus.walk_count);
+    char* text = read_text(path);
+    EXPECT(text != NULL);
+    if (text) {
+        char* cursor = text;
+        bool same = true;
+        for (size_t w = 0; w < corpus.walk_count && same; w++) {
+            for (uint32_t i = 0; i < corpus.lengths[w]; i++) {
+                char* end;
+                long id = strtol(cursor, &end, 10);
+                same = same && end != cursor && id == corpus.nodes[w * corpus.stride + i];
+                cursor = end;
+            }
+            same = same && *cursor == '\n';
+            cursor++;
+        }
+        EXPECT(same && *cursor == '\0');
+        free(text);
+    }
+    corpus_free(&corpus);
+    unlink(path);
+    graph_destroy(graph);
+}
+
+int main(void) {
+    printf("test_generators\n");
+    RUN_TEST(test_rmat_thread_independent);
+    RUN_TEST(test_erdos_renyi_extremes);
+    RUN_TEST(test_erdos_renyi_density);
+    RUN_TEST(test_sbm_blocks);
+    RUN_TEST(test_barabasi_albert);
+    RUN_TEST(test_edge_list_file);
+    RUN_TEST(test_walks_valid_and_thread_independent);
+    RUN_TEST(test_walks_bias);
+    RUN_TEST(test_walks_errors_and_file);
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,131 @@
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <math.h>
+#include <time.h>
+#include "core/graph_build.h"
+#include "utils/graph_build_utils.h"
+
+// * Minimal test harness shared by the tests/test_*.c programs.
+// * EXPECT records a failure and keeps going, so one run reports every broken
+// * check; the program exits non-zero when any check failed.
+
+static int test_checks = 0;
+static int test_failures = 0;
+
+#define EXPECT(cond)\
+    do {\
+        test_checks++;\
+        if (!(cond)) {\
+            test_failures++;\
+            fprintf(stderr, "%s:%d: %s: expected %s\n", __FILE__, __LINE__, __func__, #cond);\
+        }\
+    } while (0)
+
+#define EXPECT_NEAR(value, expected, tolerance) EXPECT(fabs((double)(value) - (double)(expected)) <= (tolerance))
+
+#define RUN_TEST(test)\
+    do {\
+        int failures_before = test_failures;\
+        test();\
+        printf("  %-48s %s\n", #test, test_failures == failures_before ? "ok" : "FAILED");\
+    } while (0)
+
+#define TEST_SUMMARY()\
+    (printf("%d checks, %d failed\n", test_checks, test_failures), test_failures ? 1 : 0)
+
+// Helper: fresh temporary file path (file created empty), removed by the caller
+static inline void test_temp_path(char* path, size_t size, const char* name) {
+    snprintf(path, size, "/tmp/%s_XXXXXX", name);
+    int fd = mkstemp(path);
+    if (fd >= 0) close(fd);
+}
+
+// Helper: usleep is not in POSIX.1-2008
+static inline void test_sleep_ms(long ms) {
+    struct timespec delay = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&delay, NULL);
+}
+
+// Helper: fresh empty temporary directory
+static inline bool test_temp_dir(char* path, size_t size, const char* name) {
+    snprintf(path, size, "/tmp/%s_XXXXXX", name);
+    return mkdtemp(path) != NULL;
+}
+
+// Helper: remove a flat directory and the files in it
+static inline void test_remove_dir(const char* path) {
+    DIR* dir = opendir(path);
+    if (!dir) return;
+    char file[512];
+    for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+        snprintf(file, sizeof(file), "%s/%s", path, entry->d_name);
+        unlink(file);
+    }
+    closedir(dir);
+    rmdir(path);
+}
+
+// Helper: write text into a fresh temporary file
+static inline void test_write_file(char* path, size_t size, const char* name, const char* text) {
+    test_temp_path(path, size, name);
+    FILE* file = fopen(path, "w");
+    if (!file) return;
+    fputs(text, file);
+    fclose(file);
+}
+
+// Helper: weight of from -> to, NAN when the edge is missing
+static inline double test_edge_weight(const Graph* graph, int from, int to) {
+    const Node* node = find_node(graph, from);
+    size_t position;
+    if (!node || !node_find_edge(node, to, &position)) return NAN;
+    return node->neighbors[position].weight;
+}
+
+static inline size_t test_degree(const Graph* graph, int id) {
+    const Node* node = find_node(graph, id);
+    return node ? node->neighbor_count : (size_t)-1;
+}
+
+// Helper: same type, node set and weighted edge set, neighbor order ignored
+static inline bool test_graphs_equal(const Graph* a, const Graph* b) {
+    if (a->type != b->type || a->node_count != b->node_count) return false;
+    for (size_t i = 0; i < a->node_count; i++) {
+        const Node* node = find_node(a, a->node_ids[i]);
+        const Node* other = find_node(b, a->node_ids[i]);
+        if (!node || !other || node->neighbor_count != other->neighbor_count) return false;
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            if (test_edge_weight(b, node->id, node->neighbors[e].node_id) != node->neighbors[e].weight) return false;
+        }
+    }
+    return true;
+}
+
+// Helper: node order, neighbor order and weights as text, for exact comparisons
+static inline char* test_describe(const Graph* graph) {
+    size_t size = 64, length = 0;
+    for (size_t i = 0; i < graph->node_count; i++) size += 32 + 48 * test_degree(graph, graph->node_ids[i]);
+    char* text = malloc(size);
+    if (!text) return NULL;
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        const Node* node = find_node(graph, graph->node_ids[i]);
+        length += (size_t)snprintf(text + length, size - length, "%d:", node->id);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            length += (size_t)snprintf(text + length, size - length, " %d/%.17g",
+                node->neighbors[e].node_id, node->neighbors[e].weight);
+        }
+        length += (size_t)snprintf(text + length, size - length, "\n");
+    }
+    text[length] = '\0';
+    return text;
+}
+
+#endif
@@ -0,0 +1,573 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "core/graph_build.h"
+#include "io/edge_list.h"
+#include "io/graph_export.h"
+#include "io/graph_external.h"
+#include "io/graph_persist.h"
+#include "generators/graph_generators.h"
+#include "test_helpers.h"
+
+// ---------------------------------------------------------------------------
+// edge_list
+// ---------------------------------------------------------------------------
+
+static void test_load_graph(void) {
+    char path[64];
+    test_write_file(path, sizeof(path), "test_edges",
+        "# comment\n"
+        "1 2 0.5\n"
+        "\n"
+        "  2   3\n"
+        "3 1 2.0\n"
+        "not an edge\n"
+        "1 2 9.0\n");
+
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    // The malformed line and the duplicate edge are counted as warnings
+    EXPECT(load_graph(path, graph) == 2);
+    EXPECT(graph_node_count(graph) == 3);
+    EXPECT(graph_edge_count(graph) == 3);
+    EXPECT(test_edge_weight(graph, 2, 1) == 0.5);
+    EXPECT(test_edge_weight(graph, 3, 2) == 1.0);
+    EXPECT(test_edge_weight(graph, 1, 3) == 2.0);
+    graph_destroy(graph);
+    unlink(path);
+}
+
+static void test_load_graph_missing_file(void) {
+    Graph* graph = graph_create(GRAPH_DIRECTED, 0);
+    EXPECT(load_graph("/nonexistent/edges.txt", graph) == -1);
+    EXPECT(graph_node_count(graph) == 0);
+    graph_destroy(graph);
+}
+
+// Helper: whole file into a malloc'd string
+static char* read_text(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = malloc((size_t)size + 1);
+    if (text) text[fread(text, 1, (size_t)size, file)] = '\0';
+    fclose(file);
+    return text;
+}
+
+// Helper: R-MAT graph with varied weights
+static Graph* weighted_graph(GraphType type, int scale) {
+    GeneratorConfig config = generator_config_default(GEN_RMAT);
+    config.params.rmat.scale = scale;
+    config.params.rmat.edge_factor = 4;
+    Graph* graph = graph_create(type, 0);
+    generate_graph(graph, &config, NULL);
+
+    for (size_t i = 0; i < graph->node_count; i++) {
+        Node* node = find_node(graph, graph->node_ids[i]);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            int a = node->id < node->neighbors[e].node_id ? node->id : node->neighbors[e].node_id;
+            int b = node->id ^ node->neighbors[e].node_id ^ a;
+            // Same weight at both ends of an undirected edge
+            node->neighbors[e].weight = type == GRAPH_UNDIRECTED ? (a * 31 + b) / 7.0 : node->id / 3.0 + e;
+        }
+    }
+    return graph;
+}
+
+// ---------------------------------------------------------------------------
+// graph_export
+// ---------------------------------------------------------------------------
+
+static void test_edge_list_round_trip(void) {
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    for (size_t t = 0; t < 2; t++) {
+        Graph* graph = weighted_graph(types[t], 10);
+        char sequential[64], parallel[64];
+        test_temp_path(sequential, sizeof(sequential), "test_export");
+        test_temp_path(parallel, sizeof(parallel), "test_export");
+
+        ExportOptions options = export_options_default();
+        size_t edges_1, edges_4;
+        EXPECT(graph_save_edge_list(graph, sequential, &options, &edges_1) == STATUS_SUCCESS);
+        options.num_threads = 4;
+        EXPECT(graph_save_edge_list(graph, parallel, &options, &edges_4) == STATUS_SUCCESS);
+        EXPECT(edges_1 == graph_edge_count(graph) && edges_4 == edges_1);
+
+        char* text_1 = read_text(sequential);
+        char* text_4 = read_text(parallel);
+        EXPECT(text_1 && text_4 && strcmp(text_1, text_4) == 0);
+        EXPECT(text_1 && strncmp(text_1, "# format=", 9) == 0);
+
+        // Weights survive exactly; isolated nodes are not written
+        Graph* loaded = graph_create(types[t], 0);
+        EXPECT(load_graph(sequential, loaded) == 0);
+        EXPECT(graph_edge_count(loaded) == graph_edge_count(graph));
+        size_t mismatches = 0;
+        for (size_t i = 0; i < graph->node_count; i++) {
+            const Node* node = find_node(graph, graph->node_ids[i]);
+            for (size_t e = 0; e < node->neighbor_count; e++) {
+                mismatches += test_edge_weight(loaded, node->id, node->neighbors[e].node_id) != node->neighbors[e].weight;
+            }
+        }
+        EXPECT(mismatches == 0);
+
+        free(text_1);
+        free(text_4);
+        graph_destroy(loaded);
+        graph_destroy(graph);
+        unlink(sequential);
+        unlink(parallel);
+    }
+}
+
+static void test_adjacency_list_format(void) {
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 1; id <= 4; id++) graph_insert_node(graph, id, 0);
+    graph_insert_edge(graph, 1, 2, 0.5);
+    graph_insert_edge(graph, 1, 3, 2.0);
+
+    char path[64];
+    test_temp_path(path, sizeof(path), "test_export");
+    ExportOptions options = export_options_default();
+    options.write_header = false;
+    size_t edges;
+    EXPECT(graph_save_adjacency_list(graph, path, &options, &edges) == STATUS_SUCCESS);
+    EXPECT(edges == 4);     // undirected edges are listed at both ends
+
+    char* text = read_text(path);
+    EXPECT(text && strcmp(text, "1 2:0.5 3:2\n2 1:0.5\n3 1:2\n4\n") == 0);
+    free(text);
+
+    options.write_weights = false;
+    EXPECT(graph_save_edge_list(graph, path, &options, NULL) == STATUS_SUCCESS);
+    text = read_text(path);
+    EXPECT(text && strcmp(text, "1 2\n1 3\n") == 0);
+    free(text);
+
+    EXPECT(graph_save_edge_list(graph, "/nonexistent/dir/edges.txt", &options, NULL) != STATUS_SUCCESS);
+    graph_destroy(graph);
+    unlink(path);
+}
+
+// ---------------------------------------------------------------------------
+// graph_external
+// ---------------------------------------------------------------------------
+
+// Helper: every node of the adjacency file matches graph, in ID order with sorted targets
+static bool disk_matches_graph(const char* path, const Graph* graph) {
+    DiskAdjacency* adjacency = disk_adjacency_open(path, 1 << 16);
+    if (!adjacency) return false;
+
+    bool ok = disk_adjacency_node_count(adjacency) == graph->node_count;
+    int targets[256];
+    double weights[256];
+    int id, previous = 0;
+    size_t degree, nodes = 0;
+    while (ok && disk_adjacency_next_node(adjacency, &id, &degree)) {
+        const Node* node = find_node(graph, id);
+        ok = node && node->neighbor_count == degree && (nodes == 0 || id > previous);
+        previous = id;
+        nodes++;
+
+        int last = 0;
+        for (size_t read = 0; ok && read < degree;) {
+            size_t count = disk_adjacency_read_arcs(adjacency, targets, weights, 256);
+            ok = count > 0;
+            for (size_t i = 0; ok && i < count; i++, read++) {
+                ok = test_edge_weight(graph, id, targets[i]) == weights[i] && (read == 0 || targets[i] > last);
+                last = targets[i];
+            }
+        }
+    }
+    ok = ok && nodes == graph->node_count && disk_adjacency_status(adjacency) == STATUS_SUCCESS;
+    disk_adjacency_close(adjacency);
+    return ok;
+}
+
+static void test_external_build_matches_load_graph(void) {
+    GeneratorConfig generator = generator_config_default(GEN_RMAT);
+    generator.params.rmat.scale = 14;
+    generator.params.rmat.edge_factor = 8;
+    generator.type = GRAPH_UNDIRECTED;
+
+    char edges[64], adjacency[64];
+    test_temp_path(edges, sizeof(edges), "test_external");
+    test_temp_path(adjacency, sizeof(adjacency), "test_external");
+    size_t lines;
+    EXPECT(generate_edge_list(edges, &generator, &lines) == STATUS_SUCCESS);
+
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    for (size_t t = 0; t < 2; t++) {
+        Graph* graph = graph_create(types[t], 0);
+        load_graph(edges, graph);
+
+        // The smallest budget forces several spilled runs
+        ExternalBuildConfig config = external_build_config_default();
+        config.memory_budget = 1 << 20;
+        config.scratch_dir = "/tmp";
+        config.type = types[t];
+        ExternalBuildStats stats;
+        EXPECT(graph_external_build(edges, adjacency, &config, &stats) == STATUS_SUCCESS);
+        EXPECT(stats.edges == lines && stats.runs > 1);
+        EXPECT(stats.node_count == graph->node_count);
+        EXPECT(stats.arc_count == (types[t] == GRAPH_UNDIRECTED ? 2 : 1) * graph_edge_count(graph));
+        EXPECT(stats.peak_bytes <= config.memory_budget);
+        EXPECT(disk_matches_graph(adjacency, graph));
+
+        DiskGraphSummary summary;
+        EXPECT(disk_adjacency_summarize(adjacency, 1 << 20, &summary) == STATUS_SUCCESS);
+        EXPECT(summary.arc_count == stats.arc_count && summary.node_count == stats.node_count);
+        EXPECT_NEAR(summary.total_weight, (double)summary.arc_count, 1e-9);
+        const Node* hub = find_node(graph, summary.max_degree_id);
+        EXPECT(hub && hub->neighbor_count == summary.max_degree);
+        graph_destroy(graph);
+    }
+
+    unlink(edges);
+    unlink(adjacency);
+}
+
+static void test_external_build_edge_cases(void) {
+    char edges[64], adjacency[64];
+    test_write_file(edges, sizeof(edges), "test_external",
+        "# header\n"
+        "5 1 0.25\n"
+        "1 5 9.0\n"
+        "3 3 1.0\n"
+        "garbage\n"
+        "1 2\n"
+        "5 1 4.0\n");
+    test_temp_path(adjacency, sizeof(adjacency), "test_external");
+
+    ExternalBuildConfig config = external_build_config_default();
+    config.scratch_dir = "/tmp";
+    config.type = GRAPH_UNDIRECTED;
+    ExternalBuildStats stats;
+    EXPECT(graph_external_build(edges, adjacency, &config, &stats) == STATUS_SUCCESS);
+    // The undirected self loop is skipped as an invalid line, duplicates keep the first weight
+    EXPECT(stats.invalid_lines == 2 && stats.edges == 4 && stats.duplicates == 4);
+
+    // load_graph keeps the endpoint of the rejected self loop as an isolated node
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    load_graph(edges, graph);
+    graph_remove_node(graph, 3);
+    EXPECT(test_edge_weight(graph, 1, 5) == 0.25);
+    EXPECT(disk_matches_graph(adjacency, graph));
+    graph_destroy(graph);
+
+    EXPECT(graph_external_build("/nonexistent/edges.txt", adjacency, &config, NULL) != STATUS_SUCCESS);
+    EXPECT(disk_adjacency_open("/nonexistent/graph.adj", 1 << 16) == NULL);
+    unlink(edges);
+    unlink(adjacency);
+}
+
+// ---------------------------------------------------------------------------
+// labeled graphs
+// ---------------------------------------------------------------------------
+
+static void test_load_labeled_graph(void) {
+    char path[64], second[64];
+    test_write_file(path, sizeof(path), "test_labeled",
+        "# comment\n"
+        "TP53 MDM2 0.9\n"
+        "   \n"
+        "\r\n"
+        "MDM2\tCDKN1A\n"
+        "lonely\n"
+        "TP53 MDM2 2.0\n"
+        "EGFR ERBB2 heavy\n");
+    test_write_file(second, sizeof(second), "test_labeled", "CDKN1A EGFR 3.5\n");
+
+    LabelTable* labels = label_table_create(0);
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    // Blank lines are skipped; the short line, the duplicate and the malformed weight are warnings
+    EXPECT(load_labeled_graph(path, graph, labels) == 3);
+    EXPECT(label_table_count(labels) == 3);
+    EXPECT(graph_node_count(graph) == 3 && graph_edge_count(graph) == 2);
+    int tp53 = label_table_find(labels, "TP53", 4), mdm2 = label_table_find(labels, "MDM2", 4);
+    int cdkn1a = label_table_find(labels, "CDKN1A", 6);
+    EXPECT(tp53 == 0 && mdm2 == 1 && cdkn1a == 2);
+    EXPECT(test_edge_weight(graph, mdm2, tp53) == 0.9);
+    EXPECT(test_edge_weight(graph, cdkn1a, mdm2) == 1.0);
+
+    // A second graph shares the table and its IDs
+    Graph* other = graph_create(GRAPH_DIRECTED, 0);
+    EXPECT(load_labeled_graph(second, other, labels) == 0);
+    EXPECT(label_table_find(labels, "EGFR", 4) == 3);
+    EXPECT(test_edge_weight(other, cdkn1a, 3) == 3.5);
+
+    int source, target;
+    double weight;
+    EXPECT(parse_labeled_edge("A B 1e-3 trailing", labels, &source, &target, &weight) == STATUS_SUCCESS);
+    EXPECT(weight == 1e-3 && target == source + 1);
+    EXPECT(parse_labeled_edge("A", labels, &source, &target, &weight) == STATUS_INVALID);
+    EXPECT(load_labeled_graph("/nonexistent/edges.txt", graph, labels) == -1);
+
+    graph_destroy(other);
+    graph_destroy(graph);
+    label_table_destroy(labels);
+    unlink(path);
+    unlink(second);
+}
+
+static void test_labeled_export_round_trip(void) {
+    LabelTable* labels = label_table_create(0);
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    const char* names[] = {"BRCA1", "BARD1", "RAD51"};
+    int ids[3];
+    for (int i = 0; i < 3; i++) {
+        label_table_intern(labels, names[i], strlen(names[i]), &ids[i]);
+        graph_insert_node(graph, ids[i], 0);
+    }
+    graph_insert_node(graph, 99, 0);        // no label, written by ID
+    graph_insert_edge(graph, ids[0], ids[1], 0.5);
+    graph_insert_edge(graph, ids[0], ids[2], 2.0);
+    graph_insert_edge(graph, ids[2], 99, 1.0);
+
+    char path[64];
+    test_temp_path(path, sizeof(path), "test_export");
+    ExportOptions options = export_options_default();
+    options.write_header = false;
+    options.labels = labels;
+    EXPECT(graph_save_edge_list(graph, path, &options, NULL) == STATUS_SUCCESS);
+    char* text = read_text(path);
+    EXPECT(text && strcmp(text, "BRCA1 BARD1 0.5\nBRCA1 RAD51 2\nRAD51 99 1\n") == 0);
+    free(text);
+
+    EXPECT(graph_save_adjacency_list(graph, path, &options, NULL) == STATUS_SUCCESS);
+    text = read_text(path);
+    EXPECT(text && strncmp(text, "BRCA1 BARD1:0.5 RAD51:2\n", 24) == 0);
+    free(text);
+
+    // Reading the edge list back into a fresh table gives the same graph by name
+    EXPECT(graph_save_edge_list(graph, path, &options, NULL) == STATUS_SUCCESS);
+    LabelTable* reread = label_table_create(0);
+    Graph* loaded = graph_create(GRAPH_UNDIRECTED, 0);
+    EXPECT(load_labeled_graph(path, loaded, reread) == 0);
+    EXPECT(graph_edge_count(loaded) == 3);
+    int brca1 = label_table_find(reread, "BRCA1", 5), rad51 = label_table_find(reread, "RAD51", 5);
+    EXPECT(test_edge_weight(loaded, brca1, rad51) == 2.0);
+    EXPECT(test_edge_weight(loaded, label_table_find(reread, "99", 2), rad51) == 1.0);
+
+    graph_destroy(loaded);
+    label_table_destroy(reread);
+    graph_destroy(graph);
+    label_table_destroy(labels);
+    unlink(path);
+}
+
+static void test_labeled_external_build(void) {
+    // Labeled copy of an R-MAT edge list
+    GeneratorConfig generator = generator_config_default(GEN_RMAT);
+    generator.params.rmat.scale = 12;
+    generator.params.rmat.edge_factor = 8;
+    char numeric[64], edges[64], adjacency[64];
+    test_temp_path(numeric, sizeof(numeric), "test_external");
+    test_temp_path(edges, sizeof(edges), "test_external");
+    test_temp_path(adjacency, sizeof(adjacency), "test_external");
+    EXPECT(generate_edge_list(numeric, &generator, NULL) == STATUS_SUCCESS);
+
+    FILE* input = fopen(numeric, "r");
+    FILE* output = fopen(edges, "w");
+    EXPECT(input && output);
+    if (input && output) {
+        int from, to;
+        double weight;
+        char line[128];
+        while (fgets(line, sizeof(line), input)) {
+            if (sscanf(line, "%d %d %lf", &from, &to, &weight) < 2 || from == to) continue;
+            fprintf(output, "gene_%d protein-%d\n", from, to);
+        }
+    }
+    if (input) fclose(input);
+    if (output) fclose(output);
+
+    LabelTable* memory_labels = label_table_create(0);
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    EXPECT(load_labeled_graph(edges, graph, memory_labels) >= 0);
+
+    LabelTable* disk_labels = label_table_create(0);
+    ExternalBuildConfig config = external_build_config_default();
+    config.memory_budget = 1 << 20;
+    config.scratch_dir = "/tmp";
+    config.type = GRAPH_UNDIRECTED;
+    config.labels = disk_labels;
+    ExternalBuildStats stats;
+    EXPECT(graph_external_build(edges, adjacency, &config, &stats) == STATUS_SUCCESS);
+    EXPECT(stats.invalid_lines == 0 && stats.node_count == graph->node_count);
+
+    // Both tables intern in line order, so IDs agree
+    EXPECT(label_table_count(disk_labels) == label_table_count(memory_labels));
+    bool same = true;
+    for (size_t id = 0; id < label_table_count(memory_labels); id++) {
+        same = same && strcmp(label_table_name(memory_labels, (int)id, NULL), label_table_name(disk_labels, (int)id, NULL)) == 0;
+    }
+    EXPECT(same);
+    EXPECT(disk_matches_graph(adjacency, graph));
+
+    graph_destroy(graph);
+    label_table_destroy(memory_labels);
+    label_table_destroy(disk_labels);
+    unlink(numeric);
+    unlink(edges);
+    unlink(adjacency);
+}
+
+// ---------------------------------------------------------------------------
+// graph_persist
+// ---------------------------------------------------------------------------
+
+// Helper: the same mutations on a store and on a plain graph, returns how many were logged
+static uint64_t persist_mutations(GraphStore* store, Graph* expected, int first, int count) {
+    uint64_t logged = 0;
+    for (int i = first; i < first + count; i++) {
+        int from = i % 17, to = (i * 7 + 3) % 17;
+        double weight = 1.0 + i * 0.25;
+        Status status;
+        if (i < 17) {
+            status = graph_store_insert_node(store, i, 2);
+            EXPECT(status == graph_insert_node(expected, i, 2));
+        } else if (i % 5 == 4) {
+            status = graph_store_remove_edge(store, from, to);
+            EXPECT(status == graph_remove_edge(expected, from, to));
+        } else if ((status = graph_store_insert_edge(store, from, to, weight)) == STATUS_SUCCESS) {
+            EXPECT(graph_insert_edge(expected, from, to, weight) == STATUS_SUCCESS);
+        } else {
+            status = graph_store_update_edge(store, from, to, weight);
+            EXPECT(status == graph_update_edge(expected, from, to, weight));
+        }
+        if (status == STATUS_SUCCESS) logged++;
+    }
+    return logged;
+}
+
+// Helper: reopen the store and compare the recovered graph
+static bool persist_recovers(const char* directory, const Graph* expected) {
+    GraphStore* store = graph_store_open(directory, GRAPH_UNDIRECTED, NULL);
+    if (!store) return false;
+    char* recovered = test_describe(graph_store_graph(store));
+    char* wanted = test_describe(expected);
+    bool equal = recovered && wanted && strcmp(recovered, wanted) == 0;
+    free(recovered);
+    free(wanted);
+    return graph_store_close(store) == STATUS_SUCCESS && equal;
+}
+
+static void test_persist_recovery(void) {
+    char directory[64];
+    EXPECT(test_temp_dir(directory, sizeof(directory), "persist"));
+
+    GraphStore* store = graph_store_open(directory, GRAPH_DIRECTED, NULL);
+    EXPECT(store != NULL);
+    if (!store) return;
+    Graph* expected = graph_create(GRAPH_DIRECTED, 0);
+    EXPECT(persist_mutations(store, expected, 0, 200) > 100);
+    EXPECT(graph_store_insert_node(store, 100, 4) == STATUS_SUCCESS);
+    EXPECT(graph_insert_node(expected, 100, 4) == STATUS_SUCCESS);
+    EXPECT(graph_store_remove_node(store, 3) == graph_remove_node(expected, 3));
+    EXPECT(graph_store_insert_edge(store, 1, 1000, 1.0) != STATUS_SUCCESS);
+    EXPECT(graph_store_close(store) == STATUS_SUCCESS);
+
+    // The recorded type wins over the one passed on reopen
+    EXPECT(persist_recovers(directory, expected));
+
+    // Appended garbage is a torn group and is dropped
+    char log_path[128];
+    snprintf(log_path, sizeof(log_path), "%s/wal-0.log", directory);
+    FILE* log = fopen(log_path, "ab");
+    EXPECT(log != NULL);
+    if (log) {
+        fputs("torn group", log);
+        fclose(log);
+    }
+    EXPECT(persist_recovers(directory, expected));
+
+    graph_destroy(expected);
+    test_remove_dir(directory);
+}
+
+static void test_persist_snapshots(void) {
+    char directory[64];
+    EXPECT(test_temp_dir(directory, sizeof(directory), "persist"));
+
+    PersistConfig config = persist_config_default();
+    config.sync = false;
+    config.snapshot_records = 10;
+    GraphStore* store = graph_store_open(directory, GRAPH_UNDIRECTED, &config);
+    EXPECT(store != NULL);
+    if (!store) return;
+    Graph* expected = graph_create(GRAPH_UNDIRECTED, 0);
+
+    uint64_t logged = persist_mutations(store, expected, 0, 100);
+    EXPECT(graph_store_snapshot(store) != STATUS_ERROR);
+    logged += persist_mutations(store, expected, 100, 20);
+
+    // The flusher reaps finished children, at most one per 10 records was started
+    GraphStoreStats stats;
+    graph_store_stats(store, &stats);
+    for (int i = 0; i < 200 && stats.snapshots_written == 0; i++) {
+        test_sleep_ms(10);
+        graph_store_stats(store, &stats);
+    }
+    EXPECT(stats.snapshots_written >= 1 && stats.snapshots_written <= 13);
+    EXPECT(stats.records_logged == logged);
+    EXPECT(graph_store_close(store) == STATUS_SUCCESS);
+
+    EXPECT(persist_recovers(directory, expected));
+    graph_destroy(expected);
+    test_remove_dir(directory);
+}
+
+static void test_persist_group_commit(void) {
+    char directory[64];
+    EXPECT(test_temp_dir(directory, sizeof(directory), "persist"));
+
+    PersistConfig config = persist_config_default();
+    config.group_commit_ms = 0;
+    EXPECT(graph_store_open(directory, GRAPH_UNDIRECTED, &config) == NULL);
+    config.group_commit_ms = -1;
+    EXPECT(graph_store_open(directory, GRAPH_UNDIRECTED, &config) == NULL);
+
+    // The timer writes the group without an explicit flush
+    config.group_commit_ms = 1;
+    config.sync = false;
+    GraphStore* store = graph_store_open(directory, GRAPH_UNDIRECTED, &config);
+    EXPECT(store != NULL);
+    if (!store) return;
+    EXPECT(graph_store_insert_node(store, 1, 0) == STATUS_SUCCESS);
+
+    GraphStoreStats stats;
+    graph_store_stats(store, &stats);
+    for (int i = 0; i < 200 && stats.groups_written == 0; i++) {
+        test_sleep_ms(5);
+        graph_store_stats(store, &stats);
+    }
+    EXPECT(stats.groups_written == 1);
+    EXPECT(stats.records_logged == 1);
+
+    // An idle store writes nothing more
+    test_sleep_ms(20);
+    graph_store_stats(store, &stats);
+    EXPECT(stats.groups_written == 1);
+    EXPECT(graph_store_flush(store) == STATUS_SUCCESS);
+    EXPECT(graph_store_close(store) == STATUS_SUCCESS);
+    test_remove_dir(directory);
+}
+
+int main(void) {
+    printf("test_io\n");
+    RUN_TEST(test_load_graph);
+    RUN_TEST(test_load_graph_missing_file);
+    RUN_TEST(test_edge_list_round_trip);
+    RUN_TEST(test_adjacency_list_format);
+    RUN_TEST(test_external_build_matches_load_graph);
+    RUN_TEST(test_external_build_edge_cases);
+    RUN_TEST(test_load_labeled_graph);
+    RUN_TEST(test_labeled_export_round_trip);
+    RUN_TEST(test_labeled_external_build);
+    RUN_TEST(test_persist_recovery);
+    RUN_TEST(test_persist_snapshots);
+    RUN_TEST(test_persist_group_commit);
+    return TEST_SUMMARY();
+}
@@ -0,0 +1,852 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/graph_build.h"
+#include "metrics/hyperanf.h"
+#include "metrics/centrality.h"
+#include "metrics/motifs.h"
+#include "metrics/ppr.h"
+#include "metrics/link_prediction.h"
+#include "metrics/shortest_path.h"
+#include "generators/graph_generators.h"
+#include "test_helpers.h"
+
+// Helper: undirected path 0 - 1 - ... - (n - 1) with unit weights
+static Graph* path_graph(int n) {
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 0; id < n; id++) graph_insert_node(graph, id, 0);
+    for (int id = 0; id + 1 < n; id++) graph_insert_edge(graph, id, id + 1, 1.0);
+    return graph;
+}
+
+static Graph* complete_graph(int n, GraphType type) {
+    Graph* graph = graph_create(type, 0);
+    for (int id = 0; id < n; id++) graph_insert_node(graph, id, 0);
+    for (int a = 0; a < n; a++) {
+        for (int b = type == GRAPH_DIRECTED ? 0 : a + 1; b < n; b++) {
+            if (a != b) graph_insert_edge(graph, a, b, 1.0);
+        }
+    }
+    return graph;
+}
+
+// Helper: seeded G(n, p) graph
+static Graph* random_graph(size_t n, double p, GraphType type, uint64_t seed) {
+    GeneratorConfig config = generator_config_default(GEN_ERDOS_RENYI);
+    config.params.er.node_count = n;
+    config.params.er.p = p;
+    config.seed = seed;
+    Graph* graph = graph_create(type, 0);
+    generate_graph(graph, &config, NULL);
+    return graph;
+}
+
+// Helper: hop distances from source over out-edges, -1 when unreachable (IDs are 0 .. n - 1)
+static void bfs_distances(const Graph* graph, int source, int* dist) {
+    size_t n = graph->node_count;
+    int* queue = malloc(n * sizeof(int));
+    for (size_t v = 0; v < n; v++) dist[v] = -1;
+    size_t head = 0, tail = 0;
+    dist[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+        const Node* node = find_node(graph, queue[head++]);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            int w = node->neighbors[e].node_id;
+            if (dist[w] < 0) {
+                dist[w] = dist[node->id] + 1;
+                queue[tail++] = w;
+            }
+        }
+    }
+    free(queue);
+}
+
+// ---------------------------------------------------------------------------
+// hyperanf
+// ---------------------------------------------------------------------------
+
+static void test_hyperanf_path(void) {
+    Graph* graph = path_graph(40);
+    HyperAnfConfig config = hyperanf_config_default();
+    config.log2m = 12;
+
+    HyperAnfResult result;
+    EXPECT(graph_hyperanf(graph, &config, &result) == STATUS_SUCCESS);
+    EXPECT(result.iterations == 39);
+    EXPECT(result.log2m == 12);
+
+    // Exact N(t) = n + 2 * sum_{d=1..t} (n - d), small sets are counted almost exactly
+    double exact = 40.0;
+    size_t off = 0;
+    for (size_t t = 0; t <= result.iterations; t++) {
+        if (t > 0) exact += 2.0 * (40.0 - (double)t);
+        off += fabs(result.neighborhood[t] - exact) > 0.05 * exact;
+    }
+    EXPECT(off == 0);
+    EXPECT_NEAR(result.neighborhood[39], 1600.0, 80.0);
+    // Mean distance over ordered pairs of a path is (n + 1) / 3
+    EXPECT_NEAR(result.average_distance, 41.0 / 3.0, 1.0);
+    EXPECT(result.effective_diameter > 20.0 && result.effective_diameter <= 39.0);
+
+    hyperanf_result_free(&result);
+    graph_destroy(graph);
+}
+
+static void test_hyperanf_complete_graph(void) {
+    Graph* graph = complete_graph(30, GRAPH_DIRECTED);
+    HyperAnfConfig config = hyperanf_config_default();
+
+    HyperAnfResult one, four;
+    config.num_threads = 1;
+    EXPECT(graph_hyperanf(graph, &config, &one) == STATUS_SUCCESS);
+    config.num_threads = 4;
+    EXPECT(graph_hyperanf(graph, &config, &four) == STATUS_SUCCESS);
+
+    EXPECT(one.iterations == 1 && four.iterations == 1);
+    EXPECT_NEAR(one.neighborhood[1], 900.0, 45.0);
+    EXPECT(one.neighborhood[1] == four.neighborhood[1]);
+    EXPECT_NEAR(one.average_distance, 1.0, 1e-9);
+
+    hyperanf_result_free(&one);
+    hyperanf_result_free(&four);
+    graph_destroy(graph);
+}
+
+static void test_hyperanf_limits(void) {
+    Graph* graph = path_graph(100);
+    HyperAnfConfig config = hyperanf_config_default();
+    HyperAnfResult result;
+
+    config.max_iterations = 5;
+    EXPECT(graph_hyperanf(graph, &config, &result) == STATUS_SUCCESS);
+    EXPECT(result.iterations == 5);
+    hyperanf_result_free(&result);
+
+    // A tight memory limit lowers the precision instead of failing
+    config.max_iterations = 0;
+    config.log2m = 14;
+    config.memory_limit = 100 * 1024;
+    EXPECT(graph_hyperanf(graph, &config, &result) == STATUS_SUCCESS);
+    EXPECT(result.log2m < 14 && result.memory_bytes <= config.memory_limit);
+    hyperanf_result_free(&result);
+
+    config.memory_limit = 16;
+    EXPECT(graph_hyperanf(graph, &config, &result) != STATUS_SUCCESS);
+    config.memory_limit = 0;
+    config.log2m = 2;
+    EXPECT(graph_hyperanf(graph, &config, &result) == STATUS_INVALID);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// centrality
+// ---------------------------------------------------------------------------
+
+static void test_centrality_matches_bfs(void) {
+    // Sparse directed graph: unreachable pairs, several source batches
+    Graph* graph = random_graph(300, 0.008, GRAPH_DIRECTED, 3);
+    size_t n = graph->node_count;
+    int* dist = malloc(n * sizeof(int));
+
+    double* closeness = malloc(n * sizeof(double));
+    double* harmonic = malloc(n * sizeof(double));
+    uint64_t histogram[300] = {0};
+    for (size_t s = 0; s < n; s++) {
+        bfs_distances(graph, graph->node_ids[s], dist);
+        double reached = 0.0, total = 0.0, inverse = 0.0;
+        for (size_t v = 0; v < n; v++) {
+            if (dist[v] < 0) continue;
+            histogram[dist[v]]++;
+            if (dist[v] == 0) continue;
+            reached += 1.0;
+            total += dist[v];
+            inverse += 1.0 / dist[v];
+        }
+        closeness[s] = total ? (reached / (n - 1)) * (reached / total) : 0.0;
+        harmonic[s] = inverse / (n - 1);
+    }
+
+    int widths[] = {64, 512};
+    int threads[] = {1, 4};
+    for (size_t c = 0; c < 2; c++) {
+        CentralityConfig config = centrality_config_default();
+        config.batch_width = widths[c];
+        config.num_threads = threads[c];
+
+        CentralityResult result;
+        EXPECT(graph_centrality(graph, &config, &result) == STATUS_SUCCESS);
+        EXPECT(result.count == n);
+        size_t wrong = 0;
+        for (size_t s = 0; s < n; s++) {
+            wrong += result.ids[s] != graph->node_ids[s];
+            wrong += fabs(result.closeness[s] - closeness[s]) > 1e-12 || fabs(result.harmonic[s] - harmonic[s]) > 1e-12;
+        }
+        EXPECT(wrong == 0);
+        for (size_t d = 0; d <= result.max_distance; d++) wrong += result.hop_histogram[d] != histogram[d];
+        EXPECT(wrong == 0 && histogram[result.max_distance + 1] == 0);
+        centrality_result_free(&result);
+    }
+
+    free(dist);
+    free(closeness);
+    free(harmonic);
+    graph_destroy(graph);
+}
+
+static void test_centrality_sources(void) {
+    Graph* graph = path_graph(5);
+    int sources[] = {2, 0};
+    CentralityConfig config = centrality_config_default();
+    config.sources = sources;
+    config.source_count = 2;
+
+    CentralityResult result;
+    EXPECT(graph_centrality(graph, &config, &result) == STATUS_SUCCESS);
+    EXPECT(result.count == 2 && result.ids[0] == 2 && result.ids[1] == 0);
+    // Middle of the path: distances 1, 1, 2, 2
+    EXPECT_NEAR(result.closeness[0], 4.0 / 6.0, 1e-12);
+    EXPECT_NEAR(result.harmonic[0], 3.0 / 4.0, 1e-12);
+    EXPECT_NEAR(result.closeness[1], 4.0 / 10.0, 1e-12);
+    EXPECT(result.max_distance == 4);
+    centrality_result_free(&result);
+
+    int missing[] = {9};
+    config.sources = missing;
+    config.source_count = 1;
+    EXPECT(graph_centrality(graph, &config, &result) != STATUS_SUCCESS);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// motifs
+// ---------------------------------------------------------------------------
+
+// Triad type of each 6-bit arc code (v->u 1, u->v 2, v->w 4, w->v 8, u->w 16, w->u 32), 1-based
+static const int tricodes[64] = {
+    1, 2, 2, 3, 2, 4, 6, 8, 2, 6, 5, 7, 3, 8, 7, 11, 2, 6, 4, 8, 5, 9, 9, 13, 6, 10, 9, 14, 7, 14, 12, 15,
+    2, 5, 6, 7, 6, 9, 10, 14, 4, 9, 9, 12, 8, 13, 14, 15, 3, 7, 8, 11, 7, 12, 14, 15, 8, 14, 13, 15, 11, 15, 15, 16
+};
+
+static bool arc(const Graph* graph, int from, int to) {
+    return !isnan(test_edge_weight(graph, from, to));
+}
+
+// Helper: census by classifying every triple, IDs are 0 .. n - 1
+static void brute_census(const Graph* graph, MotifCounts* counts) {
+    int n = (int)graph->node_count;
+    memset(counts, 0, sizeof(*counts));
+    for (int v = 0; v < n; v++) {
+        for (int u = v + 1; u < n; u++) {
+            for (int w = u + 1; w < n; w++) {
+                int code = arc(graph, v, u) | arc(graph, u, v) << 1 | arc(graph, v, w) << 2
+                    | arc(graph, w, v) << 3 | arc(graph, u, w) << 4 | arc(graph, w, u) << 5;
+                counts->triads[tricodes[code] - 1]++;
+            }
+        }
+    }
+
+    // Bi-fans by common in-neighbors of {c, d}, bi-parallels by 2-paths a -> x -> d
+    for (int c = 0; c < n; c++) {
+        for (int d = 0; d < n; d++) {
+            if (c == d) continue;
+            uint64_t sources = 0, paths = 0;
+            for (int x = 0; x < n; x++) {
+                if (x == c || x == d) continue;
+                sources += c < d && arc(graph, x, c) && arc(graph, x, d);
+                paths += arc(graph, c, x) && arc(graph, x, d);
+            }
+            counts->bi_fans += sources * (sources - (sources > 0)) / 2;
+            counts->bi_parallels += paths * (paths - (paths > 0)) / 2;
+        }
+    }
+}
+
+static void test_motif_census_exact(void) {
+    Graph* graph = random_graph(40, 0.12, GRAPH_DIRECTED, 5);
+    MotifCounts expected;
+    brute_census(graph, &expected);
+
+    MotifConfig config = motif_config_default();
+    config.four_node = true;
+    int threads[] = {1, 4};
+    for (size_t t = 0; t < 2; t++) {
+        config.num_threads = threads[t];
+        MotifCounts counts;
+        EXPECT(graph_motif_census(graph, &config, &counts) == STATUS_SUCCESS);
+        EXPECT(!counts.estimated);
+        size_t wrong = 0;
+        for (int type = 0; type < TRIAD_COUNT; type++) {
+            if (counts.triads[type] != expected.triads[type]) {
+                wrong++;
+                fprintf(stderr, "  triad %s: %llu, expected %llu\n", triad_name((TriadType)type),
+                    (unsigned long long)counts.triads[type], (unsigned long long)expected.triads[type]);
+            }
+        }
+        EXPECT(wrong == 0);
+        EXPECT(counts.bi_fans == expected.bi_fans);
+        EXPECT(counts.bi_parallels == expected.bi_parallels);
+    }
+    graph_destroy(graph);
+}
+
+static void test_motif_census_undirected(void) {
+    // Triangle 0-1-2, pendant 3 on 2 and isolated 4: fully mutual triads
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 0; id < 5; id++) graph_insert_node(graph, id, 0);
+    graph_insert_edge(graph, 0, 1, 1.0);
+    graph_insert_edge(graph, 1, 2, 1.0);
+    graph_insert_edge(graph, 2, 0, 1.0);
+    graph_insert_edge(graph, 2, 3, 1.0);
+
+    MotifCounts counts;
+    EXPECT(graph_motif_census(graph, NULL, &counts) == STATUS_SUCCESS);
+    EXPECT(counts.triads[TRIAD_300] == 1);
+    EXPECT(counts.triads[TRIAD_201] == 2);
+    EXPECT(counts.triads[TRIAD_102] == 5);
+    EXPECT(counts.triads[TRIAD_003] == 2);
+    uint64_t total = 0;
+    for (int type = 0; type < TRIAD_COUNT; type++) total += counts.triads[type];
+    EXPECT(total == 10);
+    EXPECT(strcmp(triad_name(TRIAD_021C), "021C") == 0);
+    graph_destroy(graph);
+}
+
+static void test_motif_census_sampled(void) {
+    Graph* graph = random_graph(400, 0.03, GRAPH_DIRECTED, 9);
+    MotifConfig config = motif_config_default();
+    MotifCounts exact, sampled;
+    EXPECT(graph_motif_census(graph, &config, &exact) == STATUS_SUCCESS);
+
+    config.sample_rate = 0.5;
+    EXPECT(graph_motif_census(graph, &config, &sampled) == STATUS_SUCCESS);
+    EXPECT(sampled.estimated);
+    EXPECT_NEAR((double)sampled.triads[TRIAD_021C], (double)exact.triads[TRIAD_021C], 0.1 * exact.triads[TRIAD_021C]);
+
+    config.sample_rate = 0.0;
+    EXPECT(graph_motif_census(graph, &config, &sampled) == STATUS_INVALID);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// ppr
+// ---------------------------------------------------------------------------
+
+// Helper: symmetric pseudo-random weights in [1, 4] (IDs are 0 .. n - 1)
+static void scramble_weights(Graph* graph) {
+    for (size_t i = 0; i < graph->node_count; i++) {
+        Node* node = find_node(graph, graph->node_ids[i]);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            int low = node->id < node->neighbors[e].node_id ? node->id : node->neighbors[e].node_id;
+            int high = node->id ^ node->neighbors[e].node_id ^ low;
+            node->neighbors[e].weight = 1.0 + (double)((low * 31 + high * 17) % 7) * 0.5;
+        }
+    }
+}
+
+// Helper: PPR by power iteration, dangling mass restarts at the seeds (IDs are 0 .. n - 1)
+static void brute_ppr(const Graph* graph, const PprQuery* query, double alpha, bool weighted, double* scores) {
+    size_t n = graph->node_count;
+    double* restart = calloc(n, sizeof(double));
+    double* next = malloc(n * sizeof(double));
+    double total = 0.0;
+    for (size_t i = 0; i < query->seed_count; i++) total += query->seed_weights ? query->seed_weights[i] : 1.0;
+    for (size_t i = 0; i < query->seed_count; i++) {
+        restart[query->seeds[i]] += (query->seed_weights ? query->seed_weights[i] : 1.0) / total;
+    }
+    memcpy(scores, restart, n * sizeof(double));
+
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        double dangling = 0.0;
+        for (size_t v = 0; v < n; v++) next[v] = 0.0;
+        for (size_t v = 0; v < n; v++) {
+            const Node* node = find_node(graph, (int)v);
+            double out = 0.0;
+            for (size_t e = 0; e < node->neighbor_count; e++) out += weighted ? node->neighbors[e].weight : 1.0;
+            if (node->neighbor_count == 0) {
+                dangling += scores[v];
+                continue;
+            }
+            for (size_t e = 0; e < node->neighbor_count; e++) {
+                next[node->neighbors[e].node_id] += scores[v] * (weighted ? node->neighbors[e].weight : 1.0) / out;
+            }
+        }
+        for (size_t v = 0; v < n; v++) next[v] = alpha * restart[v] + (1.0 - alpha) * (next[v] + dangling * restart[v]);
+        memcpy(scores, next, n * sizeof(double));
+    }
+    free(restart);
+    free(next);
+}
+
+static double result_score(const PprResult* result, int id) {
+    for (size_t i = 0; i < result->count; i++) {
+        if (result->ids[i] == id) return result->scores[i];
+    }
+    return 0.0;
+}
+
+static bool result_sorted(const PprResult* result) {
+    for (size_t i = 1; i < result->count; i++) {
+        if (result->scores[i] > result->scores[i - 1]) return false;
+        if (result->scores[i] == result->scores[i - 1] && result->ids[i] < result->ids[i - 1]) return false;
+    }
+    return true;
+}
+
+static void test_ppr_matches_power_iteration(void) {
+    struct { GraphType type; bool weighted; } cases[] = {
+        {GRAPH_UNDIRECTED, false}, {GRAPH_UNDIRECTED, true}, {GRAPH_DIRECTED, false}, {GRAPH_DIRECTED, true}
+    };
+    int seeds[] = {3, 40};
+    double seed_weights[] = {3.0, 1.0};
+
+    for (int c = 0; c < 4; c++) {
+        Graph* graph = random_graph(150, 0.03, cases[c].type, 21 + (uint64_t)c);
+        if (cases[c].weighted) scramble_weights(graph);
+        PprQuery query = {seeds, c % 2 ? seed_weights : NULL, 2};
+        PprConfig config = ppr_config_default();
+        config.weighted = cases[c].weighted;
+        config.epsilon = 1e-7;
+
+        PprResult result;
+        EXPECT(graph_ppr(graph, &query, &config, &result) == STATUS_SUCCESS);
+        double* exact = malloc(graph->node_count * sizeof(double));
+        brute_ppr(graph, &query, config.alpha, cases[c].weighted, exact);
+
+        double mass = result.residual, l1 = 0.0;
+        bool within_degree = true;
+        for (size_t v = 0; v < graph->node_count; v++) {
+            double error = fabs(result_score(&result, (int)v) - exact[v]);
+            l1 += error;
+            double degree = (double)test_degree(graph, (int)v);
+            if (error > config.epsilon * (degree > 0 ? degree : 1.0) + 1e-12) within_degree = false;
+        }
+        for (size_t i = 0; i < result.count; i++) mass += result.scores[i];
+
+        EXPECT_NEAR(mass, 1.0, 1e-9);
+        EXPECT(l1 <= result.residual + 1e-9);
+        if (cases[c].type == GRAPH_UNDIRECTED && !cases[c].weighted) EXPECT(within_degree);
+        EXPECT(result_sorted(&result));
+        EXPECT(result.pushes > 0 && result.touched >= result.count);
+
+        free(exact);
+        ppr_result_free(&result);
+        graph_destroy(graph);
+    }
+}
+
+static void test_ppr_top_k_and_batch(void) {
+    Graph* graph = random_graph(200, 0.04, GRAPH_UNDIRECTED, 33);
+    PprConfig config = ppr_config_default();
+    config.num_threads = 3;
+
+    int seeds[6] = {0, 17, 42, 99, 150, 199};
+    int missing = 1000;
+    PprQuery queries[7];
+    for (int i = 0; i < 6; i++) queries[i] = (PprQuery){&seeds[i], NULL, 1};
+    queries[6] = queries[3];
+    queries[3] = (PprQuery){&missing, NULL, 1};
+
+    PprResult full[7], top[7];
+    EXPECT(graph_ppr_batch(graph, queries, 7, &config, full) == STATUS_WARNING);
+    config.top_k = 5;
+    EXPECT(graph_ppr_batch(graph, queries, 7, &config, top) == STATUS_WARNING);
+    EXPECT(full[3].count == 0 && top[3].count == 0);
+
+    for (int i = 0; i < 7; i++) {
+        if (i == 3) continue;
+        PprResult single;
+        config.top_k = 0;
+        EXPECT(graph_ppr(graph, &queries[i], &config, &single) == STATUS_SUCCESS);
+        EXPECT(single.count == full[i].count && single.pushes == full[i].pushes);
+        EXPECT(memcmp(single.ids, full[i].ids, single.count * sizeof(int)) == 0);
+        EXPECT(memcmp(single.scores, full[i].scores, single.count * sizeof(double)) == 0);
+        ppr_result_free(&single);
+
+        // top_k keeps the head of the full ranking
+        EXPECT(top[i].count == 5);
+        EXPECT(memcmp(top[i].ids, full[i].ids, 5 * sizeof(int)) == 0);
+        EXPECT(top[i].ids[0] == queries[i].seeds[0]);
+    }
+    for (int i = 0; i < 7; i++) {
+        ppr_result_free(&full[i]);
+        ppr_result_free(&top[i]);
+    }
+
+    // Invalid input
+    PprResult result;
+    PprQuery empty = {NULL, NULL, 0};
+    EXPECT(graph_ppr(graph, &empty, NULL, &result) == STATUS_INVALID);
+    double zero = 0.0;
+    PprQuery zero_weight = {seeds, &zero, 1};
+    EXPECT(graph_ppr(graph, &zero_weight, NULL, &result) == STATUS_INVALID);
+    config.alpha = 0.0;
+    EXPECT(graph_ppr(graph, &queries[0], &config, &result) == STATUS_INVALID);
+    config = ppr_config_default();
+    config.weighted = true;
+    find_node(graph, 0)->neighbors[0].weight = -1.0;
+    EXPECT(graph_ppr(graph, &queries[0], &config, &result) == STATUS_INVALID);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// link_prediction
+// ---------------------------------------------------------------------------
+
+// Helper: n x n undirected support of the graph, self loops dropped (IDs are 0 .. n - 1)
+static bool* support_matrix(const Graph* graph) {
+    size_t n = graph->node_count;
+    bool* linked = calloc(n * n, sizeof(bool));
+    for (size_t v = 0; v < n; v++) {
+        const Node* node = find_node(graph, (int)v);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            size_t w = (size_t)node->neighbors[e].node_id;
+            if (w == v) continue;
+            linked[v * n + w] = linked[w * n + v] = true;
+        }
+    }
+    return linked;
+}
+
+static LinkPair brute_link(const bool* linked, size_t n, LinkScore score, int u, int v) {
+    size_t common = 0, either = 0;
+    double sum = 0.0;
+    for (size_t w = 0; w < n; w++) {
+        bool in_u = linked[(size_t)u * n + w], in_v = linked[(size_t)v * n + w];
+        if (in_u || in_v) either++;
+        if (!in_u || !in_v) continue;
+        common++;
+        size_t degree = 0;
+        for (size_t x = 0; x < n; x++) degree += linked[w * n + x];
+        if (score == LINK_ADAMIC_ADAR && degree > 1) sum += 1.0 / log((double)degree);
+        if (score == LINK_RESOURCE_ALLOCATION) sum += 1.0 / (double)degree;
+    }
+
+    LinkPair pair = {u, v, 0.0, (uint32_t)common};
+    if (score == LINK_COMMON_NEIGHBORS) pair.score = (double)common;
+    else if (score == LINK_JACCARD) pair.score = either ? (double)common / (double)either : 0.0;
+    else pair.score = sum;
+    return pair;
+}
+
+static void test_link_scores_match_brute_force(void) {
+    LinkScore scores[] = {LINK_COMMON_NEIGHBORS, LINK_JACCARD, LINK_ADAMIC_ADAR, LINK_RESOURCE_ALLOCATION};
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+
+    for (int t = 0; t < 2; t++) {
+        Graph* graph = random_graph(80, 0.08, types[t], 51 + (uint64_t)t);
+        if (types[t] == GRAPH_DIRECTED) graph_insert_edge(graph, 5, 5, 1.0);
+        size_t n = graph->node_count;
+        bool* linked = support_matrix(graph);
+
+        size_t count = n * (n - 1) / 2;
+        LinkPair* pairs = malloc(count * sizeof(LinkPair));
+        for (int s = 0; s < 4; s++) {
+            size_t k = 0;
+            for (int u = 0; u < (int)n; u++) {
+                for (int v = u + 1; v < (int)n; v++) pairs[k++] = (LinkPair){v, u, -1.0, 0};
+            }
+            LinkConfig config = link_config_default();
+            config.score = scores[s];
+            config.num_threads = 3;
+            EXPECT(graph_link_scores(graph, pairs, count, &config) == STATUS_SUCCESS);
+
+            bool match = true;
+            for (size_t i = 0; i < count; i++) {
+                LinkPair expected = brute_link(linked, n, scores[s], pairs[i].u, pairs[i].v);
+                match = match && pairs[i].common == expected.common && fabs(pairs[i].score - expected.score) < 1e-12;
+            }
+            EXPECT(match);
+        }
+
+        LinkPair missing = {0, 500, 0.0, 0};
+        EXPECT(graph_link_scores(graph, &missing, 1, NULL) == STATUS_WARNING);
+        free(pairs);
+        free(linked);
+        graph_destroy(graph);
+    }
+}
+
+static void test_link_top_k(void) {
+    Graph* graph = random_graph(120, 0.05, GRAPH_UNDIRECTED, 77);
+    size_t n = graph->node_count;
+    bool* linked = support_matrix(graph);
+    LinkScore scores[] = {LINK_COMMON_NEIGHBORS, LINK_JACCARD, LINK_ADAMIC_ADAR, LINK_RESOURCE_ALLOCATION};
+
+    for (int s = 0; s < 4; s++) {
+        for (int adjacent = 0; adjacent < 2; adjacent++) {
+            LinkConfig config = link_config_default();
+            config.score = scores[s];
+            config.top_k = 40;
+            config.include_adjacent = adjacent;
+            config.num_threads = 4;
+
+            LinkPrediction result;
+            EXPECT(graph_link_top_k(graph, &config, &result) == STATUS_SUCCESS);
+            EXPECT(result.count == 40);
+
+            // Candidates by brute force, the k-th best score is the cut
+            double* candidates = malloc(n * n * sizeof(double));
+            size_t candidate_count = 0;
+            for (int u = 0; u < (int)n; u++) {
+                for (int v = u + 1; v < (int)n; v++) {
+                    LinkPair pair = brute_link(linked, n, scores[s], u, v);
+                    if (pair.common == 0 || (!adjacent && linked[(size_t)u * n + (size_t)v])) continue;
+                    candidates[candidate_count++] = pair.score;
+                }
+            }
+            size_t above = 0;
+            double cut = result.count ? result.pairs[result.count - 1].score : 0.0;
+            for (size_t i = 0; i < candidate_count; i++) above += candidates[i] > cut + 1e-12;
+
+            bool valid = true;
+            LinkPair* rescored = malloc(result.count * sizeof(LinkPair));
+            for (size_t i = 0; i < result.count; i++) {
+                const LinkPair* pair = &result.pairs[i];
+                valid = valid && pair->u < pair->v && pair->common > 0;
+                valid = valid && (adjacent || !linked[(size_t)pair->u * n + (size_t)pair->v]);
+                if (i > 0) {
+                    const LinkPair* prev = &result.pairs[i - 1];
+                    valid = valid && (prev->score > pair->score || (prev->score == pair->score
+                        && (prev->u < pair->u || (prev->u == pair->u && prev->v < pair->v))));
+                }
+                LinkPair expected = brute_link(linked, n, scores[s], pair->u, pair->v);
+                valid = valid && pair->common == expected.common && fabs(pair->score - expected.score) < 1e-12;
+                rescored[i] = (LinkPair){pair->u, pair->v, 0.0, 0};
+            }
+            EXPECT(valid);
+            EXPECT(above < result.count);
+
+            // Both modes agree exactly on the same pair
+            EXPECT(graph_link_scores(graph, rescored, result.count, &config) == STATUS_SUCCESS);
+            bool exact = true;
+            for (size_t i = 0; i < result.count; i++) exact = exact && rescored[i].score == result.pairs[i].score;
+            EXPECT(exact);
+
+            free(rescored);
+            free(candidates);
+            link_prediction_free(&result);
+        }
+    }
+
+    LinkConfig config = link_config_default();
+    config.top_k = 0;
+    LinkPrediction result;
+    EXPECT(graph_link_top_k(graph, &config, &result) == STATUS_SUCCESS && result.count == 0);
+    link_prediction_free(&result);
+
+    // Heap sizes that would wrap are refused before anything is allocated
+    config.top_k = SIZE_MAX / 2;
+    config.num_threads = 2;
+    EXPECT(graph_link_top_k(graph, &config, &result) == STATUS_INVALID && result.pairs == NULL);
+    free(linked);
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// shortest_path
+// ---------------------------------------------------------------------------
+
+// Helper: O(n^2) Dijkstra over out-edges, INFINITY when unreachable (IDs are 0 .. n - 1)
+static void brute_dijkstra(const Graph* graph, int source, double* dist) {
+    size_t n = graph->node_count;
+    bool* done = calloc(n, sizeof(bool));
+    for (size_t v = 0; v < n; v++) dist[v] = INFINITY;
+    dist[source] = 0.0;
+    for (;;) {
+        size_t best = n;
+        for (size_t v = 0; v < n; v++) {
+            if (!done[v] && dist[v] < INFINITY && (best == n || dist[v] < dist[best])) best = v;
+        }
+        if (best == n) break;
+        done[best] = true;
+        const Node* node = find_node(graph, (int)best);
+        for (size_t e = 0; e < node->neighbor_count; e++) {
+            double candidate = dist[best] + node->neighbors[e].weight;
+            if (candidate < dist[node->neighbors[e].node_id]) dist[node->neighbors[e].node_id] = candidate;
+        }
+    }
+    free(done);
+}
+
+// Helper: the path runs from -> to over existing edges and has the reported length
+static bool path_valid(const Graph* graph, const PathResult* result, int from, int to) {
+    if (result->distance == INFINITY) return result->length == 0;
+    if (result->length == 0 || result->nodes[0] != from || result->nodes[result->length - 1] != to) return false;
+    double total = 0.0;
+    for (size_t i = 1; i < result->length; i++) {
+        double weight = test_edge_weight(graph, result->nodes[i - 1], result->nodes[i]);
+        if (isnan(weight)) return false;
+        total += weight;
+    }
+    return fabs(total - result->distance) < 1e-9;
+}
+
+// Helper: every query method against Dijkstra for a spread of pairs, false on any mismatch
+static bool alt_matches_dijkstra(const Graph* graph, const AltIndex* index, size_t* alt_settled, size_t* plain_settled) {
+    size_t n = graph->node_count;
+    double* dist = malloc(n * sizeof(double));
+    AltSearch* search = alt_search_create(index);
+    bool ok = search != NULL;
+    PathMethod methods[] = {PATH_ALT, PATH_BIDIRECTIONAL, PATH_DIJKSTRA};
+
+    for (size_t q = 0; q < 40 && ok; q++) {
+        int from = (int)((q * 37) % n), to = (int)((q * 101 + 7) % n);
+        brute_dijkstra(graph, from, dist);
+        for (int m = 0; m < 3 && ok; m++) {
+            PathResult result;
+            ok = alt_shortest_path(search, from, to, methods[m], &result) == STATUS_SUCCESS;
+            ok = ok && (dist[to] == INFINITY ? result.distance == INFINITY : fabs(result.distance - dist[to]) < 1e-9);
+            ok = ok && path_valid(graph, &result, from, to);
+            if (methods[m] == PATH_ALT) *alt_settled += result.settled;
+            if (methods[m] == PATH_DIJKSTRA) *plain_settled += result.settled;
+            path_result_free(&result);
+        }
+    }
+    alt_search_free(search);
+    free(dist);
+    return ok;
+}
+
+static void test_alt_matches_dijkstra(void) {
+    GraphType types[] = {GRAPH_UNDIRECTED, GRAPH_DIRECTED};
+    LandmarkSelection selections[] = {LANDMARK_FARTHEST, LANDMARK_RANDOM};
+
+    for (int t = 0; t < 2; t++) {
+        Graph* graph = random_graph(300, types[t] == GRAPH_DIRECTED ? 0.012 : 0.008, types[t], 61 + (uint64_t)t);
+        scramble_weights(graph);
+        for (int s = 0; s < 2; s++) {
+            AltConfig config = alt_config_default();
+            config.landmark_count = 6;
+            config.selection = selections[s];
+            config.num_threads = 3;
+            AltIndex* index = NULL;
+            EXPECT(alt_index_build(graph, &config, &index) == STATUS_SUCCESS);
+            if (!index) continue;
+
+            int landmarks[6];
+            EXPECT(alt_index_landmarks(index, landmarks, 6) == 6);
+            bool distinct = true;
+            for (int a = 0; a < 6; a++) {
+                for (int b = a + 1; b < 6; b++) distinct = distinct && landmarks[a] != landmarks[b];
+            }
+            EXPECT(distinct);
+
+            size_t alt_settled = 0, plain_settled = 0;
+            EXPECT(alt_matches_dijkstra(graph, index, &alt_settled, &plain_settled));
+            EXPECT(alt_settled < plain_settled);
+            alt_index_free(index);
+        }
+        graph_destroy(graph);
+    }
+}
+
+static void test_alt_edge_cases(void) {
+    Graph* graph = path_graph(5);
+    graph_insert_node(graph, 9, 0);
+    AltIndex* index = NULL;
+    EXPECT(alt_index_build(graph, NULL, &index) == STATUS_SUCCESS);
+    AltSearch* search = index ? alt_search_create(index) : NULL;
+    EXPECT(search != NULL);
+    if (search) {
+        PathResult result;
+        EXPECT(alt_shortest_path(search, 2, 2, PATH_ALT, &result) == STATUS_SUCCESS);
+        EXPECT(result.distance == 0.0 && result.length == 1 && result.nodes[0] == 2);
+        path_result_free(&result);
+        EXPECT(alt_shortest_path(search, 0, 4, PATH_ALT, &result) == STATUS_SUCCESS);
+        EXPECT(result.distance == 4.0 && result.length == 5);
+        path_result_free(&result);
+        EXPECT(alt_shortest_path(search, 0, 9, PATH_ALT, &result) == STATUS_SUCCESS);
+        EXPECT(result.distance == INFINITY && result.length == 0);
+        path_result_free(&result);
+        EXPECT(alt_shortest_path(search, 0, 42, PATH_ALT, &result) == STATUS_WARNING);
+    }
+    alt_search_free(search);
+    alt_index_free(index);
+
+    // Lengths must not be negative
+    graph_update_edge(graph, 1, 2, -1.0);
+    index = NULL;
+    EXPECT(alt_index_build(graph, NULL, &index) == STATUS_INVALID && index == NULL);
+    graph_destroy(graph);
+}
+
+static void test_alt_save_load(void) {
+    Graph* graph = random_graph(200, 0.02, GRAPH_DIRECTED, 71);
+    scramble_weights(graph);
+    AltConfig config = alt_config_default();
+    config.landmark_count = 4;
+    AltIndex* index = NULL;
+    EXPECT(alt_index_build(graph, &config, &index) == STATUS_SUCCESS);
+    if (!index) {
+        graph_destroy(graph);
+        return;
+    }
+
+    char path[64];
+    test_temp_path(path, sizeof(path), "alt_index");
+    EXPECT(alt_index_save(index, path) == STATUS_SUCCESS);
+
+    AltIndex* loaded = NULL;
+    EXPECT(alt_index_load(graph, path, 2, &loaded) == STATUS_SUCCESS);
+    if (loaded) {
+        int built[4], restored[4];
+        EXPECT(alt_index_landmarks(loaded, restored, 4) == 4);
+        alt_index_landmarks(index, built, 4);
+        EXPECT(memcmp(built, restored, sizeof(built)) == 0);
+        size_t alt_settled = 0, plain_settled = 0;
+        EXPECT(alt_matches_dijkstra(graph, loaded, &alt_settled, &plain_settled));
+        alt_index_free(loaded);
+    }
+
+    // Another weight is another graph
+    Node* node = find_node(graph, 0);
+    double weight = node->neighbors[0].weight;
+    node->neighbors[0].weight = weight + 1.0;
+    EXPECT(alt_index_load(graph, path, 2, &loaded) == STATUS_INVALID && loaded == NULL);
+    node->neighbors[0].weight = weight;
+
+    // A flipped payload byte fails the checksum
+    FILE* file = fopen(path, "r+b");
+    EXPECT(file != NULL);
+    if (file) {
+        fseek(file, -1, SEEK_END);
+        int last = fgetc(file);
+        fseek(file, -1, SEEK_END);
+        fputc(last ^ 0x5a, file);
+        fclose(file);
+    }
+    EXPECT(alt_index_load(graph, path, 2, &loaded) == STATUS_ERROR && loaded == NULL);
+
+    file = fopen(path, "w");
+    if (file) {
+        fputs("not an index\n", file);
+        fclose(file);
+    }
+    EXPECT(alt_index_load(graph, path, 2, &loaded) == STATUS_ERROR);
+    unlink(path);
+    EXPECT(alt_index_load(graph, path, 2, &loaded) == STATUS_ERROR);
+
+    alt_index_free(index);
+    graph_destroy(graph);
+}
+
+int main(void) {
+    printf("test_metrics\n");
+    RUN_TEST(test_hyperanf_path);
+    RUN_TEST(test_hyperanf_complete_graph);
+    RUN_TEST(test_hyperanf_limits);
+    RUN_TEST(test_centrality_matches_bfs);
+    RUN_TEST(test_centrality_sources);
+    RUN_TEST(test_motif_census_exact);
+    RUN_TEST(test_motif_census_undirected);
+    RUN_TEST(test_motif_census_sampled);
+    RUN_TEST(test_ppr_matches_power_iteration);
+    RUN_TEST(test_ppr_top_k_and_batch);
+    RUN_TEST(test_link_scores_match_brute_force);
+    RUN_TEST(test_link_top_k);
+    RUN_TEST(test_alt_matches_dijkstra);
+    RUN_TEST(test_alt_edge_cases);
+    RUN_TEST(test_alt_save_load);
+    return TEST_SUMMARY();
+}
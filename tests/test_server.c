@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "core/graph_build.h"
+#include "server/graph_server.h"
+#include "test_helpers.h"
+
+// * Server tests: a client on the Unix socket against a server thread.
+
+typedef struct {
+    GraphServer* server;
+    Status status;
+} ServerThread;
+
+static void* server_main(void* arg) {
+    ServerThread* thread = arg;
+    thread->status = graph_server_run(thread->server);
+    return NULL;
+}
+
+// Helper: connect, retrying while the server thread binds the socket
+static int client_connect(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    snprintf(address.sun_path, sizeof(address.sun_path), "%s", path);
+
+    for (int attempt = 0; attempt < 500; attempt++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (connect(fd, (struct sockaddr*)&address, sizeof(address)) == 0) return fd;
+        close(fd);
+        test_sleep_ms(2);
+    }
+    return -1;
+}
+
+static bool read_exact(int fd, void* data, size_t length) {
+    char* cursor = data;
+    while (length > 0) {
+        ssize_t got = read(fd, cursor, length);
+        if (got <= 0) return false;
+        cursor += got;
+        length -= (size_t)got;
+    }
+    return true;
+}
+
+static bool write_exact(int fd, const void* data, size_t length) {
+    const char* cursor = data;
+    while (length > 0) {
+        ssize_t put = write(fd, cursor, length);
+        if (put <= 0) return false;
+        cursor += put;
+        length -= (size_t)put;
+    }
+    return true;
+}
+
+// Helper: one request, one response; neighbor entries are skipped
+static QueryResponse query(int fd, QueryOp op, int a, int b, double weight) {
+    static uint32_t next_id = 1;
+    QueryRequest request;
+    memset(&request, 0, sizeof(request));
+    request.id = next_id++;
+    request.op = (uint8_t)op;
+    request.a = a;
+    request.b = b;
+    request.weight = weight;
+
+    QueryResponse response;
+    memset(&response, 0, sizeof(response));
+    response.status = QUERY_FAILED;
+    if (!write_exact(fd, &request, sizeof(request)) || !read_exact(fd, &response, sizeof(response))) return response;
+    EXPECT(response.id == request.id);
+
+    if (op == QUERY_NEIGHBORS && response.status == QUERY_OK) {
+        for (int64_t i = 0; i < response.value; i++) {
+            QueryNeighbor neighbor;
+            if (!read_exact(fd, &neighbor, sizeof(neighbor))) break;
+        }
+    }
+    return response;
+}
+
+static void test_server_queries_and_mutations(void) {
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/graph_server_%d.sock", (int)getpid());
+
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int i = 0; i < 4; i++) EXPECT(graph_insert_node(graph, i, 0) == STATUS_SUCCESS);
+    EXPECT(graph_insert_edge(graph, 0, 1, 1.0) == STATUS_SUCCESS);
+    EXPECT(graph_insert_edge(graph, 1, 2, 2.0) == STATUS_SUCCESS);
+
+    ServerConfig config = server_config_default();
+    config.socket_path = path;
+    config.num_threads = 2;
+    ServerThread thread = {graph_server_create(graph, &config), STATUS_ERROR};
+    EXPECT(thread.server != NULL);
+    if (!thread.server) {
+        graph_destroy(graph);
+        return;
+    }
+    pthread_t runner;
+    EXPECT(pthread_create(&runner, NULL, server_main, &thread) == 0);
+
+    int fd = client_connect(path);
+    EXPECT(fd >= 0);
+    if (fd >= 0) {
+        EXPECT(query(fd, QUERY_PING, 0, 0, 0.0).status == QUERY_OK);
+        EXPECT(query(fd, QUERY_DEGREE, 1, 0, 0.0).value == 2);
+        EXPECT(query(fd, QUERY_NEIGHBORS, 1, 0, 0.0).value == 2);
+        EXPECT(query(fd, QUERY_EDGE, 2, 1, 0.0).weight == 2.0);
+        EXPECT(query(fd, QUERY_EDGE, 0, 2, 0.0).status == QUERY_NOT_FOUND);
+        EXPECT(query(fd, QUERY_DISTANCE, 0, 2, 0.0).value == 2);
+        EXPECT(query(fd, QUERY_DISTANCE, 0, 3, 0.0).status == QUERY_NOT_FOUND);
+        EXPECT(query(fd, QUERY_COMPONENT, 2, 0, 0.0).value == 0);
+        EXPECT(query(fd, QUERY_COMPONENT, 9, 0, 0.0).status == QUERY_NOT_FOUND);
+        EXPECT(query(fd, QUERY_OP_COUNT, 0, 0, 0.0).status == QUERY_INVALID);
+
+        // Inserts create missing endpoints and merge components
+        EXPECT(query(fd, QUERY_INSERT_EDGE, 3, 10, 4.0).status == QUERY_OK);
+        EXPECT(query(fd, QUERY_EDGE, 10, 3, 0.0).weight == 4.0);
+        EXPECT(query(fd, QUERY_COMPONENT, 10, 0, 0.0).value == 3);
+        EXPECT(query(fd, QUERY_INSERT_EDGE, 2, 3, 1.0).status == QUERY_OK);
+        EXPECT(query(fd, QUERY_COMPONENT, 10, 0, 0.0).value == 0);
+
+        // Rejected inserts leave no new nodes behind
+        EXPECT(query(fd, QUERY_INSERT_EDGE, 20, 20, 1.0).status == QUERY_FAILED);
+        EXPECT(query(fd, QUERY_DEGREE, 20, 0, 0.0).status == QUERY_NOT_FOUND);
+        EXPECT(query(fd, QUERY_INSERT_EDGE, 1, 0, 1.0).status == QUERY_FAILED);
+        EXPECT(query(fd, QUERY_COMPONENT, 20, 0, 0.0).status == QUERY_NOT_FOUND);
+
+        EXPECT(query(fd, QUERY_REMOVE_EDGE, 2, 3, 0.0).status == QUERY_OK);
+        EXPECT(query(fd, QUERY_REMOVE_EDGE, 2, 3, 0.0).status != QUERY_OK);
+        EXPECT(query(fd, QUERY_COMPONENT, 10, 0, 0.0).value == 3);
+
+        // Pipelined requests come back in order
+        QueryRequest batch[16];
+        memset(batch, 0, sizeof(batch));
+        for (int i = 0; i < 16; i++) {
+            batch[i].id = 1000 + (uint32_t)i;
+            batch[i].op = QUERY_DEGREE;
+            batch[i].a = i % 4;
+        }
+        EXPECT(write_exact(fd, batch, sizeof(batch)));
+        for (int i = 0; i < 16; i++) {
+            QueryResponse response;
+            EXPECT(read_exact(fd, &response, sizeof(response)));
+            EXPECT(response.id == batch[i].id);
+            EXPECT((size_t)response.value == test_degree(graph, i % 4));
+        }
+        close(fd);
+    }
+
+    graph_server_stop(thread.server);
+    pthread_join(runner, NULL);
+    EXPECT(thread.status == STATUS_SUCCESS);
+    graph_server_destroy(thread.server);
+
+    EXPECT(graph->node_count == 5);
+    EXPECT(test_degree(graph, 3) == 1);
+    graph_destroy(graph);
+    unlink(path);
+}
+
+int main(void) {
+    printf("test_server\n");
+    RUN_TEST(test_server_queries_and_mutations);
+    return TEST_SUMMARY();
+}
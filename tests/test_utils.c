@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "utils/thread_utils.h"
+#include "utils/random_utils.h"
+#include "utils/graph_stats.h"
+#include "utils/diagnostics.h"
+#include "utils/format_utils.h"
+#include "test_helpers.h"
+
+// ---------------------------------------------------------------------------
+// thread_utils, random_utils
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int* hits;
+    int max_thread;
+} ForContext;
+
+static void count_task(void* ctx, size_t task, int thread_id) {
+    ForContext* context = ctx;
+    __atomic_fetch_add(&context->hits[task], 1, __ATOMIC_RELAXED);
+    int seen = __atomic_load_n(&context->max_thread, __ATOMIC_RELAXED);
+    while (thread_id > seen && !__atomic_compare_exchange_n(&context->max_thread, &seen, thread_id, false,
+        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static void test_parallel_for_covers_every_task(void) {
+    int threads[] = {1, 3, 8};
+    for (size_t t = 0; t < 3; t++) {
+        ForContext context = {calloc(1000, sizeof(int)), 0};
+        EXPECT(parallel_for(1000, threads[t], count_task, &context) == STATUS_SUCCESS);
+
+        int wrong = 0;
+        for (size_t i = 0; i < 1000; i++) wrong += context.hits[i] != 1;
+        EXPECT(wrong == 0);
+        EXPECT(context.max_thread < threads[t]);
+        free(context.hits);
+    }
+
+    EXPECT(parallel_for(0, 4, count_task, NULL) == STATUS_SUCCESS);
+    EXPECT(thread_count_resolve(0) >= 1 && thread_count_resolve(5) == 5);
+}
+
+static void test_rng_streams(void) {
+    Rng a, b, c;
+    rng_seed(&a, 42, 0);
+    rng_seed(&b, 42, 0);
+    rng_seed(&c, 42, 1);
+
+    int same = 0, equal_streams = 0;
+    for (int i = 0; i < 100; i++) {
+        uint64_t x = rng_next(&a);
+        same += x == rng_next(&b);
+        equal_streams += x == rng_next(&c);
+    }
+    EXPECT(same == 100);
+    EXPECT(equal_streams == 0);
+
+    int out_of_range = 0;
+    double sum = 0.0;
+    for (int i = 0; i < 10000; i++) {
+        out_of_range += rng_bounded(&a, 7) >= 7;
+        double u = rng_uniform(&a);
+        out_of_range += u < 0.0 || u >= 1.0;
+        sum += u;
+    }
+    EXPECT(out_of_range == 0);
+    EXPECT_NEAR(sum / 10000.0, 0.5, 0.02);
+}
+
+// ---------------------------------------------------------------------------
+// graph_stats
+// ---------------------------------------------------------------------------
+
+static void lookup_task(void* ctx, size_t task, int thread_id) {
+    (void)thread_id;
+    const Graph* graph = ctx;
+    for (int id = 0; id < 200; id++) find_node(graph, (int)(task % 2) * 1000 + id);
+}
+
+static void test_graph_stats_shape(void) {
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    for (int id = 0; id < 200; id++) graph_insert_node(graph, id, 8);
+    for (int id = 1; id < 200; id++) graph_insert_edge(graph, 0, id, 1.0);
+
+    GraphStats stats = graph_stats(graph);
+    EXPECT(stats.node_count == 200 && stats.edge_count == 199);
+    EXPECT(stats.bucket_count == graph->node_capacity);
+    EXPECT(stats.used_buckets > 0 && stats.used_buckets <= stats.bucket_count);
+    EXPECT(stats.adjacency_used == 2 * 199);
+    EXPECT(stats.adjacency_capacity >= stats.adjacency_used);
+    EXPECT(stats.bytes_total == stats.bytes_graph + stats.bytes_hash_table + stats.bytes_node_ids
+        + stats.bytes_nodes + stats.bytes_adjacency);
+
+    FILE* out = tmpfile();
+    EXPECT(out && graph_stats_dump_json(&stats, out) == STATUS_SUCCESS);
+    if (out) fclose(out);
+    graph_destroy(graph);
+}
+
+static void test_graph_stats_counters(void) {
+    Graph* graph = graph_create(GRAPH_DIRECTED, 0);
+    for (int id = 0; id < 200; id++) graph_insert_node(graph, id, 0);
+
+    // Half of the tasks look up existing IDs, the other half missing ones
+    graph_stats_reset();
+    EXPECT(parallel_for(64, 4, lookup_task, graph) == STATUS_SUCCESS);
+    GraphStats stats = graph_stats(graph);
+
+#ifdef GRAPH_STATS
+    EXPECT(stats.counters_enabled);
+    EXPECT(stats.counters.lookups == 64 * 200);
+    EXPECT(stats.counters.lookup_hits == 32 * 200 && stats.counters.lookup_misses == 32 * 200);
+    uint64_t probes = 0;
+    for (size_t i = 0; i < STATS_HISTOGRAM_BUCKETS; i++) probes += stats.counters.probe_histogram[i];
+    EXPECT(probes == 64 * 200);
+
+    // Only successful mutations count; a duplicate scan stops at the hit
+    for (int to = 1; to <= 3; to++) graph_insert_edge(graph, 0, to, 1.0);
+    graph_stats_reset();
+    EXPECT(graph_insert_edge(graph, 0, 1, 1.0) == STATUS_WARNING);
+    EXPECT(graph_insert_edge(graph, 0, 999, 1.0) == STATUS_WARNING);
+    EXPECT(graph_insert_edge(graph, 0, 4, 1.0) == STATUS_SUCCESS);
+    stats = graph_stats(graph);
+    EXPECT(stats.counters.edge_inserts == 1);
+    EXPECT(stats.counters.duplicate_scans == 2 && stats.counters.duplicate_hits == 1);
+    EXPECT(stats.counters.duplicate_scan_steps == 1 + 3);
+#else
+    EXPECT(!stats.counters_enabled && stats.counters.lookups == 0);
+#endif
+    graph_destroy(graph);
+}
+
+// ---------------------------------------------------------------------------
+// diagnostics
+// ---------------------------------------------------------------------------
+
+static void count_sink(const DiagRecord* record, void* ctx) {
+    (void)record;
+    (*(int*)ctx)++;
+}
+
+static void test_diag_default_ring_skips_warnings(void) {
+    diag_reset();
+    Graph* graph = graph_create(GRAPH_UNDIRECTED, 0);
+    graph_insert_node(graph, 1, 0);
+    graph_insert_node(graph, 2, 0);
+    graph_insert_edge(graph, 1, 2, 1.0);
+
+    // Duplicate edge: counted, but not buffered at the default ring level
+    EXPECT(graph_insert_edge(graph, 1, 2, 1.0) == STATUS_WARNING);
+    DiagRecord records[4];
+    EXPECT(diag_count(ERR_EXISTS) == 1);
+    EXPECT(diag_drain(records, 4) == 0);
+
+    diag_set_ring_level(DIAG_WARNING);
+    graph_insert_edge(graph, 2, 1, 1.0);
+    EXPECT(diag_drain(records, 4) == 1);
+    EXPECT(records[0].level == DIAG_WARNING && records[0].code == ERR_EXISTS);
+    EXPECT(records[0].a == 2 && records[0].b == 1);
+    EXPECT(diag_count(ERR_EXISTS) == 2);
+
+    diag_set_ring_level(DIAG_ERROR);
+    graph_destroy(graph);
+    diag_reset();
+}
+
+static void test_diag_sink_and_overflow(void) {
+    diag_reset();
+    int delivered = 0;
+    diag_set_sink(count_sink, &delivered, DIAG_ERROR);
+    DIAG(DIAG_WARNING, ERR_NOT_FOUND, "below the sink level", -1, -1);
+    DIAG(DIAG_ERROR, ERR_INVALID_ARG, "delivered", 1, -1);
+    EXPECT(delivered == 1);
+    diag_set_sink(NULL, NULL, DIAG_DEBUG);
+    DIAG(DIAG_FATAL, ERR_INTERNAL, "no sink installed", -1, -1);
+    EXPECT(delivered == 1);
+
+    // Ring keeps the newest DIAG_RING_SIZE records
+    diag_reset();
+    for (int i = 0; i < DIAG_RING_SIZE + 10; i++) DIAG(DIAG_ERROR, ERR_INVALID_ARG, "flood", i, -1);
+    EXPECT(diag_dropped() == 10);
+    DiagRecord first;
+    EXPECT(diag_drain(&first, 1) == 1 && first.a == 10);
+    EXPECT(diag_count(ERR_INVALID_ARG) == DIAG_RING_SIZE + 10);
+
+    diag_reset();
+    EXPECT(diag_drain(&first, 1) == 0 && diag_dropped() == 0 && diag_count(ERR_INVALID_ARG) == 0);
+}
+
+// ---------------------------------------------------------------------------
+// format_utils
+// ---------------------------------------------------------------------------
+
+static void test_format_numbers(void) {
+    char out[FORMAT_DOUBLE_CHARS + 1];
+
+    out[format_int(out, -2147483647 - 1)] = '\0';
+    EXPECT(strcmp(out, "-2147483648") == 0);
+    out[format_int(out, 0)] = '\0';
+    EXPECT(strcmp(out, "0") == 0);
+    out[format_uint64(out, UINT64_MAX)] = '\0';
+    EXPECT(strcmp(out, "18446744073709551615") == 0);
+
+    out[format_double(out, 1.0)] = '\0';
+    EXPECT(strcmp(out, "1") == 0);
+    out[format_double(out, -2.25)] = '\0';
+    EXPECT(strcmp(out, "-2.25") == 0);
+
+    // Everything parses back to the same double
+    double values[] = {0.1, 1.0 / 3.0, 1e-300, 6.02214076e23, -0.0, 123456789.125, 1e9 + 0.5};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        out[format_double(out, values[i])] = '\0';
+        EXPECT(strtod(out, NULL) == values[i]);
+    }
+}
+
+int main(void) {
+    printf("test_utils\n");
+    RUN_TEST(test_parallel_for_covers_every_task);
+    RUN_TEST(test_rng_streams);
+    RUN_TEST(test_graph_stats_shape);
+    RUN_TEST(test_graph_stats_counters);
+    RUN_TEST(test_diag_default_ring_skips_warnings);
+    RUN_TEST(test_diag_sink_and_overflow);
+    RUN_TEST(test_format_numbers);
+    return TEST_SUMMARY();
+}